@@ -22,8 +22,11 @@
 #include <cstdlib>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include "Environment.h"
 #include <helpers/StringUtils.h>
+#include <helpers/CpuFeatures.h>
+#include <helpers/NumaHelper.h>
 
 namespace nd4j {
 
@@ -35,6 +38,10 @@ namespace nd4j {
         _profile.store(false);
         _precBoost.store(false);
         _dataType.store(nd4j::DataType::FLOAT32);
+        _maxThreads.store(static_cast<int>(std::thread::hardware_concurrency()));
+
+        _maxIsaLevel = CpuFeatures::detectIsaLevel();
+        _isaLevel.store(_maxIsaLevel);
 
 #ifndef ANDROID
         const char* omp_threads = std::getenv("OMP_NUM_THREADS");
@@ -49,6 +56,73 @@ namespace nd4j {
                 // still do nothing
             }
         }
+
+        const char* isa = std::getenv("ND4J_ISA");
+        if (isa != nullptr) {
+            int level = CpuFeatures::isaLevelByName(isa);
+            if (level >= 0 && level <= _maxIsaLevel)
+                _isaLevel.store(level);
+        }
+
+        const char* poolSpin = std::getenv("ND4J_POOL_SPIN");
+        if (poolSpin != nullptr) {
+            try {
+                setThreadPoolSpin(std::stoi(std::string(poolSpin)));
+            } catch (std::exception &e) {
+                // keep default
+            }
+        }
+
+        const char* poolAffinity = std::getenv("ND4J_POOL_AFFINITY");
+        if (poolAffinity != nullptr) {
+            std::string affinity(poolAffinity);
+            _threadPoolAffinity.store(affinity == "1" || affinity == "true");
+        }
+
+        const char* numa = std::getenv("ND4J_NUMA");
+        if (numa != nullptr) {
+            int policy = NumaHelper::policyByName(numa);
+            if (policy >= 0)
+                _numaPolicy.store(policy);
+        }
+
+        const char* numaNode = std::getenv("ND4J_NUMA_NODE");
+        if (numaNode != nullptr) {
+            try {
+                int node = std::stoi(std::string(numaNode));
+                if (node >= 0 && node < NumaHelper::numNodes())
+                    _numaNode.store(node);
+            } catch (std::exception &e) {
+                // keep default
+            }
+        }
+
+        const char* numaPin = std::getenv("ND4J_NUMA_PIN");
+        if (numaPin != nullptr) {
+            std::string pin(numaPin);
+            _numaPinThreads.store(pin == "1" || pin == "true");
+        }
+
+        const char* trace = std::getenv("ND4J_TRACE");
+        if (trace != nullptr) {
+            std::string t(trace);
+            _opTracing.store(t == "1" || t == "true");
+        }
+
+        const char* approxExp = std::getenv("ND4J_APPROX_EXP");
+        if (approxExp != nullptr) {
+            std::string a(approxExp);
+            _approximateExp.store(a == "1" || a == "true");
+        }
+
+        const char* im2colLimit = std::getenv("ND4J_IM2COL_LIMIT");
+        if (im2colLimit != nullptr) {
+            try {
+                setIm2colLimit(std::stoll(std::string(im2colLimit)));
+            } catch (std::exception &e) {
+                // keep default
+            }
+        }
 #endif
     }
 
@@ -138,6 +212,27 @@ namespace nd4j {
         _precBoost.store(reallyAllow);
     }
 
+    void Environment::setIsaLevel(int level) {
+        if (level < ISA_GENERIC || level > _maxIsaLevel)
+            throw std::runtime_error("Requested ISA level isn't supported by this CPU");
+
+        _isaLevel.store(level);
+    }
+
+    void Environment::setNumaPolicy(int policy) {
+        if (policy < NUMA_DEFAULT || policy > NUMA_BIND)
+            throw std::runtime_error("Unknown NUMA policy requested");
+
+        _numaPolicy.store(policy);
+    }
+
+    void Environment::setNumaNode(int node) {
+        if (node < 0 || node >= NumaHelper::numNodes())
+            throw std::runtime_error("Requested NUMA node doesn't exist");
+
+        _numaNode.store(node);
+    }
+
     nd4j::Environment *nd4j::Environment::_instance = 0;
 
 }
@@ -22,6 +22,7 @@
 #define LIBND4J_ENVIRONMENT_H
 
 #include <atomic>
+#include <cstdint>
 #include <dll.h>
 #include <stdexcept>
 #include <array/DataType.h>
@@ -39,6 +40,36 @@ namespace nd4j{
         std::atomic<bool> _precBoost;
         std::atomic<bool> _useMKLDNN{true};
 
+        // workspace allocation options
+        std::atomic<bool> _workspaceZeroing{false};
+        std::atomic<bool> _workspaceHugePages{false};
+        std::atomic<int> _workspaceThreadChunk{0};
+
+        // instruction set used by CPU loops, and the best one current CPU supports
+        std::atomic<int> _isaLevel{0};
+        int _maxIsaLevel = 0;
+
+        // graph rewrites applied on import
+        std::atomic<bool> _graphFusion{false};
+
+        // intra-op thread pool options, used with THREADPOOL=yes builds
+        std::atomic<int> _threadPoolSpin{10000};
+        std::atomic<bool> _threadPoolAffinity{false};
+
+        // NUMA placement of host buffers, and pinning of thread teams to nodes
+        std::atomic<int> _numaPolicy{0};
+        std::atomic<int> _numaNode{0};
+        std::atomic<bool> _numaPinThreads{false};
+
+        // per-op trace collection, see graph/profiling/OpTraceCollector.h
+        std::atomic<bool> _opTracing{false};
+
+        // polynomial exp in softmax loops
+        std::atomic<bool> _approximateExp{false};
+
+        // max size of im2col/vol2col buffer in convolutions, bigger ones are done via implicit GEMM
+        std::atomic<int64_t> _im2colLimit{256L * 1024L * 1024L};
+
 #ifdef __ND4J_EXPERIMENTAL__
         const bool _experimental = true;
 #else
@@ -72,6 +103,93 @@ namespace nd4j{
         bool isUseMKLDNN() { return _useMKLDNN.load(); }
         void setUseMKLDNN(bool useMKLDNN) { _useMKLDNN.store(useMKLDNN); }
 
+        /**
+         * If enabled, workspace buffers are zeroed upon allocation. Disabled by default, since arrays initialize their memory themselves
+         */
+        bool isWorkspaceZeroing() { return _workspaceZeroing.load(); }
+        void setWorkspaceZeroing(bool reallyZero) { _workspaceZeroing.store(reallyZero); }
+
+        /**
+         * If enabled, big workspace buffers are aligned to 2MB and advised to be backed by transparent huge pages (Linux only)
+         */
+        bool isWorkspaceHugePages() { return _workspaceHugePages.load(); }
+        void setWorkspaceHugePages(bool reallyUse) { _workspaceHugePages.store(reallyUse); }
+
+        /**
+         * Size of per-thread chunk carved out of workspace for small allocations, in bytes. 0 disables per-thread chunks
+         */
+        int workspaceThreadChunk() { return _workspaceThreadChunk.load(); }
+        void setWorkspaceThreadChunk(int bytes) { _workspaceThreadChunk.store(bytes < 0 ? 0 : bytes); }
+
+        /**
+         * ISA level CPU loops are dispatched to (see IsaLevel in helpers/CpuFeatures.h). Defaults to the best level supported by current CPU,
+         * can be lowered via setIsaLevel() or ND4J_ISA environment variable: generic, avx2, avx512
+         */
+        int isaLevel() { return _isaLevel.load(std::memory_order_relaxed); }
+        int maxIsaLevel() { return _maxIsaLevel; }
+        void setIsaLevel(int level);
+
+        /**
+         * If enabled, chains of elementwise ops (including matmul epilogues) are fused into single ops when Graph is imported
+         */
+        bool isGraphFusion() { return _graphFusion.load(); }
+        void setGraphFusion(bool reallyFuse) { _graphFusion.store(reallyFuse); }
+
+        /**
+         * Number of iterations idle thread pool worker spins waiting for next job, before it parks. 0 means workers park immediately.
+         * Can be set via ND4J_POOL_SPIN environment variable
+         */
+        int threadPoolSpin() { return _threadPoolSpin.load(std::memory_order_relaxed); }
+        void setThreadPoolSpin(int iterations) { _threadPoolSpin.store(iterations < 0 ? 0 : iterations); }
+
+        /**
+         * If enabled, thread pool workers are pinned to cores (Linux only). Takes effect when pool is created, i.e. before first parallel loop.
+         * Can be set via ND4J_POOL_AFFINITY environment variable
+         */
+        bool isThreadPoolAffinity() { return _threadPoolAffinity.load(); }
+        void setThreadPoolAffinity(bool reallyPin) { _threadPoolAffinity.store(reallyPin); }
+
+        /**
+         * NUMA placement policy for workspace and array buffers (see NumaPolicy in helpers/NumaHelper.h). Default policy leaves placement to OS.
+         * Interleave/bind apply to heap arrays of NumaHelper::minPlacedBytes() and more, smaller ones are left to first touch.
+         * Can be set via ND4J_NUMA environment variable: default, interleave, local, bind
+         */
+        int numaPolicy() { return _numaPolicy.load(std::memory_order_relaxed); }
+        void setNumaPolicy(int policy);
+
+        /**
+         * Node buffers are bound to with NUMA_BIND policy. Can be set via ND4J_NUMA_NODE environment variable
+         */
+        int numaNode() { return _numaNode.load(std::memory_order_relaxed); }
+        void setNumaNode(int node);
+
+        /**
+         * If enabled, OpenMP threads and thread pool workers are pinned to NUMA nodes in contiguous blocks, so thread N always works on the same node.
+         * Takes effect before first parallel loop only. Can be set via ND4J_NUMA_PIN environment variable
+         */
+        bool isNumaPinThreads() { return _numaPinThreads.load(); }
+        void setNumaPinThreads(bool reallyPin) { _numaPinThreads.store(reallyPin); }
+
+        /**
+         * If enabled, every op execution is recorded by OpTraceCollector. Can be set via ND4J_TRACE environment variable
+         */
+        bool isOpTracing() { return _opTracing.load(std::memory_order_relaxed); }
+        void setOpTracing(bool reallyTrace) { _opTracing.store(reallyTrace); }
+
+        /**
+         * If enabled, softmax and log_softmax of float, half and bfloat16 arrays use vectorizable polynomial exp instead of libm one,
+         * with relative error below 1e-6. Double arrays always use exact exp. Can be set via ND4J_APPROX_EXP environment variable
+         */
+        bool isApproximateExp() { return _approximateExp.load(std::memory_order_relaxed); }
+        void setApproximateExp(bool reallyApproximate) { _approximateExp.store(reallyApproximate); }
+
+        /**
+         * Max size of columns buffer conv2d/conv3d (and their backprop) may materialize for BLAS GEMM, in bytes. Convolutions that need
+         * bigger buffer use implicit GEMM that packs columns tile by tile instead. 0 forces implicit GEMM. Can be set via ND4J_IM2COL_LIMIT environment variable
+         */
+        int64_t im2colLimit() { return _im2colLimit.load(std::memory_order_relaxed); }
+        void setIm2colLimit(int64_t bytes) { _im2colLimit.store(bytes < 0 ? 0 : bytes); }
+
         nd4j::DataType defaultFloatDataType();
         void setDefaultFloatDataType(nd4j::DataType dtype);
 
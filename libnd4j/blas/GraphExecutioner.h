@@ -47,7 +47,10 @@ namespace nd4j {
     public:
         //static Nd4jStatus executeFlatNode(nd4j::graph::Graph *graph, nd4j::graph::Node *node, nd4j::graph::VariableSpace<float> *variableSpace);
 
-        static Nd4jStatus executeFlatNode(Graph *graph, Node *node, VariableSpace *variableSpace);
+        /**
+         * This method executes single node. If workspace is given, op allocates from it instead of VariableSpace workspace
+         */
+        static Nd4jStatus executeFlatNode(Graph *graph, Node *node, VariableSpace *variableSpace, nd4j::memory::Workspace *workspace = nullptr);
 
         /**
         * This method executes given Graph
@@ -71,6 +74,11 @@ namespace nd4j {
 
         static Graph *importFromFlatBuffers(const char *filename);
 
+        /**
+        * This method imports Graph from memory-mapped FlatBuffers file, without copying arrays stored in it
+        */
+        static Graph *importFromMappedFlatBuffers(const char *filename);
+
         static Graph *importFromFlatPointer(Nd4jPointer ptr);
     };
 
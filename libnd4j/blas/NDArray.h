@@ -32,6 +32,7 @@
 #include <array/ArrayType.h>
 #include <array/ResultSet.h>
 #include <helpers/ShapeBuilders.h>
+#include <helpers/ConstantShapeHelper.h>
 #include <op_enums.h>
 #include <ops/BroadcastOpsTuple.h>
 #include <ops/BroadcastBoolOpsTuple.h>
@@ -98,6 +99,11 @@ namespace nd4j {
 */
         template <typename T>
         void* templatedPointerShift(const Nd4jLong offset) const;
+
+        /**
+         * This method zeroes freshly allocated buffer. Heap buffers are zeroed in parallel under NUMA_LOCAL policy, so their pages get spread over nodes
+         */
+        void placeBuffer();
     
     protected:
 
@@ -1500,7 +1506,9 @@ namespace nd4j {
     //////////////////////////////////////////////////////////////////////////
     void NDArray::triggerAllocationFlag(bool bufferAllocated, bool shapeAllocated) {
         _isBuffAlloc = bufferAllocated;
-        _isShapeAlloc = shapeAllocated;
+
+        // interned shapes are shared between arrays, so they're never released by any of them
+        _isShapeAlloc = shapeAllocated && !nd4j::ConstantShapeHelper::getInstance()->isInterned(_shapeInfo);
     }
 
     //////////////////////////////////////////////////////////////////////////
@@ -579,6 +579,42 @@ public:
         BUILD_SINGLE_SELECTOR(xType, nd4j::SpecialMethods, ::sortTadGeneric(x, xShapeInfo, dimension, dimensionLength, tadShapeInfo, tadOffsets, descending), LIBND4J_TYPES);
     }
 
+    static void execSortByKey(void *x, Nd4jLong *xShapeInfo, void *y, Nd4jLong *yShapeInfo, bool descending) {
+        auto xType = nd4j::ArrayOptions::dataType(xShapeInfo);
+        auto yType = nd4j::ArrayOptions::dataType(yShapeInfo);
+
+        BUILD_DOUBLE_SELECTOR(xType, yType, nd4j::DoubleMethods, ::sortByKey(x, xShapeInfo, y, yShapeInfo, descending), LIBND4J_TYPES, LIBND4J_TYPES);
+    }
+
+    static void execSortByValue(void *x, Nd4jLong *xShapeInfo, void *y, Nd4jLong *yShapeInfo, bool descending) {
+        auto xType = nd4j::ArrayOptions::dataType(xShapeInfo);
+        auto yType = nd4j::ArrayOptions::dataType(yShapeInfo);
+
+        BUILD_DOUBLE_SELECTOR(xType, yType, nd4j::DoubleMethods, ::sortByValue(x, xShapeInfo, y, yShapeInfo, descending), LIBND4J_TYPES, LIBND4J_TYPES);
+    }
+
+    static void execSortTadByKey(void *x, Nd4jLong *xShapeInfo, void *y, Nd4jLong *yShapeInfo, int *dimension, int dimensionLength, bool descending) {
+        auto xType = nd4j::ArrayOptions::dataType(xShapeInfo);
+        auto yType = nd4j::ArrayOptions::dataType(yShapeInfo);
+
+        BUILD_DOUBLE_SELECTOR(xType, yType, nd4j::DoubleMethods, ::sortTadByKey(x, xShapeInfo, y, yShapeInfo, dimension, dimensionLength, descending), LIBND4J_TYPES, LIBND4J_TYPES);
+    }
+
+    static void execSortTadByValue(void *x, Nd4jLong *xShapeInfo, void *y, Nd4jLong *yShapeInfo, int *dimension, int dimensionLength, bool descending) {
+        auto xType = nd4j::ArrayOptions::dataType(xShapeInfo);
+        auto yType = nd4j::ArrayOptions::dataType(yShapeInfo);
+
+        BUILD_DOUBLE_SELECTOR(xType, yType, nd4j::DoubleMethods, ::sortTadByValue(x, xShapeInfo, y, yShapeInfo, dimension, dimensionLength, descending), LIBND4J_TYPES, LIBND4J_TYPES);
+    }
+
+    static void execArgSort(void *x, Nd4jLong *xShapeInfo, void *z, Nd4jLong *zShapeInfo, bool descending) {
+        auto xType = nd4j::ArrayOptions::dataType(xShapeInfo);
+        if (nd4j::ArrayOptions::dataType(zShapeInfo) != nd4j::DataType::INT64)
+            throw std::runtime_error("argSort: indices array must have INT64 data type");
+
+        BUILD_SINGLE_SELECTOR(xType, nd4j::SpecialMethods, ::argSortGeneric(x, xShapeInfo, reinterpret_cast<Nd4jLong *>(z), zShapeInfo, descending), LIBND4J_TYPES);
+    }
+
     inline static void execSortCooIndices(Nd4jLong *indices, void *values, Nd4jLong length, int rank) {
         nd4j::sparse::SparseUtils<Nd4jLong>::sortCooIndicesGeneric(indices, reinterpret_cast<Nd4jLong *>(values), length, rank);
     }
@@ -867,6 +867,31 @@ public:
      */
     void enableVerboseMode(bool reallyEnable);
 
+    /**
+     * This method enables or disables per-op trace collection
+     *
+     * @param reallyEnable
+     */
+    void enableOpTracing(bool reallyEnable);
+
+    /**
+     * This method writes ops traced so far as Chrome trace-event JSON
+     *
+     * @param path
+     * @return 0 on success, non-zero if file can't be written
+     */
+    int exportOpTrace(const char *path);
+
+    /**
+     * This method prints out per-op counters aggregated by op name and shapes
+     */
+    void printOpTrace();
+
+    /**
+     * This method drops all traced ops
+     */
+    void resetOpTrace();
+
     /**
      *
      * @param gridSize
@@ -1594,6 +1619,47 @@ public:
             Nd4jLong *tadOffsets,
             bool descending);
 
+    // key-value sorts: x and y are permuted together, ordered by x for ByKey variants, and by y for ByValue variants
+    void sortByKey(Nd4jPointer *extraPointers,
+            void *x, Nd4jLong *xShapeInfo,
+            void *dx, Nd4jLong *dxShapeInfo,
+            void *y, Nd4jLong *yShapeInfo,
+            void *dy, Nd4jLong *dyShapeInfo,
+            bool descending);
+
+    void sortByValue(Nd4jPointer *extraPointers,
+            void *x, Nd4jLong *xShapeInfo,
+            void *dx, Nd4jLong *dxShapeInfo,
+            void *y, Nd4jLong *yShapeInfo,
+            void *dy, Nd4jLong *dyShapeInfo,
+            bool descending);
+
+    void sortTadByKey(Nd4jPointer *extraPointers,
+            void *x, Nd4jLong *xShapeInfo,
+            void *dx, Nd4jLong *dxShapeInfo,
+            void *y, Nd4jLong *yShapeInfo,
+            void *dy, Nd4jLong *dyShapeInfo,
+            int *dimension,
+            int dimensionLength,
+            bool descending);
+
+    void sortTadByValue(Nd4jPointer *extraPointers,
+            void *x, Nd4jLong *xShapeInfo,
+            void *dx, Nd4jLong *dxShapeInfo,
+            void *y, Nd4jLong *yShapeInfo,
+            void *dy, Nd4jLong *dyShapeInfo,
+            int *dimension,
+            int dimensionLength,
+            bool descending);
+
+    // stores indices that would sort x into z (INT64), x itself stays intact
+    void argSort(Nd4jPointer *extraPointers,
+            void *x, Nd4jLong *xShapeInfo,
+            void *dx, Nd4jLong *dxShapeInfo,
+            void *z, Nd4jLong *zShapeInfo,
+            void *dz, Nd4jLong *dzShapeInfo,
+            bool descending);
+
 
     // special sort impl for sorting out COO indices and values
     void sortCooIndices(Nd4jPointer *extraPointers, Nd4jLong *indices, void *values, Nd4jLong length, int rank);
@@ -1657,6 +1723,13 @@ public:
                       int* hIindexes, int* dIindexes);
 
     void inspectArray(Nd4jPointer *extraPointers, Nd4jPointer buffer, Nd4jLong *shapeInfo, Nd4jPointer specialBuffer, Nd4jLong *specialShapeInfo, Nd4jPointer debugInfo);
+
+    /**
+     * These methods return TAD cache statistics: number of cache hits, number of cache misses, and number of cached TAD packs
+     */
+    Nd4jLong getTadCacheHits();
+    Nd4jLong getTadCacheMisses();
+    Nd4jLong getTadCacheSize();
 };
 
 
@@ -44,8 +44,11 @@
 #include <chrono>
 #include <ctime>
 #include <graph/execution/LogicExecutor.h>
+#include <graph/execution/DataflowExecutor.h>
+#include <graph/MemoryPlan.h>
 #include <array/DataTypeUtils.h>
 #include <helpers/BitwiseUtils.h>
+#include <graph/FlatUtils.h>
 #include <generated/array_generated.h>
 #include <helpers/ShapeUtils.h>
 #include <Status.h>
@@ -68,7 +71,7 @@ namespace graph {
  * @param variableSpace - VariableSpace instance pointer - varspace specific to current Thread/Session
  * @return
  */
- Nd4jStatus GraphExecutioner::executeFlatNode(Graph *graph, Node *node, VariableSpace *variableSpace) {
+ Nd4jStatus GraphExecutioner::executeFlatNode(Graph *graph, Node *node, VariableSpace *variableSpace, nd4j::memory::Workspace *workspace) {
     OpType opType = node->opType();
     int opNum = node->opNum();
 //    std::string opName = *(node->getCustomOp()->getOpName());
@@ -86,6 +89,8 @@ namespace graph {
     }
 
     Context context(node->getContextPrototype(), variableSpace);
+    if (workspace != nullptr)
+        context.attachWorkspace(workspace);
 
     if (nd4j::Environment::getInstance()->isDebugAndVerbose()) {
         //nd4j_debug("Input variables: %i\n", node->input()->size());
@@ -217,6 +222,18 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
     Nd4jLong tb0 = Environment::getInstance()->isProfiling() ? GraphProfile::currentTime() : 0L;
     graph->buildGraph();
 
+    // if graph has static memory plan - binding arena-backed arrays, so ops don't allocate their outputs
+    auto memoryPlan = __variableSpace == graph->getVariableSpace() ? graph->memoryPlan() : nullptr;
+    if (memoryPlan != nullptr) {
+        if (memoryPlan->isValid(__variableSpace)) {
+            memoryPlan->attach(__variableSpace);
+        } else {
+            nd4j_debug("Input shapes changed, dropping memory plan\n", "");
+            graph->forgetMemoryPlan();
+            memoryPlan = nullptr;
+        }
+    }
+
     auto footprintForward = nd4j::memory::MemoryRegistrator::getInstance()->getGraphMemoryFootprint(graph->hashCode());
     if (footprintForward > 0) {
         if (__variableSpace->workspace() != nullptr) {
@@ -234,6 +251,22 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
 
     bool pe = graph->getExecutorConfiguration()->_executionMode == ExecutionMode_AUTO;
 
+    // in AUTO mode graphs without control flow are executed as dataflow, with independent nodes running concurrently
+    // memory plan relies on sequential execution order though, so planned graphs are executed sequentially
+    if (pe && memoryPlan == nullptr && DataflowExecutor::isApplicable(graph)) {
+        auto status = DataflowExecutor::execute(graph, __variableSpace);
+
+        if (Environment::getInstance()->isProfiling())
+            flowPath->profile()->setExecutionTime(GraphProfile::relativeTime(timeStart));
+
+        if (__variableSpace->workspace() != nullptr)
+            nd4j::memory::MemoryRegistrator::getInstance()->setGraphMemoryFootprintIfGreater(graph->hashCode(), __variableSpace->workspace()->getAllocatedSize());
+
+        if (tempFlow)
+            delete flowPath;
+
+        return status;
+    }
 
     // basically if at some point code diverges, code branch might be _DISABLED_, and all nodes within that branch will be disabled as well
 
@@ -435,6 +468,10 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
 
                 auto timeStart = std::chrono::system_clock::now();
 
+                // arena memory is shared between arrays, so planned outputs are zeroed before producer writes them, and checked against actual shapes
+                if (memoryPlan != nullptr)
+                    memoryPlan->prepare(node, __variableSpace);
+
                 // actual node execution happens right here
                 Nd4jStatus status = executeFlatNode(graph, node, __variableSpace);
 
@@ -576,14 +613,7 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
 
 
         NDArray* array = var->getNDArray();
-        auto byteVector = array->asByteVector();
-
-        auto fBuffer = builder.CreateVector(byteVector);
-        auto fShape = builder.CreateVector(array->getShapeInfoAsFlatVector());
-
-        auto bo = static_cast<nd4j::graph::ByteOrder>(BitwiseUtils::asByteOrder());
-
-        auto fArray = CreateFlatArray(builder, fShape, fBuffer, static_cast<nd4j::graph::DataType>(array->dataType()), bo);
+        auto fArray = FlatUtils::toFlatArray(builder, *array);
 
         auto fName = builder.CreateString(*(var->getName()));
         auto id = CreateIntPair(builder, var->id(), var->index());
@@ -837,14 +867,13 @@ uint8_t* readFlatBuffers(const char * filename) {
     uint8_t * data = new uint8_t[fileLen];
 
     FILE *in = fopen(filename, "rb");
-    int cnt = 0;
-    int b = 0;
-    while (cnt < fileLen) {
-        b += fread(data + cnt, 1, 1, in);
+    auto cnt = fread(data, 1, fileLen, in);
+    fclose(in);
 
-        cnt++;
+    if ((long) cnt != fileLen) {
+        delete[] data;
+        throw std::runtime_error("Failed to read file");
     }
-    fclose(in);
 
     return data;
 }
@@ -899,6 +928,23 @@ flatbuffers::Offset<FlatResult> GraphExecutioner::execute(Graph *graph, flatbuff
             return restoredGraph;
         }
 
+        /**
+        *   This method maps given FlatBuffers file into memory, and returns Graph instance.
+        *   Arrays stored in the file are used in place where possible, so they don't take heap memory,
+        *   and file stays mapped as long as Graph exists.
+        */
+        Graph* GraphExecutioner::importFromMappedFlatBuffers(const char *filename) {
+            auto file = new MappedFile(filename);
+
+            try {
+                auto fg = GetFlatGraph(reinterpret_cast<uint8_t *>(file->pointer()));
+                return new Graph(fg, nullptr, file);
+            } catch (...) {
+                delete file;
+                throw;
+            }
+        }
+
         Graph *GraphExecutioner::importFromFlatPointer(Nd4jPointer ptr) {
             auto fg = GetFlatGraph(reinterpret_cast<uint8_t *>(ptr));
             auto restoredGraph = new Graph(fg);
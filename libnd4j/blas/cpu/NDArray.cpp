@@ -42,6 +42,8 @@
 #include <helpers/threshold.h>
 #include <graph/exceptions/datatype_exception.h>
 #include <helpers/ConstantTadHelper.h>
+#include <helpers/ConstantShapeHelper.h>
+#include <helpers/NumaHelper.h>
 
 namespace nd4j {
 
@@ -126,6 +128,15 @@ namespace nd4j {
     }
     BUILD_SINGLE_TEMPLATE(template NDArray* NDArray::asT, (), LIBND4J_TYPES);
 
+////////////////////////////////////////////////////////////////////////
+// shapes are taken from ConstantShapeHelper whenever possible, so they aren't allocated per array
+static Nd4jLong* constantOrNewShapeInfo(const nd4j::DataType dtype, const char order, const std::vector<Nd4jLong> &shape, nd4j::memory::Workspace* workspace, bool &isShapeAlloc) {
+    auto shapeInfo = ConstantShapeHelper::getInstance()->createShapeInfo(dtype, order, shape);
+    isShapeAlloc = shapeInfo == nullptr;
+
+    return isShapeAlloc ? ShapeBuilders::createShapeInfo(dtype, order, shape, workspace) : shapeInfo;
+}
+
 ////////////////////////////////////////////////////////////////////////
 // copy constructor
 NDArray::NDArray(const NDArray& other) {
@@ -183,6 +194,22 @@ NDArray::NDArray(nd4j::memory::Workspace* workspace) {
     _length = 0;
 }
 
+////////////////////////////////////////////////////////////////////////
+// workspace buffers are placed once, when workspace itself is allocated. Heap buffers get interleave/bind policy only if they're big:
+// mbind costs a syscall, and small buffers share pages with other allocations anyway
+void NDArray::placeBuffer() {
+    const auto policy = Environment::getInstance()->numaPolicy();
+    const auto numBytes = _length * sizeOfT();
+
+    if (_workspace == nullptr && (policy == NUMA_INTERLEAVE || policy == NUMA_BIND) && numBytes >= NumaHelper::minPlacedBytes())
+        NumaHelper::place(_buffer, numBytes);
+
+    if (_workspace == nullptr && policy == NUMA_LOCAL)
+        NumaHelper::firstTouch(_buffer, _length, static_cast<int>(sizeOfT()));
+    else
+        memset(_buffer, 0, numBytes);
+}
+
 ////////////////////////////////////////////////////////////////////////
 // default constructor
  NDArray::NDArray() {
@@ -198,10 +225,12 @@ NDArray::NDArray(const char order, const std::vector<Nd4jLong> &shape, nd4j::Dat
         throw std::invalid_argument("Rank of NDArray can't exceed 32");
 
     _workspace = workspace;
-    setShapeInfo(ShapeBuilders::createShapeInfo(dtype, order, shape, workspace));
+    bool isShapeAlloc;
+    setShapeInfo(constantOrNewShapeInfo(dtype, order, shape, workspace, isShapeAlloc));
     ALLOCATE(_buffer, workspace, _length * DataTypeUtils::sizeOf(dtype), int8_t);
-    memset(_buffer, 0, _length * DataTypeUtils::sizeOf(dtype));    
-    triggerAllocationFlag(true, true);
+    placeBuffer();
+    _isBuffAlloc = true;
+    _isShapeAlloc = isShapeAlloc;
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -211,7 +240,9 @@ NDArray::NDArray(const char order, const std::vector<Nd4jLong> &shape, const std
         throw std::invalid_argument("Rank of NDArray can't exceed 32");
 
     _workspace = workspace;
-    setShapeInfo(ShapeBuilders::createShapeInfo(dtype, order, shape, workspace));
+    bool isShapeAlloc;
+    setShapeInfo(constantOrNewShapeInfo(dtype, order, shape, workspace, isShapeAlloc));
+    _isShapeAlloc = isShapeAlloc;
 
     if (_length != data.size()) {
         nd4j_printf("NDArray constructor: data size [%i] doesn't match shape length [%i]\n", data.size(), _length);
@@ -219,8 +250,7 @@ NDArray::NDArray(const char order, const std::vector<Nd4jLong> &shape, const std
     }
 
     ALLOCATE(_buffer, workspace, _length * DataTypeUtils::sizeOf(dtype), int8_t);
-    
-    triggerAllocationFlag(true, true);
+    _isBuffAlloc = true;
 
     for(Nd4jLong i=0; i < _length; ++i) {
         BUILD_SINGLE_PARTIAL_SELECTOR(dtype, templatedDoubleAssign<, double>(_buffer, i, reinterpret_cast<const void *>(data.data()), i), LIBND4J_TYPES);
@@ -247,10 +277,12 @@ NDArray::NDArray(void* buffer, const char order, const std::vector<Nd4jLong> &sh
         throw std::invalid_argument("Rank of NDArray can't exceed 32");
 
     _workspace = workspace;
-    setShapeInfo(ShapeBuilders::createShapeInfo(dtype, order, shape, workspace));
+    bool isShapeAlloc;
+    setShapeInfo(constantOrNewShapeInfo(dtype, order, shape, workspace, isShapeAlloc));
 
     _buffer = reinterpret_cast<int8_t *>(buffer);    
-    triggerAllocationFlag(false, true);
+    _isBuffAlloc = false;
+    _isShapeAlloc = isShapeAlloc;
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -269,15 +301,19 @@ NDArray::NDArray(Nd4jLong* shapeInfo, const bool copyStrides, nd4j::memory::Work
             shape::updateStrides(_shapeInfo, shape::order(shapeInfo));                
     }
     else {
-        setShapeInfo(ShapeBuilders::copyShapeInfo(shapeInfo, copyStrides, workspace));        
-        _isShapeAlloc = true;
-        if(isShapeAlloc)
-            RELEASE(shapeInfo, workspace);        
+        Nd4jLong buffer[MAX_SHAPEINFOLENGTH];
+        memcpy(buffer, shapeInfo, shape::shapeInfoByteLength(shapeInfo));
+        if(!copyStrides)
+            shape::updateStrides(buffer, shape::order(shapeInfo));
+
+        auto constantShape = ConstantShapeHelper::getInstance()->intern(buffer);
+        setShapeInfo(constantShape != nullptr ? constantShape : ShapeBuilders::copyShapeInfo(buffer, true, workspace));
+        _isShapeAlloc = constantShape == nullptr;
     }    
     
     if (!isEmpty()) {        
         ALLOCATE(_buffer, workspace, _length * DataTypeUtils::sizeOfElement(_dataType), int8_t);
-        memset(_buffer, 0, _length * DataTypeUtils::sizeOfElement(_dataType));
+        placeBuffer();
         _isBuffAlloc = true;
     }    
 }
@@ -299,15 +335,20 @@ NDArray::NDArray(Nd4jLong* shapeInfo, const nd4j::DataType dtype, const bool cop
             shape::updateStrides(_shapeInfo, shape::order(shapeInfo));                
     }
     else {
-        setShapeInfo(ShapeBuilders::copyShapeInfoAndType(shapeInfo, dtype, copyStrides, workspace));        
-        _isShapeAlloc = true;
-        if(isShapeAlloc)
-            RELEASE(shapeInfo, workspace);        
+        Nd4jLong buffer[MAX_SHAPEINFOLENGTH];
+        memcpy(buffer, shapeInfo, shape::shapeInfoByteLength(shapeInfo));
+        if(!copyStrides)
+            shape::updateStrides(buffer, shape::order(shapeInfo));
+        ArrayOptions::setDataType(buffer, dtype);
+
+        auto constantShape = ConstantShapeHelper::getInstance()->intern(buffer);
+        setShapeInfo(constantShape != nullptr ? constantShape : ShapeBuilders::copyShapeInfo(buffer, true, workspace));
+        _isShapeAlloc = constantShape == nullptr;
     }      
 
     if(!isEmpty()) {
         ALLOCATE(_buffer, _workspace, _length * sizeOfT() , int8_t);    
-        memset(_buffer, 0, _length * DataTypeUtils::sizeOfElement(_dataType));
+        placeBuffer();
         _isBuffAlloc = true;
     }
 }
@@ -319,10 +360,12 @@ NDArray::NDArray(nd4j::DataType dtype, nd4j::memory::Workspace* workspace, const
     _workspace = workspace;
 
     if(isScalar) {
-        setShapeInfo(ShapeBuilders::createScalarShapeInfo(dtype, workspace));
+        auto shapeInfo = ConstantShapeHelper::getInstance()->scalarShapeInfo(dtype);
+        setShapeInfo(shapeInfo != nullptr ? shapeInfo : ShapeBuilders::createScalarShapeInfo(dtype, workspace));
         ALLOCATE(_buffer, workspace, DataTypeUtils::sizeOfElement(dtype), int8_t);
         memset(_buffer, 0, DataTypeUtils::sizeOfElement(dtype));    
-        triggerAllocationFlag(true, true);
+        _isBuffAlloc = true;
+        _isShapeAlloc = shapeInfo == nullptr;
     }
     else {
         setShapeInfo(ShapeBuilders::emptyShapeInfo(dtype, workspace));            
@@ -1048,8 +1091,15 @@ void NDArray::replacePointers(void *buffer, Nd4jLong *shapeInfo, const bool rele
                     BUILD_DOUBLE_SELECTOR(_dataType, other._dataType, templatedDoubleAssign, (_buffer, 0, other._buffer, 0), LIBND4J_TYPES, LIBND4J_TYPES);
                 }
                 else if (this->isEmpty() != other.isEmpty()) { // need assign non-empty scalar to empty
-                    if (other.isEmpty())
+                    if (other.isEmpty()) {
+                        // shape might be shared, so it's modified on private copy
+                        if (!_isShapeAlloc) {
+                            setShapeInfo(ShapeBuilders::copyShapeInfo(_shapeInfo, true, _workspace));
+                            _isShapeAlloc = true;
+                        }
+
                         ArrayOptions::setPropertyBit(this->_shapeInfo, ARRAY_EMPTY);
+                    }
                     else
                         *this = other;
                 }
@@ -1993,17 +2043,21 @@ void NDArray::applyPairwiseTransform(nd4j::pairwise::BoolOps op, const NDArray *
 
         auto tadPack = nd4j::ConstantTadHelper::getInstance()->tadForDimensions(_shapeInfo, copy);
 
-        Nd4jLong* shapeInfo;
-        if (_workspace == nullptr) {
-            shapeInfo = new Nd4jLong[shape::shapeInfoLength(tadPack.primaryShapeInfo())];
-        } else {
-            shapeInfo = reinterpret_cast<Nd4jLong *>(_workspace->allocateBytes(shape::shapeInfoByteLength(tadPack.primaryShapeInfo())));
+        // all TADs share the same shape, so it's interned instead of being copied for each view
+        auto shapeInfo = ConstantShapeHelper::getInstance()->intern(tadPack.primaryShapeInfo());
+        const bool isShapeAlloc = shapeInfo == nullptr;
+        if (isShapeAlloc) {
+            if (_workspace == nullptr) {
+                shapeInfo = new Nd4jLong[shape::shapeInfoLength(tadPack.primaryShapeInfo())];
+            } else {
+                shapeInfo = reinterpret_cast<Nd4jLong *>(_workspace->allocateBytes(shape::shapeInfoByteLength(tadPack.primaryShapeInfo())));
+            }
+            std::memcpy(shapeInfo, tadPack.primaryShapeInfo(), shape::shapeInfoByteLength(tadPack.primaryShapeInfo()));
         }
-        std::memcpy(shapeInfo, tadPack.primaryShapeInfo(), shape::shapeInfoByteLength(tadPack.primaryShapeInfo()));
 
         auto array = new NDArray(bufferWithOffset(tadPack.primaryOffsets()[index]), shapeInfo, _workspace);
         array->_isBuffAlloc = false;
-        array->_isShapeAlloc = true;
+        array->_isShapeAlloc = isShapeAlloc;
         array->_isView = true;
 
         return array;
@@ -2327,6 +2381,12 @@ template void NDArray::applyScalar(nd4j::scalar::Ops op, const bool scalar, NDAr
 //////////////////////////////////////////////////////////////////////////
     // calculate strides
     void NDArray::updateStrides(const char order) {
+        // shape might be shared, so it's modified on private copy
+        if (!_isShapeAlloc) {
+            setShapeInfo(ShapeBuilders::copyShapeInfo(_shapeInfo, true, _workspace));
+            _isShapeAlloc = true;
+        }
+
     	shape::updateStrides(_shapeInfo, order);
     }
 
@@ -3922,8 +3982,9 @@ template void NDArray::pIdx(const Nd4jLong* indices, const bool value);
     NDArray NDArray::operator()(const std::vector<Nd4jLong>& idx, const bool keepUnitiesInShape, const bool isStrided)  const {
 
         const int rank = rankOf();
-        Nd4jLong *newShape;
-        ALLOCATE(newShape, _workspace, shape::shapeInfoLength(rank), Nd4jLong);
+
+        // sub-array shape is evaluated on stack, and then interned
+        Nd4jLong newShape[MAX_SHAPEINFOLENGTH];
         memcpy(newShape, _shapeInfo, shape::shapeInfoByteLength(rank));
 
         auto shapeOf = shape::shapeOf(newShape);
@@ -3953,8 +4014,15 @@ template void NDArray::pIdx(const Nd4jLong* indices, const bool value);
         // check if there is possibility to set ews = 1
         shape::setEws(newShape, subArrLen);
 
+        auto subArrShape = ConstantShapeHelper::getInstance()->intern(newShape);
+        const bool isShapeAlloc = subArrShape == nullptr;
+        if (isShapeAlloc) {
+            ALLOCATE(subArrShape, _workspace, shape::shapeInfoLength(rank), Nd4jLong);
+            memcpy(subArrShape, newShape, shape::shapeInfoByteLength(rank));
+        }
+
         // create resulting sub-array
-        NDArray result(bufferWithOffset(offset), newShape, _workspace, false, true);
+        NDArray result(bufferWithOffset(offset), subArrShape, _workspace, false, isShapeAlloc);
 
         if(!keepUnitiesInShape) {
             const int coeff = isStrided ? 3 : 2;
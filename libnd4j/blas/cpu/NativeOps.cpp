@@ -71,6 +71,7 @@ bool experimentalSupport = false;
 #include <graph/ResultWrapper.h>
 #include <helpers/DebugHelper.h>
 #include <helpers/ConstantTadHelper.h>
+#include <graph/profiling/OpTraceCollector.h>
 
 using namespace nd4j;
 
@@ -1211,6 +1212,28 @@ void NativeOps::enableVerboseMode(bool reallyEnable) {
     nd4j::Environment::getInstance()->setVerbose(reallyEnable);
 }
 
+void NativeOps::enableOpTracing(bool reallyEnable) {
+    nd4j::Environment::getInstance()->setOpTracing(reallyEnable);
+}
+
+int NativeOps::exportOpTrace(const char *path) {
+    try {
+        nd4j::graph::OpTraceCollector::getInstance()->exportChromeTrace(path);
+        return ND4J_STATUS_OK;
+    } catch (std::exception &e) {
+        nd4j_printf("Trace export failed: %s\n", e.what());
+        return ND4J_STATUS_BAD_INPUT;
+    }
+}
+
+void NativeOps::printOpTrace() {
+    nd4j::graph::OpTraceCollector::getInstance()->printOut();
+}
+
+void NativeOps::resetOpTrace() {
+    nd4j::graph::OpTraceCollector::getInstance()->reset();
+}
+
 void NativeOps::setGridLimit(int gridSize) {
     // no-op
 }
@@ -1816,6 +1839,55 @@ void NativeOps::sortTad(Nd4jPointer *extraPointers,
     NativeOpExcutioner::execSort(hX, hXShapeInfo, dimension, dimensionLength, tadShapeInfo, tadOffsets, descending);
 }
 
+void NativeOps::sortByKey(Nd4jPointer *extraPointers,
+            void *hX, Nd4jLong *hXShapeInfo,
+            void *dX, Nd4jLong *dXShapeInfo,
+            void *hY, Nd4jLong *hYShapeInfo,
+            void *dY, Nd4jLong *dYShapeInfo,
+            bool descending) {
+    NativeOpExcutioner::execSortByKey(hX, hXShapeInfo, hY, hYShapeInfo, descending);
+}
+
+void NativeOps::sortByValue(Nd4jPointer *extraPointers,
+            void *hX, Nd4jLong *hXShapeInfo,
+            void *dX, Nd4jLong *dXShapeInfo,
+            void *hY, Nd4jLong *hYShapeInfo,
+            void *dY, Nd4jLong *dYShapeInfo,
+            bool descending) {
+    NativeOpExcutioner::execSortByValue(hX, hXShapeInfo, hY, hYShapeInfo, descending);
+}
+
+void NativeOps::sortTadByKey(Nd4jPointer *extraPointers,
+            void *hX, Nd4jLong *hXShapeInfo,
+            void *dX, Nd4jLong *dXShapeInfo,
+            void *hY, Nd4jLong *hYShapeInfo,
+            void *dY, Nd4jLong *dYShapeInfo,
+            int *dimension,
+            int dimensionLength,
+            bool descending) {
+    NativeOpExcutioner::execSortTadByKey(hX, hXShapeInfo, hY, hYShapeInfo, dimension, dimensionLength, descending);
+}
+
+void NativeOps::sortTadByValue(Nd4jPointer *extraPointers,
+            void *hX, Nd4jLong *hXShapeInfo,
+            void *dX, Nd4jLong *dXShapeInfo,
+            void *hY, Nd4jLong *hYShapeInfo,
+            void *dY, Nd4jLong *dYShapeInfo,
+            int *dimension,
+            int dimensionLength,
+            bool descending) {
+    NativeOpExcutioner::execSortTadByValue(hX, hXShapeInfo, hY, hYShapeInfo, dimension, dimensionLength, descending);
+}
+
+void NativeOps::argSort(Nd4jPointer *extraPointers,
+            void *hX, Nd4jLong *hXShapeInfo,
+            void *dX, Nd4jLong *dXShapeInfo,
+            void *hZ, Nd4jLong *hZShapeInfo,
+            void *dZ, Nd4jLong *dZShapeInfo,
+            bool descending) {
+    NativeOpExcutioner::execArgSort(hX, hXShapeInfo, hZ, hZShapeInfo, descending);
+}
+
 void NativeOps::sortCooIndices(Nd4jPointer *extraPointers,
         Nd4jLong *indices,
         void *values,
@@ -2558,6 +2630,18 @@ void NativeOps::inspectArray(Nd4jPointer *extraPointers, Nd4jPointer buffer, Nd4
     nd4j::DebugHelper::retrieveDebugStatistics(p, &array);
 }
 
+Nd4jLong NativeOps::getTadCacheHits() {
+    return nd4j::ConstantTadHelper::getInstance()->cacheHits();
+}
+
+Nd4jLong NativeOps::getTadCacheMisses() {
+    return nd4j::ConstantTadHelper::getInstance()->cacheMisses();
+}
+
+Nd4jLong NativeOps::getTadCacheSize() {
+    return nd4j::ConstantTadHelper::getInstance()->cacheSize();
+}
+
 void NativeOps::tryPointer(Nd4jPointer extra, Nd4jPointer p, int len) {
     auto buf = reinterpret_cast<int8_t*>(p);
     int cnt = 0;
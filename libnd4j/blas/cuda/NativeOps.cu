@@ -68,6 +68,8 @@
 #include <Context.h>
 #include <ops/specials_cuda.h>
 #include <helpers/DebugHelper.h>
+#include <graph/profiling/OpTraceCollector.h>
+#include <helpers/ConstantTadHelper.h>
 
 #include <graph/exceptions/datatype_exception.h>
 
@@ -1671,6 +1673,28 @@ void NativeOps::enableVerboseMode(bool reallyEnable) {
 	nd4j::Environment::getInstance()->setVerbose(reallyEnable);
 }
 
+void NativeOps::enableOpTracing(bool reallyEnable) {
+	nd4j::Environment::getInstance()->setOpTracing(reallyEnable);
+}
+
+int NativeOps::exportOpTrace(const char *path) {
+	try {
+		nd4j::graph::OpTraceCollector::getInstance()->exportChromeTrace(path);
+		return ND4J_STATUS_OK;
+	} catch (std::exception &e) {
+		nd4j_printf("Trace export failed: %s\n", e.what());
+		return ND4J_STATUS_BAD_INPUT;
+	}
+}
+
+void NativeOps::printOpTrace() {
+	nd4j::graph::OpTraceCollector::getInstance()->printOut();
+}
+
+void NativeOps::resetOpTrace() {
+	nd4j::graph::OpTraceCollector::getInstance()->reset();
+}
+
 int NativeOps::getDeviceMajor(int device) {
 	return deviceProperties[device].major;
 }
@@ -2947,6 +2971,26 @@ void NativeOps::sortTad(Nd4jPointer *extraPointers,
     nd4j::DebugHelper::checkErrorCode(stream, "sortTadFloat(...) failed");
 }
 
+void NativeOps::sortByKey(Nd4jPointer *extraPointers, void *x, Nd4jLong *xShapeInfo, void *dX, Nd4jLong *dXShapeInfo, void *y, Nd4jLong *yShapeInfo, void *dY, Nd4jLong *dYShapeInfo, bool descending) {
+	throw std::runtime_error("sortByKey:: Not implemented yet");
+}
+
+void NativeOps::sortByValue(Nd4jPointer *extraPointers, void *x, Nd4jLong *xShapeInfo, void *dX, Nd4jLong *dXShapeInfo, void *y, Nd4jLong *yShapeInfo, void *dY, Nd4jLong *dYShapeInfo, bool descending) {
+	throw std::runtime_error("sortByValue:: Not implemented yet");
+}
+
+void NativeOps::sortTadByKey(Nd4jPointer *extraPointers, void *x, Nd4jLong *xShapeInfo, void *dX, Nd4jLong *dXShapeInfo, void *y, Nd4jLong *yShapeInfo, void *dY, Nd4jLong *dYShapeInfo, int *dimension, int dimensionLength, bool descending) {
+	throw std::runtime_error("sortTadByKey:: Not implemented yet");
+}
+
+void NativeOps::sortTadByValue(Nd4jPointer *extraPointers, void *x, Nd4jLong *xShapeInfo, void *dX, Nd4jLong *dXShapeInfo, void *y, Nd4jLong *yShapeInfo, void *dY, Nd4jLong *dYShapeInfo, int *dimension, int dimensionLength, bool descending) {
+	throw std::runtime_error("sortTadByValue:: Not implemented yet");
+}
+
+void NativeOps::argSort(Nd4jPointer *extraPointers, void *x, Nd4jLong *xShapeInfo, void *dX, Nd4jLong *dXShapeInfo, void *z, Nd4jLong *zShapeInfo, void *dZ, Nd4jLong *dZShapeInfo, bool descending) {
+	throw std::runtime_error("argSort:: Not implemented yet");
+}
+
 void NativeOps::sortCooIndices(Nd4jPointer *extraPointers, Nd4jLong *indices, void *values, Nd4jLong length, int rank) {
 	throw std::runtime_error("sortCooIndices:: Not implemented yet");
 }
@@ -3681,6 +3725,18 @@ void NativeOps::inspectArray(Nd4jPointer *extraPointers, Nd4jPointer buffer, Nd4
     nd4j::DebugHelper::retrieveDebugStatistics(p, &array);
 }
 
+Nd4jLong NativeOps::getTadCacheHits() {
+    return nd4j::ConstantTadHelper::getInstance()->cacheHits();
+}
+
+Nd4jLong NativeOps::getTadCacheMisses() {
+    return nd4j::ConstantTadHelper::getInstance()->cacheMisses();
+}
+
+Nd4jLong NativeOps::getTadCacheSize() {
+    return nd4j::ConstantTadHelper::getInstance()->cacheSize();
+}
+
 void __global__ tryPointerKernel(void* p, int len) {
     auto buf = reinterpret_cast<int8_t*>(p);
     auto tid = threadIdx.x + blockIdx.x * blockDim.x;
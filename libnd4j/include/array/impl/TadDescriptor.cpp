@@ -21,12 +21,14 @@
 
 #include <algorithm>
 #include "../TadDescriptor.h"
+#include <op_boilerplate.h>
 
 namespace nd4j {
     TadDescriptor::TadDescriptor(const TadDescriptor &other) {
         _originalShape = other._originalShape;
         _axis = other._axis;
         _unitiesInShape = other._unitiesInShape;
+        _hash = other._hash;
     }
 
     TadDescriptor::TadDescriptor(const Nd4jLong *originalShape, const int *dimensions, const int length, const bool keepUnitiesInShape) {
@@ -41,6 +43,8 @@ namespace nd4j {
 
         _originalShape = descriptor;
         _unitiesInShape = keepUnitiesInShape;
+
+        updateHash();
     }
 
     TadDescriptor::TadDescriptor(const ShapeDescriptor &descriptor, const std::vector<int> &dimensions, const bool keepUnitiesInShape) {
@@ -50,6 +54,36 @@ namespace nd4j {
 
         if (_axis.size() > 1)
             std::sort(_axis.begin(), _axis.end());
+
+        updateHash();
+    }
+
+    static FORCEINLINE uint64_t mixHash(uint64_t hash, uint64_t value) {
+        hash ^= value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+        return hash;
+    }
+
+    void TadDescriptor::updateHash() {
+        uint64_t hash = 14695981039346656037ULL;
+
+        hash = mixHash(hash, (uint64_t) _originalShape.rank());
+        hash = mixHash(hash, (uint64_t) _originalShape.dataType());
+        hash = mixHash(hash, (uint64_t) _originalShape.order());
+        hash = mixHash(hash, (uint64_t) _originalShape.ews());
+        hash = mixHash(hash, (uint64_t) _originalShape.isEmpty());
+
+        for (auto v: _originalShape.shape())
+            hash = mixHash(hash, (uint64_t) v);
+
+        for (auto v: _originalShape.strides())
+            hash = mixHash(hash, (uint64_t) v);
+
+        for (auto v: _axis)
+            hash = mixHash(hash, (uint64_t) v);
+
+        hash = mixHash(hash, (uint64_t) _unitiesInShape);
+
+        _hash = (Nd4jLong) hash;
     }
 
     bool TadDescriptor::operator==(const TadDescriptor &other) const {
@@ -72,4 +106,8 @@ namespace nd4j {
     bool TadDescriptor::areUnitiesinShape() const {
         return _unitiesInShape;   
     }
+
+    Nd4jLong TadDescriptor::hash() const {
+        return _hash;
+    }
 }
\ No newline at end of file
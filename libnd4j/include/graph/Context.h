@@ -125,6 +125,7 @@ namespace nd4j {
 #ifdef HAVE_MKLDNN
             std::vector<nd4j::MKLDNNStream>& getMKLDNNStreams() { return _mkldnnStreams; }
 #endif
+
             /**
              *
              * @return
@@ -22,11 +22,13 @@
 #define ND4J_CONTEXT_PROTOTYPE_H
 
 #include <vector>
+#include <memory>
 #include <Environment.h>
 #include <array/DataType.h>
 #include <dll.h>
 #include <RandomGenerator.h>
 #include <ops/declarable/OpDescriptor.h>
+#include <helpers/WinogradFilter.h>
 
 namespace nd4j {
     namespace graph {
@@ -53,6 +55,9 @@ namespace nd4j {
             nd4j::ops::OpDescriptor* _opDescriptor;
             bool _useMKLDNN = nd4j::Environment::getInstance()->isUseMKLDNN();
 
+            // Winograd-transformed conv2d weights, shared with every Context built from this prototype
+            std::shared_ptr<nd4j::WinogradFilter> _winogradFilter;
+
         public:
             explicit ContextPrototype(nd4j::ops::OpDescriptor* opDescriptor = nullptr, int nodeId = 1, bool inPlace = false);
             ~ContextPrototype() = default;
@@ -96,6 +101,14 @@ namespace nd4j {
             bool isUseMKLDNN() { return _useMKLDNN; }
             void setUseMKLDNN(bool useMKLDNN) { _useMKLDNN = useMKLDNN; }
 
+            /**
+             * This method returns Winograd filter cache of this block. Graph nodes build new Context for every execution,
+             * so Context created from prototype shares cache of the prototype, and transformed weights survive between runs.
+             * Clones get their own empty cache
+             */
+            std::shared_ptr<nd4j::WinogradFilter> winogradFilter();
+            nd4j::WinogradFilter& getWinogradFilter() { return *winogradFilter(); }
+
             /**
              * This method returns number of inputs available in this block
              * @return
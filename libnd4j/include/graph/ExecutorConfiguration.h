@@ -37,6 +37,10 @@ namespace nd4j {
             Nd4jLong _footprintBackward = 0L;
             Direction _direction = Direction_FORWARD_ONLY;
 
+            // number of concurrent workers and OpenMP threads per op for ExecutionMode_AUTO. 0 means "pick automatically"
+            int _interOpThreads = 0;
+            int _intraOpThreads = 0;
+
             explicit ExecutorConfiguration(const nd4j::graph::FlatConfiguration *conf = nullptr);
             ~ExecutorConfiguration() = default;
             
@@ -35,7 +35,24 @@ namespace nd4j {
 
             static std::pair<Nd4jLong, Nd4jLong> fromLongPair(LongPair* pair);
 
+            // alignment of array buffers written by toFlatArray, in bytes
+            static const int BUFFER_ALIGNMENT = 64;
+
             static NDArray* fromFlatArray(const nd4j::graph::FlatArray* flatArray);
+
+            /**
+             * This method returns NDArray that uses FlatArray buffer in place, without copying it.
+             * Returned array doesn't own its buffer, so FlatBuffer must outlive it.
+             *
+             * @return nullptr if buffer can't be used as is (i.e. byte order differs or buffer isn't aligned)
+             */
+            static NDArray* viewFlatArray(const nd4j::graph::FlatArray* flatArray);
+
+            /**
+             * This method serializes given array as FlatArray. Buffer is written in native byte order,
+             * and aligned to BUFFER_ALIGNMENT bytes, so it can be used in place via viewFlatArray
+             */
+            static flatbuffers::Offset<FlatArray> toFlatArray(flatbuffers::FlatBufferBuilder &builder, NDArray &array);
         };
     }
 }
@@ -35,9 +35,11 @@
 #include <graph/generated/config_generated.h>
 #include <graph/ExecutorConfiguration.h>
 #include <ops/declarable/OpDescriptor.h>
+#include <helpers/MappedFile.h>
 
 namespace nd4j {
     namespace graph {
+        class MemoryPlan;
 
         class ND4J_EXPORT Graph {
         protected:
@@ -66,6 +68,15 @@ namespace nd4j {
             std::map<int, Scope*> _mappedScopes;
             std::vector<Scope*> _scopes;
 
+            // optional static memory plan, built on demand
+            MemoryPlan* _memoryPlan = nullptr;
+
+            // memory-mapped file this graph was imported from, arrays in VariableSpace might point into it
+            MappedFile* _mappedFile = nullptr;
+
+            // number of nodes removed by fusion on import
+            int _fusedNodes = 0;
+
 ////////////////////////////////////////
             Nd4jStatus validateNode(nd4j::graph::Node *node);
 
@@ -79,8 +90,15 @@ namespace nd4j {
 
             void prepareOutputs();
 
+            void fuseNodes();
+
         public:
-            Graph(const FlatGraph *flatGraph = nullptr, VariableSpace *variableSpace = nullptr);
+            /**
+             * @param flatGraph
+             * @param variableSpace
+             * @param mappedFile - memory-mapped file holding flatGraph. If set, Graph takes ownership of it, and arrays are restored without copying where possible
+             */
+            Graph(const FlatGraph *flatGraph = nullptr, VariableSpace *variableSpace = nullptr, MappedFile *mappedFile = nullptr);
 
             ~Graph();
 
@@ -96,6 +114,39 @@ namespace nd4j {
             // this method will return estimated memory size (in bytes) required for 1 full graph execution round
             Nd4jLong estimateRequiredMemory();
 
+            /**
+             * This method builds static memory plan for this graph: all intermediate arrays are placed into single arena,
+             * reusing memory of arrays that aren't alive anymore. Graph must be executed at least once before this call,
+             * since plan is built out of array shapes observed during execution.
+             *
+             * Once plan is built, GraphExecutioner binds arena-backed arrays before each execution, so ops don't allocate outputs.
+             * Plan is dropped automatically if shapes of external inputs change, or graph gets modified.
+             *
+             * @return
+             */
+            Nd4jStatus planMemory();
+
+            /**
+             * This method returns memory plan of this graph, or nullptr if there's no plan
+             */
+            MemoryPlan* memoryPlan();
+
+            /**
+             * This method returns memory-mapped file this graph was imported from, or nullptr
+             */
+            MappedFile* mappedFile();
+
+            /**
+             * This method drops memory plan, if any
+             */
+            void forgetMemoryPlan();
+
+            /**
+             * This method returns number of nodes removed by fusion of elementwise chains on import.
+             * Fusion is applied only if enabled via Environment::setGraphFusion()
+             */
+            int fusedNodes();
+
             // this method returns number of root nodes in this graph
             int rootNodes();
 
@@ -0,0 +1,49 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_GRAPHFUSION_H
+#define LIBND4J_GRAPHFUSION_H
+
+#include <dll.h>
+#include <map>
+#include <vector>
+#include <graph/Node.h>
+
+namespace nd4j {
+    namespace graph {
+        /**
+         * This class implements graph rewrite which fuses chains of elementwise ops into single ops:
+         * - chains of transforms, scalar ops, activations and pairwise ops with external operands (i.e. bias) become fused_elementwise
+         * - matmul followed by such chain (i.e. bias + activation) becomes fused_matmul
+         *
+         * Op can be fused into the next one only if its output is consumed by that op alone, and isn't requested as graph output.
+         * Fused node takes id and name of the last node in chain, so its consumers are left intact.
+         */
+        class ND4J_EXPORT GraphFusion {
+        public:
+            /**
+             * This method fuses nodes in place
+             *
+             * @param nodes - map of not yet toposorted nodes. Fused nodes are removed from map and deleted
+             * @param outputs - ids of nodes requested as graph outputs
+             * @return number of nodes removed from graph
+             */
+            static int fuse(std::map<int, Node*> &nodes, const std::vector<int> &outputs);
+        };
+    }
+}
+
+#endif //LIBND4J_GRAPHFUSION_H
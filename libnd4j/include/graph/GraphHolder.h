@@ -21,7 +21,10 @@
 #include <helpers/logger.h>
 #include <pointercast.h>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <graph/Graph.h>
+#include <graph/GraphSessionPool.h>
 #include <helpers/SimpleReadWriteLock.h>
 #include <graph/exceptions/unknown_graph_exception.h>
 
@@ -34,8 +37,17 @@ namespace nd4j {
 
             std::map<Nd4jLong, SimpleReadWriteLock> _locks;
 
+            // pooled inference sessions, one pool per registered graph. checked out sessions keep their pool alive,
+            // so graph can be replaced or forgotten while requests are still running
+            std::map<Nd4jLong, std::shared_ptr<GraphSessionPool>> _pools;
+            std::map<Graph *, std::shared_ptr<GraphSessionPool>> _sessions;
+            std::mutex _poolsLock;
+
             GraphHolder() = default;
             ~GraphHolder() = default;
+
+            void attachPool(Nd4jLong graphId, Graph *graph);
+            void detachPool(Nd4jLong graphId, Graph *graphToDelete);
         public:
             static GraphHolder* getInstance();
 
@@ -59,6 +71,19 @@ namespace nd4j {
 
             void replaceGraph(Nd4jLong graphId, Graph *graph);
 
+            /**
+             * This method returns session of given graph for exclusive use. Sessions share variables of registered graph,
+             * so they're cheap, and multiple sessions can be executed concurrently.
+             *
+             * Session must be returned via releaseSession()
+             */
+            Graph* acquireSession(Nd4jLong graphId);
+
+            /**
+             * This method returns session to the pool it was acquired from, even if graph was replaced or forgotten since then
+             */
+            void releaseSession(Nd4jLong graphId, Graph *session);
+
             /////////////////////////////
 
             FORCEINLINE void lockWrite(Nd4jLong graphId) {
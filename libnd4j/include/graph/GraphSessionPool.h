@@ -0,0 +1,95 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_GRAPHSESSIONPOOL_H
+#define LIBND4J_GRAPHSESSIONPOOL_H
+
+#include <dll.h>
+#include <atomic>
+#include <graph/Graph.h>
+
+namespace nd4j {
+    namespace graph {
+        /**
+         * This class holds pool of inference sessions for single Graph.
+         *
+         * Each session is a Graph clone backed by VariableProxy: variables of original Graph (i.e. weights) are shared,
+         * and everything produced during execution goes to session's own overlay. Overlay is dropped when session is released,
+         * and session is reused by next request, so N concurrent executions cost N sets of activations, not N copies of model.
+         *
+         * Sessions are acquired and released without locks. If all pooled sessions are busy, temporary session is created,
+         * and it's destroyed upon release.
+         */
+        class ND4J_EXPORT GraphSessionPool {
+        protected:
+            Graph* _origin;
+            int _capacity;
+
+            std::atomic<Graph*>* _sessions;
+            std::atomic<bool>* _busy;
+
+            std::atomic<int> _created;
+            std::atomic<int> _temporary;
+
+            bool _ownsOrigin = false;
+        public:
+            static const int DEFAULT_CAPACITY = 32;
+
+            /**
+             * @param origin - graph sessions are created for. It must not be modified or deleted while pool exists
+             * @param capacity - maximal number of pooled sessions
+             */
+            explicit GraphSessionPool(Graph* origin, int capacity = DEFAULT_CAPACITY);
+
+            /**
+             * All sessions must be released before pool is destroyed. Sessions still in use are leaked rather than deleted
+             */
+            ~GraphSessionPool();
+
+            /**
+             * After this call origin Graph is deleted together with the pool
+             */
+            void adoptOrigin();
+
+            GraphSessionPool(const GraphSessionPool& other) = delete;
+            GraphSessionPool& operator=(const GraphSessionPool& other) = delete;
+
+            /**
+             * This method returns session for exclusive use by caller, until it's released
+             */
+            Graph* acquire();
+
+            /**
+             * This method returns session back to the pool, dropping all variables produced with it
+             */
+            void release(Graph* session);
+
+            /**
+             * This method returns number of sessions created for the pool so far
+             */
+            int pooledSessions();
+
+            /**
+             * This method returns number of temporary sessions created because pool was exhausted
+             */
+            int temporarySessions();
+
+            int capacity();
+        };
+    }
+}
+
+#endif //LIBND4J_GRAPHSESSIONPOOL_H
@@ -0,0 +1,144 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_MEMORYPLAN_H
+#define LIBND4J_MEMORYPLAN_H
+
+#include <pointercast.h>
+#include <dll.h>
+#include <vector>
+#include <map>
+#include <NDArray.h>
+#include <graph/VariableSpace.h>
+#include <graph/Node.h>
+
+namespace nd4j {
+    namespace graph {
+        class Graph;
+
+        /**
+         * This class holds static memory plan for Graph: every intermediate array gets fixed offset within single arena,
+         * and arrays with non-overlapping lifetimes share the same memory.
+         *
+         * Plan is built from shapes observed during completed Graph execution. Plan stays valid as long as shapes of external inputs are the same,
+         * so outputs of ops with data-dependent output shapes (i.e. unique, where, non_max_suppression) aren't planned: these ops allocate outputs on every run.
+         * Other custom ops may depend on input values too (i.e. reshape or tile with shape given as array), so their output shapes are checked
+         * against the plan before they run. On mismatch the rest of the run goes without plan, and plan is dropped on next execution.
+         *
+         * Arena memory is shared, so planned arrays are zeroed right before their producer runs (see prepare()): ops writing only part
+         * of their output rely on that, just like they rely on zero-initialized NDArrays.
+         */
+        class ND4J_EXPORT MemoryPlan {
+        protected:
+            Graph* _graph;
+
+            // planned arrays
+            std::vector<std::pair<int, int>> _tensors;
+            std::vector<Nd4jLong*> _shapes;
+            std::vector<Nd4jLong> _sizes;
+            std::vector<int> _first;
+            std::vector<int> _last;
+            std::vector<Nd4jLong> _offsets;
+
+            // index of array this one is aliased to (in-place ops), -1 otherwise
+            std::vector<int> _aliases;
+
+            std::map<std::pair<int, int>, int> _positions;
+
+            // arrays produced by each node, aliases excluded
+            std::map<int, std::vector<int>> _producers;
+
+            // shapes of external inputs this plan was built for
+            std::map<std::pair<int, int>, Nd4jLong*> _inputShapes;
+
+            // execution step of each node
+            std::map<int, int> _steps;
+
+            // set once some op produced output of shape other than planned
+            bool _stale = false;
+
+            int8_t* _arena = nullptr;
+            int8_t* _base = nullptr;
+            Nd4jLong _arenaSize = 0L;
+            Nd4jLong _naiveSize = 0L;
+
+            std::vector<NDArray*> _views;
+
+            void release();
+
+            bool hasPlannedShapes(Node* node, VariableSpace* variableSpace);
+            void unbindFrom(int step, VariableSpace* variableSpace);
+        public:
+            // alignment for every array within arena, in bytes
+            static const Nd4jLong ALIGNMENT = 64;
+
+            explicit MemoryPlan(Graph* graph);
+            ~MemoryPlan();
+
+            /**
+             * This method builds plan for arrays currently stored in given VariableSpace
+             *
+             * @param variableSpace - VariableSpace after at least one Graph execution
+             * @return
+             */
+            Nd4jStatus build(VariableSpace* variableSpace);
+
+            /**
+             * This method returns TRUE if external inputs in given VariableSpace have the same shapes as during planning,
+             * and no op produced output of unexpected shape since plan was built
+             */
+            bool isValid(VariableSpace* variableSpace);
+
+            /**
+             * This method binds arena-backed arrays to variables of given VariableSpace. Arena is allocated once, on first call
+             */
+            void attach(VariableSpace* variableSpace);
+
+            /**
+             * This method zeroes arena-backed outputs of given node. Must be called right before node is executed.
+             * If output shapes of the node differ from planned ones, arrays of this and all following nodes are unbound, so ops allocate them
+             */
+            void prepare(Node* node, VariableSpace* variableSpace);
+
+            /**
+             * This method unbinds arena-backed arrays from variables of given VariableSpace
+             */
+            void detach(VariableSpace* variableSpace);
+
+            /**
+             * This method returns size of arena in bytes
+             */
+            Nd4jLong arenaSize();
+
+            /**
+             * This method returns number of bytes planned arrays would take without memory reuse
+             */
+            Nd4jLong naiveSize();
+
+            /**
+             * This method returns number of planned arrays
+             */
+            int numberOfTensors();
+
+            /**
+             * This method returns offset of given array within arena, or -1 if array isn't planned
+             */
+            Nd4jLong offset(int nodeId, int index = 0);
+        };
+    }
+}
+
+#endif //LIBND4J_MEMORYPLAN_H
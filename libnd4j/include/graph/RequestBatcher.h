@@ -0,0 +1,126 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_REQUESTBATCHER_H
+#define LIBND4J_REQUESTBATCHER_H
+
+#include <dll.h>
+#include <pointercast.h>
+#include <graph/Variable.h>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <vector>
+#include <exception>
+#include <condition_variable>
+
+namespace nd4j {
+    namespace graph {
+        /**
+         * This class coalesces concurrent inference requests for the same graph registered in GraphHolder.
+         *
+         * Requests are queued, and one of waiting callers executes up to maxBatchSize of them at once:
+         * inputs are concatenated along dimension 0, graph is executed once, and outputs are split back along dimension 0.
+         * Idle batcher executes queued requests right away. While previous batch is being executed, requests pile up
+         * until queue is full, previous batch is done, or maxDelay microseconds passed.
+         *
+         * First merged execution is verified: its part for the first request must match separate execution of that request,
+         * both in shapes and values. Graphs that fail this check (i.e. outputs not following batch dimension, or mixing
+         * rows of different requests), and requests that can't be merged (different input ids, dtypes or shapes beyond
+         * dimension 0) are executed one by one.
+         */
+        class ND4J_EXPORT RequestBatcher {
+        protected:
+            struct Ticket {
+                const std::vector<Variable*>* inputs = nullptr;
+                std::vector<Variable*>* outputs = nullptr;
+                std::exception_ptr error;
+                bool done = false;
+            };
+
+            Nd4jLong _graphId;
+            int _maxBatchSize;
+            Nd4jLong _maxDelay;
+
+            std::mutex _mutex;
+            std::condition_variable _condition;
+            std::deque<Ticket*> _queue;
+            bool _leader = false;
+            int _running = 0;
+
+            // outcome of merged execution check: graph outputs are proven batch-major, or proven not to be
+            std::atomic<bool> _verified{false};
+            std::atomic<bool> _unbatchable{false};
+
+            std::atomic<Nd4jLong> _executions;
+            std::atomic<Nd4jLong> _requests;
+
+            void executeBatch(std::vector<Ticket*>& batch);
+
+            /**
+             * This method executes graph with given inputs, and splits outputs into batchSizes.size() parts along dimension 0.
+             * Empty batchSizes means no split. Returns false if outputs can't be split.
+             */
+            bool executeSession(const std::vector<Variable*>& inputs, const std::vector<Nd4jLong>& batchSizes, std::vector<std::vector<Variable*>*>& results);
+
+            static bool isMergeable(std::vector<Ticket*>& batch);
+
+            static bool isSameResult(std::vector<Variable*>& a, std::vector<Variable*>& b);
+
+            static void release(std::vector<std::vector<Variable*>*>& results);
+        public:
+            /**
+             * @param graphId - id of the graph in GraphHolder
+             * @param maxBatchSize - maximal number of requests executed at once
+             * @param maxDelay - maximal time, in microseconds, request might wait for other requests to join
+             */
+            explicit RequestBatcher(Nd4jLong graphId, int maxBatchSize = 8, Nd4jLong maxDelay = 1000);
+            virtual ~RequestBatcher() = default;
+
+            RequestBatcher(const RequestBatcher& other) = delete;
+            RequestBatcher& operator=(const RequestBatcher& other) = delete;
+
+            /**
+             * This method executes graph for given inputs, possibly together with concurrent requests.
+             * Blocks until results are available.
+             *
+             * Inputs stay owned by caller. Returned Variables (and vector itself) are owned by caller.
+             */
+            std::vector<Variable*>* execute(const std::vector<Variable*>& inputs);
+
+            /**
+             * This method returns number of graph executions performed so far
+             */
+            Nd4jLong executions();
+
+            /**
+             * This method returns number of requests served so far
+             */
+            Nd4jLong requests();
+
+            int maxBatchSize();
+
+            Nd4jLong maxDelay();
+
+            /**
+             * This method returns true if merged execution was checked and graph turned out to be unsuitable for batching
+             */
+            bool isUnbatchable();
+        };
+    }
+}
+
+#endif //LIBND4J_REQUESTBATCHER_H
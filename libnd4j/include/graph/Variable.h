@@ -45,6 +45,9 @@ namespace nd4j {
             bool _placeholder = false;
             bool _removable = true;
 
+            // array is a view of FlatBuffer memory: it can't be written to, but wrapper itself is still ours
+            bool _flatView = false;
+
             // for now we're setting default to numeric
             // in future we'll be fetching it right from the array, 
             //InputType _variableType = InputType_UNDEFINED;
@@ -58,7 +61,11 @@ namespace nd4j {
             Variable(bool placeHolder);
             Variable(nd4j::NDArray *arrayw, const char *name, int id, int idx = 0);
             Variable(nd4j::NDArray *array = nullptr, const char *name = nullptr);
-            Variable(const nd4j::graph::FlatVariable *flatVariable);
+            /**
+             * @param flatVariable
+             * @param zeroCopy - if TRUE, array will use FlatBuffer memory in place where possible, so FlatBuffer must outlive this Variable
+             */
+            Variable(const nd4j::graph::FlatVariable *flatVariable, bool zeroCopy = false);
             ~Variable();
 
             Variable* clone();
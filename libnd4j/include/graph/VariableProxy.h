@@ -30,6 +30,11 @@ namespace nd4j {
             explicit VariableProxy(VariableSpace* reference);
             ~VariableProxy();
 
+            /**
+             * This method drops all variables stored in this proxy, so only variables of backing VariableSpace remain visible
+             */
+            void reset();
+
             virtual VariableSpace& operator=(const VariableSpace& other);
 
             virtual int numberOfPlaceholders();
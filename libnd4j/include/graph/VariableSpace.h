@@ -69,6 +69,9 @@ namespace nd4j {
 
             FlowPath* _flow = nullptr;
 
+            // workspaces of dataflow workers, see workerWorkspace()
+            std::vector<nd4j::memory::Workspace*> _workerWorkspaces;
+
         public:
             VariableSpace();
             virtual ~VariableSpace();
@@ -83,6 +86,12 @@ namespace nd4j {
             
             virtual nd4j::memory::Workspace *workspace();
 
+            /**
+             * This method returns workspace dedicated to given dataflow worker, so concurrent ops don't allocate from the same workspace.
+             * Worker 0 gets workspace(). Workspaces are created on first use and live as long as this VariableSpace, since arrays allocated there end up in variables
+             */
+            nd4j::memory::Workspace *workerWorkspace(int worker);
+
             virtual bool hasExternalVariable(int it);
             virtual bool hasExternalVariable(std::pair<int,int>& pair);
             virtual bool hasExternalVariable(std::string *symbol);
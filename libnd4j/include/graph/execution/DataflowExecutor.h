@@ -0,0 +1,66 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_DATAFLOWEXECUTOR_H
+#define LIBND4J_DATAFLOWEXECUTOR_H
+
+#include <pointercast.h>
+#include <dll.h>
+#include <graph/Node.h>
+#include <graph/Graph.h>
+#include <graph/VariableSpace.h>
+
+namespace nd4j {
+    namespace graph {
+        /**
+         * This class executes Graph as dataflow: every node is dispatched as soon as all nodes it depends on are finished,
+         * so independent branches of the graph are executed concurrently by a pool of work-stealing workers.
+         *
+         * Each worker gets its own OpenMP thread budget, so inter-op and intra-op parallelism don't oversubscribe cores, and its own workspace.
+         *
+         * PLEASE NOTE: graphs with control flow (LOGIC ops, divergent ops, scopes) or embedded graphs aren't handled here,
+         * GraphExecutioner falls back to sequential execution for them
+         */
+        class ND4J_EXPORT DataflowExecutor {
+        public:
+            /**
+             * This method returns TRUE if given Graph can be executed in dataflow mode
+             */
+            static bool isApplicable(Graph *graph);
+
+            /**
+             * This method returns number of concurrent workers that'll be used for given Graph
+             */
+            static int interOpThreads(Graph *graph);
+
+            /**
+             * This method returns number of OpenMP threads available to each op when given number of workers is used
+             */
+            static int intraOpThreads(Graph *graph, int interOpThreads);
+
+            /**
+             * This method executes given Graph. Graph must be built already.
+             *
+             * @param graph
+             * @param variableSpace - VariableSpace instance to be used for execution
+             * @return
+             */
+            static Nd4jStatus execute(Graph *graph, VariableSpace *variableSpace);
+        };
+    }
+}
+
+#endif //LIBND4J_DATAFLOWEXECUTOR_H
@@ -0,0 +1,423 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <graph/execution/DataflowExecutor.h>
+#include <GraphExecutioner.h>
+#include <graph/profiling/GraphProfile.h>
+#include <templatemath.h>
+#include <Status.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace nd4j {
+    namespace graph {
+
+        /**
+         * Reader/writer gate: regular nodes share it, while nodes that can't be executed concurrently
+         * (i.e. ops with unknown number of outputs or in-place ops) take it exclusively
+         */
+        class ExecutionGate {
+        private:
+            std::mutex _lock;
+            std::condition_variable _cv;
+            int _shared = 0;
+            bool _exclusive = false;
+
+        public:
+            void enter(bool exclusive) {
+                std::unique_lock<std::mutex> lock(_lock);
+                if (exclusive) {
+                    _cv.wait(lock, [&] { return !_exclusive && _shared == 0; });
+                    _exclusive = true;
+                } else {
+                    _cv.wait(lock, [&] { return !_exclusive; });
+                    _shared++;
+                }
+            }
+
+            void leave(bool exclusive) {
+                {
+                    std::lock_guard<std::mutex> lock(_lock);
+                    if (exclusive)
+                        _exclusive = false;
+                    else
+                        _shared--;
+                }
+                _cv.notify_all();
+            }
+        };
+
+        /**
+         * Shared state of one dataflow execution round
+         */
+        class DataflowState {
+        public:
+            Graph *graph;
+            VariableSpace *variableSpace;
+            FlowPath *flowPath;
+
+            std::vector<Node*> nodes;
+            std::vector<bool> exclusive;
+            std::vector<std::vector<int>> consumers;
+            std::vector<std::atomic<int>> pending;
+
+            // per-worker queues. owner pops from the back, thieves steal from the front
+            std::vector<std::deque<int>> queues;
+            std::vector<std::unique_ptr<std::mutex>> queueLocks;
+
+            std::atomic<int> queued;
+            std::atomic<int> inflight;
+            std::atomic<int> remaining;
+            std::atomic<bool> failed;
+            std::atomic<Nd4jStatus> status;
+
+            std::mutex parkLock;
+            std::condition_variable parkCv;
+
+            std::mutex errorLock;
+            std::exception_ptr error;
+
+            ExecutionGate gate;
+
+            int intraOpThreads;
+
+            DataflowState(int numNodes, int numWorkers) : consumers(numNodes), pending(numNodes), queues(numWorkers) {
+                for (int e = 0; e < numWorkers; e++)
+                    queueLocks.emplace_back(new std::mutex());
+
+                queued = 0;
+                inflight = 0;
+                remaining = numNodes;
+                failed = false;
+                status = Status::OK();
+            }
+
+            void push(int worker, int task) {
+                inflight++;
+                {
+                    std::lock_guard<std::mutex> lock(*queueLocks[worker]);
+                    queues[worker].emplace_back(task);
+                }
+                queued++;
+                wake(false);
+            }
+
+            // parked worker checks its condition under parkLock, so taking it here guarantees notification isn't lost in between
+            void wake(bool all) {
+                {
+                    std::lock_guard<std::mutex> lock(parkLock);
+                }
+
+                if (all)
+                    parkCv.notify_all();
+                else
+                    parkCv.notify_one();
+            }
+
+            bool pop(int worker, int &task) {
+                // own queue first
+                {
+                    std::lock_guard<std::mutex> lock(*queueLocks[worker]);
+                    if (!queues[worker].empty()) {
+                        task = queues[worker].back();
+                        queues[worker].pop_back();
+                        queued--;
+                        return true;
+                    }
+                }
+
+                // stealing from other workers then
+                int numWorkers = (int) queues.size();
+                for (int e = 1; e < numWorkers; e++) {
+                    int victim = (worker + e) % numWorkers;
+                    std::lock_guard<std::mutex> lock(*queueLocks[victim]);
+                    if (!queues[victim].empty()) {
+                        task = queues[victim].front();
+                        queues[victim].pop_front();
+                        queued--;
+                        return true;
+                    }
+                }
+
+                return false;
+            }
+
+            void fail(Nd4jStatus code) {
+                Nd4jStatus expected = Status::OK();
+                status.compare_exchange_strong(expected, code);
+                failed = true;
+                wake(true);
+            }
+        };
+
+        static void executeDataflowNode(DataflowState &state, int worker, int task) {
+            auto node = state.nodes[task];
+            bool exclusive = state.exclusive[task];
+
+            state.gate.enter(exclusive);
+
+            Nd4jStatus status = Status::OK();
+            auto timeStart = std::chrono::system_clock::now();
+            try {
+                status = GraphExecutioner::executeFlatNode(state.graph, node, state.variableSpace, state.variableSpace->workerWorkspace(worker));
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(state.errorLock);
+                if (!state.error)
+                    state.error = std::current_exception();
+
+                status = ND4J_STATUS_KERNEL_FAILURE;
+            }
+            auto timeEnd = std::chrono::system_clock::now();
+
+            state.gate.leave(exclusive);
+
+            auto outerTime = std::chrono::duration_cast<std::chrono::nanoseconds>(timeEnd - timeStart).count();
+            state.flowPath->setOuterTime(node->id(), outerTime);
+
+            if (Environment::getInstance()->isProfiling())
+                state.flowPath->profile()->nodeById(node->id())->setTotalTime(outerTime);
+
+            if (status != Status::OK()) {
+                state.fail(status);
+                return;
+            }
+
+            state.flowPath->markExecuted(node->id(), true);
+
+            // releasing nodes which were waiting for this one
+            for (auto c: state.consumers[task])
+                if (--state.pending[c] == 0)
+                    state.push(worker, c);
+
+            --state.remaining;
+
+            // nothing queued, nothing running, but some nodes weren't executed: their dependencies can't be resolved
+            if (--state.inflight == 0 && state.remaining.load() > 0)
+                state.fail(Status::THROW("Dataflow execution stalled: graph has unresolved dependencies"));
+
+            state.wake(true);
+        }
+
+        static void dataflowWorker(DataflowState *state, int worker) {
+#ifdef _OPENMP
+            omp_set_num_threads(state->intraOpThreads);
+#endif
+
+            while (true) {
+                if (state->failed.load() || state->remaining.load() == 0)
+                    break;
+
+                int task = -1;
+                if (state->pop(worker, task)) {
+                    executeDataflowNode(*state, worker, task);
+                    continue;
+                }
+
+                // nothing to do right now, parking till some node gets released
+                std::unique_lock<std::mutex> lock(state->parkLock);
+                state->parkCv.wait(lock, [&] {
+                    return state->queued.load() > 0 || state->remaining.load() == 0 || state->failed.load();
+                });
+            }
+        }
+
+        static bool isExclusiveNode(Node *node) {
+            // in-place ops and ops writing to external variables modify arrays other nodes might be reading
+            if (node->isInplace() || node->hasExternalOutputs())
+                return true;
+
+            // random ops share RNG state
+            if (node->opType() == OpType_RANDOM)
+                return true;
+
+            // ops with variable number of outputs might register new variables during execution
+            if (node->hasCustomOp() && node->getCustomOp()->getOpDescriptor()->getNumberOfOutputs() < 0)
+                return true;
+
+            return false;
+        }
+
+        bool DataflowExecutor::isApplicable(Graph *graph) {
+            if (!graph->scopes()->empty())
+                return false;
+
+            for (auto &v: *graph->getMapped()) {
+                auto node = v.second;
+
+                if (node->opType() == OpType_LOGIC || node->opType() == OpType_GRAPH)
+                    return false;
+
+                if (node->hasGraphEmbedded() || node->isScoped() || node->isDivergencePoint())
+                    return false;
+            }
+
+            return true;
+        }
+
+        int DataflowExecutor::interOpThreads(Graph *graph) {
+            auto configured = graph->getExecutorConfiguration()->_interOpThreads;
+#ifdef _OPENMP
+            int maxThreads = omp_get_max_threads();
+#else
+            int maxThreads = 1;
+#endif
+            if (configured > 0)
+                return configured;
+
+            // there's no sense to have more workers than widest layer of the graph has nodes
+            int width = 1;
+            for (auto &v: *graph->getOnion())
+                width = nd4j::math::nd4j_max<int>(width, (int) v.second->size());
+
+            return nd4j::math::nd4j_max<int>(1, nd4j::math::nd4j_min<int>(width, maxThreads));
+        }
+
+        int DataflowExecutor::intraOpThreads(Graph *graph, int interOpThreads) {
+            auto configured = graph->getExecutorConfiguration()->_intraOpThreads;
+#ifdef _OPENMP
+            int maxThreads = omp_get_max_threads();
+#else
+            int maxThreads = 1;
+#endif
+            if (configured > 0)
+                return configured;
+
+            return nd4j::math::nd4j_max<int>(1, maxThreads / nd4j::math::nd4j_max<int>(1, interOpThreads));
+        }
+
+        Nd4jStatus DataflowExecutor::execute(Graph *graph, VariableSpace *variableSpace) {
+            auto flowPath = variableSpace->flowPath();
+
+            // collecting nodes in layered order, so roots are dispatched in the same order as in sequential mode
+            std::vector<Node*> nodes;
+            std::map<int, int> positions;
+            for (auto &v: *graph->getOnion()) {
+                for (auto node: *v.second) {
+                    positions[node->id()] = (int) nodes.size();
+                    nodes.emplace_back(node);
+                }
+            }
+
+            if (nodes.empty())
+                return Status::OK();
+
+            int numWorkers = nd4j::math::nd4j_min<int>(interOpThreads(graph), (int) nodes.size());
+
+            DataflowState state((int) nodes.size(), numWorkers);
+            state.graph = graph;
+            state.variableSpace = variableSpace;
+            state.flowPath = flowPath;
+            state.nodes = nodes;
+            state.intraOpThreads = intraOpThreads(graph, numWorkers);
+
+            for (int e = 0; e < (int) nodes.size(); e++) {
+                auto node = nodes[e];
+                state.exclusive.emplace_back(isExclusiveNode(node));
+
+                // every output must exist before workers start, so VariableSpace maps are never modified concurrently.
+                // ops with unknown number of outputs are exclusive, so nothing else runs while they add variables
+                int numOutputs = 1;
+                if (node->hasCustomOp())
+                    numOutputs = nd4j::math::nd4j_max<int>(1, node->getCustomOp()->getOpDescriptor()->getNumberOfOutputs());
+
+                for (int o = 0; o < numOutputs; o++) {
+                    std::pair<int, int> p(node->id(), o);
+                    if (!variableSpace->hasVariable(p)) {
+                        auto var = new Variable(nullptr, nullptr, p.first, p.second);
+                        variableSpace->putVariable(p, var);
+                    }
+                }
+
+                std::set<int> dependencies;
+                for (auto &p: *node->input()) {
+                    if (p.first == node->id() || positions.count(p.first) == 0)
+                        continue;
+
+                    if (!variableSpace->hasVariable(p)) {
+                        auto var = new Variable(nullptr, nullptr, p.first, p.second);
+                        variableSpace->putVariable(p, var);
+                    }
+
+                    dependencies.insert(p.first);
+                }
+
+                state.pending[e] = (int) dependencies.size();
+                for (auto d: dependencies)
+                    state.consumers[positions[d]].emplace_back(e);
+
+                // same applies to FlowPath and profiler state
+                flowPath->markNodeActive(node->id(), true);
+                flowPath->setOuterTime(node->id(), 0);
+
+                if (Environment::getInstance()->isProfiling())
+                    flowPath->profile()->nodeById(node->id(), node->name()->c_str());
+            }
+
+            // worker workspaces are created upfront as well
+            for (int e = 0; e < numWorkers; e++)
+                variableSpace->workerWorkspace(e);
+
+            // distributing roots over workers
+            int cnt = 0;
+            for (int e = 0; e < (int) nodes.size(); e++)
+                if (state.pending[e].load() == 0)
+                    state.push(cnt++ % numWorkers, e);
+
+            if (cnt == 0)
+                return Status::THROW("Dataflow execution: graph has no root nodes");
+
+            nd4j_debug("Dataflow execution: %i nodes; %i workers; %i threads per op\n", (int) nodes.size(), numWorkers, state.intraOpThreads);
+
+#ifdef _OPENMP
+            int callerThreads = omp_get_max_threads();
+#endif
+
+            // calling thread acts as worker 0
+            std::vector<std::thread> workers;
+            for (int e = 1; e < numWorkers; e++)
+                workers.emplace_back(dataflowWorker, &state, e);
+
+            dataflowWorker(&state, 0);
+
+            for (auto &t: workers)
+                t.join();
+
+#ifdef _OPENMP
+            omp_set_num_threads(callerThreads);
+#endif
+
+            if (state.error)
+                std::rethrow_exception(state.error);
+
+            if (state.failed.load())
+                return state.status.load();
+
+            return Status::OK();
+        }
+    }
+}
@@ -54,6 +54,7 @@ namespace nd4j {
                 this->_isInplace = prototype->isInplace();
                 this->_nodeId = prototype->nodeId();
                 this->_useMKLDNN = prototype->isUseMKLDNN();
+                this->_winogradFilter = prototype->winogradFilter();
             }
 
 
@@ -150,6 +150,13 @@ namespace nd4j {
             return clone;
         }
 
+        std::shared_ptr<nd4j::WinogradFilter> ContextPrototype::winogradFilter() {
+            if (_winogradFilter == nullptr)
+                _winogradFilter = std::make_shared<nd4j::WinogradFilter>();
+
+            return _winogradFilter;
+        }
+
         void ContextPrototype::setOpDescriptor(nd4j::ops::OpDescriptor* opDescriptor) {
             _opDescriptor = opDescriptor;
         }
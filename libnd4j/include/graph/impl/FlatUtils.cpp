@@ -24,6 +24,7 @@
 #include <array/DataTypeUtils.h>
 #include <array/ByteOrderUtils.h>
 #include <NDArrayFactory.h>
+#include <helpers/BitwiseUtils.h>
 
 
 namespace nd4j {
@@ -104,5 +105,43 @@ namespace nd4j {
 
             return array;
         }
+
+        NDArray* FlatUtils::viewFlatArray(const nd4j::graph::FlatArray *flatArray) {
+            auto dtype = DataTypeUtils::fromFlatDataType(flatArray->dtype());
+            if (dtype == UTF8 || flatArray->buffer() == nullptr)
+                return nullptr;
+
+            if (ByteOrderUtils::fromFlatByteOrder(flatArray->byteOrder()) != BitwiseUtils::asByteOrder())
+                return nullptr;
+
+            auto rank = static_cast<int>(flatArray->shape()->Get(0));
+            auto newShape = new Nd4jLong[shape::shapeInfoLength(rank)];
+            memcpy(newShape, flatArray->shape()->data(), shape::shapeInfoByteLength(rank));
+
+            auto buffer = flatArray->buffer()->data();
+            auto length = shape::length(newShape);
+            auto sizeOfT = DataTypeUtils::sizeOf(dtype);
+
+            // buffers written before alignment was enforced might be misaligned for given data type
+            if (shape::isEmpty(newShape) || flatArray->buffer()->size() < length * sizeOfT || reinterpret_cast<Nd4jLong>(buffer) % sizeOfT != 0) {
+                delete[] newShape;
+                return nullptr;
+            }
+
+            return new NDArray(const_cast<int8_t *>(buffer), newShape, nullptr, false, true);
+        }
+
+        flatbuffers::Offset<FlatArray> FlatUtils::toFlatArray(flatbuffers::FlatBufferBuilder &builder, NDArray &array) {
+            auto byteVector = array.asByteVector();
+            auto fShape = builder.CreateVector(array.getShapeInfoAsFlatVector());
+
+            // alignment is relative to the end of FlatBuffer, builder pads whole buffer accordingly
+            builder.ForceVectorAlignment(byteVector.size(), sizeof(int8_t), BUFFER_ALIGNMENT);
+            auto fBuffer = builder.CreateVector(byteVector);
+
+            auto bo = static_cast<nd4j::graph::ByteOrder>(BitwiseUtils::asByteOrder());
+
+            return CreateFlatArray(builder, fShape, fBuffer, static_cast<nd4j::graph::DataType>(array.dataType()), bo);
+        }
     }
 }
\ No newline at end of file
@@ -26,6 +26,10 @@
 #include <helpers/ShapeUtils.h>
 #include <ops/declarable/OpRegistrator.h>
 #include <graph/VariableProxy.h>
+#include <graph/MemoryPlan.h>
+#include <graph/GraphFusion.h>
+#include <Environment.h>
+#include <Status.h>
 #include <graph/exceptions/graph_exception.h>
 #include <graph/exceptions/unresolved_input_exception.h>
 #include <graph/exceptions/unresolved_output_exception.h>
@@ -44,6 +48,44 @@ namespace nd4j {
             return _variableSpace->numberOfPlaceholders();
         };
 
+        Nd4jStatus Graph::planMemory() {
+            if (!_built.load())
+                this->buildGraph();
+
+            // existing plan stays as is, arrays are bound to it already
+            if (_memoryPlan != nullptr)
+                return Status::OK();
+
+            auto plan = new MemoryPlan(this);
+            auto status = plan->build(_variableSpace);
+            if (status != Status::OK()) {
+                delete plan;
+                return status;
+            }
+
+            _memoryPlan = plan;
+            _memoryPlan->attach(_variableSpace);
+
+            return Status::OK();
+        }
+
+        MemoryPlan* Graph::memoryPlan() {
+            return _memoryPlan;
+        }
+
+        MappedFile* Graph::mappedFile() {
+            return _mappedFile;
+        }
+
+        void Graph::forgetMemoryPlan() {
+            if (_memoryPlan == nullptr)
+                return;
+
+            _memoryPlan->detach(_variableSpace);
+            delete _memoryPlan;
+            _memoryPlan = nullptr;
+        }
+
         Nd4jLong Graph::estimateRequiredMemory() {
 
             Nd4jLong result = 0L;
@@ -298,16 +340,24 @@ namespace nd4j {
             for (auto v: _scopes)
                 delete v;
 
+            forgetMemoryPlan();
+
             delete _mapped;
             delete _nodes;
             delete _variableSpace;
             delete _onion;
             delete _configuration;
+
+            // arrays backed by mapped file are gone at this point
+            delete _mappedFile;
         }
 
         void Graph::addNode(Node *node) {
             _built.store(false);
 
+            // graph structure changes, so memory plan isn't valid anymore
+            forgetMemoryPlan();
+
             if (node->opType() == OpType_LOGIC) {
                 // nd4j_debug("Adding LogicOp [%i]\n", node->opNum());
                 // SCOPE
@@ -762,6 +812,12 @@ namespace nd4j {
                         bool singleInput = true;
                         auto inputs = node->input();
                         for (auto &t: *inputs) {
+                            // read-only variables (i.e. views of mapped file) must not be overwritten
+                            if (_variableSpace->hasVariable(t) && _variableSpace->getVariable(t)->isReadOnly()) {
+                                singleInput = false;
+                                break;
+                            }
+
                             if (_mapped->count(t.first) == 0)
                                 continue;
 
@@ -864,7 +920,8 @@ namespace nd4j {
             }
         }
 
-        Graph::Graph(const FlatGraph *flatGraph, VariableSpace *variableSpace) {
+        Graph::Graph(const FlatGraph *flatGraph, VariableSpace *variableSpace, MappedFile *mappedFile) {
+            _mappedFile = mappedFile;
             this->_onion = new std::map<int, std::vector<Node *> *>();
             this->_mapped = new std::map<int, Node *> ();
             this->_nodes = new std::vector<int>();
@@ -891,7 +948,7 @@ namespace nd4j {
                 for (unsigned int e = 0; e < flatGraph->variables()->size(); e++) {
                     auto flatVar = flatGraph->variables()->Get(e);
 
-                    auto var = new Variable(flatVar);
+                    auto var = new Variable(flatVar, _mappedFile != nullptr);
                     std::pair<int, int> pair(flatVar->id()->first(), flatVar->id()->second());
                     _variableSpace->putVariable(pair, var);
 
@@ -942,6 +999,8 @@ namespace nd4j {
                     _unmapped[nnode->id()] = nnode;
                 }
 
+                if (Environment::getInstance()->isGraphFusion())
+                    fuseNodes();
 
                 this->toposortNodes();
 
@@ -958,6 +1017,25 @@ namespace nd4j {
         }
 
 
+        void Graph::fuseNodes() {
+            // all intermediate results are requested in this mode, so nothing can be fused
+            if (_configuration->_outputMode == OutputMode_VARIABLE_SPACE)
+                return;
+
+            // fusion would break frames and scopes
+            for (auto &v: _unmapped)
+                if (v.second->opType() == OpType_LOGIC || v.second->isScoped() || v.second->hasGraphEmbedded())
+                    return;
+
+            _fusedNodes = GraphFusion::fuse(_unmapped, _output);
+
+            nd4j_debug("Graph fusion: %i nodes fused away\n", _fusedNodes);
+        }
+
+        int Graph::fusedNodes() {
+            return _fusedNodes;
+        }
+
         void Graph::toposortNodes() {
             int attempts = 0;
 
@@ -1269,6 +1347,8 @@ namespace nd4j {
         }
 
         void Graph::replaceState(VariableSpace *state, ExecutorConfiguration *configuration) {
+            forgetMemoryPlan();
+
             delete _variableSpace;
             delete _configuration;
 
@@ -1310,7 +1390,7 @@ namespace nd4j {
                 for (auto x: *(ovec)) {
                     auto n = x->clone();
                     vec->emplace_back(n);
-                    _handles.emplace_back(n);
+                    clone->_handles.emplace_back(n);
                     (*clone->_mapped)[n->id()] = n;
                 }
 
@@ -1361,7 +1441,7 @@ namespace nd4j {
                 for (auto x: *(ovec)) {
                     auto n = x->clone();
                     vec->emplace_back(n);
-                    _handles.emplace_back(n);
+                    clone->_handles.emplace_back(n);
                     (*clone->_mapped)[n->id()] = n;
                 }
 
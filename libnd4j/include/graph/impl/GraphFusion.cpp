@@ -0,0 +1,280 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <graph/GraphFusion.h>
+#include <ops/declarable/OpRegistrator.h>
+#include <ops/declarable/helpers/fused_ops.h>
+#include <helpers/logger.h>
+#include <op_enums.h>
+#include <algorithm>
+
+namespace nd4j {
+    namespace graph {
+        struct FusionStep {
+            int kind;
+            int opNum;
+            double scalar;
+
+            // input of the node, which becomes operand of pairwise step
+            std::pair<int, int> operand;
+        };
+
+        static bool hasExtraArgs(Node *node) {
+            if (node->extraParams() != nullptr)
+                return true;
+
+            auto block = node->protoContext();
+            return block != nullptr && !block->getTArguments()->empty();
+        }
+
+        static double firstTArg(Node *node, double defaultValue) {
+            auto block = node->protoContext();
+            if (block == nullptr || block->getTArguments()->empty())
+                return defaultValue;
+
+            return block->getTArguments()->at(0);
+        }
+
+        /**
+         * This method checks if given node can be expressed as fused step, and fills that step
+         */
+        static bool asStep(Node *node, FusionStep &step) {
+            step.scalar = 0.0;
+            step.operand = std::pair<int, int>(0, 0);
+
+            auto numInputs = node->input()->size();
+
+            switch (node->opType()) {
+                case OpType_TRANSFORM_SAME:
+                    step.kind = ops::helpers::FUSED_TRANSFORM_SAME;
+                    break;
+                case OpType_TRANSFORM_STRICT:
+                    step.kind = ops::helpers::FUSED_TRANSFORM_STRICT;
+                    break;
+                case OpType_TRANSFORM_FLOAT:
+                    step.kind = ops::helpers::FUSED_TRANSFORM_FLOAT;
+                    break;
+                case OpType_SCALAR:
+                    // scalar given as second input isn't known at import time
+                    if (numInputs != 1)
+                        return false;
+
+                    step.kind = ops::helpers::FUSED_SCALAR;
+                    step.scalar = node->scalar();
+                    break;
+                case OpType_PAIRWISE:
+                    step.kind = ops::helpers::FUSED_PAIRWISE;
+                    break;
+                case OpType_CUSTOM: {
+                    if (node->getCustomOp() == nullptr)
+                        return false;
+
+                    auto name = *node->getCustomOp()->getOpName();
+                    if (name == "relu" || name == "relu6" || name == "lrelu") {
+                        step.kind = ops::helpers::FUSED_SCALAR;
+                        step.opNum = name == "relu" ? scalar::RELU : name == "relu6" ? scalar::RELU6 : scalar::LeakyRELU;
+                        step.scalar = firstTArg(node, 0.0);
+                        return numInputs == 1;
+                    }
+
+                    if (hasExtraArgs(node))
+                        return false;
+
+                    if (name == "identity") {
+                        step.kind = ops::helpers::FUSED_TRANSFORM_SAME;
+                        step.opNum = transform::Identity;
+                        return numInputs == 1;
+                    }
+
+                    std::map<std::string, int> strict = {{"sigmoid", transform::Sigmoid}, {"tanh", transform::Tanh}, {"elu", transform::ELU},
+                                                         {"selu", transform::SELU}, {"softplus", transform::SoftPlus}, {"softsign", transform::SoftSign}};
+                    if (strict.count(name) > 0) {
+                        step.kind = ops::helpers::FUSED_TRANSFORM_STRICT;
+                        step.opNum = strict[name];
+                        return numInputs == 1;
+                    }
+
+                    std::map<std::string, int> binary = {{"biasadd", pairwise::Add}, {"add", pairwise::Add}, {"subtract", pairwise::Subtract},
+                                                         {"multiply", pairwise::Multiply}, {"divide", pairwise::Divide}};
+                    if (binary.count(name) > 0 && numInputs == 2) {
+                        step.kind = ops::helpers::FUSED_PAIRWISE;
+                        step.opNum = binary[name];
+                        step.operand = node->input()->at(1);
+                        return true;
+                    }
+
+                    return false;
+                }
+                default:
+                    return false;
+            }
+
+            // legacy ops
+            if (hasExtraArgs(node) || !node->getDimensions()->empty())
+                return false;
+
+            step.opNum = (int) node->opNum();
+            if (!ops::helpers::isFusibleStep(step.kind, step.opNum))
+                return false;
+
+            if (step.kind == ops::helpers::FUSED_PAIRWISE) {
+                if (numInputs != 2)
+                    return false;
+
+                step.operand = node->input()->at(1);
+                return true;
+            }
+
+            return numInputs == 1;
+        }
+
+        static bool isMatmul(Node *node) {
+            return node->opType() == OpType_CUSTOM && node->getCustomOp() != nullptr && *node->getCustomOp()->getOpName() == "matmul" && node->input()->size() == 2;
+        }
+
+        int GraphFusion::fuse(std::map<int, Node*> &nodes, const std::vector<int> &outputs) {
+            // building consumers lists
+            std::map<int, std::vector<int>> consumers;
+            for (auto &v: nodes) {
+                for (auto &in: *v.second->input()) {
+                    if (nodes.count(in.first) > 0)
+                        consumers[in.first].emplace_back(v.first);
+                }
+            }
+
+            // returns id of node, given node can be fused into, or 0
+            auto nextInChain = [&] (Node *node) -> int {
+                if (std::find(outputs.begin(), outputs.end(), node->id()) != outputs.end())
+                    return 0;
+
+                if (consumers.count(node->id()) == 0 || consumers[node->id()].size() != 1)
+                    return 0;
+
+                auto consumer = nodes[consumers[node->id()].at(0)];
+                auto inputs = consumer->input();
+
+                // output of this node must be the main input of consumer, and nothing else
+                if (inputs->at(0) != std::pair<int, int>(node->id(), 0))
+                    return 0;
+
+                for (int e = 1; e < (int) inputs->size(); e++)
+                    if (inputs->at(e).first == node->id())
+                        return 0;
+
+                FusionStep step;
+                return asStep(consumer, step) ? consumer->id() : 0;
+            };
+
+            // collecting chain heads first, since map is modified afterwards
+            std::vector<int> heads;
+            for (auto &v: nodes) {
+                auto node = v.second;
+                FusionStep step;
+                bool matmul = isMatmul(node);
+                if (!matmul && !asStep(node, step))
+                    continue;
+
+                // node that continues some chain isn't a head
+                auto in = node->input()->at(0);
+                if (!matmul && nodes.count(in.first) > 0) {
+                    auto producer = nodes[in.first];
+                    if ((isMatmul(producer) || asStep(producer, step)) && nextInChain(producer) == node->id())
+                        continue;
+                }
+
+                if (nextInChain(node) != 0)
+                    heads.emplace_back(node->id());
+            }
+
+            auto fusedElementwise = nd4j::ops::OpRegistrator::getInstance()->getOperation("fused_elementwise");
+            auto fusedMatmul = nd4j::ops::OpRegistrator::getInstance()->getOperation("fused_matmul");
+            if (fusedElementwise == nullptr || fusedMatmul == nullptr)
+                return 0;
+
+            int removed = 0;
+            for (auto id: heads) {
+                auto head = nodes[id];
+                bool matmul = isMatmul(head);
+
+                std::vector<Node*> chain;
+                std::vector<FusionStep> steps;
+                if (!matmul) {
+                    FusionStep step;
+                    asStep(head, step);
+                    steps.emplace_back(step);
+                }
+                chain.emplace_back(head);
+
+                for (int next = nextInChain(head); next != 0; next = nextInChain(nodes[next])) {
+                    FusionStep step;
+                    asStep(nodes[next], step);
+                    steps.emplace_back(step);
+                    chain.emplace_back(nodes[next]);
+                }
+
+                // single op doesn't need fusion
+                if (chain.size() < 2)
+                    continue;
+
+                auto last = chain.back();
+                auto fused = new Node(matmul ? fusedMatmul : fusedElementwise, last->id());
+                fused->setName(*last->getName());
+                fused->setScopeInfo(last->scopeId(), last->scopeName()->c_str());
+
+                // fused node replaces last node of the chain, so it inherits its consumers
+                for (auto &o: *last->output()) {
+                    if (o.second == 0)
+                        fused->pickOutput(o.first);
+                    else
+                        fused->pickOutput(o.first, o.second);
+                }
+
+                fused->pickInput(head->input()->at(0));
+                if (matmul)
+                    fused->pickInput(head->input()->at(1));
+
+                for (auto &s: steps)
+                    if (s.kind == ops::helpers::FUSED_PAIRWISE)
+                        fused->pickInput(s.operand);
+
+                auto block = fused->getContextPrototype();
+                if (matmul) {
+                    auto iArgs = head->protoContext() != nullptr ? *head->protoContext()->getIArguments() : std::vector<int>();
+                    for (int e = 0; e < 3; e++)
+                        block->getIArguments()->emplace_back(e < (int) iArgs.size() ? iArgs[e] : 0);
+                }
+
+                for (auto &s: steps) {
+                    block->getIArguments()->emplace_back(s.kind);
+                    block->getIArguments()->emplace_back(s.opNum);
+                    block->getTArguments()->emplace_back(s.scalar);
+                }
+
+                nd4j_debug("GraphFusion: fusing %i nodes into Node_%i [%s]\n", (int) chain.size(), last->id(), last->getName()->c_str());
+
+                for (auto node: chain) {
+                    nodes.erase(node->id());
+                    delete node;
+                }
+
+                nodes[fused->id()] = fused;
+                removed += (int) chain.size() - 1;
+            }
+
+            return removed;
+        }
+    }
+}
@@ -37,6 +37,7 @@ namespace nd4j {
                 throw graph_exists_exception(graphId);
 
             _graphF[graphId] = graph;
+            attachPool(graphId, graph);
 
             nd4j::SimpleReadWriteLock lock;
             _locks[graphId] = lock;
@@ -64,16 +65,44 @@ namespace nd4j {
             return graph;
         }
 
+        void GraphHolder::attachPool(Nd4jLong graphId, Graph* graph) {
+            std::lock_guard<std::mutex> lock(_poolsLock);
+            _pools[graphId] = std::make_shared<GraphSessionPool>(graph);
+        }
+
+        void GraphHolder::detachPool(Nd4jLong graphId, Graph* graphToDelete) {
+            std::shared_ptr<GraphSessionPool> pool;
+            {
+                std::lock_guard<std::mutex> lock(_poolsLock);
+                auto it = _pools.find(graphId);
+                if (it != _pools.end()) {
+                    pool = it->second;
+                    _pools.erase(it);
+                }
+            }
+
+            if (graphToDelete == nullptr)
+                return;
+
+            // sessions still running refer to the graph, so it goes away together with their pool
+            if (pool != nullptr)
+                pool->adoptOrigin();
+            else
+                delete graphToDelete;
+        }
+
         void GraphHolder::forgetGraph(Nd4jLong graphId) {
             if (this->hasGraph(graphId))
                 _graphF.erase(graphId);
+
+            detachPool(graphId, nullptr);
         }
 
         void GraphHolder::dropGraph(Nd4jLong graphId) {
             if (this->hasGraph(graphId)) {
                 auto g = _graphF[graphId];
-                forgetGraph(graphId);
-                delete g;
+                _graphF.erase(graphId);
+                detachPool(graphId, g);
             }
         }
 
@@ -105,12 +134,47 @@ namespace nd4j {
             this->lockWrite(graphId);
 
             _graphF[graphId] = graph;
+            attachPool(graphId, graph);
 
             this->unlockWrite(graphId);
         }
 
+        Graph* GraphHolder::acquireSession(Nd4jLong graphId) {
+            std::shared_ptr<GraphSessionPool> pool;
+            {
+                std::lock_guard<std::mutex> lock(_poolsLock);
+                auto it = _pools.find(graphId);
+                if (it == _pools.end())
+                    throw unknown_graph_exception(graphId);
 
+                pool = it->second;
+            }
 
+            auto session = pool->acquire();
+
+            std::lock_guard<std::mutex> lock(_poolsLock);
+            _sessions[session] = pool;
+
+            return session;
+        }
+
+        void GraphHolder::releaseSession(Nd4jLong graphId, Graph* session) {
+            std::shared_ptr<GraphSessionPool> pool;
+            {
+                std::lock_guard<std::mutex> lock(_poolsLock);
+                auto it = _sessions.find(session);
+                if (it == _sessions.end()) {
+                    nd4j_printf("GraphHolder: session wasn't acquired for graph [%lld]\n", graphId);
+                    throw std::runtime_error("Bad argument");
+                }
+
+                pool = it->second;
+                _sessions.erase(it);
+            }
+
+            // if pool was detached meanwhile, this is the last reference, and pool goes away after the release
+            pool->release(session);
+        }
 
         flatbuffers::Offset<FlatResult> GraphHolder::execute(Nd4jLong graphId, flatbuffers::FlatBufferBuilder &builder, const FlatInferenceRequest* request) {
             if (!hasGraph(graphId))
@@ -118,9 +182,18 @@ namespace nd4j {
 
             lockRead(graphId);
 
-            auto graph = cloneGraph(graphId);
-            auto res = GraphExecutioner::execute(graph, builder, request);
-            delete graph;
+            auto session = acquireSession(graphId);
+
+            flatbuffers::Offset<FlatResult> res;
+            try {
+                res = GraphExecutioner::execute(session, builder, request);
+            } catch (...) {
+                releaseSession(graphId, session);
+                unlockRead(graphId);
+                throw;
+            }
+
+            releaseSession(graphId, session);
 
             unlockRead(graphId);
 
@@ -0,0 +1,126 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <graph/GraphSessionPool.h>
+#include <graph/VariableProxy.h>
+#include <helpers/logger.h>
+#include <stdexcept>
+
+namespace nd4j {
+    namespace graph {
+        GraphSessionPool::GraphSessionPool(Graph* origin, int capacity) {
+            if (origin == nullptr)
+                throw std::invalid_argument("GraphSessionPool: origin Graph can't be null");
+
+            if (capacity < 1)
+                throw std::invalid_argument("GraphSessionPool: capacity must be positive");
+
+            _origin = origin;
+            _capacity = capacity;
+
+            _sessions = new std::atomic<Graph*>[capacity];
+            _busy = new std::atomic<bool>[capacity];
+            for (int e = 0; e < capacity; e++) {
+                _sessions[e].store(nullptr);
+                _busy[e].store(false);
+            }
+
+            _created.store(0);
+            _temporary.store(0);
+        }
+
+        GraphSessionPool::~GraphSessionPool() {
+            for (int e = 0; e < _capacity; e++) {
+                if (_busy[e].load()) {
+                    nd4j_printf("GraphSessionPool: session [%i] is still in use, leaking it\n", e);
+                    continue;
+                }
+
+                delete _sessions[e].load();
+            }
+
+            delete[] _sessions;
+            delete[] _busy;
+
+            if (_ownsOrigin)
+                delete _origin;
+        }
+
+        void GraphSessionPool::adoptOrigin() {
+            _ownsOrigin = true;
+        }
+
+        Graph* GraphSessionPool::acquire() {
+            for (int e = 0; e < _capacity; e++) {
+                // cheap check first, so busy slots don't bounce cache lines
+                if (_busy[e].load(std::memory_order_relaxed))
+                    continue;
+
+                bool expected = false;
+                if (!_busy[e].compare_exchange_strong(expected, true, std::memory_order_acquire))
+                    continue;
+
+                // slot is ours now, sessions are created lazily
+                auto session = _sessions[e].load(std::memory_order_relaxed);
+                if (session == nullptr) {
+                    session = _origin->cloneWithProxy();
+                    _sessions[e].store(session, std::memory_order_relaxed);
+                    _created++;
+                }
+
+                return session;
+            }
+
+            _temporary++;
+            nd4j_debug("GraphSessionPool: all %i sessions are busy, creating temporary one\n", _capacity);
+
+            return _origin->cloneWithProxy();
+        }
+
+        void GraphSessionPool::release(Graph* session) {
+            if (session == nullptr)
+                return;
+
+            for (int e = 0; e < _capacity; e++) {
+                if (_sessions[e].load(std::memory_order_relaxed) != session)
+                    continue;
+
+                // activations of this request aren't needed anymore
+                auto proxy = dynamic_cast<VariableProxy*>(session->getVariableSpace());
+                if (proxy != nullptr)
+                    proxy->reset();
+
+                _busy[e].store(false, std::memory_order_release);
+                return;
+            }
+
+            // not pooled session
+            delete session;
+        }
+
+        int GraphSessionPool::pooledSessions() {
+            return _created.load();
+        }
+
+        int GraphSessionPool::temporarySessions() {
+            return _temporary.load();
+        }
+
+        int GraphSessionPool::capacity() {
+            return _capacity;
+        }
+    }
+}
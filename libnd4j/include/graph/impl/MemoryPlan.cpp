@@ -0,0 +1,405 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <graph/MemoryPlan.h>
+#include <graph/Graph.h>
+#include <graph/Context.h>
+#include <array/ShapeList.h>
+#include <helpers/shape.h>
+#include <templatemath.h>
+#include <Status.h>
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <set>
+#include <string>
+
+namespace nd4j {
+    namespace graph {
+        MemoryPlan::MemoryPlan(Graph *graph) {
+            _graph = graph;
+        }
+
+        MemoryPlan::~MemoryPlan() {
+            release();
+        }
+
+        void MemoryPlan::release() {
+            for (auto v: _views)
+                delete v;
+
+            for (auto s: _shapes)
+                delete[] s;
+
+            for (auto &v: _inputShapes)
+                delete[] v.second;
+
+            if (_arena != nullptr)
+                delete[] _arena;
+
+            _views.clear();
+            _shapes.clear();
+            _inputShapes.clear();
+            _tensors.clear();
+            _sizes.clear();
+            _first.clear();
+            _last.clear();
+            _offsets.clear();
+            _aliases.clear();
+            _positions.clear();
+            _producers.clear();
+            _steps.clear();
+            _stale = false;
+
+            _arena = nullptr;
+            _base = nullptr;
+            _arenaSize = 0L;
+            _naiveSize = 0L;
+        }
+
+        static Nd4jLong* copyShape(Nd4jLong *shapeInfo) {
+            auto result = new Nd4jLong[shape::shapeInfoLength(shapeInfo)];
+            memcpy(result, shapeInfo, shape::shapeInfoByteLength(shapeInfo));
+            return result;
+        }
+
+        static bool isPlannable(NDArray *array) {
+            if (array == nullptr || array->isEmpty() || array->dataType() == nd4j::DataType::UTF8)
+                return false;
+
+            // only dense arrays can be placed into arena
+            return !array->isView() && (array->ews() == 1 || array->lengthOf() == 1);
+        }
+
+        // output shapes of these ops depend on input values, not only on input shapes. Other ops are checked at execution time
+        static bool hasDataDependentShape(Node *node) {
+            static const std::set<std::string> ops = {"unique", "unique_with_counts", "Where", "where_np", "choose", "listdiff", "dynamic_partition",
+                                                      "non_max_suppression", "segment_max", "segment_min", "segment_mean", "segment_prod", "segment_sum",
+                                                      "broadcast_dynamic_shape", "range", "fill"};
+
+            if (!node->hasCustomOp() || node->getCustomOp()->getOpName() == nullptr)
+                return false;
+
+            return ops.count(*node->getCustomOp()->getOpName()) > 0;
+        }
+
+        Nd4jStatus MemoryPlan::build(VariableSpace *variableSpace) {
+            release();
+
+            // assigning execution step to each node, exactly as sequential executor does
+            std::map<int, int> steps;
+            std::vector<Node*> nodes;
+            for (int l = 0; l < (int) _graph->getOnion()->size(); l++) {
+                int layerSize = _graph->getOnion()->count(l) == 1 ? _graph->getOnion()->at(l)->size() : 0;
+                for (int n = 0; n < layerSize; n++) {
+                    auto node = _graph->getOnion()->at(l)->at(n);
+
+                    // control flow rewinds execution, so lifetimes can't be derived from steps
+                    if (node->opType() == OpType_LOGIC || node->hasGraphEmbedded() || node->isScoped())
+                        return Status::CODE(ND4J_STATUS_BAD_GRAPH, "MemoryPlan: graphs with control flow can't be planned");
+
+                    steps[node->id()] = (int) nodes.size();
+                    nodes.emplace_back(node);
+                }
+            }
+
+            std::map<int, bool> outputs;
+            for (auto id: *_graph->output())
+                outputs[id] = true;
+
+            for (auto id: *_graph->autos())
+                outputs[id] = true;
+
+            _steps = steps;
+
+            // collecting arrays produced by nodes
+            for (auto node: nodes) {
+                if (hasDataDependentShape(node))
+                    continue;
+
+                for (int e = 0; e < DataTypeUtils::max<int>(); e++) {
+                    std::pair<int, int> pair(node->id(), e);
+                    if (!variableSpace->hasVariable(pair))
+                        break;
+
+                    auto var = variableSpace->getVariable(pair);
+                    if (!var->hasNDArray() || var->isExternal())
+                        continue;
+
+                    auto array = var->getNDArray();
+                    int alias = -1;
+
+                    // in-place op reuses its input array, so we just extend lifetime of that input
+                    if (node->isInplace()) {
+                        if (e >= (int) node->input()->size())
+                            continue;
+
+                        auto in = node->input()->at(e);
+                        if (_positions.count(in) == 0)
+                            continue;
+
+                        alias = _positions[in];
+                        while (_aliases[alias] >= 0)
+                            alias = _aliases[alias];
+
+                        if (array->lengthOf() * array->sizeOfT() > _sizes[alias])
+                            continue;
+                    } else if (!var->isRemovable() || !isPlannable(array)) {
+                        // arrays not owned by variable (i.e. propagated external arrays) are left as is
+                        continue;
+                    }
+
+                    _positions[pair] = (int) _tensors.size();
+                    _tensors.emplace_back(pair);
+                    _shapes.emplace_back(copyShape(array->shapeInfo()));
+                    _sizes.emplace_back(alias >= 0 ? 0L : nd4j::math::nd4j_max<Nd4jLong>(ALIGNMENT, (array->lengthOf() * array->sizeOfT() + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT));
+                    _first.emplace_back(steps[node->id()]);
+                    _last.emplace_back(outputs.count(node->id()) > 0 ? INT_MAX : steps[node->id()]);
+                    _offsets.emplace_back(-1L);
+                    _aliases.emplace_back(alias);
+
+                    if (alias < 0)
+                        _producers[node->id()].emplace_back(_positions[pair]);
+                }
+            }
+
+            // extending lifetimes up to the last consumer
+            for (auto node: nodes) {
+                for (auto &in: *node->input()) {
+                    if (in.first < 0) {
+                        if (_inputShapes.count(in) == 0 && variableSpace->hasVariable(in) && variableSpace->getVariable(in)->hasNDArray())
+                            _inputShapes[in] = copyShape(variableSpace->getVariable(in)->getNDArray()->shapeInfo());
+
+                        continue;
+                    }
+
+                    if (_positions.count(in) == 0)
+                        continue;
+
+                    auto p = _positions[in];
+                    _last[p] = nd4j::math::nd4j_max<int>(_last[p], steps[node->id()]);
+                }
+            }
+
+            // aliased arrays keep their source alive
+            for (int e = 0; e < (int) _tensors.size(); e++) {
+                if (_aliases[e] < 0)
+                    continue;
+
+                auto root = _aliases[e];
+                _first[root] = nd4j::math::nd4j_min<int>(_first[root], _first[e]);
+                _last[root] = nd4j::math::nd4j_max<int>(_last[root], _last[e]);
+            }
+
+            // greedy interval coloring: biggest arrays are placed first, at lowest offset that doesn't conflict with placed arrays alive at the same time
+            std::vector<int> order;
+            for (int e = 0; e < (int) _tensors.size(); e++) {
+                if (_aliases[e] < 0) {
+                    order.emplace_back(e);
+                    _naiveSize += _sizes[e];
+                }
+            }
+
+            std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return _sizes[a] > _sizes[b]; });
+
+            std::vector<int> placed;
+            for (auto t: order) {
+                std::vector<std::pair<Nd4jLong, Nd4jLong>> busy;
+                for (auto p: placed)
+                    if (_first[p] <= _last[t] && _first[t] <= _last[p])
+                        busy.emplace_back(std::pair<Nd4jLong, Nd4jLong>(_offsets[p], _offsets[p] + _sizes[p]));
+
+                std::sort(busy.begin(), busy.end());
+
+                Nd4jLong offset = 0L;
+                for (auto &b: busy) {
+                    if (b.first - offset >= _sizes[t])
+                        break;
+
+                    offset = nd4j::math::nd4j_max<Nd4jLong>(offset, b.second);
+                }
+
+                _offsets[t] = offset;
+                _arenaSize = nd4j::math::nd4j_max<Nd4jLong>(_arenaSize, offset + _sizes[t]);
+                placed.emplace_back(t);
+            }
+
+            for (int e = 0; e < (int) _tensors.size(); e++)
+                if (_aliases[e] >= 0)
+                    _offsets[e] = _offsets[_aliases[e]];
+
+            nd4j_debug("MemoryPlan: %i arrays; arena size: %lld bytes; without reuse: %lld bytes\n", (int) _tensors.size(), _arenaSize, _naiveSize);
+
+            return Status::OK();
+        }
+
+        bool MemoryPlan::isValid(VariableSpace *variableSpace) {
+            if (_stale)
+                return false;
+
+            for (auto &v: _inputShapes) {
+                auto pair = v.first;
+                if (!variableSpace->hasVariable(pair) || !variableSpace->getVariable(pair)->hasNDArray())
+                    return false;
+
+                if (!shape::equalsStrict(v.second, variableSpace->getVariable(pair)->getNDArray()->shapeInfo()))
+                    return false;
+            }
+
+            return true;
+        }
+
+        void MemoryPlan::attach(VariableSpace *variableSpace) {
+            if (_tensors.empty())
+                return;
+
+            // arena and views are created only once, all subsequent executions reuse them
+            if (_arena == nullptr) {
+                _arena = new int8_t[_arenaSize + ALIGNMENT];
+                auto address = reinterpret_cast<Nd4jLong>(_arena);
+                _base = _arena + (ALIGNMENT - address % ALIGNMENT) % ALIGNMENT;
+
+                for (int e = 0; e < (int) _tensors.size(); e++)
+                    _views.emplace_back(new NDArray(_base + _offsets[e], _shapes[e]));
+            }
+
+            for (int e = 0; e < (int) _tensors.size(); e++) {
+                auto var = variableSpace->getVariable(_tensors[e]);
+                if (var->getNDArray() == _views[e])
+                    continue;
+
+                // array allocated by op itself during previous run
+                if (var->hasNDArray() && var->isRemovable())
+                    delete var->getNDArray();
+
+                var->setNDArray(_views[e]);
+                var->markRemovable(false);
+            }
+        }
+
+        bool MemoryPlan::hasPlannedShapes(Node *node, VariableSpace *variableSpace) {
+            // legacy ops derive output shapes from input shapes only
+            if (!node->hasCustomOp())
+                return true;
+
+            ShapeList inSha;
+            for (auto &in: *node->input()) {
+                if (!variableSpace->hasVariable(in))
+                    return false;
+
+                auto var = variableSpace->getVariable(in);
+                if (var->variableType() != VariableType::NDARRAY)
+                    continue;
+
+                if (!var->hasNDArray())
+                    return false;
+
+                inSha.push_back(var->getNDArray()->getShapeInfo());
+            }
+
+            bool result = true;
+            ShapeList *outSha = nullptr;
+            try {
+                Context block(node->getContextPrototype(), variableSpace);
+                outSha = node->getCustomOp()->calculateOutputShape(&inSha, block);
+
+                for (auto t: _producers[node->id()]) {
+                    auto index = _tensors[t].second;
+                    if (index >= outSha->size() || !shape::equalsSoft(outSha->at(index), _shapes[t]))
+                        result = false;
+                }
+            } catch (std::exception &e) {
+                // op will fail on its own, with proper message
+                result = false;
+            }
+
+            if (outSha != nullptr) {
+                outSha->destroy();
+                delete outSha;
+            }
+
+            return result;
+        }
+
+        void MemoryPlan::unbindFrom(int step, VariableSpace *variableSpace) {
+            for (int e = 0; e < (int) _tensors.size(); e++) {
+                if (_steps[_tensors[e].first] < step || !variableSpace->hasVariable(_tensors[e]))
+                    continue;
+
+                auto var = variableSpace->getVariable(_tensors[e]);
+                if (var->getNDArray() == _views[e]) {
+                    var->setNDArray(nullptr);
+                    var->markRemovable(true);
+                }
+            }
+        }
+
+        void MemoryPlan::prepare(Node *node, VariableSpace *variableSpace) {
+            // stale plan has nothing bound past the node that broke it
+            if (_views.empty() || _stale)
+                return;
+
+            // memory might hold array of another node, or the same array from previous run
+            auto it = _producers.find(node->id());
+            if (it == _producers.end())
+                return;
+
+            // outputs of this node and all nodes after it are allocated by ops for the rest of the run. Arena isn't touched anymore,
+            // so arrays computed already stay valid
+            if (!hasPlannedShapes(node, variableSpace)) {
+                nd4j_debug("MemoryPlan: node [%i] produces output of unplanned shape, dropping memory plan\n", node->id());
+
+                _stale = true;
+                unbindFrom(_steps[node->id()], variableSpace);
+                return;
+            }
+
+            for (auto t: it->second)
+                _views[t]->nullify();
+        }
+
+        void MemoryPlan::detach(VariableSpace *variableSpace) {
+            for (int e = 0; e < (int) _views.size(); e++) {
+                if (!variableSpace->hasVariable(_tensors[e]))
+                    continue;
+
+                auto var = variableSpace->getVariable(_tensors[e]);
+                if (var->getNDArray() == _views[e])
+                    var->setNDArray(nullptr);
+            }
+        }
+
+        Nd4jLong MemoryPlan::arenaSize() {
+            return _arenaSize;
+        }
+
+        Nd4jLong MemoryPlan::naiveSize() {
+            return _naiveSize;
+        }
+
+        int MemoryPlan::numberOfTensors() {
+            return (int) _tensors.size();
+        }
+
+        Nd4jLong MemoryPlan::offset(int nodeId, int index) {
+            std::pair<int, int> pair(nodeId, index);
+            if (_positions.count(pair) == 0)
+                return -1L;
+
+            return _offsets[_positions[pair]];
+        }
+    }
+}
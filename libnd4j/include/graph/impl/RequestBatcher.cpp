@@ -0,0 +1,368 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <graph/RequestBatcher.h>
+#include <graph/GraphHolder.h>
+#include <GraphExecutioner.h>
+#include <ops/declarable/helpers/transforms.h>
+#include <graph/exceptions/graph_execution_exception.h>
+#include <graph/exceptions/no_results_exception.h>
+#include <helpers/logger.h>
+#include <chrono>
+#include <stdexcept>
+
+namespace nd4j {
+    namespace graph {
+        RequestBatcher::RequestBatcher(Nd4jLong graphId, int maxBatchSize, Nd4jLong maxDelay) {
+            if (maxBatchSize < 1)
+                throw std::invalid_argument("RequestBatcher: maxBatchSize must be positive");
+
+            if (maxDelay < 0)
+                throw std::invalid_argument("RequestBatcher: maxDelay can't be negative");
+
+            _graphId = graphId;
+            _maxBatchSize = maxBatchSize;
+            _maxDelay = maxDelay;
+
+            _executions.store(0L);
+            _requests.store(0L);
+        }
+
+        std::vector<Variable*>* RequestBatcher::execute(const std::vector<Variable*>& inputs) {
+            Ticket ticket;
+            ticket.inputs = &inputs;
+
+            std::unique_lock<std::mutex> lock(_mutex);
+            _queue.emplace_back(&ticket);
+            _condition.notify_all();
+
+            while (!ticket.done) {
+                // somebody else is collecting batch right now, or our request is already being executed
+                if (_leader || _queue.empty()) {
+                    _condition.wait(lock);
+                    continue;
+                }
+
+                _leader = true;
+
+                // requests pile up only while previous batch is executed, idle batcher flushes right away
+                auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(_maxDelay);
+                while ((int) _queue.size() < _maxBatchSize && _running > 0 && std::chrono::steady_clock::now() < deadline)
+                    _condition.wait_until(lock, deadline);
+
+                std::vector<Ticket*> batch;
+                while (!_queue.empty() && (int) batch.size() < _maxBatchSize) {
+                    batch.emplace_back(_queue.front());
+                    _queue.pop_front();
+                }
+
+                // next batch can be collected while this one is executed
+                _leader = false;
+                _running++;
+                _condition.notify_all();
+
+                // execution happens outside of the lock, so new requests can be queued meanwhile
+                lock.unlock();
+                executeBatch(batch);
+                lock.lock();
+
+                for (auto t: batch)
+                    t->done = true;
+
+                _running--;
+                _condition.notify_all();
+            }
+
+            lock.unlock();
+
+            if (ticket.error)
+                std::rethrow_exception(ticket.error);
+
+            return ticket.outputs;
+        }
+
+        bool RequestBatcher::isMergeable(std::vector<Ticket*>& batch) {
+            auto first = batch[0]->inputs;
+            if (first->empty())
+                return false;
+
+            for (auto t: batch) {
+                auto inputs = t->inputs;
+                if (inputs->size() != first->size())
+                    return false;
+
+                for (int e = 0; e < (int) inputs->size(); e++) {
+                    auto a = inputs->at(e);
+                    auto b = first->at(e);
+
+                    if (a->id() != b->id() || a->index() != b->index() || *a->getName() != *b->getName())
+                        return false;
+
+                    auto x = a->getNDArray();
+                    auto y = b->getNDArray();
+                    if (x == nullptr || y == nullptr || x->isEmpty() || y->isEmpty() || x->rankOf() < 1 || x->rankOf() != y->rankOf() || x->dataType() != y->dataType())
+                        return false;
+
+                    for (int i = 1; i < x->rankOf(); i++)
+                        if (x->sizeAt(i) != y->sizeAt(i))
+                            return false;
+
+                    // first input defines batch size of request
+                    if (x->sizeAt(0) != inputs->at(0)->getNDArray()->sizeAt(0))
+                        return false;
+                }
+            }
+
+            return true;
+        }
+
+        bool RequestBatcher::isSameResult(std::vector<Variable*>& a, std::vector<Variable*>& b) {
+            if (a.size() != b.size())
+                return false;
+
+            for (int e = 0; e < (int) a.size(); e++) {
+                auto x = a[e]->getNDArray();
+                auto y = b[e]->getNDArray();
+
+                if (x == nullptr || y == nullptr) {
+                    if (x != y)
+                        return false;
+
+                    continue;
+                }
+
+                if (!x->isSameShape(y) || x->dataType() != y->dataType() || !x->equalsTo(y))
+                    return false;
+            }
+
+            return true;
+        }
+
+        void RequestBatcher::release(std::vector<std::vector<Variable*>*>& results) {
+            for (auto r: results) {
+                for (auto v: *r)
+                    delete v;
+                delete r;
+            }
+
+            results.clear();
+        }
+
+        bool RequestBatcher::executeSession(const std::vector<Variable*>& inputs, const std::vector<Nd4jLong>& batchSizes, std::vector<std::vector<Variable*>*>& results) {
+            auto holder = GraphHolder::getInstance();
+
+            holder->lockRead(_graphId);
+            auto session = holder->acquireSession(_graphId);
+
+            bool split = true;
+            try {
+                // variables are wrapped, so arrays stay owned by caller
+                for (auto v: inputs) {
+                    auto name = v->getName() != nullptr && !v->getName()->empty() ? v->getName()->c_str() : nullptr;
+                    auto wrapper = new Variable(v->getNDArray(), name, v->id(), v->index());
+                    wrapper->markRemovable(false);
+                    session->getVariableSpace()->replaceVariable(wrapper);
+                }
+
+                auto status = GraphExecutioner::execute(session);
+                if (status != Status::OK())
+                    throw graph_execution_exception(_graphId);
+
+                auto outputs = session->fetchOutputs();
+                if (outputs->empty()) {
+                    delete outputs;
+                    throw no_results_exception(_graphId);
+                }
+
+                Nd4jLong total = 0L;
+                for (auto s: batchSizes)
+                    total += s;
+
+                for (auto v: *outputs)
+                    if (!batchSizes.empty() && (!v->hasNDArray() || v->getNDArray()->rankOf() < 1 || v->getNDArray()->sizeAt(0) != total))
+                        split = false;
+
+                if (split) {
+                    // results must outlive session, so they are detached from its buffers
+                    Nd4jLong offset = 0L;
+                    int numResults = batchSizes.empty() ? 1 : (int) batchSizes.size();
+                    for (int r = 0; r < numResults; r++) {
+                        auto result = new std::vector<Variable*>();
+
+                        for (auto v: *outputs) {
+                            NDArray* array = nullptr;
+                            if (v->hasNDArray()) {
+                                if (batchSizes.empty()) {
+                                    array = v->getNDArray()->dup();
+                                } else {
+                                    std::vector<Nd4jLong> idx(2 * v->getNDArray()->rankOf(), 0L);
+                                    idx[0] = offset;
+                                    idx[1] = offset + batchSizes[r];
+
+                                    auto view = (*v->getNDArray())(idx, true);
+                                    array = view.dup();
+                                }
+                            }
+
+                            auto name = v->getName() != nullptr && !v->getName()->empty() ? v->getName()->c_str() : nullptr;
+                            result->emplace_back(new Variable(array, name, v->id(), v->index()));
+                        }
+
+                        if (!batchSizes.empty())
+                            offset += batchSizes[r];
+
+                        results.emplace_back(result);
+                    }
+                }
+
+                delete outputs;
+            } catch (...) {
+                holder->releaseSession(_graphId, session);
+                holder->unlockRead(_graphId);
+                throw;
+            }
+
+            holder->releaseSession(_graphId, session);
+            holder->unlockRead(_graphId);
+
+            return split;
+        }
+
+        void RequestBatcher::executeBatch(std::vector<Ticket*>& batch) {
+            if (batch.empty())
+                return;
+
+            // number of leading requests served already
+            int served = 0;
+
+            if (batch.size() > 1 && !_unbatchable.load() && isMergeable(batch)) {
+                std::vector<Variable*> merged;
+                std::vector<Nd4jLong> batchSizes;
+                std::vector<std::vector<Variable*>*> results;
+
+                for (auto t: batch)
+                    batchSizes.emplace_back(t->inputs->at(0)->getNDArray()->sizeAt(0));
+
+                try {
+                    auto first = batch[0]->inputs;
+                    for (int e = 0; e < (int) first->size(); e++) {
+                        std::vector<NDArray*> arrays;
+                        Nd4jLong length = 0L;
+                        for (auto t: batch) {
+                            arrays.emplace_back(t->inputs->at(e)->getNDArray());
+                            length += arrays.back()->sizeAt(0);
+                        }
+
+                        auto shape = arrays[0]->getShapeAsVector();
+                        shape[0] = length;
+
+                        auto array = new NDArray('c', shape, arrays[0]->dataType());
+                        nd4j::ops::helpers::concat(arrays, *array, 0);
+
+                        auto v = first->at(e);
+                        auto name = v->getName() != nullptr && !v->getName()->empty() ? v->getName()->c_str() : nullptr;
+                        merged.emplace_back(new Variable(array, name, v->id(), v->index()));
+                    }
+
+                    bool split = executeSession(merged, batchSizes, results);
+                    _executions++;
+
+                    for (auto v: merged)
+                        delete v;
+                    merged.clear();
+
+                    // dimension 0 of outputs matching merged batch doesn't prove much, so first merged result is compared to separate execution
+                    std::vector<std::vector<Variable*>*> single;
+                    if (split && !_verified.load()) {
+                        executeSession(*batch[0]->inputs, std::vector<Nd4jLong>(), single);
+                        _executions++;
+
+                        if (isSameResult(*single[0], *results[0]))
+                            _verified.store(true);
+                        else
+                            split = false;
+                    }
+
+                    if (split) {
+                        release(single);
+
+                        for (int e = 0; e < (int) batch.size(); e++)
+                            batch[e]->outputs = results[e];
+
+                        _requests += batch.size();
+                        return;
+                    }
+
+                    _unbatchable.store(true);
+                    release(results);
+                    nd4j_debug("RequestBatcher: outputs of graph [%lld] aren't batch-major, executing requests one by one\n", _graphId);
+
+                    // first request was executed separately already
+                    if (!single.empty()) {
+                        batch[0]->outputs = single[0];
+                        _requests++;
+                        served = 1;
+                    }
+                } catch (...) {
+                    for (auto v: merged)
+                        delete v;
+
+                    release(results);
+
+                    // failure of merged execution is failure of every request in it
+                    for (auto t: batch)
+                        t->error = std::current_exception();
+
+                    return;
+                }
+            }
+
+            for (int e = served; e < (int) batch.size(); e++) {
+                auto t = batch[e];
+                try {
+                    std::vector<std::vector<Variable*>*> results;
+                    executeSession(*t->inputs, std::vector<Nd4jLong>(), results);
+                    t->outputs = results[0];
+
+                    _executions++;
+                    _requests++;
+                } catch (...) {
+                    t->error = std::current_exception();
+                }
+            }
+        }
+
+        Nd4jLong RequestBatcher::executions() {
+            return _executions.load();
+        }
+
+        Nd4jLong RequestBatcher::requests() {
+            return _requests.load();
+        }
+
+        int RequestBatcher::maxBatchSize() {
+            return _maxBatchSize;
+        }
+
+        Nd4jLong RequestBatcher::maxDelay() {
+            return _maxDelay;
+        }
+
+        bool RequestBatcher::isUnbatchable() {
+            return _unbatchable.load();
+        }
+    }
+}
@@ -35,7 +35,7 @@ namespace nd4j {
 
             result->markExternal(this->_external);
             result->setId(this->_id);
-            result->markReadOnly(this->_readOnly);
+            result->markReadOnly(this->_readOnly && !this->_flatView);
             result->setName(&this->_name);
             result->setIndex(this->_index);
 
@@ -56,7 +56,8 @@ namespace nd4j {
             auto result = new Variable(this->isPlaceholder());
             result->_external = this->_external;
             result->_id = this->_id;
-            result->_readOnly = this->_readOnly;
+            // clone gets its own copy of array, so FlatBuffer view restrictions don't apply to it
+            result->_readOnly = this->_readOnly && !this->_flatView;
             result->_name = this->_name;
             result->_index = this->_index;
 
@@ -189,7 +190,21 @@ namespace nd4j {
         }
 
         
-        nd4j::graph::Variable::Variable(const nd4j::graph::FlatVariable *flatVariable) {
+        static NDArray* restoreFlatArray(const nd4j::graph::FlatArray *flatArray, bool zeroCopy, bool &isView) {
+            if (zeroCopy) {
+                auto view = nd4j::graph::FlatUtils::viewFlatArray(flatArray);
+                if (view != nullptr) {
+                    isView = true;
+                    return view;
+                }
+            }
+
+            auto array = nd4j::graph::FlatUtils::fromFlatArray(flatArray);
+            array->triggerAllocationFlag(true, true);
+            return array;
+        }
+
+        nd4j::graph::Variable::Variable(const nd4j::graph::FlatVariable *flatVariable, bool zeroCopy) {
             auto vid = flatVariable->id();
             this->_id = vid->first();
             this->_index = vid->second();
@@ -206,11 +221,8 @@ namespace nd4j {
                 case VarType_VARIABLE: {
 
                         // ?????
-                        if (flatVariable->ndarray() != nullptr) {
-                            auto ar = flatVariable->ndarray();
-                            _ndarray = nd4j::graph::FlatUtils::fromFlatArray(ar);
-                            _ndarray->triggerAllocationFlag(true, true);
-                        }
+                        if (flatVariable->ndarray() != nullptr)
+                            _ndarray = restoreFlatArray(flatVariable->ndarray(), zeroCopy, _flatView);
 
                         _variableType = VariableType::NDARRAY;
                     }
@@ -219,13 +231,7 @@ namespace nd4j {
                         if (flatVariable->ndarray() == nullptr)
                             throw std::runtime_error("CONSTANT variable must have NDArray bundled");
 
-                        auto ar = flatVariable->ndarray();
-                        if (ar->dtype() == DataType_UTF8) {
-                            _ndarray = nd4j::graph::FlatUtils::fromFlatArray(ar);
-                        } else {
-                            _ndarray = nd4j::graph::FlatUtils::fromFlatArray(ar);
-                        }
-                        _ndarray->triggerAllocationFlag(true, true);
+                        _ndarray = restoreFlatArray(flatVariable->ndarray(), zeroCopy, _flatView);
 
                         _variableType = VariableType::NDARRAY;
                     }
@@ -233,11 +239,8 @@ namespace nd4j {
                 case VarType_ARRAY: {
 
                         // ?????
-                        if (flatVariable->ndarray() != nullptr) {
-                            auto ar = flatVariable->ndarray();
-                            _ndarray = nd4j::graph::FlatUtils::fromFlatArray(ar);
-                            _ndarray->triggerAllocationFlag(true, true);
-                        }
+                        if (flatVariable->ndarray() != nullptr)
+                            _ndarray = restoreFlatArray(flatVariable->ndarray(), zeroCopy, _flatView);
 
                         _variableType = VariableType::NDARRAY;
                     }
@@ -247,10 +250,7 @@ namespace nd4j {
                             throw std::runtime_error("PLACEHOLDER variable must have shape defined");
 
                         if (flatVariable->ndarray() != nullptr) {
-                            auto ar = flatVariable->ndarray();
-                            _ndarray = nd4j::graph::FlatUtils::fromFlatArray(ar);
-                            _ndarray->triggerAllocationFlag(true, true);
-
+                            _ndarray = restoreFlatArray(flatVariable->ndarray(), zeroCopy, _flatView);
                             _variableType = VariableType::NDARRAY;
                         }
 
@@ -267,6 +267,9 @@ namespace nd4j {
                 default:
                     throw std::runtime_error("Unknown variable type used");
             }
+
+            // views of FlatBuffer memory can't be written to
+            _readOnly = _flatView;
         }
 
         std::vector<Nd4jLong>& nd4j::graph::Variable::shape() {
@@ -302,7 +305,7 @@ namespace nd4j {
             //nd4j_printf("Removing variable [%i:%i]\n", _id, _index);
             if (_variableType == VariableType::NDARRAY) {
                 nd4j_debug("Removing variable <%i:%i>\n", _id, _index);
-                if (_ndarray != nullptr && _removable && !_readOnly)
+                if (_ndarray != nullptr && _removable && (!_readOnly || _flatView))
                     delete _ndarray;
             }
         }
@@ -317,12 +320,9 @@ namespace nd4j {
         flatbuffers::Offset<FlatVariable> Variable::asFlatVariable(flatbuffers::FlatBufferBuilder &builder) {
             if (this->hasNDArray()) {
                 auto array = this->getNDArray();
-                auto fShape = builder.CreateVector(array->getShapeInfoAsFlatVector());
-
-                auto fBuffer = builder.CreateVector(array->asByteVector());
 
                 // packing array
-                auto fArray = CreateFlatArray(builder, fShape, fBuffer, (nd4j::graph::DataType) array->dataType());
+                auto fArray = FlatUtils::toFlatArray(builder, *array);
 
                 // packing id/index of this var
                 auto fVid = CreateIntPair(builder, this->_id, this->_index);
@@ -37,6 +37,12 @@ namespace nd4j {
             delete _current;
         }
 
+
+        void VariableProxy::reset() {
+            delete _current;
+            _current = new VariableSpace();
+        }
+
         
         int VariableProxy::numberOfPlaceholders() {
             return _backed->numberOfPlaceholders();
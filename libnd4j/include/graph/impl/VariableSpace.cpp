@@ -339,6 +339,20 @@ namespace nd4j {
             return &_workspace;
         }
 
+        nd4j::memory::Workspace * nd4j::graph::VariableSpace::workerWorkspace(int worker) {
+            if (worker < 1)
+                return workspace();
+
+            std::lock_guard<std::mutex> lock(_varmap);
+            if ((int) _workerWorkspaces.size() < worker)
+                _workerWorkspaces.resize(worker, nullptr);
+
+            if (_workerWorkspaces[worker - 1] == nullptr)
+                _workerWorkspaces[worker - 1] = new nd4j::memory::Workspace();
+
+            return _workerWorkspaces[worker - 1];
+        }
+
         std::vector<Variable*>* nd4j::graph::VariableSpace::handles() {
             return _handles;
         }
@@ -369,6 +383,10 @@ namespace nd4j {
                 NativeOps nativeOps;
                 nativeOps.destroyRandom(_rng);
             }
+
+            // arrays living in these workspaces were released above
+            for (auto w: _workerWorkspaces)
+                delete w;
         }
 
         VariableSpace& VariableSpace::operator=(const VariableSpace& other) {
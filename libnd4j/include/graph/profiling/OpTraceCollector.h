@@ -0,0 +1,196 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_OPTRACECOLLECTOR_H
+#define LIBND4J_OPTRACECOLLECTOR_H
+
+#include <pointercast.h>
+#include <dll.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace nd4j {
+    class NDArray;
+
+    namespace graph {
+        /**
+         * Single op execution
+         */
+        struct ND4J_EXPORT OpTraceEvent {
+            std::string name;
+
+            // input and output shapes, i.e. "float32[2,3] float32[3] -> float32[2,3]"
+            std::string shapes;
+
+            // graph node id, 0 for standalone op calls
+            int nodeId = 0;
+
+            // sequential id of thread op was called from, assigned by collector
+            int threadId = 0;
+
+            // start time, in ns since collector creation
+            Nd4jLong startTime = 0L;
+
+            // wall time and process CPU time spent in op, ns. CPU time is only measured if op didn't overlap with other ops
+            Nd4jLong duration = 0L;
+            Nd4jLong cpuTime = 0L;
+
+            // true if other ops were running at the same time, so CPU time couldn't be attributed to this op
+            bool concurrent = false;
+
+            Nd4jLong bytesRead = 0L;
+            Nd4jLong bytesWritten = 0L;
+
+            // estimated number of floating point operations
+            Nd4jLong flops = 0L;
+
+            // bytes op had to take from workspace spills
+            Nd4jLong spills = 0L;
+
+            // max number of threads op could use. Number of cores actually busy is cpuTime / duration
+            int maxThreads = 1;
+        };
+
+        /**
+         * Executions of the same op with the same shapes, aggregated
+         */
+        struct ND4J_EXPORT OpTraceStats {
+            std::string name;
+            std::string shapes;
+
+            Nd4jLong count = 0L;
+            Nd4jLong totalTime = 0L;
+            Nd4jLong minTime = 0L;
+            Nd4jLong maxTime = 0L;
+            Nd4jLong cpuTime = 0L;
+            Nd4jLong bytesRead = 0L;
+            Nd4jLong bytesWritten = 0L;
+            Nd4jLong flops = 0L;
+            Nd4jLong spills = 0L;
+
+            // wall time of executions that didn't overlap with other ops, i.e. the ones cpuTime was measured for
+            Nd4jLong exclusiveTime = 0L;
+
+            // GB/s achieved over all executions
+            double bandwidth() const;
+
+            // GFLOP/s achieved over all executions
+            double flopRate() const;
+
+            // average number of busy cores, as CPU time / wall time of non-overlapping executions. 0 if all executions overlapped
+            double parallelism() const;
+        };
+
+        /**
+         * This class brackets single traced op execution.
+         *
+         * Ops spread work over OpenMP or ThreadPool workers, so their CPU time can only be read from process-wide clock, which also
+         * counts every other op running at the same time. Scope counts ops in flight, and tells if any other op overlapped with this
+         * one. Nested op calls made by the same thread don't count as overlap. CPU time spent by threads outside of ops
+         * (e.g. JVM threads) is still counted.
+         */
+        class ND4J_EXPORT OpTraceScope {
+        private:
+            Nd4jLong _generation;
+            bool _alone;
+            bool _outer;
+        public:
+            OpTraceScope();
+            ~OpTraceScope();
+
+            /**
+             * This method returns true if no other op was running since this scope was created
+             */
+            bool isExclusive() const;
+        };
+
+        /**
+         * This class collects per-op counters for every DeclarableOp execution, graph nodes and standalone calls alike, while
+         * Environment::isOpTracing() is enabled. When tracing is disabled ops only pay for a single flag check.
+         *
+         * Collected events can be exported as Chrome trace-event JSON (chrome://tracing, Perfetto), and are aggregated by op name and shapes
+         */
+        class ND4J_EXPORT OpTraceCollector {
+        private:
+            // max number of stored events. Events beyond that are still aggregated, but not stored
+            static const Nd4jLong MAX_EVENTS = 1L << 20;
+
+            std::chrono::time_point<std::chrono::steady_clock> _epoch;
+
+            std::mutex _lock;
+            std::vector<OpTraceEvent> _events;
+            std::map<std::pair<std::string, std::string>, OpTraceStats> _stats;
+            std::map<std::thread::id, int> _threads;
+            Nd4jLong _dropped = 0L;
+
+            // ops in flight in low 16 bits, number of started ops in high bits. Updated by OpTraceScope
+            std::atomic<uint64_t> _ops;
+
+            friend class OpTraceScope;
+
+            OpTraceCollector();
+            ~OpTraceCollector() = default;
+        public:
+            static OpTraceCollector* getInstance();
+
+            /**
+             * This method returns current time in ns since collector creation
+             */
+            Nd4jLong now() const;
+
+            /**
+             * This method stores event and updates aggregated counters. Thread id is assigned here
+             */
+            void record(OpTraceEvent &event);
+
+            /**
+             * This method returns aggregated counters, slowest ops first
+             */
+            std::vector<OpTraceStats> summary();
+
+            /**
+             * This method returns stored events as Chrome trace-event JSON
+             */
+            std::string asChromeTrace();
+
+            /**
+             * This method writes Chrome trace-event JSON to given file. Throws std::runtime_error if file can't be written
+             */
+            void exportChromeTrace(const char *path);
+
+            Nd4jLong numberOfEvents();
+
+            void reset();
+
+            void printOut();
+
+            /**
+             * This method returns estimated number of floating point operations for given op: 2*M*N*K for matmul, 2 * output * receptive field for conv2d,
+             * and max(input, output) elements for everything else
+             *
+             * @param iArgs - integer arguments of op, used to tell if matmul output is transposed
+             */
+            static Nd4jLong estimateFlops(const std::string &opName, const std::vector<NDArray*> &inputs, const std::vector<NDArray*> &outputs, const std::vector<int> &iArgs = {});
+        };
+    }
+}
+
+#endif //LIBND4J_OPTRACECOLLECTOR_H
@@ -0,0 +1,281 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <graph/profiling/OpTraceCollector.h>
+#include <helpers/logger.h>
+#include <NDArray.h>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace nd4j {
+    namespace graph {
+
+        double OpTraceStats::bandwidth() const {
+            // bytes per ns is the same as GB/s
+            return totalTime > 0 ? static_cast<double>(bytesRead + bytesWritten) / totalTime : 0.0;
+        }
+
+        double OpTraceStats::flopRate() const {
+            return totalTime > 0 ? static_cast<double>(flops) / totalTime : 0.0;
+        }
+
+        double OpTraceStats::parallelism() const {
+            return exclusiveTime > 0 ? static_cast<double>(cpuTime) / exclusiveTime : 0.0;
+        }
+
+        // nesting depth of traced ops in current thread, only outermost op counts as op in flight
+        static thread_local int traceDepth = 0;
+
+        static const uint64_t TRACE_IN_FLIGHT_MASK = 0xFFFFULL;
+        static const uint64_t TRACE_GENERATION = 1ULL << 16;
+
+        OpTraceScope::OpTraceScope() {
+            auto &ops = OpTraceCollector::getInstance()->_ops;
+            _outer = traceDepth++ == 0;
+
+            if (_outer) {
+                // single atomic update, so op in flight and op started during our execution can't both slip past us
+                auto previous = ops.fetch_add(TRACE_GENERATION + 1);
+                _alone = (previous & TRACE_IN_FLIGHT_MASK) == 0;
+                _generation = static_cast<Nd4jLong>(previous / TRACE_GENERATION) + 1;
+            } else {
+                // outer op of this thread is in flight too
+                auto current = ops.load();
+                _alone = (current & TRACE_IN_FLIGHT_MASK) == 1;
+                _generation = static_cast<Nd4jLong>(current / TRACE_GENERATION);
+            }
+        }
+
+        OpTraceScope::~OpTraceScope() {
+            traceDepth--;
+
+            if (_outer)
+                OpTraceCollector::getInstance()->_ops.fetch_sub(1);
+        }
+
+        bool OpTraceScope::isExclusive() const {
+            auto current = OpTraceCollector::getInstance()->_ops.load();
+            return _alone && static_cast<Nd4jLong>(current / TRACE_GENERATION) == _generation;
+        }
+
+        // op names and shapes don't have anything but quotes and backslashes to worry about
+        static std::string escapeJson(const std::string &value) {
+            std::string result;
+            result.reserve(value.size());
+
+            for (auto c: value) {
+                if (c == '"' || c == '\\')
+                    result += '\\';
+
+                result += c;
+            }
+
+            return result;
+        }
+
+        OpTraceCollector::OpTraceCollector() {
+            _epoch = std::chrono::steady_clock::now();
+            _ops = 0;
+        }
+
+        OpTraceCollector* OpTraceCollector::getInstance() {
+            static OpTraceCollector* instance = new OpTraceCollector();
+            return instance;
+        }
+
+        Nd4jLong OpTraceCollector::now() const {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _epoch).count();
+        }
+
+        void OpTraceCollector::record(OpTraceEvent &event) {
+            std::lock_guard<std::mutex> lock(_lock);
+
+            auto tid = std::this_thread::get_id();
+            auto t = _threads.find(tid);
+            if (t == _threads.end())
+                t = _threads.emplace(tid, static_cast<int>(_threads.size())).first;
+
+            event.threadId = t->second;
+
+            auto &stats = _stats[std::make_pair(event.name, event.shapes)];
+            if (stats.count == 0) {
+                stats.name = event.name;
+                stats.shapes = event.shapes;
+                stats.minTime = event.duration;
+                stats.maxTime = event.duration;
+            }
+
+            stats.count++;
+            stats.totalTime += event.duration;
+            stats.minTime = std::min(stats.minTime, event.duration);
+            stats.maxTime = std::max(stats.maxTime, event.duration);
+            if (!event.concurrent) {
+                stats.cpuTime += event.cpuTime;
+                stats.exclusiveTime += event.duration;
+            }
+
+            stats.bytesRead += event.bytesRead;
+            stats.bytesWritten += event.bytesWritten;
+            stats.flops += event.flops;
+            stats.spills += event.spills;
+
+            if (static_cast<Nd4jLong>(_events.size()) < MAX_EVENTS)
+                _events.emplace_back(event);
+            else
+                _dropped++;
+        }
+
+        std::vector<OpTraceStats> OpTraceCollector::summary() {
+            std::vector<OpTraceStats> result;
+            {
+                std::lock_guard<std::mutex> lock(_lock);
+                for (auto &v: _stats)
+                    result.emplace_back(v.second);
+            }
+
+            std::sort(result.begin(), result.end(), [](const OpTraceStats &a, const OpTraceStats &b) -> bool {
+                return a.totalTime > b.totalTime;
+            });
+
+            return result;
+        }
+
+        std::string OpTraceCollector::asChromeTrace() {
+            std::lock_guard<std::mutex> lock(_lock);
+
+            std::ostringstream out;
+            out.precision(3);
+            out << std::fixed;
+            out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+            bool first = true;
+            for (auto &e: _events) {
+                if (!first)
+                    out << ",";
+
+                first = false;
+
+                // complete events, timestamps are in microseconds
+                out << "\n{\"name\":\"" << escapeJson(e.name) << "\",\"cat\":\"op\",\"ph\":\"X\",\"pid\":0,\"tid\":" << e.threadId
+                    << ",\"ts\":" << e.startTime / 1000.0 << ",\"dur\":" << e.duration / 1000.0
+                    << ",\"args\":{\"node\":" << e.nodeId
+                    << ",\"shapes\":\"" << escapeJson(e.shapes) << "\""
+                    << ",\"bytes_read\":" << e.bytesRead
+                    << ",\"bytes_written\":" << e.bytesWritten
+                    << ",\"flops\":" << e.flops
+                    << ",\"gbps\":" << (e.duration > 0 ? static_cast<double>(e.bytesRead + e.bytesWritten) / e.duration : 0.0)
+                    << ",\"gflops\":" << (e.duration > 0 ? static_cast<double>(e.flops) / e.duration : 0.0)
+                    << ",\"spills\":" << e.spills
+                    << ",\"max_threads\":" << e.maxThreads
+                    << ",\"concurrent\":" << (e.concurrent ? "true" : "false");
+
+                // CPU time of overlapping ops can't be told apart
+                if (!e.concurrent)
+                    out << ",\"parallelism\":" << (e.duration > 0 ? static_cast<double>(e.cpuTime) / e.duration : 0.0);
+
+                out << "}}";
+            }
+
+            out << "\n],\"otherData\":{\"dropped_events\":" << _dropped << "}}\n";
+
+            return out.str();
+        }
+
+        void OpTraceCollector::exportChromeTrace(const char *path) {
+            std::ofstream file(path, std::ios::out | std::ios::trunc);
+            if (!file.good()) {
+                nd4j_printf("Can't open file [%s] for trace export\n", path);
+                throw std::runtime_error("Can't open file for trace export");
+            }
+
+            file << asChromeTrace();
+            if (!file.good())
+                throw std::runtime_error("Failed to write trace file");
+        }
+
+        Nd4jLong OpTraceCollector::numberOfEvents() {
+            std::lock_guard<std::mutex> lock(_lock);
+            return static_cast<Nd4jLong>(_events.size()) + _dropped;
+        }
+
+        void OpTraceCollector::reset() {
+            std::lock_guard<std::mutex> lock(_lock);
+            _events.clear();
+            _stats.clear();
+            _threads.clear();
+            _dropped = 0L;
+        }
+
+        void OpTraceCollector::printOut() {
+            auto stats = summary();
+
+            nd4j_printf("Op trace: %lld executions of %i distinct op/shape pairs\n", numberOfEvents(), (int) stats.size());
+            for (auto &s: stats) {
+                nd4j_printf("%s %s: CNT: %lld; TTL: %lld ns; AVG: %lld ns; MIN: %lld ns; MAX: %lld ns; %.3f GB/s; %.3f GFLOP/s; PAR: %.2f; SPILLS: %lld;\n",
+                            s.name.c_str(), s.shapes.c_str(), s.count, s.totalTime, s.totalTime / s.count, s.minTime, s.maxTime,
+                            s.bandwidth(), s.flopRate(), s.parallelism(), s.spills);
+            }
+        }
+
+        Nd4jLong OpTraceCollector::estimateFlops(const std::string &opName, const std::vector<NDArray*> &inputs, const std::vector<NDArray*> &outputs, const std::vector<int> &iArgs) {
+            Nd4jLong inLength = 0L;
+            Nd4jLong outLength = 0L;
+
+            for (auto v: inputs)
+                if (v != nullptr)
+                    inLength += v->lengthOf();
+
+            for (auto v: outputs)
+                if (v != nullptr)
+                    outLength += v->lengthOf();
+
+            if (inputs.size() >= 2 && !outputs.empty() && inputs[0] != nullptr && inputs[1] != nullptr && outputs[0] != nullptr && outputs[0]->lengthOf() > 0) {
+                auto z = outputs[0];
+
+                if (opName == "matmul" || opName == "fused_matmul" || opName == "mmul") {
+                    // x holds batch * M * K elements, z holds batch * M * N (batch * N * M if transZ), so K doesn't depend on transX/transY
+                    const bool transZ = iArgs.size() > 2 && iArgs[2] != 0;
+
+                    // vector z is either [M] for matrix x, or [N] for vector x
+                    Nd4jLong n = 1;
+                    if (z->rankOf() >= 2)
+                        n = z->sizeAt(transZ ? -2 : -1);
+                    else if (inputs[0]->rankOf() <= 1)
+                        n = z->lengthOf();
+
+                    auto rows = z->lengthOf() / n;
+                    auto k = rows > 0 ? inputs[0]->lengthOf() / rows : 0;
+
+                    return 2 * z->lengthOf() * k;
+                }
+
+                if (opName == "conv2d" && inputs[1]->rankOf() == 4) {
+                    // weights are [kH, kW, iC, oC], every output element takes kH * kW * iC multiply-adds
+                    return 2 * z->lengthOf() * (inputs[1]->lengthOf() / inputs[1]->sizeAt(3));
+                }
+
+                if (opName == "depthwise_conv2d" && inputs[1]->rankOf() == 4) {
+                    // weights are [kH, kW, iC, mC], every output element takes kH * kW multiply-adds
+                    return 2 * z->lengthOf() * inputs[1]->sizeAt(0) * inputs[1]->sizeAt(1);
+                }
+            }
+
+            return std::max(inLength, outLength);
+        }
+    }
+}
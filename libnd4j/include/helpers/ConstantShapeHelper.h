@@ -0,0 +1,115 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef DEV_TESTS_CONSTANTSHAPEHELPER_H
+#define DEV_TESTS_CONSTANTSHAPEHELPER_H
+
+#include <dll.h>
+#include <pointercast.h>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <array/DataType.h>
+#include <array/ShapeDescriptor.h>
+
+namespace nd4j {
+    /**
+     * This class interns shapeInfo buffers: equal shapes are represented by the same immutable buffer,
+     * so arrays sharing a shape don't allocate shape metadata, and equal shapes can be compared by pointer.
+     *
+     * Entries are never removed, so returned pointers stay valid for the lifetime of the process,
+     * and must never be modified or released. To keep memory bounded, cache stops accepting new shapes
+     * once it holds cacheLimit() entries; methods return nullptr then, and caller is expected to allocate its own shapeInfo.
+     *
+     * Just like ConstantTadHelper, cache is split into shards by hash, lookups are lock-free, and shard mutex
+     * is taken only when new shape is added.
+     */
+    class ND4J_EXPORT ConstantShapeHelper {
+    private:
+        static ConstantShapeHelper *_INSTANCE;
+
+        // both values must be powers of 2
+        static const int SHARDS = 32;
+        static const int BUCKETS = 256;
+
+        class ShapeEntry {
+        public:
+            Nd4jLong *shapeInfo;
+            Nd4jLong hash;
+            ShapeEntry *next = nullptr;
+
+            ShapeEntry(const Nd4jLong *original, Nd4jLong h);
+            ~ShapeEntry();
+        };
+
+        class ShapeShard {
+        public:
+            std::mutex mutex;
+            std::atomic<ShapeEntry*> buckets[BUCKETS];
+            std::atomic<Nd4jLong> hits;
+            std::atomic<Nd4jLong> misses;
+
+            ShapeShard();
+        };
+
+        ShapeShard _shards[SHARDS];
+
+        std::atomic<Nd4jLong> _size;
+        std::atomic<Nd4jLong> _limit;
+
+        ConstantShapeHelper();
+
+        static Nd4jLong hash(const Nd4jLong *shapeInfo);
+    public:
+        ~ConstantShapeHelper();
+
+        static ConstantShapeHelper* getInstance();
+
+        /**
+         * This method returns interned copy of given shapeInfo, or nullptr if cache is full
+         */
+        Nd4jLong* intern(const Nd4jLong *shapeInfo);
+
+        /**
+         * These methods return interned shapeInfo for given shape, or nullptr if cache is full
+         */
+        Nd4jLong* bufferForShapeInfo(ShapeDescriptor &descriptor);
+        Nd4jLong* createShapeInfo(const nd4j::DataType dataType, const char order, const std::vector<Nd4jLong> &shape);
+        Nd4jLong* createShapeInfo(const nd4j::DataType dataType, const char order, const int rank, const Nd4jLong *shape);
+        Nd4jLong* scalarShapeInfo(const nd4j::DataType dataType);
+
+        /**
+         * This method checks if given pointer is interned shapeInfo
+         */
+        bool isInterned(const Nd4jLong *shapeInfo);
+
+        /**
+         * These methods return cache statistics: number of lookups served from cache, number of lookups that had to add shape
+         * (or were rejected because cache is full), and number of cached shapes
+         */
+        Nd4jLong cacheHits();
+        Nd4jLong cacheMisses();
+        Nd4jLong cacheSize();
+
+        /**
+         * Maximal number of cached shapes. Lowering the limit doesn't release shapes already cached.
+         */
+        Nd4jLong cacheLimit();
+        void setCacheLimit(Nd4jLong limit);
+    };
+}
+
+#endif //DEV_TESTS_CONSTANTSHAPEHELPER_H
@@ -27,22 +27,55 @@
 #include <map>
 #include <vector>
 #include <mutex>
+#include <atomic>
 #include <array/ShapeDescriptor.h>
 #include <array/TadDescriptor.h>
 #include <array/DataBuffer.h>
 #include <array/TadPack.h>
 
 namespace nd4j {
+    /**
+     * This class caches TadPacks for shape/dimensions combinations.
+     *
+     * Cache is split into shards by precomputed TadDescriptor hash. Entries are never removed, so lookups traverse
+     * bucket chains without any locks, and shard mutex is taken only when new TadPack is built.
+     */
     class ND4J_EXPORT ConstantTadHelper {
     private:
         static ConstantTadHelper *_INSTANCE;
 
-        std::mutex _mutex;
-        std::vector<std::map<TadDescriptor, TadPack>> _cache;
+        // both values must be powers of 2
+        static const int SHARDS = 64;
+        static const int BUCKETS = 128;
 
-        ConstantTadHelper();
+        class TadEntry {
+        public:
+            TadDescriptor descriptor;
+            TadPack pack;
+            Nd4jLong hash;
+            TadEntry *next = nullptr;
+
+            TadEntry(TadDescriptor &d, TadPack &p) : descriptor(d), pack(p) {
+                hash = d.hash();
+            }
+        };
+
+        class TadShard {
+        public:
+            std::mutex mutex;
+            std::atomic<TadEntry*> buckets[BUCKETS];
+            std::atomic<Nd4jLong> hits;
+            std::atomic<Nd4jLong> misses;
+            std::atomic<Nd4jLong> size;
+
+            TadShard();
+        };
+
+        TadShard _shards[SHARDS];
+
+        ConstantTadHelper() = default;
     public:
-        ~ConstantTadHelper() = default;
+        ~ConstantTadHelper();
 
         static ConstantTadHelper* getInstance();
 
@@ -51,6 +84,13 @@ namespace nd4j {
         TadPack& tadForDimensions(Nd4jLong *originalShape, int dimensions, const bool keepUnitiesInShape = false);
         TadPack& tadForDimensions(ShapeDescriptor &descriptor, std::vector<int> &dimensions, const bool keepUnitiesInShape = false);
         TadPack& tadForDimensions(TadDescriptor &descriptor);
+
+        /**
+         * These methods return cache statistics: number of lookups served from cache, number of TadPacks built, and number of cached TadPacks
+         */
+        Nd4jLong cacheHits();
+        Nd4jLong cacheMisses();
+        Nd4jLong cacheSize();
     };
 }
 
@@ -0,0 +1,48 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_CPUFEATURES_H
+#define LIBND4J_CPUFEATURES_H
+
+#include <dll.h>
+
+namespace nd4j {
+    /**
+     * Instruction set levels CPU loops can be dispatched to
+     */
+    enum IsaLevel {
+        ISA_GENERIC = 0,
+        ISA_AVX2 = 1,
+        ISA_AVX512 = 2,
+    };
+
+    class ND4J_EXPORT CpuFeatures {
+    public:
+        /**
+         * This method returns best ISA level supported by both current CPU and OS
+         */
+        static int detectIsaLevel();
+
+        /**
+         * This method returns ISA level for given name (generic, avx2, avx512), or -1 if name is unknown
+         */
+        static int isaLevelByName(const char *name);
+
+        static const char* isaName(int level);
+    };
+}
+
+#endif //LIBND4J_CPUFEATURES_H
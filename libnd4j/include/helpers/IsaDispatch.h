@@ -0,0 +1,114 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_ISADISPATCH_H
+#define LIBND4J_ISADISPATCH_H
+
+#include <op_boilerplate.h>
+#include <Environment.h>
+#include <helpers/CpuFeatures.h>
+
+// function multiversioning is available for GCC/Clang on x86 only
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !defined(__CUDACC__) && !defined(__JAVACPP_HACK__) && !defined(ANDROID)
+#define ND4J_ISA_DISPATCH
+#define ND4J_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define ND4J_TARGET_AVX512 __attribute__((target("avx512f")))
+#endif
+
+namespace nd4j {
+
+    /**
+     * This class compiles given Kernel for every supported ISA level, and calls the one selected by Environment::isaLevel().
+     * Kernel::run must be inlineable, so its body gets vectorized for each target separately.
+     * Only loops that vectorize belong here: strict sequential loops (i.e. FP reductions) gain nothing from wider registers.
+     */
+    template <typename Kernel>
+    class IsaDispatch {
+    public:
+#ifdef ND4J_ISA_DISPATCH
+        template <typename... Args>
+        ND4J_TARGET_AVX2 static void avx2(Args... args) {
+            Kernel::run(args...);
+        }
+
+        template <typename... Args>
+        ND4J_TARGET_AVX512 static void avx512(Args... args) {
+            Kernel::run(args...);
+        }
+#endif
+
+        /**
+         * This method calls Kernel compiled for given ISA level. Loops over many short chunks (i.e. TADs) should
+         * fetch level once, and use this method instead of run()
+         */
+        template <typename... Args>
+        static FORCEINLINE void runFor(int isaLevel, Args... args) {
+#ifdef ND4J_ISA_DISPATCH
+            switch (isaLevel) {
+                case ISA_AVX512:
+                    avx512(args...);
+                    return;
+                case ISA_AVX2:
+                    avx2(args...);
+                    return;
+                default:
+                    break;
+            }
+#endif
+            Kernel::run(args...);
+        }
+
+        template <typename... Args>
+        static FORCEINLINE void run(Args... args) {
+            runFor(Environment::getInstance()->isaLevel(), args...);
+        }
+    };
+
+    // z = op(x), contiguous buffers
+    template <typename X, typename Z, typename E, typename OpType>
+    class TransformKernel {
+    public:
+        static FORCEINLINE void run(X *x, Z *z, E *extraParams, unsigned int length) {
+            PRAGMA_OMP_SIMD
+            for (unsigned int i = 0; i < length; i++)
+                z[i] = OpType::op(x[i], extraParams);
+        }
+    };
+
+    // z = op(x, y), contiguous buffers
+    template <typename X, typename Y, typename Z, typename OpType>
+    class PairwiseKernel {
+    public:
+        static FORCEINLINE void run(X *x, Y *y, Z *z, Z *extraParams, unsigned int length) {
+            PRAGMA_OMP_SIMD
+            for (unsigned int i = 0; i < length; i++)
+                z[i] = OpType::op(x[i], y[i], extraParams);
+        }
+    };
+
+    // z = op(x, scalar), contiguous buffers
+    template <typename X, typename Y, typename Z, typename OpType>
+    class ScalarKernel {
+    public:
+        static FORCEINLINE void run(X *x, Y scalar, Z *z, Z *extraParams, unsigned int length) {
+            PRAGMA_OMP_SIMD
+            for (unsigned int i = 0; i < length; i++)
+                z[i] = OpType::op(x[i], scalar, extraParams);
+        }
+    };
+}
+
+#endif //LIBND4J_ISADISPATCH_H
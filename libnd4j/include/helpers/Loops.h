@@ -26,11 +26,13 @@
 #include <shape.h>
 #include <LoopKind.h>
 #include <OmpLaunchHelper.h>
+#include <helpers/ThreadPool.h>
 #include <DataTypeUtils.h>
 #include <ops.h>
 #include <indexreduce.h>
 #include <helpers/ConstantTadHelper.h>
 #include <openmp_pragmas.h>
+#include <helpers/IsaDispatch.h>
 
 namespace nd4j {
 
@@ -603,19 +605,11 @@ void Loops::loopXYZ(const X* x, const Nd4jLong* xShapeInfo,
             //*********************************************//
             case LoopKind::EWS1: {
 
-                PRAGMA_OMP_PARALLEL_THREADS(threadsInfo._numThreads)
-                {
-                    const auto threadNum = omp_get_thread_num();
-                    const auto threadOffset = threadsInfo.getThreadOffset(threadNum);
-                    const auto lenPerThread = static_cast<uint>(threadsInfo.getItersPerThread(threadNum));
-
-                    const auto xi = x + threadOffset;
-                    const auto zi = z + threadOffset;
+                Threads::parallel_for([&](Nd4jLong start, Nd4jLong stop) {
+                    const auto chunkLen = static_cast<uint>(stop - start);
 
-                    PRAGMA_OMP_SIMD
-                    for (uint i = 0; i < lenPerThread; i++)
-                        zi[i] = OpType::op(xi[i], extraParams);
-                }
+                    IsaDispatch<TransformKernel<X, Z, E, OpType>>::run(x + start, z + start, extraParams, chunkLen);
+                }, 0, len, 0, threadsInfo._numThreads);
             }
                 break;
 
@@ -624,19 +618,16 @@ void Loops::loopXYZ(const X* x, const Nd4jLong* xShapeInfo,
                 const uint xEws = shape::elementWiseStride(xShapeInfo);
                 const uint zEws = shape::elementWiseStride(zShapeInfo);
 
-                PRAGMA_OMP_PARALLEL_THREADS(threadsInfo._numThreads)
-                {
-                    const auto threadNum = omp_get_thread_num();
-                    const auto threadOffset = threadsInfo.getThreadOffset(threadNum);
-                    const auto lenPerThread = static_cast<uint>(threadsInfo.getItersPerThread(threadNum));
+                Threads::parallel_for([&](Nd4jLong start, Nd4jLong stop) {
+                    const auto chunkLen = static_cast<uint>(stop - start);
 
-                    const auto xi = x + threadOffset * xEws;
-                    auto zi = z + threadOffset * zEws;
+                    const auto xi = x + start * xEws;
+                    auto zi = z + start * zEws;
 
                     PRAGMA_OMP_SIMD
-                    for (uint i = 0; i < lenPerThread; i++)
+                    for (uint i = 0; i < chunkLen; i++)
                         zi[i*zEws] = OpType::op(xi[i*xEws], extraParams);
-                }
+                }, 0, len, 0, threadsInfo._numThreads);
             }
                 break;
 
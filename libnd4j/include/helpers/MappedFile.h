@@ -0,0 +1,55 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_MAPPEDFILE_H
+#define LIBND4J_MAPPEDFILE_H
+
+#include <pointercast.h>
+#include <dll.h>
+
+namespace nd4j {
+    /**
+     * This class maps whole file into memory as read-only mapping:
+     * pages are loaded on first access and shared with page cache. Writing into mapped memory crashes, so arrays
+     * pointing into it belong to read-only Variables, and nodes consuming them never run in-place.
+     *
+     * Mapping is released in destructor, so anything pointing into it must be released before.
+     */
+    class ND4J_EXPORT MappedFile {
+    private:
+        void* _pointer = nullptr;
+        Nd4jLong _length = 0L;
+
+    public:
+        explicit MappedFile(const char *fileName);
+        ~MappedFile();
+
+        MappedFile(const MappedFile& other) = delete;
+        MappedFile& operator=(const MappedFile& other) = delete;
+
+        /**
+         * This method returns pointer to the beginning of mapped file
+         */
+        void* pointer() const;
+
+        /**
+         * This method returns length of mapped file, in bytes
+         */
+        Nd4jLong length() const;
+    };
+}
+
+#endif //LIBND4J_MAPPEDFILE_H
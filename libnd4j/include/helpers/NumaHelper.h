@@ -0,0 +1,98 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_NUMAHELPER_H
+#define LIBND4J_NUMAHELPER_H
+
+#include <dll.h>
+#include <pointercast.h>
+#include <vector>
+#include <string>
+
+namespace nd4j {
+    /**
+     * Placement policies for host buffers of workspaces and arrays
+     */
+    enum NumaPolicy {
+        // no explicit placement: pages land on node of the thread that touches them first
+        NUMA_DEFAULT = 0,
+        // pages are spread round-robin over all nodes
+        NUMA_INTERLEAVE = 1,
+        // pages are first touched in parallel, by the same threads that process them in elementwise loops
+        NUMA_LOCAL = 2,
+        // pages are bound to Environment::numaNode()
+        NUMA_BIND = 3,
+    };
+
+    /**
+     * This class provides NUMA topology and placement helpers. It talks to the kernel directly (sysfs, mbind), so there's no libnuma dependency.
+     * On anything but Linux all nodes collapse into node 0, and placement calls do nothing.
+     */
+    class ND4J_EXPORT NumaHelper {
+    public:
+        /**
+         * This method returns number of NUMA nodes available
+         */
+        static int numNodes();
+
+        /**
+         * This method returns ids of CPUs that belong to given node
+         */
+        static std::vector<int> cpusOfNode(int node);
+
+        /**
+         * This method returns policy for given name (default, interleave, local, bind), or -1 if name is unknown
+         */
+        static int policyByName(const char *name);
+
+        static const char* policyName(int policy);
+
+        /**
+         * This method applies current Environment interleave/bind policy to freshly allocated memory, before it's touched.
+         * Only pages that are fully covered by buffer are affected
+         */
+        static void place(void *ptr, Nd4jLong numBytes);
+
+        /**
+         * This method returns size of smallest heap array buffer interleave/bind policies are applied to. Smaller arrays are left to first touch
+         */
+        static Nd4jLong minPlacedBytes();
+
+        /**
+         * This method zeroes length elements of elementSize bytes each, split evenly between threads of OpenMP team, so with first-touch placement
+         * each thread gets its part of buffer on its own node. Falls back to plain memset when called from parallel region
+         */
+        static void firstTouch(void *ptr, Nd4jLong length, int elementSize);
+
+        /**
+         * This method pins calling thread to CPUs of given node. Returns false if it's not supported, or failed
+         */
+        static bool pinCurrentThread(int node);
+
+        /**
+         * This method returns node thread with given id should be pinned to, if team of numThreads is spread over nodes in contiguous blocks
+         */
+        static int nodeForThread(int threadId, int numThreads);
+
+        /**
+         * This method pins OpenMP team to nodes in contiguous blocks, once. Calling thread belongs to application, so it keeps its own affinity.
+         * Does nothing unless Environment::isNumaPinThreads() is enabled and there's more than one node
+         */
+        static void pinTeam();
+    };
+}
+
+#endif //LIBND4J_NUMAHELPER_H
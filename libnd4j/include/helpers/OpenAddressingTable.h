@@ -0,0 +1,165 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_OPENADDRESSINGTABLE_H
+#define LIBND4J_OPENADDRESSINGTABLE_H
+
+#include <pointercast.h>
+#include <op_boilerplate.h>
+#include <NDArray.h>
+#include <vector>
+#include <cstring>
+#include <cstdint>
+
+namespace nd4j {
+
+    /**
+     * This class provides simple open addressing (linear probing) hash table, mapping values of array to integer ids.
+     * Keys are stored inline, so lookups don't leave table memory. Table grows twice once it's half full.
+     *
+     * PLEASE NOTE: keys are compared with operator==, so +0.0 and -0.0 are the same key, and NaN never matches anything
+     */
+    template <typename T>
+    class OpenAddressingTable {
+    private:
+        std::vector<T> _keys;
+        std::vector<Nd4jLong> _ids;
+        uint64_t _mask = 0;
+        Nd4jLong _size = 0;
+
+        void allocate(uint64_t capacity) {
+            _keys.assign(capacity, T());
+            _ids.assign(capacity, -1);
+            _mask = capacity - 1;
+        }
+
+        void grow() {
+            std::vector<T> keys;
+            std::vector<Nd4jLong> ids;
+            keys.swap(_keys);
+            ids.swap(_ids);
+
+            allocate(keys.size() * 2);
+
+            for (size_t e = 0; e < keys.size(); e++) {
+                if (ids[e] < 0)
+                    continue;
+
+                auto slot = hash(keys[e]) & _mask;
+                while (_ids[slot] >= 0)
+                    slot = (slot + 1) & _mask;
+
+                _keys[slot] = keys[e];
+                _ids[slot] = ids[e];
+            }
+        }
+
+    public:
+        /**
+         * @param expectedSize - number of distinct keys expected, table is sized to hold them without growing
+         */
+        explicit OpenAddressingTable(Nd4jLong expectedSize = 16) {
+            uint64_t capacity = 16;
+            while (capacity < static_cast<uint64_t>(expectedSize) * 2)
+                capacity <<= 1;
+
+            allocate(capacity);
+        }
+
+        /**
+         * This method returns 64-bit hash of the key. Low bits are used for slots, so high bits are free for partitioning
+         */
+        static FORCEINLINE uint64_t hash(T key) {
+            // +0.0 and -0.0 are equal, so they must get the same hash
+            if (key == static_cast<T>(0))
+                key = static_cast<T>(0);
+
+            uint64_t bits = 0;
+            memcpy(&bits, &key, sizeof(T) < sizeof(uint64_t) ? sizeof(T) : sizeof(uint64_t));
+
+            // murmur3 finalizer
+            bits ^= bits >> 33;
+            bits *= 0xff51afd7ed558ccdULL;
+            bits ^= bits >> 33;
+            bits *= 0xc4ceb9fe1a85ec53ULL;
+            bits ^= bits >> 33;
+
+            return bits;
+        }
+
+        /**
+         * This method returns id of the key. If key wasn't in table yet, it's added with given id, and inserted is set to true
+         */
+        FORCEINLINE Nd4jLong insert(T key, Nd4jLong id, bool &inserted) {
+            if (static_cast<uint64_t>(_size + 1) * 2 > _mask + 1)
+                grow();
+
+            auto slot = hash(key) & _mask;
+            while (_ids[slot] >= 0) {
+                if (_keys[slot] == key) {
+                    inserted = false;
+                    return _ids[slot];
+                }
+
+                slot = (slot + 1) & _mask;
+            }
+
+            _keys[slot] = key;
+            _ids[slot] = id;
+            _size++;
+
+            inserted = true;
+            return id;
+        }
+
+        /**
+         * This method returns id of the key, or -1 if there's no such key in table
+         */
+        FORCEINLINE Nd4jLong find(T key) const {
+            auto slot = hash(key) & _mask;
+            while (_ids[slot] >= 0) {
+                if (_keys[slot] == key)
+                    return _ids[slot];
+
+                slot = (slot + 1) & _mask;
+            }
+
+            return -1;
+        }
+
+        /**
+         * This method returns number of distinct keys in table
+         */
+        FORCEINLINE Nd4jLong size() const {
+            return _size;
+        }
+
+        /**
+         * This method returns c-ordered contiguous buffer of input, suitable for hashing its elements.
+         * If input is a view or 'f'-ordered, its copy is made, and stored into copy argument. Caller deletes it.
+         */
+        static T* linearBuffer(NDArray* input, NDArray*& copy) {
+            copy = nullptr;
+            if (input->ordering() == 'c' && input->ews() == 1)
+                return input->bufferAsT<T>();
+
+            copy = input->dup('c');
+            return copy->bufferAsT<T>();
+        }
+    };
+}
+
+#endif //LIBND4J_OPENADDRESSINGTABLE_H
@@ -0,0 +1,159 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_THREADPOOL_H
+#define LIBND4J_THREADPOOL_H
+
+#include <pointercast.h>
+#include <dll.h>
+#include <OmpLaunchHelper.h>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <exception>
+#include <condition_variable>
+
+namespace nd4j {
+
+    // loop body, called with [start, stop) range of iterations
+    typedef std::function<void(Nd4jLong, Nd4jLong)> FUNC_1D;
+
+    /**
+     * This class provides persistent pool of worker threads, used instead of OpenMP parallel regions when library is built with THREADPOOL=yes
+     *
+     * Iteration space is split into one range per participant, calling thread included. Each participant takes grain-sized
+     * chunks from its own range, and once it's empty - takes chunks from ranges of other participants.
+     * Idle workers spin for Environment::threadPoolSpin() iterations before parking on condition variable.
+     *
+     * PLEASE NOTE: only one job runs at a time. Nested calls, and calls made while pool is busy, are executed by calling thread.
+     */
+    class ND4J_EXPORT ThreadPool {
+    private:
+        // per-participant range, padded to cache line so participants don't share lines
+        struct Range {
+            std::atomic<Nd4jLong> next;
+            Nd4jLong stop;
+            char pad[64 - sizeof(std::atomic<Nd4jLong>) - sizeof(Nd4jLong)];
+        };
+
+        std::vector<std::thread> _workers;
+        Range* _ranges = nullptr;
+        int _numThreads = 1;
+
+        // current job: generation in high bits, number of participants in low 16 bits
+        std::atomic<uint64_t> _job{0};
+        std::atomic<int> _pending{0};
+        std::atomic<int> _parked{0};
+        std::atomic<bool> _stop{false};
+
+        const FUNC_1D* _func = nullptr;
+        Nd4jLong _grain = 1;
+
+        std::mutex _submitLock;
+        std::mutex _parkLock;
+        std::condition_variable _parkCondition;
+
+        std::mutex _errorLock;
+        std::exception_ptr _error;
+
+        ThreadPool();
+        ~ThreadPool();
+
+        void worker(int threadId);
+        void process(int threadId, int numParticipants);
+        uint64_t await(uint64_t seen);
+
+    public:
+        static ThreadPool* getInstance();
+
+        /**
+         * This method returns number of threads available for a single job, calling thread included
+         */
+        int numThreads() const;
+
+        /**
+         * This method calls func for all grain-sized chunks of [start, stop), using up to numThreads threads, and returns once all chunks are processed.
+         * Exception thrown by func is rethrown here
+         */
+        void execute(const FUNC_1D &func, Nd4jLong start, Nd4jLong stop, Nd4jLong grain, int numThreads);
+    };
+
+
+    /**
+     * Parallel loop helpers. Depending on build flags they're backed either by ThreadPool or by OpenMP
+     */
+    class ND4J_EXPORT Threads {
+    public:
+        /**
+         * This method returns max number of threads available for parallel loops
+         */
+        static int maxThreads();
+
+        /**
+         * This method splits [start, stop) into chunks of grain iterations and calls func for each of them.
+         *
+         * @param grain - chunk size. If <= 0, it's derived from number of threads: single span per thread with OpenMP, few chunks per worker with ThreadPool
+         * @param numThreads - max number of threads to use. If <= 0, it's derived from Environment::elementwiseThreshold()
+         */
+        static void parallel_for(const FUNC_1D &func, Nd4jLong start, Nd4jLong stop, Nd4jLong grain = 0, int numThreads = -1);
+
+        /**
+         * This method calls func for each chunk of [start, stop) and combines partial results with reducer.
+         * Partial results are combined in chunk order, so result doesn't depend on scheduling
+         */
+        template <typename T>
+        static T parallel_reduce(const std::function<T(Nd4jLong, Nd4jLong)> &func, const std::function<T(T, T)> &reducer, Nd4jLong start, Nd4jLong stop, Nd4jLong grain = 0, int numThreads = -1) {
+            if (stop <= start)
+                return T();
+
+            auto length = stop - start;
+            if (numThreads <= 0)
+                numThreads = OmpLaunchHelper::betterThreads(length, maxThreads());
+
+            if (grain <= 0)
+                grain = chunkSize(length, numThreads);
+
+            auto numChunks = (length + grain - 1) / grain;
+            if (numChunks == 1)
+                return func(start, stop);
+
+            // not std::vector, since std::vector<bool> can't be written concurrently
+            std::unique_ptr<T[]> partials(new T[numChunks]);
+            parallel_for([&](Nd4jLong cs, Nd4jLong ce) {
+                for (auto c = cs; c < ce; c++) {
+                    auto s = start + c * grain;
+                    partials[c] = func(s, s + grain < stop ? s + grain : stop);
+                }
+            }, 0, numChunks, 1, numThreads);
+
+            T result = partials[0];
+            for (Nd4jLong c = 1; c < numChunks; c++)
+                result = reducer(result, partials[c]);
+
+            return result;
+        }
+
+        /**
+         * This method returns default chunk size for given number of iterations
+         */
+        static Nd4jLong chunkSize(Nd4jLong length, int numThreads = -1);
+    };
+}
+
+#endif //LIBND4J_THREADPOOL_H
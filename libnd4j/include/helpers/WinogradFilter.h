@@ -0,0 +1,66 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_WINOGRADFILTER_H
+#define LIBND4J_WINOGRADFILTER_H
+
+#include <pointercast.h>
+#include <dll.h>
+#include <array/DataType.h>
+#include <vector>
+
+namespace nd4j {
+    class NDArray;
+
+    /**
+     * This class holds Winograd-transformed conv2d weights between executions of the same graph node.
+     * It's owned by node ContextPrototype, standalone DeclarableOp::execute() calls get fresh Context and don't reuse it.
+     *
+     * Cached filter is reused while weights buffer, shape, data type and output tile size stay the same. Content isn't
+     * checked, since hashing all weights on every call costs about as much as the transform itself. So whoever updates
+     * weights in place, keeping the same buffer, must call reset() on filters of nodes consuming them
+     */
+    class ND4J_EXPORT WinogradFilter {
+    protected:
+        const void* _weights = nullptr;
+        std::vector<Nd4jLong> _shape;
+        nd4j::DataType _dataType = nd4j::DataType::INHERIT;
+        int _tile = 0;
+
+        std::vector<int8_t> _buffer;
+    public:
+        WinogradFilter() = default;
+        ~WinogradFilter() = default;
+
+        /**
+         * This method returns true if cached filter can't be used for given weights and tile size, and must be transformed again.
+         * In this case buffer is resized to numBytes
+         */
+        bool checkAndReset(const NDArray* weights, int tile, Nd4jLong numBytes);
+
+        /**
+         * This method drops cached filter
+         */
+        void reset();
+
+        template <typename T>
+        T* bufferAsT() {
+            return reinterpret_cast<T*>(_buffer.data());
+        }
+    };
+}
+
+#endif //LIBND4J_WINOGRADFILTER_H
@@ -0,0 +1,222 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include "../ConstantShapeHelper.h"
+#include <helpers/shape.h>
+#include <array/ArrayOptions.h>
+#include <cstring>
+
+namespace nd4j {
+
+    ConstantShapeHelper::ShapeEntry::ShapeEntry(const Nd4jLong *original, Nd4jLong h) {
+        shapeInfo = new Nd4jLong[shape::shapeInfoLength(original)];
+        memcpy(shapeInfo, original, shape::shapeInfoByteLength(original));
+        hash = h;
+    }
+
+    ConstantShapeHelper::ShapeEntry::~ShapeEntry() {
+        delete[] shapeInfo;
+    }
+
+    ConstantShapeHelper::ShapeShard::ShapeShard() {
+        for (int e = 0; e < BUCKETS; e++)
+            buckets[e] = nullptr;
+
+        hits = 0;
+        misses = 0;
+    }
+
+    ConstantShapeHelper::ConstantShapeHelper() {
+        _size = 0;
+
+        // few thousands of distinct shapes is typical even for big graphs
+        _limit = 65536;
+    }
+
+    ConstantShapeHelper::~ConstantShapeHelper() {
+        for (int s = 0; s < SHARDS; s++) {
+            for (int b = 0; b < BUCKETS; b++) {
+                auto e = _shards[s].buckets[b].load();
+                while (e != nullptr) {
+                    auto next = e->next;
+                    delete e;
+                    e = next;
+                }
+            }
+        }
+    }
+
+    ConstantShapeHelper* ConstantShapeHelper::getInstance() {
+        if (!_INSTANCE)
+            _INSTANCE = new ConstantShapeHelper();
+
+        return _INSTANCE;
+    }
+
+    Nd4jLong ConstantShapeHelper::hash(const Nd4jLong *shapeInfo) {
+        // FNV-1a over all words of shapeInfo, including strides and array options
+        uint64_t h = 14695981039346656037ULL;
+        auto length = shape::shapeInfoLength(shapeInfo);
+        for (int e = 0; e < length; e++) {
+            h ^= (uint64_t) shapeInfo[e];
+            h *= 1099511628211ULL;
+        }
+
+        return (Nd4jLong) h;
+    }
+
+    Nd4jLong* ConstantShapeHelper::intern(const Nd4jLong *shapeInfo) {
+        if (shapeInfo == nullptr || shape::rank(shapeInfo) > MAX_RANK)
+            return nullptr;
+
+        auto h = hash(shapeInfo);
+        auto &shard = _shards[(uint64_t) h & (SHARDS - 1)];
+        auto &bucket = shard.buckets[((uint64_t) h >> 32) & (BUCKETS - 1)];
+        auto bytes = shape::shapeInfoByteLength(shapeInfo);
+
+        // fast path: entries are immutable once published, so no locks are needed here
+        for (auto e = bucket.load(std::memory_order_acquire); e != nullptr; e = e->next) {
+            if (e->shapeInfo == shapeInfo || (e->hash == h && e->shapeInfo[0] == shapeInfo[0] && memcmp(e->shapeInfo, shapeInfo, bytes) == 0)) {
+                shard.hits.fetch_add(1, std::memory_order_relaxed);
+                return e->shapeInfo;
+            }
+        }
+
+        shard.misses.fetch_add(1, std::memory_order_relaxed);
+
+        if (_size.load(std::memory_order_relaxed) >= _limit.load(std::memory_order_relaxed))
+            return nullptr;
+
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        // other thread might have added the same shape while we were waiting for the lock
+        auto head = bucket.load(std::memory_order_acquire);
+        for (auto e = head; e != nullptr; e = e->next)
+            if (e->hash == h && e->shapeInfo[0] == shapeInfo[0] && memcmp(e->shapeInfo, shapeInfo, bytes) == 0)
+                return e->shapeInfo;
+
+        auto entry = new ShapeEntry(shapeInfo, h);
+        entry->next = head;
+
+        // publishing fully built entry to readers
+        bucket.store(entry, std::memory_order_release);
+        _size.fetch_add(1, std::memory_order_relaxed);
+
+        return entry->shapeInfo;
+    }
+
+    Nd4jLong* ConstantShapeHelper::createShapeInfo(const nd4j::DataType dataType, const char order, const int rank, const Nd4jLong *shape) {
+        if (rank > MAX_RANK)
+            return nullptr;
+
+        // same layout as ShapeBuilders::createShapeInfo produces, but without allocation
+        Nd4jLong buffer[MAX_SHAPEINFOLENGTH];
+        if (rank == 0 || shape[0] == 0) {
+            buffer[0] = 0;
+            buffer[1] = 0;
+            buffer[2] = 1;
+            buffer[3] = 99;
+        } else {
+            buffer[0] = rank;
+            for (int e = 0; e < rank; e++)
+                buffer[e + 1] = shape[e];
+
+            shape::updateStrides(buffer, order);
+            buffer[2 * rank + 1] = 0;
+        }
+
+        nd4j::ArrayOptions::setDataType(buffer, dataType);
+
+        return intern(buffer);
+    }
+
+    Nd4jLong* ConstantShapeHelper::createShapeInfo(const nd4j::DataType dataType, const char order, const std::vector<Nd4jLong> &shape) {
+        return createShapeInfo(dataType, order, (int) shape.size(), shape.data());
+    }
+
+    Nd4jLong* ConstantShapeHelper::scalarShapeInfo(const nd4j::DataType dataType) {
+        return createShapeInfo(dataType, 'c', 0, nullptr);
+    }
+
+    Nd4jLong* ConstantShapeHelper::bufferForShapeInfo(ShapeDescriptor &descriptor) {
+        if (descriptor.rank() > MAX_RANK)
+            return nullptr;
+
+        Nd4jLong buffer[MAX_SHAPEINFOLENGTH];
+        const int rank = descriptor.rank();
+
+        buffer[0] = rank;
+        for (int e = 0; e < rank; e++) {
+            buffer[e + 1] = descriptor.shape()[e];
+            buffer[e + 1 + rank] = descriptor.strides()[e];
+        }
+
+        buffer[2 * rank + 1] = 0;
+        nd4j::ArrayOptions::setDataType(buffer, descriptor.dataType());
+        buffer[2 * rank + 2] = rank == 0 ? 1 : descriptor.ews();
+        buffer[2 * rank + 3] = (Nd4jLong) descriptor.order();
+
+        if (descriptor.isEmpty())
+            nd4j::ArrayOptions::setPropertyBit(buffer, ARRAY_EMPTY);
+
+        return intern(buffer);
+    }
+
+    bool ConstantShapeHelper::isInterned(const Nd4jLong *shapeInfo) {
+        if (shapeInfo == nullptr)
+            return false;
+
+        auto h = hash(shapeInfo);
+        auto &shard = _shards[(uint64_t) h & (SHARDS - 1)];
+        auto &bucket = shard.buckets[((uint64_t) h >> 32) & (BUCKETS - 1)];
+
+        for (auto e = bucket.load(std::memory_order_acquire); e != nullptr; e = e->next)
+            if (e->shapeInfo == shapeInfo)
+                return true;
+
+        return false;
+    }
+
+    Nd4jLong ConstantShapeHelper::cacheHits() {
+        Nd4jLong result = 0L;
+        for (int e = 0; e < SHARDS; e++)
+            result += _shards[e].hits.load(std::memory_order_relaxed);
+
+        return result;
+    }
+
+    Nd4jLong ConstantShapeHelper::cacheMisses() {
+        Nd4jLong result = 0L;
+        for (int e = 0; e < SHARDS; e++)
+            result += _shards[e].misses.load(std::memory_order_relaxed);
+
+        return result;
+    }
+
+    Nd4jLong ConstantShapeHelper::cacheSize() {
+        return _size.load(std::memory_order_relaxed);
+    }
+
+    Nd4jLong ConstantShapeHelper::cacheLimit() {
+        return _limit.load(std::memory_order_relaxed);
+    }
+
+    void ConstantShapeHelper::setCacheLimit(Nd4jLong limit) {
+        _limit.store(limit, std::memory_order_relaxed);
+    }
+
+    nd4j::ConstantShapeHelper* nd4j::ConstantShapeHelper::_INSTANCE = 0;
+}
@@ -25,9 +25,26 @@
 
 namespace nd4j {
   
-    ConstantTadHelper::ConstantTadHelper() {
-        std::map<TadDescriptor, TadPack> pack;
-        _cache.emplace_back(pack);
+    ConstantTadHelper::TadShard::TadShard() {
+        for (int e = 0; e < BUCKETS; e++)
+            buckets[e] = nullptr;
+
+        hits = 0;
+        misses = 0;
+        size = 0;
+    }
+
+    ConstantTadHelper::~ConstantTadHelper() {
+        for (int s = 0; s < SHARDS; s++) {
+            for (int b = 0; b < BUCKETS; b++) {
+                auto e = _shards[s].buckets[b].load();
+                while (e != nullptr) {
+                    auto next = e->next;
+                    delete e;
+                    e = next;
+                }
+            }
+        }
     }
 
     ConstantTadHelper* ConstantTadHelper::getInstance() {
@@ -56,59 +73,80 @@ namespace nd4j {
     }
 
     TadPack& ConstantTadHelper::tadForDimensions(TadDescriptor &descriptor) {
-        const int deviceId = 0;
+        auto hash = (uint64_t) descriptor.hash();
+        auto &shard = _shards[hash & (SHARDS - 1)];
+        auto &bucket = shard.buckets[(hash >> 32) & (BUCKETS - 1)];
+
+        // fast path: entries are immutable once published, so no locks are needed here
+        for (auto e = bucket.load(std::memory_order_acquire); e != nullptr; e = e->next) {
+            if (e->hash == descriptor.hash() && e->descriptor == descriptor) {
+                shard.hits.fetch_add(1, std::memory_order_relaxed);
+                return e->pack;
+            }
+        }
 
-        _mutex.lock();
-        if (_cache[deviceId].count(descriptor) == 0) {
-            
-            const auto shapeInfo = descriptor.originalShape().toShapeInfo();
-            const int rank = shape::rank(shapeInfo);
-            const std::vector<int> dimsToExclude = ShapeUtils::evalDimsToExclude(rank, descriptor.axis());
-            const Nd4jLong numOfSubArrs = ShapeUtils::getNumOfSubArrs(shapeInfo, dimsToExclude);
-            const int subArrRank = (rank == dimsToExclude.size() || descriptor.areUnitiesinShape()) ? rank : rank - dimsToExclude.size();
+        std::lock_guard<std::mutex> lock(shard.mutex);
 
-            auto sPtr = new Nd4jLong[shape::shapeInfoLength(subArrRank)];
-            auto oPtr = new Nd4jLong[numOfSubArrs];
+        // other thread might have built the same pack while we were waiting for the lock
+        auto head = bucket.load(std::memory_order_acquire);
+        for (auto e = head; e != nullptr; e = e->next) {
+            if (e->hash == descriptor.hash() && e->descriptor == descriptor) {
+                shard.hits.fetch_add(1, std::memory_order_relaxed);
+                return e->pack;
+            }
+        }
 
-            shape::calcSubArrShapeAndOffsets(shapeInfo, numOfSubArrs, dimsToExclude.size(), dimsToExclude.data(), sPtr, oPtr, descriptor.areUnitiesinShape());
+        const auto shapeInfo = descriptor.originalShape().toShapeInfo();
+        const int rank = shape::rank(shapeInfo);
+        const std::vector<int> dimsToExclude = ShapeUtils::evalDimsToExclude(rank, descriptor.axis());
+        const Nd4jLong numOfSubArrs = ShapeUtils::getNumOfSubArrs(shapeInfo, dimsToExclude);
+        const int subArrRank = (rank == dimsToExclude.size() || descriptor.areUnitiesinShape()) ? rank : rank - dimsToExclude.size();
 
-            DataBuffer shapesBuffer(sPtr, nullptr);
-            DataBuffer offsetsBuffer(oPtr, nullptr);
-            TadPack t(shapesBuffer, offsetsBuffer, numOfSubArrs);
+        auto sPtr = new Nd4jLong[shape::shapeInfoLength(subArrRank)];
+        auto oPtr = new Nd4jLong[numOfSubArrs];
 
+        shape::calcSubArrShapeAndOffsets(shapeInfo, numOfSubArrs, dimsToExclude.size(), dimsToExclude.data(), sPtr, oPtr, descriptor.areUnitiesinShape());
 
+        DataBuffer shapesBuffer(sPtr, nullptr);
+        DataBuffer offsetsBuffer(oPtr, nullptr);
+        TadPack t(shapesBuffer, offsetsBuffer, numOfSubArrs);
 
-            // auto shapeInfo = descriptor.originalShape().toShapeInfo();
-            // shape::TAD tad;
-            // tad.init(shapeInfo, descriptor.axis().data(), descriptor.axis().size());
-            // tad.createTadOnlyShapeInfo();
-            // tad.createOffsets();       
+        delete[] shapeInfo;
 
-            // auto sPtr = new Nd4jLong[shape::shapeInfoLength(tad.tadOnlyShapeInfo)];
-            // auto oPtr = new Nd4jLong[tad.numTads];
+        auto entry = new TadEntry(descriptor, t);
+        entry->next = head;
 
-            // memcpy(sPtr, tad.tadOnlyShapeInfo, shape::shapeInfoByteLength(tad.tadOnlyShapeInfo));
-            // memcpy(oPtr, tad.tadOffsets, tad.numTads * sizeof(Nd4jLong));
+        // publishing fully built entry to readers
+        bucket.store(entry, std::memory_order_release);
 
-            // DataBuffer shapesBuffer(sPtr, nullptr);
-            // DataBuffer offsetsBuffer(oPtr, nullptr);
-            // TadPack t(shapesBuffer, offsetsBuffer, tad.numTads);
+        shard.misses.fetch_add(1, std::memory_order_relaxed);
+        shard.size.fetch_add(1, std::memory_order_relaxed);
 
+        return entry->pack;
+    }
 
-            _cache[deviceId][descriptor] = t;
+    Nd4jLong ConstantTadHelper::cacheHits() {
+        Nd4jLong result = 0L;
+        for (int e = 0; e < SHARDS; e++)
+            result += _shards[e].hits.load(std::memory_order_relaxed);
 
-            TadPack &r = _cache[deviceId][descriptor];
-            _mutex.unlock();
+        return result;
+    }
 
-            delete[] shapeInfo;
+    Nd4jLong ConstantTadHelper::cacheMisses() {
+        Nd4jLong result = 0L;
+        for (int e = 0; e < SHARDS; e++)
+            result += _shards[e].misses.load(std::memory_order_relaxed);
 
-            return r;
-        } else {
-            TadPack &r = _cache[deviceId][descriptor];
-            _mutex.unlock();
+        return result;
+    }
 
-            return r;
-        }
+    Nd4jLong ConstantTadHelper::cacheSize() {
+        Nd4jLong result = 0L;
+        for (int e = 0; e < SHARDS; e++)
+            result += _shards[e].size.load(std::memory_order_relaxed);
+
+        return result;
     }
 
     nd4j::ConstantTadHelper* nd4j::ConstantTadHelper::_INSTANCE = 0;
@@ -0,0 +1,61 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <helpers/CpuFeatures.h>
+#include <helpers/IsaDispatch.h>
+#include <string>
+
+namespace nd4j {
+    int CpuFeatures::detectIsaLevel() {
+#ifdef ND4J_ISA_DISPATCH
+        // __builtin_cpu_supports takes OS support for extended registers into account as well
+        __builtin_cpu_init();
+
+        if (__builtin_cpu_supports("avx512f"))
+            return ISA_AVX512;
+
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+            return ISA_AVX2;
+#endif
+        return ISA_GENERIC;
+    }
+
+    int CpuFeatures::isaLevelByName(const char *name) {
+        if (name == nullptr)
+            return -1;
+
+        std::string n(name);
+        if (n == "generic")
+            return ISA_GENERIC;
+        else if (n == "avx2")
+            return ISA_AVX2;
+        else if (n == "avx512")
+            return ISA_AVX512;
+
+        return -1;
+    }
+
+    const char* CpuFeatures::isaName(int level) {
+        switch (level) {
+            case ISA_AVX512:
+                return "avx512";
+            case ISA_AVX2:
+                return "avx2";
+            default:
+                return "generic";
+        }
+    }
+}
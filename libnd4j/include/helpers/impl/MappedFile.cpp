@@ -0,0 +1,112 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <helpers/MappedFile.h>
+#include <helpers/logger.h>
+#include <stdexcept>
+#include <errno.h>
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace nd4j {
+    MappedFile::MappedFile(const char *fileName) {
+#if defined(_WIN32) || defined(_WIN64)
+        auto h = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (h == INVALID_HANDLE_VALUE) {
+            nd4j_printf("File [%s] wasn't found. Please check path and permissions\n", fileName);
+            throw std::runtime_error("Failed to open file for MMAP");
+        }
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(h, &size) || size.QuadPart == 0) {
+            CloseHandle(h);
+            throw std::runtime_error("Failed to get size of file for MMAP");
+        }
+
+        // arrays backed by mapping are read-only, so stray write faults instead of silently diverging from file
+        auto fm = CreateFileMapping(h, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        auto ptr = fm == nullptr ? nullptr : MapViewOfFile(fm, FILE_MAP_READ, 0, 0, 0);
+
+        // view holds its own references, so handles aren't needed anymore
+        if (fm != nullptr)
+            CloseHandle(fm);
+        CloseHandle(h);
+
+        if (ptr == nullptr) {
+            nd4j_printf("MapViewOfFile failed with error code: %i\n", (int) GetLastError());
+            throw std::runtime_error("Failed to MMAP file");
+        }
+
+        _pointer = ptr;
+        _length = static_cast<Nd4jLong>(size.QuadPart);
+#else
+        errno = 0;
+        int fd = open(fileName, O_RDONLY);
+        if (fd < 0) {
+            nd4j_printf("File [%s] wasn't found. Please check path and permissions\n", fileName);
+            throw std::runtime_error("Failed to open file for MMAP");
+        }
+
+        struct stat stat_buf;
+        if (fstat(fd, &stat_buf) != 0 || stat_buf.st_size == 0) {
+            close(fd);
+            throw std::runtime_error("Failed to get size of file for MMAP");
+        }
+
+        // arrays backed by mapping are read-only, so stray write faults instead of silently diverging from file
+        auto ptr = mmap(nullptr, static_cast<size_t>(stat_buf.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+
+        // mapping holds its own reference, so descriptor isn't needed anymore
+        close(fd);
+
+        if (ptr == MAP_FAILED) {
+            nd4j_printf("Errno: %i\n", errno);
+            throw std::runtime_error("Failed to MMAP file");
+        }
+
+        _pointer = ptr;
+        _length = static_cast<Nd4jLong>(stat_buf.st_size);
+#endif
+
+        nd4j_debug("File [%s] mapped: %lld bytes\n", fileName, _length);
+    }
+
+    MappedFile::~MappedFile() {
+        if (_pointer == nullptr)
+            return;
+
+#if defined(_WIN32) || defined(_WIN64)
+        UnmapViewOfFile(_pointer);
+#else
+        munmap(_pointer, static_cast<size_t>(_length));
+#endif
+    }
+
+    void* MappedFile::pointer() const {
+        return _pointer;
+    }
+
+    Nd4jLong MappedFile::length() const {
+        return _length;
+    }
+}
@@ -25,6 +25,7 @@
 #include <helpers/ShapeUtils.h>
 #include <helpers/BlasHelper.h>
 #include <NDArrayFactory.h>
+#include <ops/gemm.h>
 
 namespace nd4j { 
 
@@ -34,35 +35,9 @@ namespace nd4j {
 template <typename T1, typename T2, typename T3>
 static void usualGemm(const char cOrder, const bool transA, const bool transB, const int M, const int N, const int K, const double alpha, const void* vA, const int lda, const void* vB, const int ldb, const double beta, void* vC, const int ldc) {
 
-    T1* A = reinterpret_cast<T1*>(const_cast<void*>(vA));
-    T2* B = reinterpret_cast<T2*>(const_cast<void*>(vB));
-    T3* C = reinterpret_cast<T3*>(vC);
-    T3 alphaZ(alpha), betaZ(beta);
-    
-    const bool flagC = cOrder == 'f';
-    const bool flagA = (flagC && transA) || (!flagC && !transA);
-    const bool flagB = (flagC && transB) || (!flagC && !transB);   
-
-    PRAGMA_OMP_PARALLEL_FOR_COLLAPSE(2)
-    for(uint row = 0; row < M; ++row) {
-       for(uint col = 0; col < N; ++col) {
-            
-            T3* c = flagC ? (C + row + col * ldc) : (C + row * ldc + col);
-            T3 val = 0;
-
-           PRAGMA_OMP_SIMD
-            for(uint i = 0; i < K; ++i) {
-                T3 a = flagA ? *(A + row * lda + i) : *(A + row + i * lda);
-                T3 b = flagB ? *(B + col + i * ldb) : *(B + col * ldb + i);             
-                val += alphaZ * a * b;
-            }
-            
-            if(betaZ)
-                *c = val + betaZ * *c;
-            else
-                *c = val;
-       }
-    }
+    // blocked & packed implementation, see ops/impl/gemm.cpp
+    nd4j::blas::GEMM<T1, T2, T3>::op(cOrder == 'f' ? CblasColMajor : CblasRowMajor, transA ? CblasTrans : CblasNoTrans, transB ? CblasTrans : CblasNoTrans,
+                                     M, N, K, alpha, const_cast<void*>(vA), lda, const_cast<void*>(vB), ldb, beta, vC, ldc);
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,287 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <helpers/NumaHelper.h>
+#include <helpers/OmpLaunchHelper.h>
+#include <helpers/logger.h>
+#include <Environment.h>
+#include <openmp_pragmas.h>
+#include <fstream>
+#include <cstring>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#if defined(__linux__) && !defined(ANDROID)
+#include <sched.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#define ND4J_NUMA_LINUX
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace nd4j {
+    // mbind(2) modes, see linux/mempolicy.h
+    static const int MPOL_BIND_MODE = 2;
+    static const int MPOL_INTERLEAVE_MODE = 3;
+
+    // heap buffers this big are mmapped by allocator, so their pages aren't shared with anything else
+    static const Nd4jLong NUMA_MIN_PLACED_BYTES = 1024L * 1024L;
+
+    // parses sysfs lists, i.e. "0-3,8-11"
+    static std::vector<int> parseList(const std::string &list) {
+        std::vector<int> result;
+
+        size_t pos = 0;
+        while (pos < list.size()) {
+            auto comma = list.find(',', pos);
+            if (comma == std::string::npos)
+                comma = list.size();
+
+            auto token = list.substr(pos, comma - pos);
+            pos = comma + 1;
+            if (token.empty())
+                continue;
+
+            try {
+                auto dash = token.find('-');
+                if (dash == std::string::npos) {
+                    result.emplace_back(std::stoi(token));
+                } else {
+                    auto first = std::stoi(token.substr(0, dash));
+                    auto last = std::stoi(token.substr(dash + 1));
+                    for (int e = first; e <= last; e++)
+                        result.emplace_back(e);
+                }
+            } catch (std::exception &e) {
+                // malformed token, skipping it
+            }
+        }
+
+        return result;
+    }
+
+    static std::string readLine(const std::string &path) {
+        std::string line;
+        std::ifstream file(path);
+        if (file.good())
+            std::getline(file, line);
+
+        return line;
+    }
+
+    int NumaHelper::numNodes() {
+        static const int nodes = [] {
+            int result = 1;
+#ifdef ND4J_NUMA_LINUX
+            // node ids may have holes, so we take highest id
+            for (auto node: parseList(readLine("/sys/devices/system/node/online")))
+                if (node + 1 > result)
+                    result = node + 1;
+#endif
+            return result;
+        }();
+
+        return nodes;
+    }
+
+    std::vector<int> NumaHelper::cpusOfNode(int node) {
+        std::vector<int> cpus;
+#ifdef ND4J_NUMA_LINUX
+        cpus = parseList(readLine("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist"));
+#endif
+
+        // no topology info available: everything is node 0
+        if (cpus.empty() && node == 0)
+            for (int e = 0; e < static_cast<int>(std::thread::hardware_concurrency()); e++)
+                cpus.emplace_back(e);
+
+        return cpus;
+    }
+
+    int NumaHelper::policyByName(const char *name) {
+        if (name == nullptr)
+            return -1;
+
+        std::string n(name);
+        if (n == "default")
+            return NUMA_DEFAULT;
+        else if (n == "interleave")
+            return NUMA_INTERLEAVE;
+        else if (n == "local")
+            return NUMA_LOCAL;
+        else if (n == "bind")
+            return NUMA_BIND;
+
+        return -1;
+    }
+
+    const char* NumaHelper::policyName(int policy) {
+        switch (policy) {
+            case NUMA_INTERLEAVE:
+                return "interleave";
+            case NUMA_LOCAL:
+                return "local";
+            case NUMA_BIND:
+                return "bind";
+            default:
+                return "default";
+        }
+    }
+
+    void NumaHelper::place(void *ptr, Nd4jLong numBytes) {
+        // called before buffers are touched, so it's the place to pin team. Pinning happens once, later calls return right away
+        pinTeam();
+
+        auto policy = Environment::getInstance()->numaPolicy();
+        if (policy != NUMA_INTERLEAVE && policy != NUMA_BIND)
+            return;
+
+#if defined(ND4J_NUMA_LINUX) && defined(__NR_mbind)
+        auto nodes = numNodes();
+        if (ptr == nullptr || nodes < 2)
+            return;
+
+        // mbind works with whole pages only
+        const auto page = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+        auto start = (reinterpret_cast<uintptr_t>(ptr) + page - 1) / page * page;
+        auto stop = (reinterpret_cast<uintptr_t>(ptr) + numBytes) / page * page;
+        if (stop <= start)
+            return;
+
+        const int bits = sizeof(unsigned long) * 8;
+        std::vector<unsigned long> mask((nodes + bits - 1) / bits, 0UL);
+
+        if (policy == NUMA_INTERLEAVE) {
+            for (int e = 0; e < nodes; e++)
+                mask[e / bits] |= 1UL << (e % bits);
+        } else {
+            auto node = Environment::getInstance()->numaNode();
+            if (node >= nodes) {
+                nd4j_printf("NumaHelper: can't bind memory to node %i, only %i nodes available\n", node, nodes);
+                return;
+            }
+
+            mask[node / bits] |= 1UL << (node % bits);
+        }
+
+        auto mode = policy == NUMA_INTERLEAVE ? MPOL_INTERLEAVE_MODE : MPOL_BIND_MODE;
+        if (syscall(__NR_mbind, reinterpret_cast<void *>(start), stop - start, mode, mask.data(), mask.size() * bits + 1, 0) != 0)
+            nd4j_debug("NumaHelper: mbind failed for %lld bytes, memory stays with default policy\n", (Nd4jLong) (stop - start));
+#endif
+    }
+
+    Nd4jLong NumaHelper::minPlacedBytes() {
+        return NUMA_MIN_PLACED_BYTES;
+    }
+
+    void NumaHelper::firstTouch(void *ptr, Nd4jLong length, int elementSize) {
+        if (ptr == nullptr || length < 1)
+            return;
+
+        auto buffer = reinterpret_cast<int8_t *>(ptr);
+
+        // nested regions get single thread, so there's nothing to spread
+        OmpLaunchHelper info(length);
+#ifdef _OPENMP
+        if (info._numThreads <= 1 || omp_in_parallel()) {
+#else
+        if (info._numThreads <= 1) {
+#endif
+            memset(buffer, 0, length * elementSize);
+            return;
+        }
+
+        PRAGMA_OMP_PARALLEL_THREADS(info._numThreads)
+        {
+#ifdef _OPENMP
+            // team may be smaller than requested, so slices are computed for actual team size
+            const Nd4jLong threadNum = omp_get_thread_num();
+            const Nd4jLong numThreads = omp_get_num_threads();
+#else
+            const Nd4jLong threadNum = 0;
+            const Nd4jLong numThreads = 1;
+#endif
+            const auto span = length / numThreads;
+            const auto tail = length % numThreads;
+            const auto offset = threadNum * span + (threadNum < tail ? threadNum : tail);
+            const auto count = span + (threadNum < tail ? 1 : 0);
+
+            if (count > 0)
+                memset(buffer + offset * elementSize, 0, count * elementSize);
+        }
+    }
+
+    bool NumaHelper::pinCurrentThread(int node) {
+#ifdef ND4J_NUMA_LINUX
+        auto cpus = cpusOfNode(node);
+        if (cpus.empty())
+            return false;
+
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (auto cpu: cpus)
+            if (cpu < CPU_SETSIZE)
+                CPU_SET(cpu, &set);
+
+        return sched_setaffinity(0, sizeof(cpu_set_t), &set) == 0;
+#else
+        return false;
+#endif
+    }
+
+    int NumaHelper::nodeForThread(int threadId, int numThreads) {
+        if (numThreads < 1)
+            return 0;
+
+        return static_cast<int>(static_cast<Nd4jLong>(threadId) * numNodes() / numThreads);
+    }
+
+    void NumaHelper::pinTeam() {
+        if (!Environment::getInstance()->isNumaPinThreads() || numNodes() < 2)
+            return;
+
+        static std::once_flag pinned;
+        std::call_once(pinned, [] {
+#ifdef _OPENMP
+            // OpenMP keeps the same threads between parallel regions, so pinning them once is enough
+            auto numThreads = omp_get_max_threads();
+
+#ifdef ND4J_NUMA_LINUX
+            // calling thread is master of the team only while region lasts, so its original affinity is restored afterwards
+            cpu_set_t original;
+            CPU_ZERO(&original);
+            bool saved = sched_getaffinity(0, sizeof(cpu_set_t), &original) == 0;
+#endif
+
+            PRAGMA_OMP_PARALLEL_THREADS(numThreads)
+            {
+                auto threadNum = omp_get_thread_num();
+                if (!pinCurrentThread(nodeForThread(threadNum, numThreads)))
+                    nd4j_debug("NumaHelper: failed to pin thread %i\n", threadNum);
+            }
+
+#ifdef ND4J_NUMA_LINUX
+            if (saved && sched_setaffinity(0, sizeof(cpu_set_t), &original) != 0)
+                nd4j_debug("NumaHelper: failed to restore affinity of calling thread\n", "");
+#endif
+#endif
+        });
+    }
+}
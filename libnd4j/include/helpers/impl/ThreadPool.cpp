@@ -0,0 +1,304 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <helpers/ThreadPool.h>
+#include <helpers/logger.h>
+#include <helpers/NumaHelper.h>
+#include <Environment.h>
+#include <openmp_pragmas.h>
+
+#if defined(__linux__) && !defined(ANDROID)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace nd4j {
+
+    // true for pool workers, and for calling thread while it runs its share of a job
+    static thread_local bool _insidePool = false;
+
+    ThreadPool::ThreadPool() {
+        _numThreads = Environment::getInstance()->maxThreads();
+        if (_numThreads < 1)
+            _numThreads = 1;
+
+        // participant count must fit into low bits of _job
+        if (_numThreads > 0xFFFF)
+            _numThreads = 0xFFFF;
+
+        _ranges = new Range[_numThreads];
+
+        // node pinning, if enabled, is done by workers themselves and takes precedence over per-core pinning
+        const bool pin = Environment::getInstance()->isThreadPoolAffinity() && !Environment::getInstance()->isNumaPinThreads();
+        const int numCores = static_cast<int>(std::thread::hardware_concurrency());
+
+        for (int e = 1; e < _numThreads; e++) {
+            _workers.emplace_back(&ThreadPool::worker, this, e);
+
+#if defined(__linux__) && !defined(ANDROID)
+            if (pin && numCores > 0) {
+                cpu_set_t set;
+                CPU_ZERO(&set);
+                CPU_SET(e % numCores, &set);
+
+                if (pthread_setaffinity_np(_workers.back().native_handle(), sizeof(cpu_set_t), &set) != 0)
+                    nd4j_printf("ThreadPool: failed to pin worker %i to core %i\n", e, e % numCores);
+            }
+#endif
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        _stop.store(true);
+        {
+            std::lock_guard<std::mutex> lock(_parkLock);
+        }
+        _parkCondition.notify_all();
+
+        for (auto &w: _workers)
+            w.join();
+
+        delete[] _ranges;
+    }
+
+    ThreadPool* ThreadPool::getInstance() {
+        // function-local static is constructed exactly once, even if first calls are concurrent
+        static ThreadPool* instance = new ThreadPool();
+        return instance;
+    }
+
+    int ThreadPool::numThreads() const {
+        return _numThreads;
+    }
+
+    uint64_t ThreadPool::await(uint64_t seen) {
+        const int spin = Environment::getInstance()->threadPoolSpin();
+        for (int e = 0; e < spin; e++) {
+            auto job = _job.load(std::memory_order_acquire);
+            if (job != seen || _stop.load(std::memory_order_relaxed))
+                return job;
+
+            if ((e & 63) == 63)
+                std::this_thread::yield();
+        }
+
+        // nothing arrived while spinning, so park until next job. _parked is checked by execute() after job is published
+        std::unique_lock<std::mutex> lock(_parkLock);
+        _parked++;
+        _parkCondition.wait(lock, [&] { return _job.load() != seen || _stop.load(); });
+        _parked--;
+
+        return _job.load();
+    }
+
+    void ThreadPool::worker(int threadId) {
+        _insidePool = true;
+
+        // workers are spread over nodes in contiguous blocks, the same way ranges are assigned to them
+        if (Environment::getInstance()->isNumaPinThreads() && NumaHelper::numNodes() > 1)
+            NumaHelper::pinCurrentThread(NumaHelper::nodeForThread(threadId, _numThreads));
+
+        uint64_t seen = 0;
+        while (true) {
+            auto job = await(seen);
+            if (_stop.load())
+                return;
+
+            seen = job;
+            auto numParticipants = static_cast<int>(job & 0xFFFF);
+            if (threadId >= numParticipants)
+                continue;
+
+            process(threadId, numParticipants);
+            _pending.fetch_sub(1, std::memory_order_acq_rel);
+        }
+    }
+
+    void ThreadPool::process(int threadId, int numParticipants) {
+        auto &func = *_func;
+        const auto grain = _grain;
+
+        // own range goes first, then ranges of other participants
+        for (int r = 0; r < numParticipants; r++) {
+            auto &range = _ranges[(threadId + r) % numParticipants];
+
+            while (true) {
+                auto start = range.next.fetch_add(grain, std::memory_order_relaxed);
+                if (start >= range.stop)
+                    break;
+
+                auto stop = start + grain < range.stop ? start + grain : range.stop;
+                try {
+                    func(start, stop);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(_errorLock);
+                    if (!_error)
+                        _error = std::current_exception();
+                }
+            }
+        }
+    }
+
+    void ThreadPool::execute(const FUNC_1D &func, Nd4jLong start, Nd4jLong stop, Nd4jLong grain, int numThreads) {
+        if (stop <= start)
+            return;
+
+        if (grain < 1)
+            grain = 1;
+
+        auto numChunks = (stop - start + grain - 1) / grain;
+        if (numThreads > _numThreads)
+            numThreads = _numThreads;
+
+        if (numThreads > numChunks)
+            numThreads = static_cast<int>(numChunks);
+
+        if (numThreads <= 1 || _insidePool) {
+            func(start, stop);
+            return;
+        }
+
+        // pool is busy with another caller's job, there's no point in waiting for it
+        std::unique_lock<std::mutex> submit(_submitLock, std::try_to_lock);
+        if (!submit.owns_lock()) {
+            func(start, stop);
+            return;
+        }
+
+        // chunks are spread evenly, first participants get one extra chunk if there's remainder
+        auto chunksPerThread = numChunks / numThreads;
+        auto remainder = numChunks % numThreads;
+        auto rangeStart = start;
+        for (int e = 0; e < numThreads; e++) {
+            auto rangeStop = rangeStart + (chunksPerThread + (e < remainder ? 1 : 0)) * grain;
+            if (rangeStop > stop)
+                rangeStop = stop;
+
+            _ranges[e].next.store(rangeStart, std::memory_order_relaxed);
+            _ranges[e].stop = rangeStop;
+            rangeStart = rangeStop;
+        }
+
+        _func = &func;
+        _grain = grain;
+        _error = nullptr;
+        _pending.store(numThreads - 1, std::memory_order_relaxed);
+
+        // publishing the job. seq_cst store pairs with _parked increment in await()
+        auto generation = (_job.load(std::memory_order_relaxed) >> 16) + 1;
+        _job.store((generation << 16) | static_cast<uint64_t>(numThreads));
+
+        if (_parked.load() > 0) {
+            {
+                std::lock_guard<std::mutex> lock(_parkLock);
+            }
+            _parkCondition.notify_all();
+        }
+
+        _insidePool = true;
+        process(0, numThreads);
+        _insidePool = false;
+
+        // by now all chunks are taken, so we only wait for chunks in flight
+        while (_pending.load(std::memory_order_acquire) > 0)
+            std::this_thread::yield();
+
+        _func = nullptr;
+
+        if (_error) {
+            auto error = _error;
+            _error = nullptr;
+            std::rethrow_exception(error);
+        }
+    }
+
+
+    int Threads::maxThreads() {
+#ifdef __ND4J_THREADPOOL__
+        return ThreadPool::getInstance()->numThreads();
+#elif defined(_OPENMP)
+        return omp_get_max_threads();
+#else
+        return 1;
+#endif
+    }
+
+    Nd4jLong Threads::chunkSize(Nd4jLong length, int numThreads) {
+        if (numThreads <= 0)
+            numThreads = OmpLaunchHelper::betterThreads(length, maxThreads());
+
+        if (numThreads <= 1)
+            return length < 1 ? 1 : length;
+
+#ifdef __ND4J_THREADPOOL__
+        // few chunks per worker leave some room for stealing
+        auto chunk = length / (static_cast<Nd4jLong>(numThreads) * 4);
+        return chunk < 1 ? 1 : chunk;
+#else
+        // OpenMP threads get single contiguous span each
+        return (length + numThreads - 1) / numThreads;
+#endif
+    }
+
+    void Threads::parallel_for(const FUNC_1D &func, Nd4jLong start, Nd4jLong stop, Nd4jLong grain, int numThreads) {
+        if (stop <= start)
+            return;
+
+        auto length = stop - start;
+        if (numThreads <= 0)
+            numThreads = OmpLaunchHelper::betterThreads(length, maxThreads());
+
+        if (grain <= 0)
+            grain = chunkSize(length, numThreads);
+
+        auto numChunks = (length + grain - 1) / grain;
+        if (numThreads > numChunks)
+            numThreads = static_cast<int>(numChunks);
+
+        if (numThreads <= 1) {
+            func(start, stop);
+            return;
+        }
+
+#ifdef __ND4J_THREADPOOL__
+        ThreadPool::getInstance()->execute(func, start, stop, grain, numThreads);
+#else
+        // exceptions can't leave OpenMP region, so first one is rethrown after it
+        std::exception_ptr error;
+
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(schedule(static) num_threads(numThreads))
+        for (Nd4jLong c = 0; c < numChunks; c++) {
+            auto s = start + c * grain;
+            try {
+                func(s, s + grain < stop ? s + grain : stop);
+            } catch (...) {
+                PRAGMA_OMP_CRITICAL
+                {
+                    if (!error)
+                        error = std::current_exception();
+                }
+            }
+        }
+
+        if (error)
+            std::rethrow_exception(error);
+#endif
+    }
+}
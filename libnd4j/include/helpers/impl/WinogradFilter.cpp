@@ -0,0 +1,46 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <helpers/WinogradFilter.h>
+#include <NDArray.h>
+
+namespace nd4j {
+
+    bool WinogradFilter::checkAndReset(const NDArray* weights, int tile, Nd4jLong numBytes) {
+        // for contiguous c-ordered arrays buffer pointer and shape identify weights completely, other layouts are never cached
+        const bool cacheable = weights->ordering() == 'c' && weights->ews() == 1;
+        auto shape = weights->getShapeAsVector();
+
+        if (cacheable && _weights == weights->getBuffer() && _tile == tile && _dataType == weights->dataType() && _shape == shape)
+            return false;
+
+        _weights = cacheable ? weights->getBuffer() : nullptr;
+        _tile = tile;
+        _dataType = weights->dataType();
+        _shape = shape;
+        _buffer.resize(numBytes);
+
+        return true;
+    }
+
+    void WinogradFilter::reset() {
+        _weights = nullptr;
+        _shape.clear();
+        _tile = 0;
+        _buffer.clear();
+        _buffer.shrink_to_fit();
+    }
+}
@@ -2823,6 +2823,10 @@ template <typename T>
      * @return
      */
     INLINEDEF _CUDA_HD bool equalsStrict(const Nd4jLong *shapeA, const Nd4jLong *shapeB) {
+        // interned shapes are shared, so identical pointers are the common case
+        if (shapeA == shapeB)
+            return true;
+
         if (shapeA[0] != shapeB[0])
             return false;
 
@@ -2841,7 +2845,10 @@ template <typename T>
 
 //////////////////////////////////////////////////////////////////////
 INLINEDEF _CUDA_HD bool haveSameShapeAndStrides(const Nd4jLong *shapeInfo1, const Nd4jLong *shapeInfo2) {
-        
+
+    if (shapeInfo1 == shapeInfo2)
+        return true;
+
     if (shapeInfo1[0] != shapeInfo2[0])
         return false;
 
@@ -2878,6 +2885,9 @@ INLINEDEF _CUDA_HD bool haveSameShapeAndStrides(const Nd4jLong *shapeInfo1, cons
      * @return
      */
     INLINEDEF _CUDA_HD bool equalsSoft(const Nd4jLong *shapeA, const Nd4jLong *shapeB) {
+        if (shapeA == shapeB)
+            return true;
+
         if (shapeA[0] != shapeB[0])
             return false;
 
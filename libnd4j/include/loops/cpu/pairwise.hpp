@@ -26,6 +26,8 @@
 #include <helpers/shape.h>
 #include <op_boilerplate.h>
 #include <OmpLaunchHelper.h>
+#include <helpers/ThreadPool.h>
+#include <helpers/IsaDispatch.h>
 
 using namespace simdOps;
 
@@ -72,37 +74,25 @@ namespace functions {
 
             if (xEws == 1 && yEws == 1 && zEws == 1) {
 
-                PRAGMA_OMP_PARALLEL_THREADS(info._numThreads)
-                {
-                    auto threadNum = omp_get_thread_num();
-                    auto threadOffset = info.getThreadOffset(threadNum);
-                    auto xi = x + threadOffset;
-                    auto yi = y + threadOffset;
-                    auto zi = z + threadOffset;
+                nd4j::Threads::parallel_for([&](Nd4jLong start, Nd4jLong stop) {
+                    auto ulen = static_cast<unsigned int>(stop - start);
 
-                    auto ulen = static_cast<unsigned int>(info.getItersPerThread(threadNum));
-
-                    PRAGMA_OMP_SIMD
-                    for (unsigned int i = 0; i < ulen; i++)
-                        zi[i] = OpType::op(xi[i], yi[i], extraParams);
-                }
+                    nd4j::IsaDispatch<nd4j::PairwiseKernel<X, Y, Z, OpType>>::run(x + start, y + start, z + start, extraParams, ulen);
+                }, 0, n, 0, info._numThreads);
             }
             else {
 
-                PRAGMA_OMP_PARALLEL_THREADS(info._numThreads)
-                {
-                    auto threadNum = omp_get_thread_num();
-                    auto threadOffset = info.getThreadOffset(threadNum);
-                    auto xi = x + xEws*threadOffset;
-                    auto yi = y + yEws*threadOffset;
-                    auto zi = z + zEws*threadOffset;
+                nd4j::Threads::parallel_for([&](Nd4jLong start, Nd4jLong stop) {
+                    auto xi = x + xEws*start;
+                    auto yi = y + yEws*start;
+                    auto zi = z + zEws*start;
 
-                    auto ulen = static_cast<unsigned int>(info.getItersPerThread(threadNum));
+                    auto ulen = static_cast<unsigned int>(stop - start);
 
                     PRAGMA_OMP_SIMD
                     for (unsigned int i = 0; i < ulen; i++)
                         zi[i*zEws] = OpType::op(xi[i*xEws], yi[i*yEws], extraParams);
-                }
+                }, 0, n, 0, info._numThreads);
             }
         }
 
@@ -23,6 +23,7 @@
 #include <types/types.h>
 #include <LoopKind.h>
 #include "../legacy_ops.h"
+#include <helpers/IsaDispatch.h>
 
 using namespace simdOps;
 
@@ -66,14 +67,14 @@ void ScalarTransform<X, Y, Z>::transform(void *vx, Nd4jLong *xShapeInfo,
     int num_threads = nd4j::math::nd4j_min<int>(numTads, omp_get_max_threads());
 
     if (kindOfLoop == nd4j::LoopKind::EWS1) {
+        const int isaLevel = nd4j::Environment::getInstance()->isaLevel();
+
         PRAGMA_OMP_PARALLEL_FOR_THREADS(num_threads)
         for (unsigned int r = 0; r < numTads; r++) {
             auto oZ = z + zTadOffsets[r];
             auto oX = x + xTadOffsets[r];
 
-            PRAGMA_OMP_SIMD
-            for (unsigned int f = 0; f < tadLength; f++)
-                oZ[f] = OpType::op(oX[f], scalars[r], extraParams);
+            nd4j::IsaDispatch<nd4j::ScalarKernel<X, Y, Z, OpType>>::runFor(isaLevel, oX, scalars[r], oZ, extraParams, (unsigned int) tadLength);
         }
     } 
     else {
@@ -218,9 +219,7 @@ void ScalarTransform<X, Y, Z>::transform(void *vx, Nd4jLong xEws,
             auto zi = z + threadOffset;
             auto ulen = static_cast<unsigned int>(info.getItersPerThread(threadNum));
 
-            PRAGMA_OMP_SIMD
-            for (unsigned int i = 0; i < ulen; i++)
-                zi[i] = OpType::op(xi[i], scalar, extraParams);
+            nd4j::IsaDispatch<nd4j::ScalarKernel<X, Y, Z, OpType>>::run(xi, scalar, zi, extraParams, ulen);
         }
     } 
     else {
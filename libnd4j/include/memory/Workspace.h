@@ -25,6 +25,7 @@
 #define LIBND4J_WORKSPACE_H
 
 #include <atomic>
+#include <map>
 #include <vector>
 #include <mutex>
 #include <dll.h>
@@ -55,18 +56,32 @@ namespace nd4j {
             Nd4jLong _initialSize = 0L;
             Nd4jLong _currentSize = 0L;
 
-            std::mutex _mutexAllocation;
             std::mutex _mutexSpills;
 
             bool _externalized = false;
 
-            std::vector<void*> _spills;
+            // spills of current cycle, along with their block size
+            std::vector<std::pair<void*, Nd4jLong>> _spills;
+
+            // spills released by previous cycles, grouped by block size
+            std::map<Nd4jLong, std::vector<void*>> _spillsPool;
 
             std::atomic<Nd4jLong> _spillsSize;
+            std::atomic<Nd4jLong> _pooledSize;
             std::atomic<Nd4jLong> _cycleAllocations;
 
+            // unique id and buffer generation, used to validate per-thread chunks
+            Nd4jLong _id = 0L;
+            std::atomic<Nd4jLong> _generation;
+            Nd4jLong _threadChunk = 0L;
+
             void init(Nd4jLong bytes);
             void freeSpills();
+            void releaseSpills();
+            void releasePool();
+
+            void* bumpBytes(Nd4jLong numBytes);
+            void* allocateSpill(Nd4jLong numBytes);
         public:
             explicit Workspace(ExternalWorkspace *external);
             explicit Workspace(Nd4jLong initialSize = 0);
@@ -76,6 +91,7 @@ namespace nd4j {
             Nd4jLong getCurrentSize();
             Nd4jLong getCurrentOffset();
             Nd4jLong getSpilledSize();
+            Nd4jLong getPooledSize();
             Nd4jLong getUsedSize();
 
             void expandBy(Nd4jLong numBytes);
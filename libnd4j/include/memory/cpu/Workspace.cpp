@@ -28,12 +28,91 @@
 #include "../Workspace.h"
 #include <helpers/logger.h>
 #include <templatemath.h>
+#include <Environment.h>
+#include <helpers/NumaHelper.h>
 #include <cstring>
 
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
 
 namespace nd4j {
     namespace memory {
+        // spills are rounded up to alignment, and big ones to page size, so pooled blocks fit requests of similar size
+        static const Nd4jLong SPILL_ALIGNMENT = 64L;
+        static const Nd4jLong HUGE_PAGE_SIZE = 2L * 1024L * 1024L;
+        static const Nd4jLong NUMA_PAGE_SIZE = 4096L;
+
+        // pooled block is reused for request at least this fraction of its size, so pool doesn't waste too much memory
+        static const Nd4jLong SPILL_REUSE_RATIO = 2L;
+
+        // number of workspaces each thread can hold chunks for simultaneously
+        static const int THREAD_CHUNKS = 4;
+
+        static std::atomic<Nd4jLong> _workspaceCounter(0L);
+
+        struct ThreadChunk {
+            Nd4jLong id = -1L;
+            Nd4jLong generation = -1L;
+            char *ptr = nullptr;
+            Nd4jLong left = 0L;
+        };
+
+        static thread_local ThreadChunk _threadChunks[THREAD_CHUNKS];
+
+        static Nd4jLong spillSize(Nd4jLong numBytes) {
+            auto granularity = numBytes < NUMA_PAGE_SIZE ? SPILL_ALIGNMENT : NUMA_PAGE_SIZE;
+            return (numBytes + granularity - 1) / granularity * granularity;
+        }
+
+        static char* allocateHost(Nd4jLong bytes) {
+            char *ptr = nullptr;
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+            if (Environment::getInstance()->isWorkspaceHugePages() && bytes >= HUGE_PAGE_SIZE) {
+                void *p = nullptr;
+                auto aligned = (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+                if (posix_memalign(&p, HUGE_PAGE_SIZE, aligned) == 0) {
+                    madvise(p, aligned, MADV_HUGEPAGE);
+                    ptr = (char *) p;
+                }
+            }
+#endif
+
+            const auto numaPolicy = Environment::getInstance()->numaPolicy();
+
+#if defined(__linux__)
+            // NUMA placement works with whole pages, so buffer should start at page boundary
+            if (ptr == nullptr && numaPolicy != NUMA_DEFAULT) {
+                void *p = nullptr;
+                if (posix_memalign(&p, NUMA_PAGE_SIZE, bytes) == 0)
+                    ptr = (char *) p;
+            }
+#endif
+
+            if (ptr == nullptr)
+                ptr = (char *) malloc(bytes);
+
+            CHECK_ALLOC(ptr, "Failed to allocate new workspace");
+
+            NumaHelper::place(ptr, bytes);
+
+            // arrays initialize their buffers anyway, so zeroing is optional. With local policy pages are touched by all threads, to spread them over nodes
+            if (Environment::getInstance()->isWorkspaceZeroing() || numaPolicy == NUMA_LOCAL)
+                NumaHelper::firstTouch(ptr, bytes, 1);
+
+            return ptr;
+        }
+
         Workspace::Workspace(ExternalWorkspace *external) {
+            this->_cycleAllocations = 0;
+            this->_spillsSize = 0;
+            this->_pooledSize = 0;
+            this->_generation = 0;
+            this->_id = _workspaceCounter++;
+            this->_threadChunk = Environment::getInstance()->workspaceThreadChunk();
+
             if (external->sizeHost() > 0) {
                 _ptrHost = (char *) external->pointerHost();
                 _ptrDevice = (char *) external->pointerDevice();
@@ -41,8 +120,6 @@ namespace nd4j {
                 _initialSize = external->sizeHost();
                 _currentSize = external->sizeHost();
                 _offset = 0L;
-                this->_cycleAllocations = 0;
-                this->_spillsSize = 0;
 
                 _externalized = true;
             }
@@ -50,11 +127,7 @@ namespace nd4j {
 
         Workspace::Workspace(Nd4jLong initialSize) {
             if (initialSize > 0) {
-                this->_ptrHost = (char *) malloc(initialSize);
-
-                CHECK_ALLOC(this->_ptrHost, "Failed to allocate new workspace");
-
-                memset(this->_ptrHost, 0, initialSize);
+                this->_ptrHost = allocateHost(initialSize);
                 this->_allocatedHost = true;
             } else
                 this->_allocatedHost = false;
@@ -64,6 +137,10 @@ namespace nd4j {
             this->_offset = 0;
             this->_cycleAllocations = 0;
             this->_spillsSize = 0;
+            this->_pooledSize = 0;
+            this->_generation = 0;
+            this->_id = _workspaceCounter++;
+            this->_threadChunk = Environment::getInstance()->workspaceThreadChunk();
         }
 
         void Workspace::init(Nd4jLong bytes) {
@@ -71,13 +148,14 @@ namespace nd4j {
                 if (this->_allocatedHost && !_externalized)
                     free((void *)this->_ptrHost);
 
-                this->_ptrHost =(char *) malloc(bytes);
-
-                CHECK_ALLOC(this->_ptrHost, "Failed to allocate new workspace");
+                this->_ptrHost = allocateHost(bytes);
 
-                memset(this->_ptrHost, 0, bytes);
                 this->_currentSize = bytes;
                 this->_allocatedHost = true;
+
+                // main buffer is big enough now, so pooled spills aren't needed anymore
+                releasePool();
+                _generation++;
             }
         }
 
@@ -89,18 +167,34 @@ namespace nd4j {
             this->init(numBytes);
         }
 
-        void Workspace::freeSpills() {
+        void Workspace::releaseSpills() {
+            std::lock_guard<std::mutex> lock(_mutexSpills);
             _spillsSize = 0;
 
-            if (_spills.size() < 1)
-                return;
-
-            for (auto v:_spills)
-                free(v);
+            for (auto &v:_spills) {
+                _spillsPool[v.second].emplace_back(v.first);
+                _pooledSize += v.second;
+            }
 
             _spills.clear();
         }
 
+        void Workspace::releasePool() {
+            std::lock_guard<std::mutex> lock(_mutexSpills);
+
+            for (auto &c:_spillsPool)
+                for (auto v:c.second)
+                    free(v);
+
+            _spillsPool.clear();
+            _pooledSize = 0;
+        }
+
+        void Workspace::freeSpills() {
+            releaseSpills();
+            releasePool();
+        }
+
         Workspace::~Workspace() {
             if (this->_allocatedHost && !_externalized)
                 free((void *)this->_ptrHost);
@@ -120,64 +214,120 @@ namespace nd4j {
             return _offset.load();
         }
 
+        void* Workspace::bumpBytes(Nd4jLong numBytes) {
+            auto offset = _offset.load();
+            do {
+                if (offset + numBytes > _currentSize)
+                    return nullptr;
+            } while (!_offset.compare_exchange_weak(offset, offset + numBytes));
 
-        void* Workspace::allocateBytes(Nd4jLong numBytes) {
-            if (numBytes < 1) {
-                nd4j_printf("Bad number of bytes requested for allocation: %i\n", numBytes);
-                throw std::invalid_argument("Number of bytes for allocation should be positive");
-            }
+            return (void *)(_ptrHost + offset);
+        }
 
-            //numBytes += 32;
-            void* result = nullptr;
-            this->_cycleAllocations += numBytes;
-            this->_mutexAllocation.lock();
+        void* Workspace::allocateSpill(Nd4jLong numBytes) {
+            auto size = spillSize(numBytes);
+            void *p = nullptr;
 
-            if (_offset.load() + numBytes > _currentSize) {
-                nd4j_debug("Allocating %lld bytes in spills\n", numBytes);
-                this->_mutexAllocation.unlock();
+            std::lock_guard<std::mutex> lock(_mutexSpills);
+
+            // smallest pooled block that fits
+            auto it = _spillsPool.lower_bound(size);
+            if (it != _spillsPool.end() && it->first <= size * SPILL_REUSE_RATIO) {
+                size = it->first;
+                p = it->second.back();
+                it->second.pop_back();
+                if (it->second.empty())
+                    _spillsPool.erase(it);
 
-                void *p = malloc(numBytes);
+                _pooledSize -= size;
+
+                nd4j_debug("Reusing %lld bytes from spills pool\n", numBytes);
+            } else {
+                nd4j_debug("Allocating %lld bytes in spills\n", numBytes);
 
+                p = malloc(size);
                 CHECK_ALLOC(p, "Failed to allocate new workspace");
+            }
 
-                _mutexSpills.lock();
-                _spills.push_back(p);
-                _mutexSpills.unlock();
+            _spills.emplace_back(std::pair<void*, Nd4jLong>(p, size));
+            _spillsSize += numBytes;
 
-                _spillsSize += numBytes;
+            return p;
+        }
 
-                return p;
+        void* Workspace::allocateBytes(Nd4jLong numBytes) {
+            if (numBytes < 1) {
+                nd4j_printf("Bad number of bytes requested for allocation: %i\n", numBytes);
+                throw std::invalid_argument("Number of bytes for allocation should be positive");
             }
 
-            result = (void *)(_ptrHost + _offset.load());
-            _offset += numBytes;
-            //memset(result, 0, (int) numBytes);
+            // small allocations are served from chunk owned by current thread, without touching shared offset
+            if (_threadChunk > 0 && numBytes <= _threadChunk / 4) {
+                auto aligned = (numBytes + 7) / 8 * 8;
+                auto generation = _generation.load();
+                auto &chunk = _threadChunks[_id % THREAD_CHUNKS];
+
+                if (chunk.id != _id || chunk.generation != generation || chunk.left < aligned) {
+                    auto p = (char *) bumpBytes(_threadChunk);
+                    if (p != nullptr) {
+                        this->_cycleAllocations += _threadChunk;
+
+                        chunk.id = _id;
+                        chunk.generation = generation;
+                        chunk.ptr = p;
+                        chunk.left = _threadChunk;
+                    }
+                }
+
+                if (chunk.id == _id && chunk.generation == generation && chunk.left >= aligned) {
+                    auto result = (void *) chunk.ptr;
+                    chunk.ptr += aligned;
+                    chunk.left -= aligned;
+
+                    return result;
+                }
+
+                this->_cycleAllocations += numBytes;
+                return allocateSpill(numBytes);
+            }
 
-            nd4j_debug("Allocating %lld bytes from workspace; Current PTR: %p; Current offset: %lld\n", numBytes, result, _offset.load());
+            this->_cycleAllocations += numBytes;
+
+            auto result = bumpBytes(numBytes);
+            if (result == nullptr)
+                return allocateSpill(numBytes);
 
-            this->_mutexAllocation.unlock();
+            nd4j_debug("Allocating %lld bytes from workspace; Current PTR: %p; Current offset: %lld\n", numBytes, result, _offset.load());
 
             return result;
         }
 
         Nd4jLong Workspace::getAllocatedSize() {
-            return getCurrentSize() + getSpilledSize();
+            return getCurrentSize() + getSpilledSize() + getPooledSize();
         }
 
         void Workspace::scopeIn() {
-            freeSpills();
+            releaseSpills();
             init(_cycleAllocations.load());
             _cycleAllocations = 0;
         }
 
         void Workspace::scopeOut() {
             _offset = 0;
+
+            // everything allocated within this scope is dead now: thread chunks are invalidated, spills go back to pool
+            _generation++;
+            releaseSpills();
         }
 
         Nd4jLong Workspace::getSpilledSize() {
             return _spillsSize.load();
         }
 
+        Nd4jLong Workspace::getPooledSize() {
+            return _pooledSize.load();
+        }
+
         void* Workspace::allocateBytes(nd4j::memory::MemoryType type, Nd4jLong numBytes) {
             if (type == DEVICE)
                 throw std::runtime_error("CPU backend doesn't have device memory");
@@ -191,4 +341,3 @@ namespace nd4j {
         }
     }
 }
-
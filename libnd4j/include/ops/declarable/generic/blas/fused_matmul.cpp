@@ -0,0 +1,121 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <op_boilerplate.h>
+#if NOT_EXCLUDED(OP_fused_matmul)
+
+#include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/fused_ops.h>
+#include <MmulHelper.h>
+
+namespace nd4j {
+    namespace ops {
+        CUSTOM_OP_IMPL(fused_matmul, -2, 1, false, -2, -2) {
+            auto x = INPUT_VARIABLE(0);
+            auto y = INPUT_VARIABLE(1);
+            auto z = OUTPUT_VARIABLE(0);
+
+            REQUIRE_TRUE(block.numI() >= 3, 0, "fused_matmul: transX, transY and transZ arguments expected");
+
+            int transX = INT_ARG(0);
+            int transY = INT_ARG(1);
+            const int transZ = INT_ARG(2);
+
+            REQUIRE_TRUE(x->rankOf() > 0 && y->rankOf() > 0, 0, "fused_matmul: input arrays must have rank bigger than 0 (should not be scalars), but got instead: x rank = %i, y rank = %i !", x->rankOf(), y->rankOf());
+
+            if (transZ) {
+                x = INPUT_VARIABLE(1);
+                y = INPUT_VARIABLE(0);
+                bool temp = transX;
+                transX = !transY;
+                transY = !temp;
+            }
+
+            std::vector<NDArray*> operands;
+            for (int e = 2; e < block.width(); e++)
+                operands.emplace_back(INPUT_VARIABLE(e));
+
+            auto steps = helpers::parseFusedSteps(*block.getIArguments(), 3, *block.getTArguments(), operands);
+
+            auto mmulShape = ShapeUtils::evalShapeForMatmul(x->getShapeInfo(), y->getShapeInfo(), transX, transY);
+            auto mmulType = x->dataType() > y->dataType() ? x->dataType() : y->dataType();
+
+            // epilogue is applied in place, unless it changes shape or type of the product
+            if (z->isSameShape(mmulShape) && z->dataType() == mmulType) {
+                MmulHelper::matmul(x, y, z, transX, transY);
+                helpers::fusedElementwise(z, steps, z);
+            } else {
+                auto mmulOrder = x->ordering() == 'c' && y->ordering() == 'c' ? 'c' : 'f';
+                NDArray product(mmulOrder, mmulShape, mmulType, block.getWorkspace());
+
+                MmulHelper::matmul(x, y, &product, transX, transY);
+                helpers::fusedElementwise(&product, steps, z);
+            }
+
+            return Status::OK();
+        }
+
+        DECLARE_TYPES(fused_matmul) {
+            getOpDescriptor()
+                    ->setAllowedInputTypes(0, {ALL_FLOATS})
+                    ->setAllowedInputTypes(1, {ALL_FLOATS})
+                    ->setAllowedOutputTypes(0, {ALL_FLOATS});
+        }
+
+        DECLARE_SHAPE_FN(fused_matmul) {
+            auto xShapeInfo = inputShape->at(0);
+            auto yShapeInfo = inputShape->at(1);
+
+            REQUIRE_TRUE(block.numI() >= 3, 0, "fused_matmul: transX, transY and transZ arguments expected");
+
+            int transX = INT_ARG(0);
+            int transY = INT_ARG(1);
+            const int transZ = INT_ARG(2);
+
+            REQUIRE_TRUE(xShapeInfo[0] > 0 && yShapeInfo[0] > 0, 0, "fused_matmul: input arrays must have rank bigger than 0 (should not be scalars), but got instead: x rank = %i, y rank = %i !", xShapeInfo[0], yShapeInfo[0]);
+
+            if (transZ) {
+                xShapeInfo = inputShape->at(1);
+                yShapeInfo = inputShape->at(0);
+                bool temp = transX;
+                transX = !transY;
+                transY = !temp;
+            }
+
+            auto zShapeOnly = ShapeUtils::evalShapeForMatmul(xShapeInfo, yShapeInfo, transX, transY);
+
+            auto dtypeX = ArrayOptions::dataType(xShapeInfo);
+            auto dtypeY = ArrayOptions::dataType(yShapeInfo);
+            auto dtypeZ = dtypeX > dtypeY ? dtypeX : dtypeY;
+            auto zOrder = shape::order(xShapeInfo) == 'c' && shape::order(yShapeInfo) == 'c' ? 'c' : 'f';
+
+            auto mmulShape = ShapeBuilders::createShapeInfo(dtypeZ, zOrder, zShapeOnly, block.getWorkspace());
+
+            std::vector<Nd4jLong*> operandShapes;
+            for (int e = 2; e < inputShape->size(); e++)
+                operandShapes.emplace_back(inputShape->at(e));
+
+            auto newShape = helpers::fusedOutputShapeInfo(mmulShape, *block.getIArguments(), 3, operandShapes, block.getWorkspace());
+            RELEASE(mmulShape, block.getWorkspace());
+
+            REQUIRE_TRUE(newShape != nullptr, 0, "fused_matmul: operand shapes aren't broadcastable");
+
+            return SHAPELIST(newShape);
+        }
+    }
+}
+
+#endif
@@ -149,24 +149,8 @@ CUSTOM_OP_IMPL(conv3dnew, 2, 1, false, 0, 13) {
 #endif
     nd4j_debug("MKL-DNN is not used for conv3dnew!\n", 0);
 
-    std::vector<int> permutForOutput;
+    ConvolutionUtils::conv3d(block, input, weights, bias, output, kD, kH, kW, sD, sH, sW, pD, pH, pW, dD, dH, dW, isNCDHW);
 
-    if(!isNCDHW)
-        input = input->permute({0,4,1,2,3});                                    // [bS, iD, iH, iW, iC] -> [bS, iC, iD, iH, iW]
-    else
-        permutForOutput    = {0,2,3,4,1};                                        // [bS, oC, oD, oH, oW] -> [bS, oD, oH, oW, oC]
-
-    NDArray columns(input->ordering(), {bS, iC, kD, kH, kW, oD, oH, oW}, input->dataType(), block.getWorkspace());
-    ConvolutionUtils::vol2col(*input, columns, sD, sH, sW, pD, pH, pW, dD, dH, dW);                 // [bS, iC, iD, iH, iW] is convoluted to [bS, iC, kD, kH, kW, oD, oH, oW]
-    // [bS, iC, kD, kH, kW, oD, oH, oW] x [kD, kH, kW, iC, oC] = [bS, oD, oH, oW, oC]
-    MmulHelper::tensorDot(&columns, weights, output, {1,2,3,4}, {3,0,1,2}, permutForOutput);
-
-    if(bias)
-        output->applyBroadcast(broadcast::Add, {indIOioC}, bias);
-
-    if(!isNCDHW)
-        delete input;                
-    
     return Status::OK();
 }
 
@@ -444,38 +428,8 @@ CUSTOM_OP_IMPL(conv3dnew_bp, 3, 2, false, 0, 13) {
 #endif
     nd4j_debug("MKL-DNN is not used for conv3dnew_bp!\n", 0);
 
-    std::vector<int> gradOaxesForDot;
+    ConvolutionUtils::conv3dBP(block, input, weights, gradO, gradI, gradW, gradB, kD, kH, kW, sD, sH, sW, pD, pH, pW, dD, dH, dW, isNDHWC);
 
-    if(!isNDHWC) {
-        input = input->permute({0,4,1,2,3});                                    // [bS, iD, iH, iW, iC] -> [bS, iC, iD, iH, iW]
-        gradI = gradI->permute({0,4,1,2,3});                                    // [bS, iD, iH, iW, iC] -> [bS, iC, iD, iH, iW]
-        gradOaxesForDot  = {0,1,2,3};                                           // bS, oD, oH, oW
-    }
-    else
-        gradOaxesForDot  = {0,2,3,4};                                           // bS, oD, oH, oW
-
-    // ----- calculation of gradW and gradB ----- //                
-    NDArray columns(input->ordering(), {bS, iC, kD, kH, kW, oD, oH, oW}, input->dataType(), block.getWorkspace());
-    ConvolutionUtils::vol2col(*input, columns, sD, sH, sW, pD, pH, pW, dD, dH, dW);                   // [bS, iC, iD, iH, iW] is convoluted to [bS, iC, kD, kH, kW, oD, oH, oW]
-    MmulHelper::tensorDot(&columns, gradO, gradW, {0,5,6,7}, gradOaxesForDot, {3,0,1,2,4});     // [bS, iC, kD, kH, kW, oD, oH, oW] x [bS, oD, oH, oW, oC]/[bS, oC, oD, oH, oW] = [iC, kD, kH, kW, oC]
-
-    if(gradB) {        
-        if(gradB->rankOf() == 2) 
-            gradB = gradB->reshape(gradB->ordering(), {(int)gradB->lengthOf()});
-        gradO->reduceAlongDimension(reduce::Sum, gradB, gradOaxesForDot);                          // sum over bS oD oH oW
-        if(gradB != OUTPUT_VARIABLE(2)) 
-            delete gradB;
-    }
-
-    //----- calculation of gradI -----//            
-    MmulHelper::tensorDot(weights, gradO, &columns, {indWoC}, {indIOioC}, {2,3,4,1,0,5,6,7});   // [kD, kH, kW, iC, oC] x [bS, oD, oH, oW, oC]/[bS, oC, oD, oH, oW] = [kD, kH, kW, iC, bS, oD, oH, oW]
-    ConvolutionUtils::col2vol(columns, *gradI, sD, sH, sW, pD, pH, pW, dD, dH, dW);                   // columns [bS, iC, kD, kH, kW, oD, oH, oW] is de-convoluted to  [bS, iC, iD, iH, iW]
-   
-    if(!isNDHWC) {
-        delete input;        
-        delete gradI;
-    }
-    
     return Status::OK();
 }
 
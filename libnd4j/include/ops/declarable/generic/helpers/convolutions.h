@@ -79,6 +79,11 @@ namespace nd4j {
 
             static void conv2d(nd4j::graph::Context& block, const std::vector<NDArray*>& inArrs, NDArray* output, const std::vector<int>& intArgs);
 
+            // Winograd F(2x2, 3x3)/F(4x4, 3x3) path, used for 3x3 undilated stride-1 convolutions of float/double arrays
+            static bool isWinogradApplicable(const NDArray* input, const NDArray* weights, const NDArray* bias, const NDArray* output, const int kH, const int kW, const int sH, const int sW, const int dH, const int dW);
+
+            static void conv2dWinograd(nd4j::graph::Context& block, const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output, const int pH, const int pW, const int isNCHW);
+
             static void conv2dBP(nd4j::graph::Context& block, const std::vector<NDArray*>& inArrs, const std::vector<NDArray*>& outArrs, const std::vector<int>& intArgs);
 
             static void conv2dBP(nd4j::graph::Context& block, const NDArray* input, const NDArray* weights, const NDArray* bias, const NDArray* gradO, NDArray* gradI, NDArray* gradW, NDArray* gradB, const int kH, const int kW, const int sH, const int sW, int pH, int pW, const int dH, const int dW, const int isSameMode, const int isNCHW);
@@ -89,6 +94,10 @@ namespace nd4j {
 
             static void sconv2d(nd4j::graph::Context& block, const NDArray* input, const NDArray* weightsDepth, const NDArray* weightsPoint, const NDArray* bias,  NDArray* output, const int kH, const int kW, const int sH, const int sW, int pH, int pW, const int dH, const int dW, const int isSameMode, const int isNCHW);
 
+            static void conv3d(nd4j::graph::Context& block, const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output, const int kD, const int kH, const int kW, const int sD, const int sH, const int sW, const int pD, const int pH, const int pW, const int dD, const int dH, const int dW, const int isNCDHW);
+
+            static void conv3dBP(nd4j::graph::Context& block, const NDArray* input, const NDArray* weights, const NDArray* gradO, NDArray* gradI, NDArray* gradW, NDArray* gradB, const int kD, const int kH, const int kW, const int sD, const int sH, const int sW, const int pD, const int pH, const int pW, const int dD, const int dH, const int dW, const int isNCDHW);
+
             static void vol2col(const NDArray& vol, NDArray& col, const int sD, const int sH, const int sW, const int pD, const int pH, const int pW, const int dD, const int dH, const int dW);
 
             static void col2vol(const NDArray& col, NDArray& vol, const int sD, const int sH, const int sW, const int pD, const int pH, const int pW, const int dD, const int dH, const int dW);
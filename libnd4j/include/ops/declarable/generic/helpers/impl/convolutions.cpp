@@ -24,6 +24,10 @@
 #include <ops/declarable/helpers/col2im.h>
 #include <NDArrayFactory.h>
 #include <MmulHelper.h>
+#include <helpers/ThreadPool.h>
+#include <helpers/OmpLaunchHelper.h>
+#include <algorithm>
+#include <vector>
 
 namespace nd4j {
 namespace ops  {
@@ -404,6 +408,777 @@ else
 }
 
 
+//////////////////////////////////////////////////////////////////////////
+// Implicit GEMM path for conv2d/conv3d on CPU.
+// Convolution is the product [oD*oH*oW, kD*kH*kW*iC] x [kD*kH*kW*iC, oC], but columns are packed for one tile of output pixels at a time,
+// so scratch memory doesn't depend on image size, and results go directly into output array. 2d case is handled as 3d case with unit depth
+struct ConvGeometry {
+    int bS, iC, iD, iH, iW, oC, oD, oH, oW;
+    int kD, kH, kW, sD, sH, sW, pD, pH, pW, dD, dH, dW;
+
+    // strides of input and output in [b, c, d, h, w] order, regardless of data format. Depth strides are 0 in 2d case
+    Nd4jLong inStr[5];
+    Nd4jLong outStr[5];
+
+    FORCEINLINE Nd4jLong numPixels() const { return static_cast<Nd4jLong>(oD) * oH * oW; }
+
+    // length of GEMM reduction dimension, kernel positions go first, input channels last - the same way as in weights
+    FORCEINLINE int numK() const { return kD * kH * kW * iC; }
+};
+
+// max number of kernel rows applied to whole tile at once, keeps slice of weights in L1/L2
+#define CONV_TILE_K 64
+
+//////////////////////////////////////////////////////////////////////////
+static ConvGeometry convGeometry2d(const NDArray& input, const NDArray& output, const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW, const int isNCHW) {
+
+    ConvGeometry g;
+    int indIOioC, indIiH, indWoC, indWiC, indWkH, indOoH;
+    ConvolutionUtils::getSizesAndIndexesConv2d(isNCHW, input, output, g.bS, g.iC, g.iH, g.iW, g.oC, g.oH, g.oW, indIOioC, indIiH, indWiC, indWoC, indWkH, indOoH);
+
+    g.iD = g.oD = g.kD = g.sD = g.dD = 1;
+    g.pD = 0;
+    g.kH = kH; g.kW = kW; g.sH = sH; g.sW = sW; g.pH = pH; g.pW = pW; g.dH = dH; g.dW = dW;
+
+    g.inStr[0]  = input.stridesOf()[0];
+    g.inStr[1]  = input.stridesOf()[indIOioC];
+    g.inStr[2]  = 0;
+    g.inStr[3]  = input.stridesOf()[indIiH];
+    g.inStr[4]  = input.stridesOf()[indIiH + 1];
+    g.outStr[0] = output.stridesOf()[0];
+    g.outStr[1] = output.stridesOf()[indIOioC];
+    g.outStr[2] = 0;
+    g.outStr[3] = output.stridesOf()[indOoH];
+    g.outStr[4] = output.stridesOf()[indOoH + 1];
+
+    return g;
+}
+
+//////////////////////////////////////////////////////////////////////////
+static ConvGeometry convGeometry3d(const NDArray& input, const NDArray& output, const int kD, const int kH, const int kW, const int sD, const int sH, const int sW, const int pD, const int pH, const int pW, const int dD, const int dH, const int dW, const int isNCDHW) {
+
+    ConvGeometry g;
+    int indIOioC, indIOioD, indWoC, indWiC, indWkD;
+    ConvolutionUtils::getSizesAndIndexesConv3d(isNCDHW, input, output, g.bS, g.iC, g.iD, g.iH, g.iW, g.oC, g.oD, g.oH, g.oW, indIOioC, indIOioD, indWiC, indWoC, indWkD);
+
+    g.kD = kD; g.kH = kH; g.kW = kW; g.sD = sD; g.sH = sH; g.sW = sW; g.pD = pD; g.pH = pH; g.pW = pW; g.dD = dD; g.dH = dH; g.dW = dW;
+
+    g.inStr[0]  = input.stridesOf()[0];
+    g.inStr[1]  = input.stridesOf()[indIOioC];
+    g.outStr[0] = output.stridesOf()[0];
+    g.outStr[1] = output.stridesOf()[indIOioC];
+    for (int e = 0; e < 3; e++) {
+        g.inStr[2 + e]  = input.stridesOf()[indIOioD + e];
+        g.outStr[2 + e] = output.stridesOf()[indIOioD + e];
+    }
+
+    return g;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// implicit GEMM path works on arrays of the same floating point type only, mixed types go through im2col/vol2col
+static bool isImplicitGemmApplicable(const std::initializer_list<const NDArray*>& arrays) {
+
+    const NDArray* first = *arrays.begin();
+    if (!DataTypeUtils::isR(first->dataType()))
+        return false;
+
+    for (auto array: arrays)
+        if (array != nullptr && array->dataType() != first->dataType())
+            return false;
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// BLAS GEMM over materialized columns is faster, so implicit GEMM is used for dense convolutions only when columns of colLength elements don't fit into limit
+static bool isImplicitGemmPreferred(const std::initializer_list<const NDArray*>& arrays, const Nd4jLong colLength) {
+
+    if (!isImplicitGemmApplicable(arrays))
+        return false;
+
+    const auto colBytes = colLength * static_cast<Nd4jLong>(DataTypeUtils::sizeOfElement((*arrays.begin())->dataType()));
+    return colBytes > Environment::getInstance()->im2colLimit();
+}
+
+//////////////////////////////////////////////////////////////////////////
+// number of output pixels per tile, columns tile and accumulators together take ~64K elements
+static int tileSize(const ConvGeometry& g) {
+
+    Nd4jLong tile = 65536 / (g.numK() + g.oC);
+    tile = nd4j::math::nd4j_max<Nd4jLong>(4, nd4j::math::nd4j_min<Nd4jLong>(256, tile));
+
+    return static_cast<int>(nd4j::math::nd4j_min<Nd4jLong>(tile, g.numPixels()));
+}
+
+//////////////////////////////////////////////////////////////////////////
+// packs rows [k0, k1) of columns for output pixels [p0, p0 + numP) of sample b into col [numP, k1 - k0], padding is filled with zeros
+template <typename T>
+static void packColumns_(const ConvGeometry& g, const T* in, const int b, const Nd4jLong p0, const int numP, const int k0, const int k1, T* col) {
+
+    const int kLen = k1 - k0;
+    const int kHW  = g.kH * g.kW;
+    const Nd4jLong oHW = static_cast<Nd4jLong>(g.oH) * g.oW;
+    const T* inB = in + b * g.inStr[0];
+
+    for (int p = 0; p < numP; p++) {
+
+        const Nd4jLong pixel = p0 + p;
+        const int od = static_cast<int>(pixel / oHW);
+        const int oh = static_cast<int>((pixel % oHW) / g.oW);
+        const int ow = static_cast<int>(pixel % g.oW);
+
+        T* z = col + static_cast<Nd4jLong>(p) * kLen;
+
+        // every step takes a run of channels for single kernel position
+        for (int k = k0; k < k1; ) {
+            const int kPos = k / g.iC;
+            const int cStart = k % g.iC;
+            const int cStop  = nd4j::math::nd4j_min<int>(g.iC, cStart + k1 - k);
+
+            const int id = od * g.sD - g.pD + (kPos / kHW) * g.dD;
+            const int ih = oh * g.sH - g.pH + ((kPos / g.kW) % g.kH) * g.dH;
+            const int iw = ow * g.sW - g.pW + (kPos % g.kW) * g.dW;
+
+            if (static_cast<unsigned>(id) >= static_cast<unsigned>(g.iD) || static_cast<unsigned>(ih) >= static_cast<unsigned>(g.iH) || static_cast<unsigned>(iw) >= static_cast<unsigned>(g.iW)) {
+                for (int c = cStart; c < cStop; c++)
+                    *z++ = static_cast<T>(0.);
+            }
+            else {
+                const T* x = inB + id * g.inStr[2] + ih * g.inStr[3] + iw * g.inStr[4];
+                for (int c = cStart; c < cStop; c++)
+                    *z++ = x[c * g.inStr[1]];
+            }
+
+            k += cStop - cStart;
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// reads output pixels [p0, p0 + numP) of sample b from array of output shape into [numP, oC]
+template <typename T>
+static void packOutput_(const ConvGeometry& g, const T* out, const int b, const Nd4jLong p0, const int numP, T* tile) {
+
+    const Nd4jLong oHW = static_cast<Nd4jLong>(g.oH) * g.oW;
+    const T* outB = out + b * g.outStr[0];
+
+    for (int p = 0; p < numP; p++) {
+        const Nd4jLong pixel = p0 + p;
+        const T* x = outB + (pixel / oHW) * g.outStr[2] + ((pixel % oHW) / g.oW) * g.outStr[3] + (pixel % g.oW) * g.outStr[4];
+        T* z = tile + static_cast<Nd4jLong>(p) * g.oC;
+
+        for (int c = 0; c < g.oC; c++)
+            z[c] = x[c * g.outStr[1]];
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// weights [kD, kH, kW, iC, oC] or [kH, kW, iC, oC] as contiguous [K, oC] matrix, returns copy if weights aren't contiguous
+static NDArray* contiguousWeights(const NDArray* weights) {
+
+    if (weights->ordering() == 'c' && weights->ews() == 1)
+        return nullptr;
+
+    return const_cast<NDArray*>(weights)->dup('c');
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void implicitGemmConv_(const ConvGeometry& g, const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output) {
+
+    const int K  = g.numK();
+    const int oC = g.oC;
+    const int tile = tileSize(g);
+    const Nd4jLong numPixels = g.numPixels();
+    const Nd4jLong numTiles  = (numPixels + tile - 1) / tile;
+
+    NDArray* wCopy = contiguousWeights(weights);
+    const T* w  = (wCopy != nullptr ? wCopy : weights)->bufferAsT<T>();
+    const T* in = input->bufferAsT<T>();
+    T* out = output->bufferAsT<T>();
+
+    std::vector<T> biases(oC, static_cast<T>(0.));
+    if (bias != nullptr)
+        for (int c = 0; c < oC; c++)
+            biases[c] = bias->e<T>(c);
+
+    auto func = [&](Nd4jLong start, Nd4jLong stop) {
+        std::vector<T> col(static_cast<size_t>(tile) * K);
+        std::vector<T> acc(static_cast<size_t>(tile) * oC);
+
+        for (auto t = start; t < stop; t++) {
+            const int b = static_cast<int>(t / numTiles);
+            const Nd4jLong p0 = (t % numTiles) * tile;
+            const int numP = static_cast<int>(nd4j::math::nd4j_min<Nd4jLong>(tile, numPixels - p0));
+
+            packColumns_<T>(g, in, b, p0, numP, 0, K, col.data());
+
+            for (int p = 0; p < numP; p++)
+                std::copy(biases.data(), biases.data() + oC, acc.data() + static_cast<Nd4jLong>(p) * oC);
+
+            for (int k0 = 0; k0 < K; k0 += CONV_TILE_K) {
+                const int k1 = nd4j::math::nd4j_min<int>(K, k0 + CONV_TILE_K);
+
+                for (int p = 0; p < numP; p++) {
+                    T* z = acc.data() + static_cast<Nd4jLong>(p) * oC;
+                    const T* x = col.data() + static_cast<Nd4jLong>(p) * K;
+
+                    for (int k = k0; k < k1; k++) {
+                        const T v = x[k];
+                        const T* wK = w + static_cast<Nd4jLong>(k) * oC;
+
+                        PRAGMA_OMP_SIMD
+                        for (int c = 0; c < oC; c++)
+                            z[c] += v * wK[c];
+                    }
+                }
+            }
+
+            // results go straight into output, whatever its data format is
+            const Nd4jLong oHW = static_cast<Nd4jLong>(g.oH) * g.oW;
+            T* outB = out + b * g.outStr[0];
+            for (int p = 0; p < numP; p++) {
+                const Nd4jLong pixel = p0 + p;
+                T* z = outB + (pixel / oHW) * g.outStr[2] + ((pixel % oHW) / g.oW) * g.outStr[3] + (pixel % g.oW) * g.outStr[4];
+                const T* x = acc.data() + static_cast<Nd4jLong>(p) * oC;
+
+                for (int c = 0; c < oC; c++)
+                    z[c * g.outStr[1]] = x[c];
+            }
+        }
+    };
+
+    auto numThreads = OmpLaunchHelper::betterThreads(output->lengthOf() * K, Threads::maxThreads());
+    Threads::parallel_for(func, 0, g.bS * numTiles, 1, numThreads);
+
+    delete wCopy;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// gradW [kD, kH, kW, iC, oC] = columns^T x gradO, every thread owns range of K rows, so no reduction between threads is needed
+template <typename T>
+static void implicitGemmConvBPWeights_(const ConvGeometry& g, const NDArray* input, const NDArray* gradO, NDArray* gradW) {
+
+    const int K  = g.numK();
+    const int oC = g.oC;
+    const int tile = tileSize(g);
+    const Nd4jLong numPixels = g.numPixels();
+
+    const T* in = input->bufferAsT<T>();
+    T* gW = gradW->bufferAsT<T>();
+
+    // every thread reads whole gradO, so it's brought to [bS * numPixels, oC] layout once, unless it's already there
+    const T* gO = gradO->bufferAsT<T>();
+    std::vector<T> packed;
+    const bool pixelMajor = g.outStr[1] == 1 && g.outStr[4] == oC && g.outStr[3] == static_cast<Nd4jLong>(g.oW) * oC
+                            && (g.oD == 1 || g.outStr[2] == static_cast<Nd4jLong>(g.oH) * g.oW * oC) && (g.bS == 1 || g.outStr[0] == numPixels * oC);
+    if (!pixelMajor) {
+        packed.resize(static_cast<size_t>(g.bS) * numPixels * oC);
+
+        auto pack = [&](Nd4jLong start, Nd4jLong stop) {
+            for (auto b = start; b < stop; b++)
+                packOutput_<T>(g, gO, static_cast<int>(b), 0, static_cast<int>(numPixels), packed.data() + b * numPixels * oC);
+        };
+        Threads::parallel_for(pack, 0, g.bS, 1, OmpLaunchHelper::betterThreads(gradO->lengthOf(), Threads::maxThreads()));
+
+        gO = packed.data();
+    }
+
+    // gradW strides in [K, oC] terms, available only if [kD, kH, kW, iC] dimensions can be merged
+    const int rank = gradW->rankOf();
+    const Nd4jLong* strides = gradW->stridesOf();
+
+    auto func = [&](Nd4jLong start, Nd4jLong stop) {
+        const int k0 = static_cast<int>(start);
+        const int kLen = static_cast<int>(stop - start);
+
+        std::vector<T> col(static_cast<size_t>(tile) * kLen);
+        std::vector<T> acc(static_cast<size_t>(kLen) * oC, static_cast<T>(0.));
+
+        for (int b = 0; b < g.bS; b++) {
+            for (Nd4jLong p0 = 0; p0 < numPixels; p0 += tile) {
+                const int numP = static_cast<int>(nd4j::math::nd4j_min<Nd4jLong>(tile, numPixels - p0));
+
+                packColumns_<T>(g, in, b, p0, numP, k0, k0 + kLen, col.data());
+                const T* grad = gO + (b * numPixels + p0) * oC;
+
+                for (int p = 0; p < numP; p++) {
+                    const T* x = col.data() + static_cast<Nd4jLong>(p) * kLen;
+                    const T* y = grad + static_cast<Nd4jLong>(p) * oC;
+
+                    for (int k = 0; k < kLen; k++) {
+                        const T v = x[k];
+                        T* z = acc.data() + static_cast<Nd4jLong>(k) * oC;
+
+                        PRAGMA_OMP_SIMD
+                        for (int c = 0; c < oC; c++)
+                            z[c] += v * y[c];
+                    }
+                }
+            }
+        }
+
+        // K index is decomposed back into [kD, kH, kW, iC] (or [kH, kW, iC]) coordinates of gradW
+        for (int k = 0; k < kLen; k++) {
+            Nd4jLong offset = 0;
+            Nd4jLong rest = k0 + k;
+            for (int d = rank - 2; d >= 0; d--) {
+                const Nd4jLong size = gradW->sizeAt(d);
+                offset += (rest % size) * strides[d];
+                rest /= size;
+            }
+
+            const T* x = acc.data() + static_cast<Nd4jLong>(k) * oC;
+            for (int c = 0; c < oC; c++)
+                gW[offset + c * strides[rank - 1]] = x[c];
+        }
+    };
+
+    auto numThreads = OmpLaunchHelper::betterThreads(gradO->lengthOf() * K, Threads::maxThreads());
+    Threads::parallel_for(func, 0, K, (K + numThreads - 1) / numThreads, numThreads);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// gradI = gradO x weights^T, scattered back to input positions. Tasks are (sample, block of input channels) pairs, so every gradI element has single writer
+template <typename T>
+static void implicitGemmConvBPInput_(const ConvGeometry& g, const NDArray* weights, const NDArray* gradO, NDArray* gradI) {
+
+    const int oC = g.oC;
+    const int kHW = g.kH * g.kW;
+    const int kPositions = g.kD * kHW;
+    const int tile = tileSize(g);
+    const Nd4jLong numPixels = g.numPixels();
+    const Nd4jLong oHW = static_cast<Nd4jLong>(g.oH) * g.oW;
+
+    NDArray* wCopy = contiguousWeights(weights);
+    const T* w  = (wCopy != nullptr ? wCopy : weights)->bufferAsT<T>();
+    const T* gO = gradO->bufferAsT<T>();
+    T* gI = gradI->bufferAsT<T>();
+
+    gradI->nullify();
+
+    auto numThreads = OmpLaunchHelper::betterThreads(gradO->lengthOf() * g.numK(), Threads::maxThreads());
+
+    // channels are split only as much as needed to keep all threads busy
+    const int numBlocks = nd4j::math::nd4j_min<int>(g.iC, nd4j::math::nd4j_max<int>(1, (4 * numThreads + g.bS - 1) / g.bS));
+    const int blockSize = (g.iC + numBlocks - 1) / numBlocks;
+    const int numTasks  = (g.iC + blockSize - 1) / blockSize;
+
+    auto func = [&](Nd4jLong start, Nd4jLong stop) {
+        std::vector<T> grad(static_cast<size_t>(tile) * oC);
+
+        for (auto t = start; t < stop; t++) {
+            const int b = static_cast<int>(t / numTasks);
+            const int cStart = static_cast<int>(t % numTasks) * blockSize;
+            const int cStop  = nd4j::math::nd4j_min<int>(g.iC, cStart + blockSize);
+            T* gIB = gI + b * g.inStr[0];
+
+            for (Nd4jLong p0 = 0; p0 < numPixels; p0 += tile) {
+                const int numP = static_cast<int>(nd4j::math::nd4j_min<Nd4jLong>(tile, numPixels - p0));
+                packOutput_<T>(g, gO, b, p0, numP, grad.data());
+
+                for (int p = 0; p < numP; p++) {
+                    const Nd4jLong pixel = p0 + p;
+                    const int od = static_cast<int>(pixel / oHW);
+                    const int oh = static_cast<int>((pixel % oHW) / g.oW);
+                    const int ow = static_cast<int>(pixel % g.oW);
+                    const T* y = grad.data() + static_cast<Nd4jLong>(p) * oC;
+
+                    for (int kPos = 0; kPos < kPositions; kPos++) {
+                        const int id = od * g.sD - g.pD + (kPos / kHW) * g.dD;
+                        const int ih = oh * g.sH - g.pH + ((kPos / g.kW) % g.kH) * g.dH;
+                        const int iw = ow * g.sW - g.pW + (kPos % g.kW) * g.dW;
+
+                        // padding doesn't receive gradients
+                        if (static_cast<unsigned>(id) >= static_cast<unsigned>(g.iD) || static_cast<unsigned>(ih) >= static_cast<unsigned>(g.iH) || static_cast<unsigned>(iw) >= static_cast<unsigned>(g.iW))
+                            continue;
+
+                        T* z = gIB + id * g.inStr[2] + ih * g.inStr[3] + iw * g.inStr[4];
+                        for (int c = cStart; c < cStop; c++) {
+                            const T* wK = w + (static_cast<Nd4jLong>(kPos) * g.iC + c) * oC;
+
+                            T sum = static_cast<T>(0.);
+                            for (int o = 0; o < oC; o++)
+                                sum += y[o] * wK[o];
+
+                            z[c * g.inStr[1]] += sum;
+                        }
+                    }
+                }
+            }
+        }
+    };
+
+    Threads::parallel_for(func, 0, g.bS * numTasks, 1, numThreads);
+
+    delete wCopy;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// Direct depthwise kernels. Every output channel c*mC + m depends on single input channel c only, so per-channel GEMMs after
+// im2col are tiny and the whole thing is bound by memory traffic of columns. Kernels below read input in place instead.
+// ConvGeometry is reused, with oC = iC*mC
+
+//////////////////////////////////////////////////////////////////////////
+// range [owStart, owStop) of output columns for which kernel column kw hits input rather than padding
+static FORCEINLINE void validColumns(const ConvGeometry& g, const int kw, int& owStart, int& owStop) {
+
+    const int offset = kw * g.dW - g.pW;                    // iw = ow * sW + offset
+
+    owStart = offset >= 0 ? 0 : (-offset + g.sW - 1) / g.sW;
+    owStop  = offset >= g.iW ? 0 : nd4j::math::nd4j_min<int>(g.oW, (g.iW - 1 - offset) / g.sW + 1);
+
+    if (owStop < owStart)
+        owStop = owStart;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// computes output row oh of sample b as [oW, iC*mC] with channels innermost, biases may be nullptr. Weights are contiguous [kH, kW, iC, mC]
+template <typename T>
+static void depthwiseRow_(const ConvGeometry& g, const int mC, const T* in, const T* w, const T* biases, const int b, const int oh, T* row) {
+
+    const int iC = g.iC;
+    const int oC = g.oC;
+    const Nd4jLong cStr = g.inStr[1];
+
+    for (int ow = 0; ow < g.oW; ow++) {
+        T* z = row + static_cast<Nd4jLong>(ow) * oC;
+        if (biases != nullptr)
+            std::copy(biases, biases + oC, z);
+        else
+            std::fill(z, z + oC, static_cast<T>(0.));
+    }
+
+    for (int kh = 0; kh < g.kH; kh++) {
+        const int ih = oh * g.sH - g.pH + kh * g.dH;
+        if (static_cast<unsigned>(ih) >= static_cast<unsigned>(g.iH))
+            continue;
+
+        const T* x0 = in + b * g.inStr[0] + ih * g.inStr[3];
+
+        for (int kw = 0; kw < g.kW; kw++) {
+            int owStart, owStop;
+            validColumns(g, kw, owStart, owStop);
+
+            const T* wK = w + static_cast<Nd4jLong>(kh * g.kW + kw) * oC;
+
+            for (int ow = owStart; ow < owStop; ow++) {
+                const T* x = x0 + (ow * g.sW - g.pW + kw * g.dW) * g.inStr[4];
+                T* z = row + static_cast<Nd4jLong>(ow) * oC;
+
+                if (mC == 1 && cStr == 1) {
+                    PRAGMA_OMP_SIMD
+                    for (int c = 0; c < iC; c++)
+                        z[c] += x[c] * wK[c];
+                }
+                else {
+                    for (int c = 0; c < iC; c++) {
+                        const T v = x[c * cStr];
+                        for (int m = 0; m < mC; m++)
+                            z[c * mC + m] += v * wK[c * mC + m];
+                    }
+                }
+            }
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// biases as contiguous vector of output type, or empty vector if there's no bias
+template <typename T>
+static std::vector<T> biasesAsVector(const NDArray* bias) {
+
+    std::vector<T> result;
+    if (bias != nullptr) {
+        result.resize(bias->lengthOf());
+        for (Nd4jLong e = 0; e < bias->lengthOf(); e++)
+            result[e] = bias->e<T>(e);
+    }
+
+    return result;
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void depthwiseConvDirect_(const ConvGeometry& g, const int mC, const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output, const int isNCHW) {
+
+    NDArray* wCopy = contiguousWeights(weights);
+    const T* w  = (wCopy != nullptr ? wCopy : weights)->bufferAsT<T>();
+    const T* in = input->bufferAsT<T>();
+    T* out = output->bufferAsT<T>();
+
+    const std::vector<T> biases = biasesAsVector<T>(bias);
+    const T* b0 = biases.empty() ? nullptr : biases.data();
+    const int oC = g.oC;
+
+    auto numThreads = OmpLaunchHelper::betterThreads(output->lengthOf() * g.kH * g.kW, Threads::maxThreads());
+
+    if (!isNCHW) {
+        // rows of output pixels, with all channels of a pixel processed together
+        const bool isDenseRow = g.outStr[1] == 1 && g.outStr[4] == oC;
+
+        auto func = [&](Nd4jLong start, Nd4jLong stop) {
+            std::vector<T> row(isDenseRow ? 0 : static_cast<size_t>(g.oW) * oC);
+
+            for (auto t = start; t < stop; t++) {
+                const int b  = static_cast<int>(t / g.oH);
+                const int oh = static_cast<int>(t % g.oH);
+                T* z = out + b * g.outStr[0] + oh * g.outStr[3];
+
+                if (isDenseRow) {
+                    depthwiseRow_<T>(g, mC, in, w, b0, b, oh, z);
+                    continue;
+                }
+
+                depthwiseRow_<T>(g, mC, in, w, b0, b, oh, row.data());
+                for (int ow = 0; ow < g.oW; ow++)
+                    for (int c = 0; c < oC; c++)
+                        z[ow * g.outStr[4] + c * g.outStr[1]] = row[static_cast<Nd4jLong>(ow) * oC + c];
+            }
+        };
+
+        Threads::parallel_for(func, 0, static_cast<Nd4jLong>(g.bS) * g.oH, 1, numThreads);
+    }
+    else {
+        // output planes, every one of them is the sum of shifted input planes of single channel, scaled by weights
+        auto func = [&](Nd4jLong start, Nd4jLong stop) {
+            for (auto t = start; t < stop; t++) {
+                const int b  = static_cast<int>(t / oC);
+                const int oc = static_cast<int>(t % oC);
+                const int c  = oc / mC;
+
+                const T* x = in  + b * g.inStr[0]  + c  * g.inStr[1];
+                T* z       = out + b * g.outStr[0] + oc * g.outStr[1];
+
+                const T init = b0 != nullptr ? b0[oc] : static_cast<T>(0.);
+                for (int oh = 0; oh < g.oH; oh++)
+                    for (int ow = 0; ow < g.oW; ow++)
+                        z[oh * g.outStr[3] + ow * g.outStr[4]] = init;
+
+                for (int oh = 0; oh < g.oH; oh++) {
+                    T* zR = z + oh * g.outStr[3];
+
+                    for (int kh = 0; kh < g.kH; kh++) {
+                        const int ih = oh * g.sH - g.pH + kh * g.dH;
+                        if (static_cast<unsigned>(ih) >= static_cast<unsigned>(g.iH))
+                            continue;
+
+                        for (int kw = 0; kw < g.kW; kw++) {
+                            int owStart, owStop;
+                            validColumns(g, kw, owStart, owStop);
+
+                            const T v = w[static_cast<Nd4jLong>(kh * g.kW + kw) * oC + oc];
+                            const T* xR = x + ih * g.inStr[3] + (kw * g.dW - g.pW) * g.inStr[4];
+                            const Nd4jLong xStr = g.sW * g.inStr[4];
+
+                            if (g.outStr[4] == 1 && xStr == 1) {
+                                PRAGMA_OMP_SIMD
+                                for (int ow = owStart; ow < owStop; ow++)
+                                    zR[ow] += v * xR[ow];
+                            }
+                            else {
+                                for (int ow = owStart; ow < owStop; ow++)
+                                    zR[ow * g.outStr[4]] += v * xR[ow * xStr];
+                            }
+                        }
+                    }
+                }
+            }
+        };
+
+        Threads::parallel_for(func, 0, static_cast<Nd4jLong>(g.bS) * oC, 1, numThreads);
+    }
+
+    delete wCopy;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// gradW and gradI of depthwise convolution. Channels are split between threads, so both gradients have single writer per element.
+// g is built for input and gradO, giStr holds strides of gradI in [b, c, d, h, w] order
+template <typename T>
+static void depthwiseConvBPDirect_(const ConvGeometry& g, const Nd4jLong* giStr, const int mC, const NDArray* input, const NDArray* weights, const NDArray* gradO, NDArray* gradI, NDArray* gradW, const int isNCHW) {
+
+    const int iC  = g.iC;
+    const int oC  = g.oC;
+    const int kHW = g.kH * g.kW;
+
+    NDArray* wCopy = contiguousWeights(weights);
+    const T* w  = (wCopy != nullptr ? wCopy : weights)->bufferAsT<T>();
+    const T* in = input->bufferAsT<T>();
+    const T* gO = gradO->bufferAsT<T>();
+    T* gI = gradI->bufferAsT<T>();
+    T* gW = gradW->bufferAsT<T>();
+    const Nd4jLong* gWStr = gradW->stridesOf();
+
+    gradI->nullify();
+
+    auto numThreads = OmpLaunchHelper::betterThreads(gradO->lengthOf() * kHW, Threads::maxThreads());
+
+    // with channels innermost, neighbouring channels are processed together. Planes are processed one by one
+    const int blockSize = isNCHW ? 1 : nd4j::math::nd4j_max<int>(1, iC / (4 * numThreads));
+    const int numBlocks = (iC + blockSize - 1) / blockSize;
+
+    auto func = [&](Nd4jLong start, Nd4jLong stop) {
+        std::vector<T> acc(static_cast<size_t>(kHW) * blockSize * mC);
+
+        for (auto t = start; t < stop; t++) {
+            const int cStart = static_cast<int>(t) * blockSize;
+            const int cStop  = nd4j::math::nd4j_min<int>(iC, cStart + blockSize);
+            const int cLen   = cStop - cStart;
+
+            std::fill(acc.begin(), acc.end(), static_cast<T>(0.));
+
+            for (int b = 0; b < g.bS; b++) {
+                for (int oh = 0; oh < g.oH; oh++) {
+                    for (int kh = 0; kh < g.kH; kh++) {
+                        const int ih = oh * g.sH - g.pH + kh * g.dH;
+                        if (static_cast<unsigned>(ih) >= static_cast<unsigned>(g.iH))
+                            continue;
+
+                        const T* xR = in + b * g.inStr[0] + ih * g.inStr[3];
+                        T* zR       = gI + b * giStr[0] + ih * giStr[3];
+                        const T* yR = gO + b * g.outStr[0] + oh * g.outStr[3];
+
+                        for (int kw = 0; kw < g.kW; kw++) {
+                            int owStart, owStop;
+                            validColumns(g, kw, owStart, owStop);
+
+                            const int kPos = kh * g.kW + kw;
+                            const T* wK = w + static_cast<Nd4jLong>(kPos) * oC;
+                            T* aK = acc.data() + static_cast<Nd4jLong>(kPos) * cLen * mC;
+
+                            if (isNCHW) {
+                                const T* x = xR + cStart * g.inStr[1] + (kw * g.dW - g.pW) * g.inStr[4];
+                                T* z       = zR + cStart * giStr[1] + (kw * g.dW - g.pW) * giStr[4];
+                                const Nd4jLong xStr = g.sW * g.inStr[4];
+                                const Nd4jLong zStr = g.sW * giStr[4];
+
+                                for (int m = 0; m < mC; m++) {
+                                    const T* y = yR + (cStart * mC + m) * g.outStr[1];
+                                    const T v = wK[cStart * mC + m];
+
+                                    T sum = static_cast<T>(0.);
+                                    for (int ow = owStart; ow < owStop; ow++) {
+                                        const T dy = y[ow * g.outStr[4]];
+                                        sum += dy * x[ow * xStr];
+                                        z[ow * zStr] += v * dy;
+                                    }
+
+                                    aK[m] += sum;
+                                }
+                            }
+                            else {
+                                for (int ow = owStart; ow < owStop; ow++) {
+                                    const Nd4jLong iw = ow * g.sW - g.pW + kw * g.dW;
+                                    const T* x = xR + iw * g.inStr[4];
+                                    T* z       = zR + iw * giStr[4];
+                                    const T* y = yR + ow * g.outStr[4];
+
+                                    for (int c = cStart; c < cStop; c++) {
+                                        const T xv = x[c * g.inStr[1]];
+                                        T* a = aK + (c - cStart) * mC;
+
+                                        T sum = static_cast<T>(0.);
+                                        for (int m = 0; m < mC; m++) {
+                                            const T dy = y[(c * mC + m) * g.outStr[1]];
+                                            a[m] += dy * xv;
+                                            sum  += dy * wK[c * mC + m];
+                                        }
+
+                                        z[c * giStr[1]] += sum;
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+
+            // gradW [kH, kW, iC, mC]
+            for (int kPos = 0; kPos < kHW; kPos++)
+                for (int c = cStart; c < cStop; c++)
+                    for (int m = 0; m < mC; m++)
+                        gW[(kPos / g.kW) * gWStr[0] + (kPos % g.kW) * gWStr[1] + c * gWStr[2] + m * gWStr[3]] = acc[(static_cast<Nd4jLong>(kPos) * cLen + (c - cStart)) * mC + m];
+        }
+    };
+
+    Threads::parallel_for(func, 0, numBlocks, 1, numThreads);
+
+    delete wCopy;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// depthwise convolution fused with following pointwise one: every output row is computed as [oW, iC*mC] in thread-local buffer and
+// multiplied by pointwise weights [iC*mC, oC] right away, so intermediate depthwise output is never materialized.
+// gDepth is built for input and depthwise output, i.e. gDepth.oC = iC*mC
+template <typename T>
+static void sconv2dFused_(const ConvGeometry& gDepth, const int mC, const NDArray* input, const NDArray* weightsDepth, const NDArray* weightsPoint, const NDArray* bias, NDArray* output, const Nd4jLong* outStr) {
+
+    const int C  = gDepth.oC;
+    const int oC = static_cast<int>(weightsPoint->sizeAt(3));
+    const int oW = gDepth.oW;
+
+    NDArray* wDCopy = contiguousWeights(weightsDepth);
+    NDArray* wPCopy = contiguousWeights(weightsPoint);
+    const T* wD = (wDCopy != nullptr ? wDCopy : weightsDepth)->bufferAsT<T>();
+    const T* wP = (wPCopy != nullptr ? wPCopy : weightsPoint)->bufferAsT<T>();
+    const T* in = input->bufferAsT<T>();
+    T* out = output->bufferAsT<T>();
+
+    std::vector<T> biases = biasesAsVector<T>(bias);
+    if (biases.empty())
+        biases.resize(oC, static_cast<T>(0.));
+
+    auto func = [&](Nd4jLong start, Nd4jLong stop) {
+        std::vector<T> row(static_cast<size_t>(oW) * C);
+        std::vector<T> acc(static_cast<size_t>(oW) * oC);
+
+        for (auto t = start; t < stop; t++) {
+            const int b  = static_cast<int>(t / gDepth.oH);
+            const int oh = static_cast<int>(t % gDepth.oH);
+
+            depthwiseRow_<T>(gDepth, mC, in, wD, nullptr, b, oh, row.data());
+
+            for (int ow = 0; ow < oW; ow++)
+                std::copy(biases.data(), biases.data() + oC, acc.data() + static_cast<Nd4jLong>(ow) * oC);
+
+            for (int k0 = 0; k0 < C; k0 += CONV_TILE_K) {
+                const int k1 = nd4j::math::nd4j_min<int>(C, k0 + CONV_TILE_K);
+
+                for (int ow = 0; ow < oW; ow++) {
+                    T* z = acc.data() + static_cast<Nd4jLong>(ow) * oC;
+                    const T* x = row.data() + static_cast<Nd4jLong>(ow) * C;
+
+                    for (int k = k0; k < k1; k++) {
+                        const T v = x[k];
+                        const T* wK = wP + static_cast<Nd4jLong>(k) * oC;
+
+                        PRAGMA_OMP_SIMD
+                        for (int c = 0; c < oC; c++)
+                            z[c] += v * wK[c];
+                    }
+                }
+            }
+
+            T* zR = out + b * outStr[0] + oh * outStr[3];
+            for (int ow = 0; ow < oW; ow++) {
+                const T* x = acc.data() + static_cast<Nd4jLong>(ow) * oC;
+                for (int c = 0; c < oC; c++)
+                    zR[ow * outStr[4] + c * outStr[1]] = x[c];
+            }
+        }
+    };
+
+    auto numThreads = OmpLaunchHelper::betterThreads(output->lengthOf() * C, Threads::maxThreads());
+    Threads::parallel_for(func, 0, static_cast<Nd4jLong>(gDepth.bS) * gDepth.oH, 1, numThreads);
+
+    delete wDCopy;
+    delete wPCopy;
+}
+
+
 #ifdef HAVE_MKLDNN
 using namespace mkldnn;
 
@@ -678,6 +1453,17 @@ static void conv2d_(nd4j::graph::Context& block, const NDArray* input, const NDA
 #endif
     nd4j_debug("MKL-DNN is not used for conv2d!\n", 0);
 
+    if(ConvolutionUtils::isWinogradApplicable(input, weights, bias, output, kH, kW, sH, sW, dH, dW)) {
+        ConvolutionUtils::conv2dWinograd(block, input, weights, bias, output, pH, pW, isNCHW);
+        return;
+    }
+
+    if(isImplicitGemmPreferred({input, weights, bias, output}, static_cast<Nd4jLong>(bS) * oH * oW * kH * kW * iC)) {
+        auto g = convGeometry2d(*input, *output, kH, kW, sH, sW, pH, pW, dH, dW, isNCHW);
+        BUILD_SINGLE_SELECTOR(input->dataType(), implicitGemmConv_, (g, input, weights, bias, output), FLOAT_TYPES);
+        return;
+    }
+
     std::vector<int> permutForOutput;
     if(!isNCHW)
         input = input->permute({0, 3, 1, 2});                                       // [bS, iH, iW, iC] -> [bS, iC, iH, iW] if NHWC
@@ -892,23 +1678,11 @@ static void conv2dBP_(nd4j::graph::Context& block, const NDArray* input, const N
 
     std::vector<int> gradOaxesForDot;
 
-    if(!isNCHW) {
-        input = input->permute({0, 3, 1, 2});                                   // [bS, iH, iW, iC] -> [bS, iC, iH, iW]
-        gradI = gradI->permute({0, 3, 1, 2});                                   // [bS, iH, iW, iC] -> [bS, iC, iH, iW]
+    if(!isNCHW)
         gradOaxesForDot  = {0, 1, 2};                                           // bS, oH, oW
-    }
     else
         gradOaxesForDot  = {0, 2, 3};                                           // bS, oH, oW
 
-    NDArray columns(input->ordering(), {bS, iC, kH, kW, oH, oW}, input->dataType(), input->getWorkspace());
-
-    // ----- calculation of gradW ----- //
-    if(gradW) {
-        graph::LaunchContext ctx;
-        helpers::im2col(ctx, *input, columns, kH, kW, sH, sW, pH, pW, dH, dW, NDArrayFactory::create(0.f, input->getWorkspace()));   // [bS, iC, iH, iW] is convoluted to [bS, iC, kH, kW, oH, oW]
-        nd4j::MmulHelper::tensorDot(&columns, gradO, gradW, {0,4,5}, gradOaxesForDot, {2, 0, 1, 3});       // [bS, iC, kH, kW, oH, oW] x [bS, oH, oW, oC]/[bS, oC, oH, oW] = [iC, kH, kW, oC]
-    }
-
     // ----- calculation of gradB ----- //
     if(gradB) {
         NDArray* gradBR = gradB;
@@ -919,6 +1693,35 @@ static void conv2dBP_(nd4j::graph::Context& block, const NDArray* input, const N
             delete gradBR;
     }
 
+    if(isImplicitGemmPreferred({input, weights, gradO, gradI, gradW, gradB}, static_cast<Nd4jLong>(bS) * oH * oW * kH * kW * iC)) {
+
+        if(gradW) {
+            auto g = convGeometry2d(*input, *gradO, kH, kW, sH, sW, pH, pW, dH, dW, isNCHW);
+            BUILD_SINGLE_SELECTOR(input->dataType(), implicitGemmConvBPWeights_, (g, input, gradO, gradW), FLOAT_TYPES);
+        }
+
+        if(gradI) {
+            auto g = convGeometry2d(*gradI, *gradO, kH, kW, sH, sW, pH, pW, dH, dW, isNCHW);
+            BUILD_SINGLE_SELECTOR(input->dataType(), implicitGemmConvBPInput_, (g, weights, gradO, gradI), FLOAT_TYPES);
+        }
+
+        return;
+    }
+
+    if(!isNCHW) {
+        input = input->permute({0, 3, 1, 2});                                   // [bS, iH, iW, iC] -> [bS, iC, iH, iW]
+        gradI = gradI->permute({0, 3, 1, 2});                                   // [bS, iH, iW, iC] -> [bS, iC, iH, iW]
+    }
+
+    NDArray columns(input->ordering(), {bS, iC, kH, kW, oH, oW}, input->dataType(), input->getWorkspace());
+
+    // ----- calculation of gradW ----- //
+    if(gradW) {
+        graph::LaunchContext ctx;
+        helpers::im2col(ctx, *input, columns, kH, kW, sH, sW, pH, pW, dH, dW, NDArrayFactory::create(0.f, input->getWorkspace()));   // [bS, iC, iH, iW] is convoluted to [bS, iC, kH, kW, oH, oW]
+        nd4j::MmulHelper::tensorDot(&columns, gradO, gradW, {0,4,5}, gradOaxesForDot, {2, 0, 1, 3});       // [bS, iC, kH, kW, oH, oW] x [bS, oH, oW, oC]/[bS, oC, oH, oW] = [iC, kH, kW, oC]
+    }
+
     //----- calculation of gradI -----//
     nd4j::MmulHelper::tensorDot(weights, gradO, &columns, {indWoC}, {indIOioC}, {2, 3, 1, 0, 4, 5});  // [kH, kW, iC, oC]/[oC, iC, kH, kW]] x [bS, oH, oW, oC]/[bS, oC, oH, oW] = [kH, kW, iC, bS, oH, oW]
     graph::LaunchContext ctx;
@@ -955,6 +1758,15 @@ static void depthwiseConv2d_(const NDArray* input, const NDArray* weights, const
     ConvolutionUtils::getSizesAndIndexesConv2d(isNCHW, *input, *output, bS, iC, iH, iW, oC, oH, oW, indIOioC, indIiH, indWiC, indWmC, indWkH, indOoH);
     mC = weights->sizeAt(indWmC);                           // channels multiplier
 
+    if(isSameMode)                       // SAME
+        ConvolutionUtils::calcPadding2D(pH, pW, oH, oW, iH, iW, kH, kW, sH, sW, dH, dW);
+
+    if(isImplicitGemmApplicable({input, weights, bias, output})) {
+        auto g = convGeometry2d(*input, *output, kH, kW, sH, sW, pH, pW, dH, dW, isNCHW);
+        BUILD_SINGLE_SELECTOR(input->dataType(), depthwiseConvDirect_, (g, mC, input, weights, bias, output, isNCHW), FLOAT_TYPES);
+        return;
+    }
+
     std::vector<std::vector<Nd4jLong>> modifColumns = {{1,0,4,5,2,3}, {iC,bS*oH*oW,kH*kW}};  // [bS,iC,kH,kW,oH,oW] -> [iC,bS,oH,oW,kH,kW] -> [iC,bS*oH*oW,kH*kW]
     std::vector<std::vector<Nd4jLong>> modifOutput;
     std::vector<Nd4jLong> outReShape;
@@ -969,9 +1781,6 @@ static void depthwiseConv2d_(const NDArray* input, const NDArray* weights, const
         modifOutput = {{1,0,3,4,2},{iC, bS*oH*oW, mC}};                                 // [bS,iC,mC,oH,oW] -> [iC,bS,oH,oW,mC] -> [iC,bS*oH*oW,mC]
     }
 
-    if(isSameMode)                       // SAME
-        ConvolutionUtils::calcPadding2D(pH, pW, oH, oW, iH, iW, kH, kW, sH, sW, dH, dW);
-
     NDArray columns(input->ordering(), {bS, iC, kH, kW, oH, oW}, input->dataType(), input->getWorkspace());
     NDArray* outputReshaped = output->reshape(output->ordering(), outReShape);
 
@@ -1016,6 +1825,26 @@ static void depthwiseConv2dBP_(const NDArray* input, const NDArray* weights, con
     ConvolutionUtils::getSizesAndIndexesConv2d(isNCHW, *input, *gradO, bS, iC, iH, iW, oC, oH, oW, indIOioC, indIiH, indWiC, indWmC, indWkH, indOoH);
     mC = weights->sizeAt(indWmC);                           // channels multiplier
 
+    if(isSameMode)                       // SAME
+        ConvolutionUtils::calcPadding2D(pH, pW, oH, oW, iH, iW, kH, kW, sH, sW, dH, dW);
+
+    // ----- calculation of gradB ----- //
+    if(gradB) {
+        NDArray* gradBR = gradB;
+        if(gradB->rankOf() == 2)
+            gradBR = gradB->reshape(gradB->ordering(), {(int)gradB->lengthOf()});
+        gradO->reduceAlongDimension(reduce::Sum, gradBR, {0,indOoH,indOoH+1});                      // sum over bS, oH, oW
+        if(gradBR != gradB)
+            delete gradBR;
+    }
+
+    if(isImplicitGemmApplicable({input, weights, gradO, gradI, gradW})) {
+        auto g = convGeometry2d(*input, *gradO, kH, kW, sH, sW, pH, pW, dH, dW, isNCHW);
+        auto gI = convGeometry2d(*gradI, *gradO, kH, kW, sH, sW, pH, pW, dH, dW, isNCHW);
+        BUILD_SINGLE_SELECTOR(input->dataType(), depthwiseConvBPDirect_, (g, gI.inStr, mC, input, weights, gradO, gradI, gradW, isNCHW), FLOAT_TYPES);
+        return;
+    }
+
     std::vector<std::vector<Nd4jLong>> modifColumns = {{1,2,3,0,4,5}, {iC, kH*kW, bS*oH*oW}};      // [bS,iC,kH,kW,oH,oW] -> [iC, kH*kW, bS*oH*oW]
     std::vector<std::vector<Nd4jLong>> modifGradO1, modifGradO2;
     std::vector<Nd4jLong> gradOreShape;
@@ -1033,28 +1862,15 @@ static void depthwiseConv2dBP_(const NDArray* input, const NDArray* weights, con
         modifGradO2 = {{1,0,2,3},{iC, mC, bS*oH*oW}};                                   // [bS,iC*mC,oH,oW] -> [iC*mC,bS,oH,oW] -> [iC,mC,bS*oH*oW]
     }
 
-    if(isSameMode)                       // SAME
-        ConvolutionUtils::calcPadding2D(pH, pW, oH, oW, iH, iW, kH, kW, sH, sW, dH, dW);
-
     NDArray  columns(input->ordering(), {bS, iC, kH, kW, oH, oW}, input->dataType(), input->getWorkspace());
     NDArray* gradOreshaped = gradO->reshape(gradO->ordering(), gradOreShape);
 
-    // ----- calculation of gradW and gradB ----- //
+    // ----- calculation of gradW ----- //
 
     graph::LaunchContext ctx;
     helpers::im2col(ctx, *input, columns, kH, kW, sH, sW, pH, pW, dH, dW, NDArrayFactory::create(0.f, input->getWorkspace()));  // [bS, iC, iH, iW] is convoluted to [bS, iC, kH, kW, oH, oW]
     nd4j::MmulHelper::tensorDot(&columns, gradOreshaped, gradW, modifColumns, modifGradO1, {{2,0,1,3},{iC,kH*kW,mC}});  // [iC, kW*kH, bS*oH*oW] x [iC, bS*oH*oW, mC] = [iC, kH*kW, mC]
 
-    // ----- calculation of gradB ----- //
-    if(gradB) {
-        NDArray* gradBR = gradB;
-        if(gradB->rankOf() == 2)
-            gradBR = gradB->reshape(gradB->ordering(), {(int)gradB->lengthOf()});
-        gradO->reduceAlongDimension(reduce::Sum, gradBR, {0,indOoH,indOoH+1});                      // sum over bS, oH, oW
-        if(gradBR != gradB)
-            delete gradBR;
-    }
-
     //----- calculation of gradI -----//
     nd4j::MmulHelper::tensorDot(weights, gradO, &columns, {{2,0,1,3},{iC,kH*kW,mC}}, modifGradO2, modifColumns); // [iC, kH*kW, mC] x [iC, mC, bS*oH*oW] = [iC, kW*kH, bS*oH*oW]
     helpers::col2im(ctx, columns, *gradI, sH, sW, pH, pW, iH, iW, dH, dW);                                       // [bS, iC, kH, kW, oH, oW] is de-convoluted to [bS, iC, iH, iW]
@@ -1093,6 +1909,17 @@ static void sconv2d_(nd4j::graph::Context& block, const NDArray* input, const ND
     ConvolutionUtils::getSizesAndIndexesConv2d(isNCHW, *input, *output, bS, iC, iH, iW, oC, oH, oW, indIOioC, indIiH, indWiC, indWmC, indWkH, indOoH);
     mC = weightsDepth->sizeAt(indWmC);                      // channels multiplier
 
+    if(weightsPoint && isImplicitGemmApplicable({input, weightsDepth, weightsPoint, bias, output})) {
+        if(isSameMode)                   // SAME
+            ConvolutionUtils::calcPadding2D(pH, pW, oH, oW, iH, iW, kH, kW, sH, sW, dH, dW);
+
+        // geometry of depthwise part: output strides aren't used there, and channels number is iC*mC
+        auto g = convGeometry2d(*input, *output, kH, kW, sH, sW, pH, pW, dH, dW, isNCHW);
+        g.oC = iC * mC;
+        BUILD_SINGLE_SELECTOR(input->dataType(), sconv2dFused_, (g, mC, input, weightsDepth, weightsPoint, bias, output, g.outStr), FLOAT_TYPES);
+        return;
+    }
+
     NDArray* outputDepth = output;
     if(weightsPoint)                        // if pointwise convolution is expected
         outputDepth = new NDArray(output->ordering(), !isNCHW ? std::vector<Nd4jLong>({bS, oH, oW, iC*mC}) : std::vector<Nd4jLong>({bS, iC*mC, oH, oW}), input->dataType(), input->getWorkspace());
@@ -2540,6 +3367,104 @@ void ConvolutionUtils::depthwiseConv2dBP(const NDArray* input, const NDArray* we
 void ConvolutionUtils::sconv2d(nd4j::graph::Context& block, const NDArray* input, const NDArray* weightsDepth, const NDArray* weightsPoint, const NDArray* bias,  NDArray* output, const int kH, const int kW, const int sH, const int sW, int pH, int pW, const int dH, const int dW, const int isSameMode, const int isNCHW) {
     BUILD_DOUBLE_SELECTOR(input->dataType(), output->dataType(), sconv2d_, (block, input, weightsDepth, weightsPoint, bias, output, kH, kW, sH, sW, pH, pW, dH, dW, isSameMode, isNCHW), LIBND4J_TYPES, FLOAT_TYPES);
 }
+void ConvolutionUtils::conv3d(nd4j::graph::Context& block, const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output, const int kD, const int kH, const int kW, const int sD, const int sH, const int sW, const int pD, const int pH, const int pW, const int dD, const int dH, const int dW, const int isNCDHW) {
+
+    // input   [bS, iD, iH, iW, iC] (NDHWC) or [bS, iC, iD, iH, iW] (NCDHW)
+    // weights [kD, kH, kW, iC, oC] always
+    // bias    [oC]
+    // output  [bS, oD, oH, oW, oC] (NDHWC) or [bS, oC, oD, oH, oW] (NCDHW)
+
+    int bS, iC, iD, iH, iW, oC, oD, oH, oW;                     // batch size, input channels, input depth/height/width, output channels, output depth/height/width;
+    int indIOioC, indIOioD, indWoC, indWiC, indWkD;             // corresponding indexes
+    ConvolutionUtils::getSizesAndIndexesConv3d(isNCDHW, *input, *output, bS, iC, iD, iH, iW, oC, oD, oH, oW, indIOioC, indIOioD, indWiC, indWoC, indWkD);
+
+    if(isImplicitGemmPreferred({input, weights, bias, output}, static_cast<Nd4jLong>(bS) * oD * oH * oW * kD * kH * kW * iC)) {
+        auto g = convGeometry3d(*input, *output, kD, kH, kW, sD, sH, sW, pD, pH, pW, dD, dH, dW, isNCDHW);
+        BUILD_SINGLE_SELECTOR(input->dataType(), implicitGemmConv_, (g, input, weights, bias, output), FLOAT_TYPES);
+        return;
+    }
+
+    std::vector<int> permutForOutput;
+
+    if(!isNCDHW)
+        input = input->permute({0,4,1,2,3});                                    // [bS, iD, iH, iW, iC] -> [bS, iC, iD, iH, iW]
+    else
+        permutForOutput    = {0,2,3,4,1};                                        // [bS, oC, oD, oH, oW] -> [bS, oD, oH, oW, oC]
+
+    NDArray columns(input->ordering(), {bS, iC, kD, kH, kW, oD, oH, oW}, input->dataType(), block.getWorkspace());
+    ConvolutionUtils::vol2col(*input, columns, sD, sH, sW, pD, pH, pW, dD, dH, dW);                 // [bS, iC, iD, iH, iW] is convoluted to [bS, iC, kD, kH, kW, oD, oH, oW]
+    // [bS, iC, kD, kH, kW, oD, oH, oW] x [kD, kH, kW, iC, oC] = [bS, oD, oH, oW, oC]
+    MmulHelper::tensorDot(&columns, weights, output, {1,2,3,4}, {3,0,1,2}, permutForOutput);
+
+    if(bias)
+        output->applyBroadcast(broadcast::Add, {indIOioC}, bias);
+
+    if(!isNCDHW)
+        delete input;
+}
+
+void ConvolutionUtils::conv3dBP(nd4j::graph::Context& block, const NDArray* input, const NDArray* weights, const NDArray* gradO, NDArray* gradI, NDArray* gradW, NDArray* gradB, const int kD, const int kH, const int kW, const int sD, const int sH, const int sW, const int pD, const int pH, const int pW, const int dD, const int dH, const int dW, const int isNCDHW) {
+
+    // input   [bS, iD, iH, iW, iC] (NDHWC) or [bS, iC, iD, iH, iW] (NCDHW)
+    // weights [kD, kH, kW, iC, oC] always
+    // gradO   [bS, oD, oH, oW, oC] (NDHWC) or [bS, oC, oD, oH, oW] (NCDHW), epsilon_next
+    // gradI   [bS, iD, iH, iW, iC] (NDHWC) or [bS, iC, iD, iH, iW] (NCDHW), epsilon
+    // gradW   [kD, kH, kW, iC, oC] always
+    // gradB   [oC]
+
+    int bS, iC, iD, iH, iW, oC, oD, oH, oW;                     // batch size, input channels, input depth/height/width, output channels, output depth/height/width;
+    int indIOioC, indIOioD, indWoC, indWiC, indWkD;             // corresponding indexes
+    ConvolutionUtils::getSizesAndIndexesConv3d(isNCDHW, *input, *gradO, bS, iC, iD, iH, iW, oC, oD, oH, oW, indIOioC, indIOioD, indWiC, indWoC, indWkD);
+
+    std::vector<int> gradOaxesForDot;
+
+    if(!isNCDHW)
+        gradOaxesForDot  = {0,1,2,3};                                           // bS, oD, oH, oW
+    else
+        gradOaxesForDot  = {0,2,3,4};                                           // bS, oD, oH, oW
+
+    if(gradB) {
+        NDArray* gradBR = gradB;
+        if(gradB->rankOf() == 2)
+            gradBR = gradB->reshape(gradB->ordering(), {(int)gradB->lengthOf()});
+        gradO->reduceAlongDimension(reduce::Sum, gradBR, gradOaxesForDot);                          // sum over bS oD oH oW
+        if(gradBR != gradB)
+            delete gradBR;
+    }
+
+    if(isImplicitGemmPreferred({input, weights, gradO, gradI, gradW, gradB}, static_cast<Nd4jLong>(bS) * oD * oH * oW * kD * kH * kW * iC)) {
+
+        if(gradW) {
+            auto gW = convGeometry3d(*input, *gradO, kD, kH, kW, sD, sH, sW, pD, pH, pW, dD, dH, dW, isNCDHW);
+            BUILD_SINGLE_SELECTOR(input->dataType(), implicitGemmConvBPWeights_, (gW, input, gradO, gradW), FLOAT_TYPES);
+        }
+
+        if(gradI) {
+            auto gI = convGeometry3d(*gradI, *gradO, kD, kH, kW, sD, sH, sW, pD, pH, pW, dD, dH, dW, isNCDHW);
+            BUILD_SINGLE_SELECTOR(input->dataType(), implicitGemmConvBPInput_, (gI, weights, gradO, gradI), FLOAT_TYPES);
+        }
+        return;
+    }
+
+    if(!isNCDHW) {
+        input = input->permute({0,4,1,2,3});                                    // [bS, iD, iH, iW, iC] -> [bS, iC, iD, iH, iW]
+        gradI = gradI->permute({0,4,1,2,3});                                    // [bS, iD, iH, iW, iC] -> [bS, iC, iD, iH, iW]
+    }
+
+    // ----- calculation of gradW ----- //
+    NDArray columns(input->ordering(), {bS, iC, kD, kH, kW, oD, oH, oW}, input->dataType(), block.getWorkspace());
+    ConvolutionUtils::vol2col(*input, columns, sD, sH, sW, pD, pH, pW, dD, dH, dW);                   // [bS, iC, iD, iH, iW] is convoluted to [bS, iC, kD, kH, kW, oD, oH, oW]
+    MmulHelper::tensorDot(&columns, gradO, gradW, {0,5,6,7}, gradOaxesForDot, {3,0,1,2,4});     // [bS, iC, kD, kH, kW, oD, oH, oW] x [bS, oD, oH, oW, oC]/[bS, oC, oD, oH, oW] = [iC, kD, kH, kW, oC]
+
+    //----- calculation of gradI -----//
+    MmulHelper::tensorDot(weights, gradO, &columns, {indWoC}, {indIOioC}, {2,3,4,1,0,5,6,7});   // [kD, kH, kW, iC, oC] x [bS, oD, oH, oW, oC]/[bS, oC, oD, oH, oW] = [kD, kH, kW, iC, bS, oD, oH, oW]
+    ConvolutionUtils::col2vol(columns, *gradI, sD, sH, sW, pD, pH, pW, dD, dH, dW);                   // columns [bS, iC, kD, kH, kW, oD, oH, oW] is de-convoluted to  [bS, iC, iD, iH, iW]
+
+    if(!isNCDHW) {
+        delete input;
+        delete gradI;
+    }
+}
 void ConvolutionUtils::vol2col(const NDArray& volume, NDArray& columns, const int sD, const int sH, const int sW, const int pD, const int pH, const int pW, const int dD, const int dH, const int dW) {
     BUILD_SINGLE_SELECTOR(volume.dataType(), vol2col_, (volume, columns, sD, sH, sW, pD, pH, pW, dD, dH, dW), LIBND4J_TYPES);
 }
@@ -2587,6 +3512,12 @@ BUILD_SINGLE_TEMPLATE(template void upsampling2dBP_, (const NDArray& gradO, NDAr
 BUILD_SINGLE_TEMPLATE(template void upsampling3dBP_, (const NDArray& gradO, NDArray& gradI, const bool isNCHW), LIBND4J_TYPES);
 BUILD_SINGLE_TEMPLATE(template void vol2col_,        (const NDArray& volume, NDArray& columns, const int sD, const int sH, const int sW, const int pD, const int pH, const int pW, const int dD, const int dH, const int dW), LIBND4J_TYPES);
 BUILD_SINGLE_TEMPLATE(template void col2vol_,        (const NDArray& columns, NDArray& volume, const int sD, const int sH, const int sW, const int pD, const int pH, const int pW, const int dD, const int dH, const int dW), LIBND4J_TYPES);
+BUILD_SINGLE_TEMPLATE(template void implicitGemmConv_,            (const ConvGeometry& g, const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output), FLOAT_TYPES);
+BUILD_SINGLE_TEMPLATE(template void implicitGemmConvBPWeights_,   (const ConvGeometry& g, const NDArray* input, const NDArray* gradO, NDArray* gradW), FLOAT_TYPES);
+BUILD_SINGLE_TEMPLATE(template void implicitGemmConvBPInput_,     (const ConvGeometry& g, const NDArray* weights, const NDArray* gradO, NDArray* gradI), FLOAT_TYPES);
+BUILD_SINGLE_TEMPLATE(template void depthwiseConvDirect_,         (const ConvGeometry& g, const int mC, const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output, const int isNCHW), FLOAT_TYPES);
+BUILD_SINGLE_TEMPLATE(template void depthwiseConvBPDirect_,       (const ConvGeometry& g, const Nd4jLong* giStr, const int mC, const NDArray* input, const NDArray* weights, const NDArray* gradO, NDArray* gradI, NDArray* gradW, const int isNCHW), FLOAT_TYPES);
+BUILD_SINGLE_TEMPLATE(template void sconv2dFused_,                (const ConvGeometry& gDepth, const int mC, const NDArray* input, const NDArray* weightsDepth, const NDArray* weightsPoint, const NDArray* bias, NDArray* output, const Nd4jLong* outStr), FLOAT_TYPES);
 BUILD_SINGLE_TEMPLATE(template void pooling2d_,      (nd4j::graph::Context& block, const NDArray& input, NDArray& output, const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW, const int poolingMode, const int extraParam0), LIBND4J_TYPES);
 BUILD_SINGLE_TEMPLATE(template void pooling3d_,      (nd4j::graph::Context& block, const NDArray& input, NDArray& output, const int kD, const int kH, const int kW, const int sD, const int sH, const int sW, const int pD, const int pH, const int pW, const int dD, const int dH, const int dW, const int poolingMode, const int extraParam0), LIBND4J_TYPES);
 BUILD_SINGLE_TEMPLATE(template void pooling2dBP_,    (nd4j::graph::Context& block, const NDArray& input, const NDArray& gradO, NDArray& gradI, const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW, const int poolingMode, const int extraParam0), LIBND4J_TYPES);
@@ -0,0 +1,305 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <ops/declarable/generic/helpers/convolutions.h>
+#include <helpers/ThreadPool.h>
+#include <helpers/OmpLaunchHelper.h>
+#include <helpers/WinogradFilter.h>
+#include <openmp_pragmas.h>
+#include <vector>
+
+namespace nd4j {
+namespace ops  {
+
+//////////////////////////////////////////////////////////////////////////
+// Winograd F(m x m, 3x3): every alpha x alpha input tile (alpha = m + 2) gives m x m output tile.
+// Y = A^T [ (G g G^T) .* (B^T d B) ] A, where elementwise products for all tiles and channels are done as alpha*alpha independent GEMMs
+template <int M>
+struct WinogradMatrices;
+
+template <>
+struct WinogradMatrices<2> {
+    static const int ALPHA = 4;
+    static const double BT[4][4];
+    static const double G[4][3];
+    static const double AT[2][4];
+};
+
+const double WinogradMatrices<2>::BT[4][4] = {{1.,  0., -1.,  0.},
+                                              {0.,  1.,  1.,  0.},
+                                              {0., -1.,  1.,  0.},
+                                              {0.,  1.,  0., -1.}};
+
+const double WinogradMatrices<2>::G[4][3]  = {{1.,   0.,  0. },
+                                              {0.5,  0.5, 0.5},
+                                              {0.5, -0.5, 0.5},
+                                              {0.,   0.,  1. }};
+
+const double WinogradMatrices<2>::AT[2][4] = {{1., 1.,  1.,  0.},
+                                              {0., 1., -1., -1.}};
+
+template <>
+struct WinogradMatrices<4> {
+    static const int ALPHA = 6;
+    static const double BT[6][6];
+    static const double G[6][3];
+    static const double AT[4][6];
+};
+
+const double WinogradMatrices<4>::BT[6][6] = {{4.,  0., -5.,  0., 1., 0.},
+                                              {0., -4., -4.,  1., 1., 0.},
+                                              {0.,  4., -4., -1., 1., 0.},
+                                              {0., -2., -1.,  2., 1., 0.},
+                                              {0.,  2., -1., -2., 1., 0.},
+                                              {0.,  4.,  0., -5., 0., 1.}};
+
+const double WinogradMatrices<4>::G[6][3]  = {{ 1./4.,   0.,      0.    },
+                                              {-1./6.,  -1./6.,  -1./6. },
+                                              {-1./6.,   1./6.,  -1./6. },
+                                              { 1./24.,  1./12.,  1./6. },
+                                              { 1./24., -1./12.,  1./6. },
+                                              { 0.,      0.,      1.    }};
+
+const double WinogradMatrices<4>::AT[4][6] = {{1., 1.,  1., 1.,  1., 0.},
+                                              {0., 1., -1., 2., -2., 0.},
+                                              {0., 1.,  1., 4.,  4., 0.},
+                                              {0., 1., -1., 8., -8., 1.}};
+
+//////////////////////////////////////////////////////////////////////////
+// weights [3, 3, iC, oC] are transformed into u [alpha*alpha, iC, oC], transform itself is done in double precision
+template <typename T, int M>
+static void winogradFilter_(const NDArray* weights, T* u) {
+
+    typedef WinogradMatrices<M> W;
+    const int A = W::ALPHA;
+
+    const int iC = weights->sizeAt(2);
+    const int oC = weights->sizeAt(3);
+    const Nd4jLong* strides = weights->stridesOf();
+    const T* w = weights->bufferAsT<T>();
+    const Nd4jLong positionStride = static_cast<Nd4jLong>(iC) * oC;
+
+    auto func = [&](Nd4jLong start, Nd4jLong stop) {
+        for (auto ic = start; ic < stop; ic++) {
+            for (int oc = 0; oc < oC; oc++) {
+                double g[3][3];
+                for (int kh = 0; kh < 3; kh++)
+                    for (int kw = 0; kw < 3; kw++)
+                        g[kh][kw] = static_cast<double>(w[kh * strides[0] + kw * strides[1] + ic * strides[2] + oc * strides[3]]);
+
+                // G g
+                double tmp[A][3];
+                for (int i = 0; i < A; i++)
+                    for (int j = 0; j < 3; j++)
+                        tmp[i][j] = W::G[i][0] * g[0][j] + W::G[i][1] * g[1][j] + W::G[i][2] * g[2][j];
+
+                // (G g) G^T
+                for (int i = 0; i < A; i++)
+                    for (int j = 0; j < A; j++)
+                        u[(i * A + j) * positionStride + ic * oC + oc] = static_cast<T>(tmp[i][0] * W::G[j][0] + tmp[i][1] * W::G[j][1] + tmp[i][2] * W::G[j][2]);
+            }
+        }
+    };
+
+    Threads::parallel_for(func, 0, iC, 0, OmpLaunchHelper::betterThreads(weights->lengthOf() * A * A, Threads::maxThreads()));
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T, int M>
+static void winogradConv_(const NDArray* input, const T* u, const NDArray* bias, NDArray* output, const int pH, const int pW, const int isNCHW) {
+
+    typedef WinogradMatrices<M> W;
+    const int A = W::ALPHA;
+    const int AA = A * A;
+
+    int bS, iC, iH, iW, oC, oH, oW;
+    int indIOioC, indIiH, indWoC, indWiC, indWkH, indOoH;
+    ConvolutionUtils::getSizesAndIndexesConv2d(isNCHW, *input, *output, bS, iC, iH, iW, oC, oH, oW, indIOioC, indIiH, indWiC, indWoC, indWkH, indOoH);
+
+    // strides in [b, c, h, w] order, regardless of data format
+    const Nd4jLong inStr[4]  = {input->stridesOf()[0], input->stridesOf()[indIOioC], input->stridesOf()[indIiH], input->stridesOf()[indIiH + 1]};
+    const Nd4jLong outStr[4] = {output->stridesOf()[0], output->stridesOf()[indIOioC], output->stridesOf()[indOoH], output->stridesOf()[indOoH + 1]};
+
+    const T* in = input->bufferAsT<T>();
+    T* out = output->bufferAsT<T>();
+
+    std::vector<T> biases(oC, static_cast<T>(0.));
+    if (bias != nullptr)
+        for (int c = 0; c < oC; c++)
+            biases[c] = bias->e<T>(c);
+
+    const int tilesH = (oH + M - 1) / M;
+    const int tilesW = (oW + M - 1) / M;
+    const Nd4jLong numTiles = static_cast<Nd4jLong>(tilesH) * tilesW;
+
+    // tiles are processed in blocks, transformed input and products of a block together take ~128K elements
+    const int blockSize = static_cast<int>(nd4j::math::nd4j_min<Nd4jLong>(numTiles, nd4j::math::nd4j_max<Nd4jLong>(1, nd4j::math::nd4j_min<Nd4jLong>(64, 131072 / (AA * (iC + oC))))));
+    const Nd4jLong numBlocks = (numTiles + blockSize - 1) / blockSize;
+
+    auto func = [&](Nd4jLong start, Nd4jLong stop) {
+        std::vector<T> v(static_cast<size_t>(AA) * blockSize * iC);
+        std::vector<T> m(static_cast<size_t>(AA) * blockSize * oC);
+
+        for (auto task = start; task < stop; task++) {
+            const int b = static_cast<int>(task / numBlocks);
+            const Nd4jLong t0 = (task % numBlocks) * blockSize;
+            const int numT = static_cast<int>(nd4j::math::nd4j_min<Nd4jLong>(blockSize, numTiles - t0));
+            const T* inB = in + b * inStr[0];
+
+            // ----- input transform: v[xi*A + nu][t][ic] = (B^T d B)[xi][nu] ----- //
+            for (int t = 0; t < numT; t++) {
+                const int h0 = static_cast<int>((t0 + t) / tilesW) * M - pH;
+                const int w0 = static_cast<int>((t0 + t) % tilesW) * M - pW;
+
+                for (int ic = 0; ic < iC; ic++) {
+                    T d[A][A];
+                    for (int i = 0; i < A; i++) {
+                        const int h = h0 + i;
+                        for (int j = 0; j < A; j++) {
+                            const int w = w0 + j;
+                            d[i][j] = static_cast<unsigned>(h) < static_cast<unsigned>(iH) && static_cast<unsigned>(w) < static_cast<unsigned>(iW) ? inB[ic * inStr[1] + h * inStr[2] + w * inStr[3]] : static_cast<T>(0.);
+                        }
+                    }
+
+                    T tmp[A][A];
+                    for (int i = 0; i < A; i++)
+                        for (int j = 0; j < A; j++) {
+                            T sum = static_cast<T>(0.);
+                            for (int k = 0; k < A; k++)
+                                sum += static_cast<T>(W::BT[i][k]) * d[k][j];
+                            tmp[i][j] = sum;
+                        }
+
+                    for (int i = 0; i < A; i++)
+                        for (int j = 0; j < A; j++) {
+                            T sum = static_cast<T>(0.);
+                            for (int k = 0; k < A; k++)
+                                sum += tmp[i][k] * static_cast<T>(W::BT[j][k]);
+                            v[(static_cast<size_t>(i * A + j) * blockSize + t) * iC + ic] = sum;
+                        }
+                }
+            }
+
+            // ----- alpha*alpha GEMMs: m[p] = v[p] x u[p], [numT, iC] x [iC, oC] ----- //
+            for (int p = 0; p < AA; p++) {
+                const T* uP = u + static_cast<Nd4jLong>(p) * iC * oC;
+
+                for (int t = 0; t < numT; t++) {
+                    const T* x = v.data() + (static_cast<size_t>(p) * blockSize + t) * iC;
+                    T* z = m.data() + (static_cast<size_t>(p) * blockSize + t) * oC;
+
+                    for (int c = 0; c < oC; c++)
+                        z[c] = static_cast<T>(0.);
+
+                    for (int ic = 0; ic < iC; ic++) {
+                        const T val = x[ic];
+                        const T* y = uP + static_cast<Nd4jLong>(ic) * oC;
+
+                        PRAGMA_OMP_SIMD
+                        for (int c = 0; c < oC; c++)
+                            z[c] += val * y[c];
+                    }
+                }
+            }
+
+            // ----- output transform: A^T m A, partial tiles at the edges are clipped ----- //
+            T* outB = out + b * outStr[0];
+            for (int t = 0; t < numT; t++) {
+                const int h0 = static_cast<int>((t0 + t) / tilesW) * M;
+                const int w0 = static_cast<int>((t0 + t) % tilesW) * M;
+
+                for (int c = 0; c < oC; c++) {
+                    T tmp[M][A];
+                    for (int i = 0; i < M; i++)
+                        for (int j = 0; j < A; j++) {
+                            T sum = static_cast<T>(0.);
+                            for (int k = 0; k < A; k++)
+                                sum += static_cast<T>(W::AT[i][k]) * m[(static_cast<size_t>(k * A + j) * blockSize + t) * oC + c];
+                            tmp[i][j] = sum;
+                        }
+
+                    for (int i = 0; i < M && h0 + i < oH; i++)
+                        for (int j = 0; j < M && w0 + j < oW; j++) {
+                            T sum = biases[c];
+                            for (int k = 0; k < A; k++)
+                                sum += tmp[i][k] * static_cast<T>(W::AT[j][k]);
+                            outB[c * outStr[1] + (h0 + i) * outStr[2] + (w0 + j) * outStr[3]] = sum;
+                        }
+                }
+            }
+        }
+    };
+
+    auto numThreads = OmpLaunchHelper::betterThreads(output->lengthOf() * iC * 9, Threads::maxThreads());
+    Threads::parallel_for(func, 0, bS * numBlocks, 1, numThreads);
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void conv2dWinograd_(nd4j::graph::Context& block, const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output, const int pH, const int pW, const int isNCHW) {
+
+    const int oH = output->sizeAt(isNCHW ? 2 : 1);
+    const int oW = output->sizeAt(isNCHW ? 3 : 2);
+
+    // F(4x4, 3x3) needs 4x fewer multiplications than direct convolution vs 2.25x for F(2x2, 3x3), but wastes more on partial tiles of small images
+    const int tile = oH >= 8 && oW >= 8 ? 4 : 2;
+    const int alpha = tile + 2;
+    const Nd4jLong numBytes = static_cast<Nd4jLong>(alpha) * alpha * weights->sizeAt(2) * weights->sizeAt(3) * sizeof(T);
+
+    auto& filter = block.getWinogradFilter();
+
+    if (tile == 4) {
+        if (filter.checkAndReset(weights, tile, numBytes))
+            winogradFilter_<T, 4>(weights, filter.bufferAsT<T>());
+
+        winogradConv_<T, 4>(input, filter.bufferAsT<T>(), bias, output, pH, pW, isNCHW);
+    }
+    else {
+        if (filter.checkAndReset(weights, tile, numBytes))
+            winogradFilter_<T, 2>(weights, filter.bufferAsT<T>());
+
+        winogradConv_<T, 2>(input, filter.bufferAsT<T>(), bias, output, pH, pW, isNCHW);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+bool ConvolutionUtils::isWinogradApplicable(const NDArray* input, const NDArray* weights, const NDArray* bias, const NDArray* output, const int kH, const int kW, const int sH, const int sW, const int dH, const int dW) {
+
+    if (kH != 3 || kW != 3 || sH != 1 || sW != 1 || dH != 1 || dW != 1)
+        return false;
+
+    // transforms lose too much precision in half types
+    const auto dataType = input->dataType();
+    if (dataType != nd4j::DataType::FLOAT32 && dataType != nd4j::DataType::DOUBLE)
+        return false;
+
+    if (weights->dataType() != dataType || output->dataType() != dataType || (bias != nullptr && bias->dataType() != dataType))
+        return false;
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void ConvolutionUtils::conv2dWinograd(nd4j::graph::Context& block, const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output, const int pH, const int pW, const int isNCHW) {
+    // only float and double get here, see isWinogradApplicable()
+    if (input->dataType() == nd4j::DataType::DOUBLE)
+        conv2dWinograd_<double>(block, input, weights, bias, output, pH, pW, isNCHW);
+    else
+        conv2dWinograd_<float>(block, input, weights, bias, output, pH, pW, isNCHW);
+}
+
+}
+}
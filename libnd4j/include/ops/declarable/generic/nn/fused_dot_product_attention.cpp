@@ -0,0 +1,140 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <op_boilerplate.h>
+#if NOT_EXCLUDED(OP_fused_dot_product_attention)
+
+#include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/attention.h>
+
+namespace nd4j {
+namespace ops  {
+
+    static void validateFusedAttention(const NDArray* queries, const NDArray* keys, const NDArray* values, const NDArray* mask) {
+        REQUIRE_TRUE(queries->rankOf() == keys->rankOf() && keys->rankOf() == values->rankOf(), 0,
+                     "fused_dot_product_attention: Queries, Keys and Values must have same rank. "
+                     "But got queries = %s, keys = %s, values = %s", ShapeUtils::shapeAsString(queries).c_str(),
+                     ShapeUtils::shapeAsString(keys).c_str(), ShapeUtils::shapeAsString(values).c_str());
+
+        REQUIRE_TRUE(queries->rankOf() == 3 || queries->rankOf() == 4, 0,
+                     "fused_dot_product_attention: Queries, Keys and Values must be rank 3 arrays for single headed attention "
+                     "or rank 4 arrays for multi headed attention. But got rank = %i", queries->rankOf());
+
+        REQUIRE_TRUE(queries->sizeAt(0) == keys->sizeAt(0) && keys->sizeAt(0) == values->sizeAt(0), 0,
+                     "fused_dot_product_attention: Queries, Keys and Values must have the same mini batch size. "
+                     "But got queries = %i, keys = %i, values = %i", queries->sizeAt(0), keys->sizeAt(0), values->sizeAt(0));
+
+        if (queries->rankOf() == 4)
+            REQUIRE_TRUE(queries->sizeAt(1) == keys->sizeAt(1) && keys->sizeAt(1) == values->sizeAt(1), 0,
+                         "fused_dot_product_attention: Queries, Keys and Values must have the same number of heads. "
+                         "But got queries = %i, keys = %i, values = %i", queries->sizeAt(1), keys->sizeAt(1), values->sizeAt(1));
+
+        REQUIRE_TRUE(queries->sizeAt(-2) == keys->sizeAt(-2), 0,
+                     "fused_dot_product_attention: Queries and Keys must have the same feature size. "
+                     "But got queries = %i, keys = %i", queries->sizeAt(-2), keys->sizeAt(-2));
+
+        REQUIRE_TRUE(keys->sizeAt(-1) == values->sizeAt(-1), 0,
+                     "fused_dot_product_attention: Keys and Values must have the same timestep length. "
+                     "But got keys = %i, values = %i", keys->sizeAt(-1), values->sizeAt(-1));
+
+        REQUIRE_TRUE(queries->dataType() == keys->dataType() && keys->dataType() == values->dataType(), 0,
+                     "fused_dot_product_attention: Queries, Keys and Values must have the same data type");
+
+        if (mask != nullptr)
+            REQUIRE_TRUE(mask->lengthOf() == keys->sizeAt(0) * keys->sizeAt(-1), 0,
+                         "fused_dot_product_attention: Mask must have shape [batchSize, timesteps] = [%i, %i], but got %s",
+                         keys->sizeAt(0), keys->sizeAt(-1), ShapeUtils::shapeAsString(mask).c_str());
+    }
+
+    CUSTOM_OP_IMPL(fused_dot_product_attention, 3, 1, false, 0, 1) {
+        auto queries = INPUT_VARIABLE(0);
+        auto keys    = INPUT_VARIABLE(1);
+        auto values  = INPUT_VARIABLE(2);
+        auto mask    = block.width() > 3 ? INPUT_VARIABLE(3) : nullptr;
+
+        auto output = OUTPUT_VARIABLE(0);
+
+        int normalization = INT_ARG(0);
+
+        validateFusedAttention(queries, keys, values, mask);
+
+        REQUIRE_TRUE(output->dataType() == queries->dataType(), 0, "fused_dot_product_attention: Output must have the same data type as Queries");
+
+        helpers::fusedDotProductAttention(queries, keys, values, mask, output, normalization != 0);
+
+        return Status::OK();
+    }
+
+    DECLARE_TYPES(fused_dot_product_attention) {
+        getOpDescriptor()->setAllowedInputTypes({ALL_FLOATS});
+        getOpDescriptor()->setAllowedOutputTypes({ALL_FLOATS});
+    }
+
+    DECLARE_SHAPE_FN(fused_dot_product_attention) {
+        auto queryShape  = inputShape->at(0);
+        auto valuesShape = inputShape->at(2);
+        const int rank = shape::rank(queryShape);
+
+        // the same as values, but with queryCount timesteps
+        std::vector<Nd4jLong> outShape(shape::shapeOf(valuesShape), shape::shapeOf(valuesShape) + rank);
+        outShape[rank - 1] = shape::sizeAt(queryShape, rank - 1);
+
+        return SHAPELIST(ShapeBuilders::createShapeInfo(nd4j::ArrayOptions::dataType(valuesShape), 'c', outShape, block.workspace()));
+    }
+
+    CUSTOM_OP_IMPL(fused_dot_product_attention_bp, 4, 3, false, 0, 1) {
+        auto queries = INPUT_VARIABLE(0);
+        auto keys    = INPUT_VARIABLE(1);
+        auto values  = INPUT_VARIABLE(2);
+        auto eps     = INPUT_VARIABLE(3);
+        auto mask    = block.width() > 4 ? INPUT_VARIABLE(4) : nullptr;
+
+        auto dLdq = OUTPUT_VARIABLE(0);
+        auto dLdk = OUTPUT_VARIABLE(1);
+        auto dLdv = OUTPUT_VARIABLE(2);
+
+        int normalization = INT_ARG(0);
+
+        validateFusedAttention(queries, keys, values, mask);
+
+        REQUIRE_TRUE(eps->dataType() == queries->dataType() && dLdq->dataType() == queries->dataType() && dLdk->dataType() == queries->dataType() && dLdv->dataType() == queries->dataType(), 0,
+                     "fused_dot_product_attention_bp: Epsilon and gradients must have the same data type as Queries");
+
+        helpers::fusedDotProductAttentionBp(queries, keys, values, eps, mask, dLdq, dLdk, dLdv, normalization != 0);
+
+        return Status::OK();
+    }
+
+    DECLARE_TYPES(fused_dot_product_attention_bp) {
+        getOpDescriptor()->setAllowedInputTypes({ALL_FLOATS});
+        getOpDescriptor()->setAllowedOutputTypes({ALL_FLOATS});
+    }
+
+    DECLARE_SHAPE_FN(fused_dot_product_attention_bp) {
+        Nd4jLong *dLdq_shape;
+        COPY_SHAPE(inputShape->at(0), dLdq_shape);
+        Nd4jLong *dLdk_shape;
+        COPY_SHAPE(inputShape->at(1), dLdk_shape);
+        Nd4jLong *dLdv_shape;
+        COPY_SHAPE(inputShape->at(2), dLdv_shape);
+
+        return SHAPELIST(dLdq_shape, dLdk_shape, dLdv_shape);
+    }
+
+}
+}
+
+#endif
@@ -0,0 +1,111 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <op_boilerplate.h>
+#if NOT_EXCLUDED(OP_fused_multi_head_dot_product_attention)
+
+#include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/attention.h>
+
+namespace nd4j {
+namespace ops  {
+
+    CUSTOM_OP_IMPL(fused_multi_head_dot_product_attention, 7, 1, false, 0, 1) {
+        auto queries = INPUT_VARIABLE(0);
+        auto keys    = INPUT_VARIABLE(1);
+        auto values  = INPUT_VARIABLE(2);
+        auto Wq      = INPUT_VARIABLE(3);
+        auto Wk      = INPUT_VARIABLE(4);
+        auto Wv      = INPUT_VARIABLE(5);
+        auto Wo      = INPUT_VARIABLE(6);
+        auto mask    = block.width() > 7 ? INPUT_VARIABLE(7) : nullptr;
+
+        auto output = OUTPUT_VARIABLE(0);
+        int normalization = INT_ARG(0);
+
+        REQUIRE_TRUE(queries->rankOf() == 3 && keys->rankOf() == 3 && values->rankOf() == 3, 0,
+                     "fused_multi_head_dot_product_attention: Queries, Keys and Values must be rank 3 arrays. "
+                     "But got queries = %s, keys = %s, values = %s", ShapeUtils::shapeAsString(queries).c_str(),
+                     ShapeUtils::shapeAsString(keys).c_str(), ShapeUtils::shapeAsString(values).c_str());
+
+        REQUIRE_TRUE(queries->sizeAt(0) == keys->sizeAt(0) && keys->sizeAt(0) == values->sizeAt(0), 0,
+                     "fused_multi_head_dot_product_attention: Queries, Keys and Values must have the same mini batch size. "
+                     "But got queries = %i, keys = %i, values = %i", queries->sizeAt(0), keys->sizeAt(0), values->sizeAt(0));
+
+        REQUIRE_TRUE(keys->sizeAt(2) == values->sizeAt(2), 0,
+                     "fused_multi_head_dot_product_attention: Keys and Values must have the same timestep length. "
+                     "But got keys = %i, values = %i", keys->sizeAt(2), values->sizeAt(2));
+
+        REQUIRE_TRUE(Wq->rankOf() == 3 && Wk->rankOf() == 3 && Wv->rankOf() == 3, 0,
+                     "fused_multi_head_dot_product_attention: Input projections weights must be rank 3 arrays. "
+                     "But got Wq = %s, Wk = %s, Wv = %s", ShapeUtils::shapeAsString(Wq).c_str(),
+                     ShapeUtils::shapeAsString(Wk).c_str(), ShapeUtils::shapeAsString(Wv).c_str());
+
+        REQUIRE_TRUE(Wq->sizeAt(0) == Wk->sizeAt(0) && Wk->sizeAt(0) == Wv->sizeAt(0), 0,
+                     "fused_multi_head_dot_product_attention: Projections weights must have the same number of attention heads. "
+                     "But got Wq = %s, Wk = %s, Wv = %s", ShapeUtils::shapeAsString(Wq).c_str(),
+                     ShapeUtils::shapeAsString(Wk).c_str(), ShapeUtils::shapeAsString(Wv).c_str());
+
+        REQUIRE_TRUE(Wq->sizeAt(1) == Wk->sizeAt(1), 0,
+                     "fused_multi_head_dot_product_attention: Queries and Keys must be projected to the same size. "
+                     "But got Wq = %s, Wk = %s", ShapeUtils::shapeAsString(Wq).c_str(), ShapeUtils::shapeAsString(Wk).c_str());
+
+        REQUIRE_TRUE(Wq->sizeAt(2) == queries->sizeAt(1) && Wk->sizeAt(2) == keys->sizeAt(1) && Wv->sizeAt(2) == values->sizeAt(1), 0,
+                     "fused_multi_head_dot_product_attention: Projection matrices have incompatible sizes to their inputs. "
+                     "But got Wq = %s, queries = %s, Wk = %s, keys = %s, Wv = %s, values = %s",
+                     ShapeUtils::shapeAsString(Wq).c_str(), ShapeUtils::shapeAsString(queries).c_str(),
+                     ShapeUtils::shapeAsString(Wk).c_str(), ShapeUtils::shapeAsString(keys).c_str(),
+                     ShapeUtils::shapeAsString(Wv).c_str(), ShapeUtils::shapeAsString(values).c_str());
+
+        REQUIRE_TRUE(Wo->rankOf() == 2 && Wo->sizeAt(0) == Wv->sizeAt(0) * Wv->sizeAt(1), 0,
+                     "fused_multi_head_dot_product_attention: Output projection matrix Wo has incompatible size to attention result. "
+                     "Expected Wo[0] = Wv[0] * Wv[1] = %i, but got Wo = %s", Wv->sizeAt(0) * Wv->sizeAt(1), ShapeUtils::shapeAsString(Wo).c_str());
+
+        for (auto array: {keys, values, Wq, Wk, Wv, Wo, output})
+            REQUIRE_TRUE(array->dataType() == queries->dataType(), 0,
+                         "fused_multi_head_dot_product_attention: All inputs and output must have the same data type");
+
+        if (mask != nullptr)
+            REQUIRE_TRUE(mask->lengthOf() == keys->sizeAt(0) * keys->sizeAt(2), 0,
+                         "fused_multi_head_dot_product_attention: Mask must have shape [batchSize, timesteps] = [%i, %i], but got %s",
+                         keys->sizeAt(0), keys->sizeAt(2), ShapeUtils::shapeAsString(mask).c_str());
+
+        helpers::fusedMultiHeadDotProductAttention(queries, keys, values, Wq, Wk, Wv, Wo, mask, output, normalization != 0, block.workspace());
+
+        return Status::OK();
+    }
+
+    DECLARE_TYPES(fused_multi_head_dot_product_attention) {
+        getOpDescriptor()->setAllowedInputTypes({ALL_FLOATS});
+        getOpDescriptor()->setAllowedOutputTypes({ALL_FLOATS});
+    }
+
+    DECLARE_SHAPE_FN(fused_multi_head_dot_product_attention) {
+        auto queryShape  = inputShape->at(0);
+        auto valuesShape = inputShape->at(2);
+        auto WoShape     = inputShape->at(6);
+
+        auto batchSize  = shape::sizeAt(queryShape, 0);
+        auto outSize    = shape::sizeAt(WoShape, 1);
+        auto queryCount = shape::sizeAt(queryShape, 2);
+
+        return SHAPELIST(ShapeBuilders::createShapeInfo(nd4j::ArrayOptions::dataType(valuesShape), 'c', {batchSize, outSize, queryCount}, block.workspace()));
+    }
+
+}
+}
+
+#endif
@@ -20,6 +20,7 @@
 
 #include <ops/declarable/CustomOperations.h>
 #include <ops/declarable/helpers/image_suppression.h>
+#include <limits>
 
 #if NOT_EXCLUDED(OP_image_non_max_suppression)
 
@@ -46,7 +47,17 @@ namespace nd4j {
             if (block.getTArguments()->size() > 0)
                 threshold = T_ARG(0);
 
-            helpers::nonMaxSuppressionV2(boxes, scales, maxOutputSize, threshold, output);
+            double scoreThreshold = -std::numeric_limits<double>::infinity();
+            if (block.getTArguments()->size() > 1)
+                scoreThreshold = T_ARG(1);
+
+            double softNmsSigma = 0.0;
+            if (block.getTArguments()->size() > 2)
+                softNmsSigma = T_ARG(2);
+
+            REQUIRE_TRUE(softNmsSigma >= 0.0, 0, "image.non_max_suppression: soft-NMS sigma can't be negative, but %f is given", softNmsSigma);
+
+            helpers::nonMaxSuppressionV2(boxes, scales, maxOutputSize, threshold, scoreThreshold, softNmsSigma, output);
             return Status::OK();
         }
 
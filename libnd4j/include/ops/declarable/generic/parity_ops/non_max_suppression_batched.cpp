@@ -0,0 +1,74 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/image_suppression.h>
+#include <limits>
+
+#if NOT_EXCLUDED(OP_image_non_max_suppression_batched)
+
+namespace nd4j {
+    namespace ops {
+        CUSTOM_OP_IMPL(non_max_suppression_batched, 2, 3, false, 0, 1) {
+            auto boxes = INPUT_VARIABLE(0);
+            auto scores = INPUT_VARIABLE(1);
+
+            auto indices = OUTPUT_VARIABLE(0);
+            auto selectedScores = OUTPUT_VARIABLE(1);
+            auto validCounts = OUTPUT_VARIABLE(2);
+
+            REQUIRE_TRUE(boxes->rankOf() == 3 && boxes->sizeAt(2) == 4, 0, "image.non_max_suppression_batched: boxes should have shape (batch, num_boxes, 4), but rank %i is given", boxes->rankOf());
+            REQUIRE_TRUE(scores->rankOf() == 3 && scores->sizeAt(0) == boxes->sizeAt(0) && scores->sizeAt(1) == boxes->sizeAt(1), 0, "image.non_max_suppression_batched: scores should have shape (batch, num_boxes, num_classes)");
+
+            int maxOutputSize = INT_ARG(0);
+            REQUIRE_TRUE(maxOutputSize >= 0, 0, "image.non_max_suppression_batched: max output size can't be negative, but %i is given", maxOutputSize);
+
+            double threshold = block.getTArguments()->size() > 0 ? T_ARG(0) : 0.5;
+            double scoreThreshold = block.getTArguments()->size() > 1 ? T_ARG(1) : -std::numeric_limits<double>::infinity();
+            double softNmsSigma = block.getTArguments()->size() > 2 ? T_ARG(2) : 0.0;
+
+            REQUIRE_TRUE(softNmsSigma >= 0.0, 0, "image.non_max_suppression_batched: soft-NMS sigma can't be negative, but %f is given", softNmsSigma);
+
+            helpers::nonMaxSuppressionBatched(boxes, scores, maxOutputSize, threshold, scoreThreshold, softNmsSigma, indices, selectedScores, validCounts);
+            return Status::OK();
+        }
+
+        DECLARE_SHAPE_FN(non_max_suppression_batched) {
+            auto boxes = inputShape->at(0);
+            auto scores = inputShape->at(1);
+
+            Nd4jLong batchSize = shape::sizeAt(boxes, 0);
+            Nd4jLong numClasses = shape::sizeAt(scores, 2);
+            Nd4jLong maxOutputSize = INT_ARG(0);
+
+            auto indicesShape = ShapeBuilders::createShapeInfo(nd4j::DataType::INT32, 'c', {batchSize, numClasses, maxOutputSize}, block.getWorkspace());
+            auto scoresShape = ShapeBuilders::createShapeInfo(ArrayOptions::dataType(scores), 'c', {batchSize, numClasses, maxOutputSize}, block.getWorkspace());
+            auto countsShape = ShapeBuilders::createShapeInfo(nd4j::DataType::INT32, 'c', {batchSize, numClasses}, block.getWorkspace());
+
+            return SHAPELIST(indicesShape, scoresShape, countsShape);
+        }
+
+        DECLARE_TYPES(non_max_suppression_batched) {
+            getOpDescriptor()
+                    ->setAllowedInputTypes(0, {ALL_FLOATS})
+                    ->setAllowedInputTypes(1, {ALL_FLOATS})
+                    ->setAllowedOutputTypes(0, {ALL_INTS})
+                    ->setAllowedOutputTypes(1, {ALL_FLOATS})
+                    ->setAllowedOutputTypes(2, {ALL_INTS});
+        }
+    }
+}
+#endif
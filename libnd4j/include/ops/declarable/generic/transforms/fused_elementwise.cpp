@@ -0,0 +1,60 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <op_boilerplate.h>
+#if NOT_EXCLUDED(OP_fused_elementwise)
+
+#include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/fused_ops.h>
+
+namespace nd4j {
+    namespace ops {
+        CUSTOM_OP_IMPL(fused_elementwise, -1, 1, false, -2, -2) {
+            auto x = INPUT_VARIABLE(0);
+            auto z = OUTPUT_VARIABLE(0);
+
+            REQUIRE_TRUE(block.numI() >= 2, 0, "fused_elementwise: at least one step expected");
+
+            std::vector<NDArray*> operands;
+            for (int e = 1; e < block.width(); e++)
+                operands.emplace_back(INPUT_VARIABLE(e));
+
+            auto steps = helpers::parseFusedSteps(*block.getIArguments(), 0, *block.getTArguments(), operands);
+            helpers::fusedElementwise(x, steps, z);
+
+            return Status::OK();
+        }
+
+        DECLARE_TYPES(fused_elementwise) {
+            getOpDescriptor()
+                    ->setAllowedInputTypes({ALL_FLOATS, ALL_INTS})
+                    ->setAllowedOutputTypes({ALL_FLOATS, ALL_INTS});
+        }
+
+        DECLARE_SHAPE_FN(fused_elementwise) {
+            std::vector<Nd4jLong*> operandShapes;
+            for (int e = 1; e < inputShape->size(); e++)
+                operandShapes.emplace_back(inputShape->at(e));
+
+            auto newShape = helpers::fusedOutputShapeInfo(inputShape->at(0), *block.getIArguments(), 0, operandShapes, block.getWorkspace());
+            REQUIRE_TRUE(newShape != nullptr, 0, "fused_elementwise: operand shapes aren't broadcastable");
+
+            return SHAPELIST(newShape);
+        }
+    }
+}
+
+#endif
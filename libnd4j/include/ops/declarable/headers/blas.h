@@ -46,6 +46,27 @@ namespace nd4j {
         DECLARE_CUSTOM_OP(matmul_bp, 3, 2, false, 0, -2);
         #endif
 
+        /**
+         * matmul followed by chain of elementwise steps (i.e. bias and activation), applied to the product in place
+         *
+         * Input arrays:
+         * 0: x
+         * 1: y
+         * 2...: operands of pairwise steps, in order of steps
+         *
+         * Integer arguments:
+         * 0: transX
+         * 1: transY
+         * 2: transZ
+         * 3...: (kind, opNum) pair for each step, same as in fused_elementwise
+         *
+         * T arguments:
+         * scalar for each step
+         */
+        #if NOT_EXCLUDED(OP_fused_matmul)
+        DECLARE_CUSTOM_OP(fused_matmul, -2, 1, false, -2, -2);
+        #endif
+
         /**
          * tensorMmul/tensorDot operation
          * takes 2 ndarrays, and 2 sets of axes
@@ -256,6 +256,50 @@ namespace nd4j {
                 DECLARE_CUSTOM_OP(multi_head_dot_product_attention, 7, -1, false, 0, 2);
                 DECLARE_CUSTOM_OP(multi_head_dot_product_attention_bp, 8, 7, false, 0, 1);
         #endif
+
+
+        /**
+         * This operation computes the same result as dot_product_attention, but never materializes attention weights:
+         * scores are computed for a block of queries and a block of timesteps at a time, scaled and masked in place, and
+         * folded into running (online) softmax. Memory use is linear in sequence length, so long sequences are fine.
+         * Backprop recomputes weights block by block from the same inputs.
+         *
+         * Expected arguments:
+         * q: input 3D array "queries" of shape [batchSize, featureKeys, queryCount] or 4D array of shape [batchSize, numHeads, featureKeys, queryCount]
+         * k: input 3D array "keys" of shape [batchSize, featureKeys, timesteps] or 4D array of shape [batchSize, numHeads, featureKeys, timesteps]
+         * v: input 3D array "values" of shape [batchSize, featureValues, timesteps] or 4D array of shape [batchSize, numHeads, featureValues, timesteps]
+         * mask: OPTIONAL; array that defines which values should be skipped of shape [batchSize, timesteps]
+         *
+         * All arrays must have the same data type.
+         *
+         * integer input arguments:
+         * 0: normalization, may have two values: zero -> do not apply normalization, one -> apply normalization
+         *
+         * Output Arrays:
+         * 0: Attention result arrays of shape [batchSize, featureValues, queryCount] or [batchSize, numHeads, featureValues, queryCount]
+         */
+        #if NOT_EXCLUDED(OP_fused_dot_product_attention)
+                DECLARE_CUSTOM_OP(fused_dot_product_attention, 3, 1, false, 0, 1);
+                DECLARE_CUSTOM_OP(fused_dot_product_attention_bp, 4, 3, false, 0, 1);
+        #endif
+
+
+        /**
+         * This operation computes the same result as multi_head_dot_product_attention, using fused_dot_product_attention
+         * kernel for all heads. Projection weights applied to the same input are stacked and applied with single GEMM,
+         * i.e. self-attention (q, k and v being the same array) projects queries, keys and values at once.
+         *
+         * Expected arguments are the same as for multi_head_dot_product_attention, all arrays must have the same data type.
+         *
+         * integer input arguments:
+         * 0: normalization, may have two values: zero -> do not apply normalization, one -> apply normalization
+         *
+         * Output Arrays:
+         * 0: Attention result arrays of shape [batchSize, outSize, queryCount]
+         */
+        #if NOT_EXCLUDED(OP_fused_multi_head_dot_product_attention)
+                DECLARE_CUSTOM_OP(fused_multi_head_dot_product_attention, 7, 1, false, 0, 1);
+        #endif
     }
 }
 
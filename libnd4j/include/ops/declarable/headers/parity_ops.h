@@ -1580,6 +1580,8 @@ namespace nd4j {
          *     2 - output_size - 0D-tensor by int type (optional)
          * float args:
          *     0 - threshold - threshold value for overlap checks (optional, by default 0.5)
+         *     1 - score_threshold - boxes with score not above this value are ignored (optional, by default all boxes are used)
+         *     2 - soft_nms_sigma - if positive, overlapping boxes get scores decayed instead of being suppressed (optional, by default 0)
          * int args:
          *     0 - output_size - as arg 2 used for same target. Eigher this or arg 2 should be provided.
          *
@@ -1588,6 +1590,27 @@ namespace nd4j {
         DECLARE_CUSTOM_OP(non_max_suppression, 2, 1, false, 0, 0);
         #endif
 
+        /*
+         * image.non_max_suppression_batched op: non_max_suppression applied to each image and each class independently.
+         * input:
+         *     0 - boxes - 3D-tensor with shape (batch, num_boxes, 4), shared by all classes
+         *     1 - scores - 3D-tensor with shape (batch, num_boxes, num_classes)
+         * float args:
+         *     0 - threshold - threshold value for overlap checks (optional, by default 0.5)
+         *     1 - score_threshold - boxes with score not above this value are ignored (optional, by default all boxes are used)
+         *     2 - soft_nms_sigma - if positive, overlapping boxes get scores decayed instead of being suppressed (optional, by default 0)
+         * int args:
+         *     0 - max_output_size - max number of boxes selected per image and class
+         *
+         * output:
+         *     0 - selected indices with shape (batch, num_classes, max_output_size), unused positions are -1
+         *     1 - selected scores with shape (batch, num_classes, max_output_size), unused positions are 0
+         *     2 - number of selected boxes with shape (batch, num_classes)
+         * */
+        #if NOT_EXCLUDED(OP_image_non_max_suppression_batched)
+        DECLARE_CUSTOM_OP(non_max_suppression_batched, 2, 3, false, 0, 1);
+        #endif
+
         /*
          * cholesky op - decomposite positive square symetric matrix (or matricies when rank > 2).
          * input:
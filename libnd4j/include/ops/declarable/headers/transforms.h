@@ -199,6 +199,24 @@ namespace nd4j {
                 DECLARE_CONFIGURABLE_OP(standardize, 1, 1, true, 0, -2);
                 DECLARE_CUSTOM_OP(standardize_bp, 2, 1, false, 0, -2);
         #endif
+
+        /**
+         * This operation applies chain of elementwise steps to the input in a single pass over memory.
+         * Usually it's created by graph fusion, out of chains of elementwise ops.
+         *
+         * Input arrays:
+         * 0: input array
+         * 1...: operands of pairwise steps, in order of steps. Each operand is either of output shape, or broadcastable to it
+         *
+         * Integer arguments:
+         * (kind, opNum) pair for each step, see helpers::FusedStepKind
+         *
+         * T arguments:
+         * scalar for each step, ignored by all steps except scalar ones
+         */
+        #if NOT_EXCLUDED(OP_fused_elementwise)
+        DECLARE_CUSTOM_OP(fused_elementwise, -1, 1, false, -2, -2);
+        #endif
     }
 }
 
@@ -33,6 +33,16 @@ namespace helpers {
 
     void softmax(const NDArray &input, NDArray &output, const int dimension);
 
+    /**
+     * Numerically stable log(softmax(input)) along dimension
+     */
+    void logSoftmax(const NDArray &input, NDArray &output, const int dimension);
+
+    /**
+     * Gradient of softmax along dimension: gradI = softmax * (gradO - sum(softmax * gradO)), softmax isn't kept anywhere else
+     */
+    void softmaxBp(const NDArray &input, const NDArray &gradO, NDArray &gradI, const int dimension);
+
     void prelu(const NDArray &input, const NDArray &alpha, NDArray &output);
 
     void preluBP(const NDArray &input, const NDArray &alpha, const NDArray &dLdO, NDArray &dLdI, NDArray &dLdA);
@@ -0,0 +1,59 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_HELPERS_ATTENTION_H
+#define LIBND4J_HELPERS_ATTENTION_H
+
+#include <ops/declarable/helpers/helpers.h>
+
+namespace nd4j {
+namespace ops {
+namespace helpers {
+
+    /**
+     * This method computes dot product attention block by block: scores for a block of queries and a block of keys are
+     * scaled, masked and folded into running softmax right away, so [timesteps, queryCount] weights are never materialized.
+     *
+     * queries [batchSize, (numHeads,) featureKeys, queryCount]
+     * keys    [batchSize, (numHeads,) featureKeys, timesteps]
+     * values  [batchSize, (numHeads,) featureValues, timesteps]
+     * mask    [batchSize, timesteps] or nullptr, 0 for skipped timesteps
+     * output  [batchSize, (numHeads,) featureValues, queryCount]
+     *
+     * All arrays must have the same data type. Scores are divided by sqrt(featureKeys) if normalization is true
+     */
+    void fusedDotProductAttention(const NDArray* queries, const NDArray* keys, const NDArray* values, const NDArray* mask, NDArray* output, const bool normalization);
+
+    /**
+     * Backprop for fusedDotProductAttention. Weights are recomputed block by block from queries and keys,
+     * so memory use stays linear in sequence length. eps has the shape of attention output
+     */
+    void fusedDotProductAttentionBp(const NDArray* queries, const NDArray* keys, const NDArray* values, const NDArray* eps, const NDArray* mask, NDArray* dLdq, NDArray* dLdk, NDArray* dLdv, const bool normalization);
+
+    /**
+     * Multi-head attention on top of fusedDotProductAttention. Projection weights applied to the same input are stacked
+     * and applied with single GEMM, so self-attention projects queries, keys and values at once. Projected arrays are
+     * consumed in place, without permute copies.
+     *
+     * queries, keys, values are [batchSize, features, T], Wq, Wk, Wv are [numHeads, projectedSize, features],
+     * Wo is [numHeads * projectedValues, outSize], output is [batchSize, outSize, queryCount]
+     */
+    void fusedMultiHeadDotProductAttention(const NDArray* queries, const NDArray* keys, const NDArray* values, const NDArray* Wq, const NDArray* Wk, const NDArray* Wv, const NDArray* Wo, const NDArray* mask, NDArray* output, const bool normalization, nd4j::memory::Workspace* workspace);
+}
+}
+}
+
+#endif //LIBND4J_HELPERS_ATTENTION_H
@@ -23,6 +23,10 @@
 #include <ShapeUtils.h>
 #include <numeric>
 #include <ConstantTadHelper.h>
+#include <helpers/ThreadPool.h>
+#include <helpers/OmpLaunchHelper.h>
+#include <cstring>
+#include <type_traits>
 
 namespace nd4j    {
 namespace ops     {
@@ -103,7 +107,7 @@ void softMaxForVector(const NDArray& input, NDArray& output) {
         if (inEWS == 1) {
             PRAGMA_OMP_SIMD_MAX(max)
             for (int i = 0; i < length; i++)
-                max = nd4j::math::nd4j_max<T>(max, outBuff[i]);
+                max = nd4j::math::nd4j_max<T>(max, inBuff[i]);
 
             PRAGMA_OMP_SIMD_SUM(sum)
             for (int i = 0; i < length; i++) {
@@ -121,7 +125,7 @@ void softMaxForVector(const NDArray& input, NDArray& output) {
 
             PRAGMA_OMP_SIMD_MAX(max)
             for (int i = 0; i < length; i++)
-                max = nd4j::math::nd4j_max<T>(max, outBuff[i * inEWS]);
+                max = nd4j::math::nd4j_max<T>(max, inBuff[i * inEWS]);
 
             PRAGMA_OMP_SIMD_SUM(sum)
             for (int i = 0; i < length; i++) {
@@ -147,12 +151,351 @@ void softMaxForVector(const NDArray& input, NDArray& output) {
         BUILD_SINGLE_SELECTOR(xType, logSoftMaxForVector_, (input.getBuffer(), input.getShapeInfo(), output.buffer(), output.shapeInfo()), FLOAT_TYPES);
     }
 
+//////////////////////////////////////////////////////////////////////////
+// softmax of contiguous arrays works on [outer, axis, inner] view: rows along axis with inner == 1 are contiguous,
+// otherwise SOFTMAX_LANES neighbouring rows are walked along axis in lockstep, so every load is a contiguous vector
+static const Nd4jLong SOFTMAX_CHUNK = 256;
+static const Nd4jLong SOFTMAX_LANES = 128;
+static const Nd4jLong SOFTMAX_STEPS = 16;
+
+// half types are accumulated in float
+template <typename T>
+using SoftmaxAcc = typename std::conditional<std::is_same<T, double>::value, double, float>::type;
+
+// exp(x) for x <= 0 as 2^n * exp(r), n = round(x / ln2), |r| <= ln2 / 2, exp(r) is degree 6 Taylor polynomial
+static FORCEINLINE float approximateExp(float x) {
+    x = x < -87.f ? -87.f : x;
+
+    const float n = std::floor(x * 1.44269504f + 0.5f);
+    const float r = x - n * 0.693145752f - n * 1.42860677e-6f;
+
+    float p = 1.3888889e-3f;
+    p = p * r + 8.3333333e-3f;
+    p = p * r + 4.1666667e-2f;
+    p = p * r + 1.6666667e-1f;
+    p = p * r + 0.5f;
+    p = p * r + 1.f;
+    p = p * r + 1.f;
+
+    const int bits = (static_cast<int>(n) + 127) << 23;
+    float scale;
+    std::memcpy(&scale, &bits, sizeof(float));
+
+    return p * scale;
+}
+
+template <typename Z, bool approximate>
+struct SoftmaxExp {
+    static FORCEINLINE Z op(Z x) { return nd4j::math::nd4j_exp<Z, Z>(x); }
+};
+
+template <>
+struct SoftmaxExp<float, true> {
+    static FORCEINLINE float op(float x) { return approximateExp(x); }
+};
+
+//////////////////////////////////////////////////////////////////////////
+// max and sum of exp(x - max) of contiguous row in single read pass: chunk is reduced while it sits in L1,
+// and sum collected so far is rescaled once per chunk
+template <typename T, bool approximate>
+static FORCEINLINE void softmaxRowStats_(const T* x, const Nd4jLong length, SoftmaxAcc<T>& max, SoftmaxAcc<T>& sum) {
+    typedef SoftmaxAcc<T> Z;
+
+    max = -DataTypeUtils::max<Z>();
+    sum = static_cast<Z>(0);
+
+    for (Nd4jLong c = 0; c < length; c += SOFTMAX_CHUNK) {
+        const Nd4jLong end = nd4j::math::nd4j_min<Nd4jLong>(c + SOFTMAX_CHUNK, length);
+
+        Z chunkMax = max;
+        PRAGMA_OMP_SIMD_MAX(chunkMax)
+        for (Nd4jLong j = c; j < end; j++)
+            chunkMax = nd4j::math::nd4j_max<Z>(chunkMax, static_cast<Z>(x[j]));
+
+        if (chunkMax > max) {
+            sum *= SoftmaxExp<Z, approximate>::op(max - chunkMax);
+            max = chunkMax;
+        }
+
+        Z chunkSum = static_cast<Z>(0);
+        PRAGMA_OMP_SIMD_SUM(chunkSum)
+        for (Nd4jLong j = c; j < end; j++)
+            chunkSum += SoftmaxExp<Z, approximate>::op(static_cast<Z>(x[j]) - max);
+
+        sum += chunkSum;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// same as softmaxRowStats_, for numLanes rows with stride 1 between rows and stride inner along axis
+template <typename T, bool approximate>
+static FORCEINLINE void softmaxLanesStats_(const T* x, const Nd4jLong length, const Nd4jLong inner, const Nd4jLong numLanes, SoftmaxAcc<T>* max, SoftmaxAcc<T>* sum, SoftmaxAcc<T>* chunkMax) {
+    typedef SoftmaxAcc<T> Z;
+
+    for (Nd4jLong l = 0; l < numLanes; l++) {
+        max[l] = -DataTypeUtils::max<Z>();
+        sum[l] = static_cast<Z>(0);
+    }
+
+    for (Nd4jLong c = 0; c < length; c += SOFTMAX_STEPS) {
+        const Nd4jLong end = nd4j::math::nd4j_min<Nd4jLong>(c + SOFTMAX_STEPS, length);
+
+        PRAGMA_OMP_SIMD
+        for (Nd4jLong l = 0; l < numLanes; l++)
+            chunkMax[l] = max[l];
+
+        for (Nd4jLong a = c; a < end; a++) {
+            const T* xa = x + a * inner;
+
+            PRAGMA_OMP_SIMD
+            for (Nd4jLong l = 0; l < numLanes; l++)
+                chunkMax[l] = nd4j::math::nd4j_max<Z>(chunkMax[l], static_cast<Z>(xa[l]));
+        }
+
+        PRAGMA_OMP_SIMD
+        for (Nd4jLong l = 0; l < numLanes; l++) {
+            sum[l] *= SoftmaxExp<Z, approximate>::op(max[l] - chunkMax[l]);
+            max[l] = chunkMax[l];
+        }
+
+        for (Nd4jLong a = c; a < end; a++) {
+            const T* xa = x + a * inner;
+
+            PRAGMA_OMP_SIMD
+            for (Nd4jLong l = 0; l < numLanes; l++)
+                sum[l] += SoftmaxExp<Z, approximate>::op(static_cast<Z>(xa[l]) - max[l]);
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// z may be the same buffer as x
+template <typename T, bool approximate, bool isLog>
+static void softmaxContiguous_(const T* x, T* z, const Nd4jLong outer, const Nd4jLong length, const Nd4jLong inner) {
+    typedef SoftmaxAcc<T> Z;
+
+    if (inner == 1) {
+        auto func = [&](Nd4jLong start, Nd4jLong stop) {
+            for (auto r = start; r < stop; r++) {
+                const T* xr = x + r * length;
+                T* zr = z + r * length;
+
+                Z max, sum;
+                softmaxRowStats_<T, approximate>(xr, length, max, sum);
+
+                if (isLog) {
+                    const Z shift = max + nd4j::math::nd4j_log<Z, Z>(sum);
+
+                    PRAGMA_OMP_SIMD
+                    for (Nd4jLong j = 0; j < length; j++)
+                        zr[j] = static_cast<T>(static_cast<Z>(xr[j]) - shift);
+                }
+                else {
+                    const Z factor = static_cast<Z>(1) / sum;
+
+                    PRAGMA_OMP_SIMD
+                    for (Nd4jLong j = 0; j < length; j++)
+                        zr[j] = static_cast<T>(SoftmaxExp<Z, approximate>::op(static_cast<Z>(xr[j]) - max) * factor);
+                }
+            }
+        };
+
+        auto numThreads = OmpLaunchHelper::betterThreads(outer * length, Threads::maxThreads());
+        Threads::parallel_for(func, 0, outer, 1, numThreads);
+    }
+    else {
+        const Nd4jLong numBlocks = (inner + SOFTMAX_LANES - 1) / SOFTMAX_LANES;
+
+        auto func = [&](Nd4jLong start, Nd4jLong stop) {
+            Z max[SOFTMAX_LANES], sum[SOFTMAX_LANES], tmp[SOFTMAX_LANES];
+
+            for (auto t = start; t < stop; t++) {
+                const Nd4jLong l0 = (t % numBlocks) * SOFTMAX_LANES;
+                const Nd4jLong numLanes = nd4j::math::nd4j_min<Nd4jLong>(SOFTMAX_LANES, inner - l0);
+                const T* xb = x + (t / numBlocks) * length * inner + l0;
+                T* zb = z + (t / numBlocks) * length * inner + l0;
+
+                softmaxLanesStats_<T, approximate>(xb, length, inner, numLanes, max, sum, tmp);
+
+                if (isLog) {
+                    for (Nd4jLong l = 0; l < numLanes; l++)
+                        tmp[l] = max[l] + nd4j::math::nd4j_log<Z, Z>(sum[l]);
+
+                    for (Nd4jLong a = 0; a < length; a++) {
+                        const T* xa = xb + a * inner;
+                        T* za = zb + a * inner;
+
+                        PRAGMA_OMP_SIMD
+                        for (Nd4jLong l = 0; l < numLanes; l++)
+                            za[l] = static_cast<T>(static_cast<Z>(xa[l]) - tmp[l]);
+                    }
+                }
+                else {
+                    for (Nd4jLong l = 0; l < numLanes; l++)
+                        tmp[l] = static_cast<Z>(1) / sum[l];
+
+                    for (Nd4jLong a = 0; a < length; a++) {
+                        const T* xa = xb + a * inner;
+                        T* za = zb + a * inner;
+
+                        PRAGMA_OMP_SIMD
+                        for (Nd4jLong l = 0; l < numLanes; l++)
+                            za[l] = static_cast<T>(SoftmaxExp<Z, approximate>::op(static_cast<Z>(xa[l]) - max[l]) * tmp[l]);
+                    }
+                }
+            }
+        };
+
+        auto numThreads = OmpLaunchHelper::betterThreads(outer * length * inner, Threads::maxThreads());
+        Threads::parallel_for(func, 0, outer * numBlocks, 1, numThreads);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// gradI = softmax * (gradO - sum(softmax * gradO)), softmax itself is kept in gradI between passes
+template <typename T, bool approximate>
+static void softmaxBpContiguous_(const T* x, const T* g, T* z, const Nd4jLong outer, const Nd4jLong length, const Nd4jLong inner) {
+    typedef SoftmaxAcc<T> Z;
+
+    if (inner == 1) {
+        auto func = [&](Nd4jLong start, Nd4jLong stop) {
+            for (auto r = start; r < stop; r++) {
+                const T* xr = x + r * length;
+                const T* gr = g + r * length;
+                T* zr = z + r * length;
+
+                Z max, sum;
+                softmaxRowStats_<T, approximate>(xr, length, max, sum);
+
+                const Z factor = static_cast<Z>(1) / sum;
+                Z dot = static_cast<Z>(0);
+
+                PRAGMA_OMP_SIMD_SUM(dot)
+                for (Nd4jLong j = 0; j < length; j++) {
+                    const Z y = SoftmaxExp<Z, approximate>::op(static_cast<Z>(xr[j]) - max) * factor;
+                    zr[j] = static_cast<T>(y);
+                    dot += y * static_cast<Z>(gr[j]);
+                }
+
+                PRAGMA_OMP_SIMD
+                for (Nd4jLong j = 0; j < length; j++)
+                    zr[j] = static_cast<T>(static_cast<Z>(zr[j]) * (static_cast<Z>(gr[j]) - dot));
+            }
+        };
+
+        auto numThreads = OmpLaunchHelper::betterThreads(outer * length, Threads::maxThreads());
+        Threads::parallel_for(func, 0, outer, 1, numThreads);
+    }
+    else {
+        const Nd4jLong numBlocks = (inner + SOFTMAX_LANES - 1) / SOFTMAX_LANES;
+
+        auto func = [&](Nd4jLong start, Nd4jLong stop) {
+            Z max[SOFTMAX_LANES], sum[SOFTMAX_LANES], tmp[SOFTMAX_LANES];
+
+            for (auto t = start; t < stop; t++) {
+                const Nd4jLong l0 = (t % numBlocks) * SOFTMAX_LANES;
+                const Nd4jLong numLanes = nd4j::math::nd4j_min<Nd4jLong>(SOFTMAX_LANES, inner - l0);
+                const Nd4jLong offset = (t / numBlocks) * length * inner + l0;
+
+                softmaxLanesStats_<T, approximate>(x + offset, length, inner, numLanes, max, sum, tmp);
+
+                // sums aren't needed once factors are taken, so they are reused for dot products
+                for (Nd4jLong l = 0; l < numLanes; l++) {
+                    tmp[l] = static_cast<Z>(1) / sum[l];
+                    sum[l] = static_cast<Z>(0);
+                }
+
+                for (Nd4jLong a = 0; a < length; a++) {
+                    const T* xa = x + offset + a * inner;
+                    const T* ga = g + offset + a * inner;
+                    T* za = z + offset + a * inner;
+
+                    PRAGMA_OMP_SIMD
+                    for (Nd4jLong l = 0; l < numLanes; l++) {
+                        const Z y = SoftmaxExp<Z, approximate>::op(static_cast<Z>(xa[l]) - max[l]) * tmp[l];
+                        za[l] = static_cast<T>(y);
+                        sum[l] += y * static_cast<Z>(ga[l]);
+                    }
+                }
+
+                for (Nd4jLong a = 0; a < length; a++) {
+                    const T* ga = g + offset + a * inner;
+                    T* za = z + offset + a * inner;
+
+                    PRAGMA_OMP_SIMD
+                    for (Nd4jLong l = 0; l < numLanes; l++)
+                        za[l] = static_cast<T>(static_cast<Z>(za[l]) * (static_cast<Z>(ga[l]) - sum[l]));
+                }
+            }
+        };
+
+        auto numThreads = OmpLaunchHelper::betterThreads(outer * length * inner, Threads::maxThreads());
+        Threads::parallel_for(func, 0, outer * numBlocks, 1, numThreads);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// sizes of [outer, axis, inner] view, false if array isn't contiguous c-ordered one
+static bool softmaxView(const NDArray& array, const int dimension, Nd4jLong& outer, Nd4jLong& length, Nd4jLong& inner) {
+
+    if (array.ordering() != 'c' || array.ews() != 1 || array.lengthOf() == 0)
+        return false;
+
+    const int rank = array.rankOf();
+    const int dim  = dimension < 0 ? dimension + rank : dimension;
+
+    if (dim < 0 || dim >= rank)
+        return false;
+
+    outer = 1;
+    inner = 1;
+    length = array.sizeAt(dim);
+
+    for (int i = 0; i < dim; i++)
+        outer *= array.sizeAt(i);
+
+    for (int i = dim + 1; i < rank; i++)
+        inner *= array.sizeAt(i);
+
+    return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static bool softmaxFast_(const NDArray& input, NDArray& output, const int dimension, const bool isLog) {
+
+    Nd4jLong outer, length, inner;
+    if (!input.isSameShapeStrict(&output) || output.ews() != 1 || !softmaxView(input, dimension, outer, length, inner))
+        return false;
+
+    auto x = input.bufferAsT<T>();
+    auto z = output.bufferAsT<T>();
+
+    if (Environment::getInstance()->isApproximateExp()) {
+        if (isLog)
+            softmaxContiguous_<T, true, true>(x, z, outer, length, inner);
+        else
+            softmaxContiguous_<T, true, false>(x, z, outer, length, inner);
+    }
+    else {
+        if (isLog)
+            softmaxContiguous_<T, false, true>(x, z, outer, length, inner);
+        else
+            softmaxContiguous_<T, false, false>(x, z, outer, length, inner);
+    }
+
+    return true;
+}
+
 //////////////////////////////////////////////////////////////////////////
 template <typename T>
 static void softmax_(const NDArray& input, NDArray& output, const int dimension) {
 
     const int rank = input.rankOf();
 
+    if (softmaxFast_<T>(input, output, dimension, false))
+        return;
+
     if(input.isVector()) {
         
         if(rank == 1 || input.sizeAt(dimension) != 1)
@@ -242,6 +585,55 @@ void softmax(const NDArray& input, NDArray& output, const int dimension) {
     BUILD_SINGLE_SELECTOR(input.dataType(), softmax_, (input, output, dimension), FLOAT_TYPES);
 }
 
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void logSoftmax_(const NDArray& input, NDArray& output, const int dimension) {
+
+    if (softmaxFast_<T>(input, output, dimension, true))
+        return;
+
+    // log(softmax(x)) underflows to -inf for large logit gaps, so log-sum-exp is used instead
+    NDArray max = input.reduceAlongDims(nd4j::reduce::Max, {dimension}, true);
+    input.applyTrueBroadcast(nd4j::BroadcastOpsTuple::Subtract(), &max, &output, false);
+    NDArray sum = output.transform(nd4j::transform::Exp).reduceAlongDims(nd4j::reduce::Sum, {dimension}, true);
+    sum.applyTransform(nd4j::transform::Log);
+    output -= sum;
+}
+
+///////////////////////////////////////////////////////////////////
+void logSoftmax(const NDArray& input, NDArray& output, const int dimension) {
+
+    BUILD_SINGLE_SELECTOR(input.dataType(), logSoftmax_, (input, output, dimension), FLOAT_TYPES);
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void softmaxBp_(const NDArray& input, const NDArray& gradO, NDArray& gradI, const int dimension) {
+
+    Nd4jLong outer, length, inner;
+    const bool contiguous = gradO.dataType() == input.dataType() && gradI.dataType() == input.dataType() && input.isSameShapeStrict(&gradO) && input.isSameShapeStrict(&gradI)
+                            && gradO.ews() == 1 && gradI.ews() == 1 && softmaxView(input, dimension, outer, length, inner);
+
+    if (!contiguous) {
+        softmax_<T>(input, gradI, dimension);
+
+        auto sumAlongDim = (gradI * gradO).reduceAlongDims(reduce::Sum, {dimension}, true);
+        gradI.assign(gradI * (gradO - sumAlongDim));
+        return;
+    }
+
+    if (Environment::getInstance()->isApproximateExp())
+        softmaxBpContiguous_<T, true>(input.bufferAsT<T>(), gradO.bufferAsT<T>(), gradI.bufferAsT<T>(), outer, length, inner);
+    else
+        softmaxBpContiguous_<T, false>(input.bufferAsT<T>(), gradO.bufferAsT<T>(), gradI.bufferAsT<T>(), outer, length, inner);
+}
+
+///////////////////////////////////////////////////////////////////
+void softmaxBp(const NDArray& input, const NDArray& gradO, NDArray& gradI, const int dimension) {
+
+    BUILD_SINGLE_SELECTOR(input.dataType(), softmaxBp_, (input, gradO, gradI, dimension), FLOAT_TYPES);
+}
+
 
     //////////////////////////////////////////////////////////////////////////
     void prelu(const NDArray& input, const NDArray& alpha, NDArray& output) {
@@ -0,0 +1,499 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <ops/declarable/helpers/attention.h>
+#include <helpers/ThreadPool.h>
+#include <helpers/OmpLaunchHelper.h>
+#include <MmulHelper.h>
+#include <templatemath.h>
+#include <array/DataTypeUtils.h>
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace nd4j {
+namespace ops {
+namespace helpers {
+
+    // number of queries and keys per block. Scores tile and packed blocks of queries, keys and values stay in L1/L2
+    static const int ATTENTION_BLOCK_Q = 32;
+    static const int ATTENTION_BLOCK_K = 64;
+
+    // masked timesteps get the same penalty dot_product_attention adds to them
+    static const double ATTENTION_MASK_PENALTY = 1e9;
+
+    // attention operand as [batch, head, feature, time], 3d arrays are seen as single-headed
+    template <typename T>
+    struct AttentionView {
+        T* buffer;
+        Nd4jLong numHeads;
+        Nd4jLong features;
+        Nd4jLong length;
+        Nd4jLong str[4];
+
+        FORCEINLINE T* head(Nd4jLong bh) const { return buffer + (bh / numHeads) * str[0] + (bh % numHeads) * str[1]; }
+    };
+
+    template <typename T>
+    static AttentionView<T> viewOf(const NDArray* array) {
+        const int rank = array->rankOf();
+
+        AttentionView<T> v;
+        v.buffer   = array->bufferAsT<T>();
+        v.numHeads = rank == 4 ? array->sizeAt(1) : 1;
+        v.features = array->sizeAt(rank - 2);
+        v.length   = array->sizeAt(rank - 1);
+        v.str[0]   = array->stridesOf()[0];
+        v.str[1]   = rank == 4 ? array->stridesOf()[1] : 0;
+        v.str[2]   = array->stridesOf()[rank - 2];
+        v.str[3]   = array->stridesOf()[rank - 1];
+
+        return v;
+    }
+
+    // view of rows [row0, row0 + numHeads * features) of [rows, batch, time] c-ordered buffer, i.e. projection results
+    template <typename T>
+    static AttentionView<T> viewOfRows(T* buffer, const Nd4jLong row0, const Nd4jLong numHeads, const Nd4jLong features, const Nd4jLong batchSize, const Nd4jLong length) {
+        AttentionView<T> v;
+        v.buffer   = buffer + row0 * batchSize * length;
+        v.numHeads = numHeads;
+        v.features = features;
+        v.length   = length;
+        v.str[0]   = length;
+        v.str[1]   = features * batchSize * length;
+        v.str[2]   = batchSize * length;
+        v.str[3]   = 1;
+
+        return v;
+    }
+
+    // copies timesteps [t0, t0 + n) of one head into dst [n, features], multiplied by scale
+    template <typename T>
+    static void packBlock_(const AttentionView<T>& v, const T* head, const Nd4jLong t0, const int n, const T scale, T* dst) {
+        const int F = static_cast<int>(v.features);
+
+        for (int j = 0; j < n; j++) {
+            const T* x = head + (t0 + j) * v.str[3];
+            T* z = dst + static_cast<Nd4jLong>(j) * F;
+
+            for (int f = 0; f < F; f++)
+                z[f] = x[f * v.str[2]] * scale;
+        }
+    }
+
+    // s [nQ, nK] = q [nQ, F] x k [nK, F]^T + maskBias
+    template <typename T>
+    static void scores_(const T* q, const T* k, const T* maskBias, const int nQ, const int nK, const int F, T* s) {
+        for (int i = 0; i < nQ; i++) {
+            const T* x = q + static_cast<Nd4jLong>(i) * F;
+
+            for (int j = 0; j < nK; j++) {
+                const T* y = k + static_cast<Nd4jLong>(j) * F;
+
+                T sum = static_cast<T>(0.);
+                for (int f = 0; f < F; f++)
+                    sum += x[f] * y[f];
+
+                s[i * nK + j] = maskBias != nullptr ? sum + maskBias[j] : sum;
+            }
+        }
+    }
+
+    // per-timestep additive mask, [batchSize, timesteps]
+    template <typename T>
+    static std::vector<T> maskBias_(const NDArray* mask) {
+        std::vector<T> result;
+        if (mask == nullptr)
+            return result;
+
+        // half precision can't hold the penalty, but anything close to its max does the same job without turning into -inf
+        const double penalty = nd4j::math::nd4j_min<double>(ATTENTION_MASK_PENALTY, static_cast<double>(DataTypeUtils::max<T>()) / 2.);
+
+        result.resize(mask->lengthOf());
+        for (Nd4jLong e = 0; e < mask->lengthOf(); e++)
+            result[e] = static_cast<T>((mask->e<double>(e) - 1.) * penalty);
+
+        return result;
+    }
+
+    template <typename T>
+    struct AttentionProblem {
+        AttentionView<T> q, k, v;
+        Nd4jLong batchSize;
+        const T* mask;          // [batchSize, Tk] additive mask or nullptr
+        T scale;
+
+        FORCEINLINE Nd4jLong numBatches() const { return batchSize * q.numHeads; }
+        FORCEINLINE const T* maskOf(Nd4jLong bh, Nd4jLong t0) const { return mask == nullptr ? nullptr : mask + (bh / q.numHeads) * k.length + t0; }
+    };
+
+    /**
+     * Forward pass for queries [tq0, tq0 + nQ) of single head: softmax over keys is computed online, i.e. running max
+     * and sum of exponents are rescaled every time a new block of keys raises the max. Writes normalized result into acc
+     * [nQ, vF], and log-sum-exp of every row into lse if it's not nullptr
+     */
+    template <typename T>
+    static void attentionRows_(const AttentionProblem<T>& p, const Nd4jLong bh, const Nd4jLong tq0, const int nQ, const T* qT, T* kT, T* vT, T* s, T* rowMax, T* rowSum, T* acc, T* lse) {
+        const int F  = static_cast<int>(p.q.features);
+        const int vF = static_cast<int>(p.v.features);
+        const Nd4jLong Tk = p.k.length;
+        const T* kHead = p.k.head(bh);
+        const T* vHead = p.v.head(bh);
+
+        std::fill(rowSum, rowSum + nQ, static_cast<T>(0.));
+        std::fill(acc, acc + static_cast<Nd4jLong>(nQ) * vF, static_cast<T>(0.));
+
+        for (Nd4jLong tk0 = 0; tk0 < Tk; tk0 += ATTENTION_BLOCK_K) {
+            const int nK = static_cast<int>(nd4j::math::nd4j_min<Nd4jLong>(ATTENTION_BLOCK_K, Tk - tk0));
+
+            packBlock_<T>(p.k, kHead, tk0, nK, static_cast<T>(1.), kT);
+            packBlock_<T>(p.v, vHead, tk0, nK, static_cast<T>(1.), vT);
+            scores_<T>(qT, kT, p.maskOf(bh, tk0), nQ, nK, F, s);
+
+            for (int i = 0; i < nQ; i++) {
+                T* sI = s + i * nK;
+
+                T blockMax = sI[0];
+                for (int j = 1; j < nK; j++)
+                    blockMax = nd4j::math::nd4j_max<T>(blockMax, sI[j]);
+
+                // first block sets the max, nothing accumulated before it needs rescaling
+                T* a = acc + static_cast<Nd4jLong>(i) * vF;
+                if (tk0 == 0) {
+                    rowMax[i] = blockMax;
+                }
+                else if (blockMax > rowMax[i]) {
+                    const T correction = nd4j::math::nd4j_exp<T, T>(rowMax[i] - blockMax);
+                    rowSum[i] *= correction;
+                    for (int f = 0; f < vF; f++)
+                        a[f] *= correction;
+
+                    rowMax[i] = blockMax;
+                }
+
+                T sum = static_cast<T>(0.);
+                for (int j = 0; j < nK; j++) {
+                    sI[j] = nd4j::math::nd4j_exp<T, T>(sI[j] - rowMax[i]);
+                    sum += sI[j];
+                }
+                rowSum[i] += sum;
+
+                for (int j = 0; j < nK; j++) {
+                    const T w = sI[j];
+                    const T* y = vT + static_cast<Nd4jLong>(j) * vF;
+
+                    PRAGMA_OMP_SIMD
+                    for (int f = 0; f < vF; f++)
+                        a[f] += w * y[f];
+                }
+            }
+        }
+
+        for (int i = 0; i < nQ; i++) {
+            T* a = acc + static_cast<Nd4jLong>(i) * vF;
+            const T factor = static_cast<T>(1.) / rowSum[i];
+            for (int f = 0; f < vF; f++)
+                a[f] *= factor;
+
+            if (lse != nullptr)
+                lse[i] = rowMax[i] + nd4j::math::nd4j_log<T, T>(rowSum[i]);
+        }
+    }
+
+    // writes rows [nQ, vF] into timesteps [tq0, tq0 + nQ) of one head of output
+    template <typename T>
+    static void unpackBlock_(const AttentionView<T>& v, T* head, const Nd4jLong t0, const int n, const T* src) {
+        const int F = static_cast<int>(v.features);
+
+        for (int j = 0; j < n; j++) {
+            T* z = head + (t0 + j) * v.str[3];
+            const T* x = src + static_cast<Nd4jLong>(j) * F;
+
+            for (int f = 0; f < F; f++)
+                z[f * v.str[2]] = x[f];
+        }
+    }
+
+    template <typename T>
+    static void fusedAttention_(const AttentionProblem<T>& p, const AttentionView<T>& out) {
+        const int F  = static_cast<int>(p.q.features);
+        const int vF = static_cast<int>(p.v.features);
+        const Nd4jLong Tq = p.q.length;
+        const Nd4jLong numQBlocks = (Tq + ATTENTION_BLOCK_Q - 1) / ATTENTION_BLOCK_Q;
+
+        auto func = [&](Nd4jLong start, Nd4jLong stop) {
+            std::vector<T> qT(ATTENTION_BLOCK_Q * F), kT(ATTENTION_BLOCK_K * F), vT(ATTENTION_BLOCK_K * vF);
+            std::vector<T> s(ATTENTION_BLOCK_Q * ATTENTION_BLOCK_K), rowMax(ATTENTION_BLOCK_Q), rowSum(ATTENTION_BLOCK_Q), acc(ATTENTION_BLOCK_Q * vF);
+
+            for (auto t = start; t < stop; t++) {
+                const Nd4jLong bh  = t / numQBlocks;
+                const Nd4jLong tq0 = (t % numQBlocks) * ATTENTION_BLOCK_Q;
+                const int nQ = static_cast<int>(nd4j::math::nd4j_min<Nd4jLong>(ATTENTION_BLOCK_Q, Tq - tq0));
+
+                // scale is applied to queries once, instead of every score
+                packBlock_<T>(p.q, p.q.head(bh), tq0, nQ, p.scale, qT.data());
+                attentionRows_<T>(p, bh, tq0, nQ, qT.data(), kT.data(), vT.data(), s.data(), rowMax.data(), rowSum.data(), acc.data(), nullptr);
+                unpackBlock_<T>(out, out.head(bh), tq0, nQ, acc.data());
+            }
+        };
+
+        auto numThreads = OmpLaunchHelper::betterThreads(p.numBatches() * Tq * p.k.length * (F + vF), Threads::maxThreads());
+        Threads::parallel_for(func, 0, p.numBatches() * numQBlocks, 1, numThreads);
+    }
+
+    /**
+     * Backprop in two sweeps, both free of races. First one goes over blocks of queries: it recomputes forward pass to get
+     * log-sum-exp and D = sum(eps * output) of every query, and accumulates dLdq. Second one goes over blocks of keys and
+     * accumulates dLdk and dLdv, using weights restored from log-sum-exp
+     */
+    template <typename T>
+    static void fusedAttentionBp_(const AttentionProblem<T>& p, const AttentionView<T>& eps, const AttentionView<T>& dq, const AttentionView<T>& dk, const AttentionView<T>& dv) {
+        const int F  = static_cast<int>(p.q.features);
+        const int vF = static_cast<int>(p.v.features);
+        const Nd4jLong Tq = p.q.length;
+        const Nd4jLong Tk = p.k.length;
+        const Nd4jLong numQBlocks = (Tq + ATTENTION_BLOCK_Q - 1) / ATTENTION_BLOCK_Q;
+        const Nd4jLong numKBlocks = (Tk + ATTENTION_BLOCK_K - 1) / ATTENTION_BLOCK_K;
+
+        std::vector<T> lse(p.numBatches() * Tq), delta(p.numBatches() * Tq);
+
+        auto numThreads = OmpLaunchHelper::betterThreads(p.numBatches() * Tq * Tk * (F + vF), Threads::maxThreads());
+
+        auto funcQ = [&](Nd4jLong start, Nd4jLong stop) {
+            std::vector<T> qT(ATTENTION_BLOCK_Q * F), kT(ATTENTION_BLOCK_K * F), vT(ATTENTION_BLOCK_K * vF), eT(ATTENTION_BLOCK_Q * vF);
+            std::vector<T> s(ATTENTION_BLOCK_Q * ATTENTION_BLOCK_K), rowMax(ATTENTION_BLOCK_Q), rowSum(ATTENTION_BLOCK_Q), acc(ATTENTION_BLOCK_Q * vF), grad(ATTENTION_BLOCK_Q * F);
+
+            for (auto t = start; t < stop; t++) {
+                const Nd4jLong bh  = t / numQBlocks;
+                const Nd4jLong tq0 = (t % numQBlocks) * ATTENTION_BLOCK_Q;
+                const int nQ = static_cast<int>(nd4j::math::nd4j_min<Nd4jLong>(ATTENTION_BLOCK_Q, Tq - tq0));
+                T* lseB   = lse.data() + bh * Tq + tq0;
+                T* deltaB = delta.data() + bh * Tq + tq0;
+
+                packBlock_<T>(p.q, p.q.head(bh), tq0, nQ, p.scale, qT.data());
+                packBlock_<T>(eps, eps.head(bh), tq0, nQ, static_cast<T>(1.), eT.data());
+                attentionRows_<T>(p, bh, tq0, nQ, qT.data(), kT.data(), vT.data(), s.data(), rowMax.data(), rowSum.data(), acc.data(), lseB);
+
+                for (int i = 0; i < nQ; i++) {
+                    T sum = static_cast<T>(0.);
+                    for (int f = 0; f < vF; f++)
+                        sum += eT[i * vF + f] * acc[i * vF + f];
+                    deltaB[i] = sum;
+                }
+
+                std::fill(grad.begin(), grad.end(), static_cast<T>(0.));
+
+                for (Nd4jLong tk0 = 0; tk0 < Tk; tk0 += ATTENTION_BLOCK_K) {
+                    const int nK = static_cast<int>(nd4j::math::nd4j_min<Nd4jLong>(ATTENTION_BLOCK_K, Tk - tk0));
+
+                    packBlock_<T>(p.k, p.k.head(bh), tk0, nK, static_cast<T>(1.), kT.data());
+                    packBlock_<T>(p.v, p.v.head(bh), tk0, nK, static_cast<T>(1.), vT.data());
+                    scores_<T>(qT.data(), kT.data(), p.maskOf(bh, tk0), nQ, nK, F, s.data());
+
+                    for (int i = 0; i < nQ; i++) {
+                        T* g = grad.data() + static_cast<Nd4jLong>(i) * F;
+                        const T* e = eT.data() + static_cast<Nd4jLong>(i) * vF;
+
+                        for (int j = 0; j < nK; j++) {
+                            const T* y = vT.data() + static_cast<Nd4jLong>(j) * vF;
+                            T dw = static_cast<T>(0.);
+                            for (int f = 0; f < vF; f++)
+                                dw += e[f] * y[f];
+
+                            // softmax backprop: dS = P * (dP - D)
+                            const T ds = nd4j::math::nd4j_exp<T, T>(s[i * nK + j] - lseB[i]) * (dw - deltaB[i]) * p.scale;
+                            const T* k = kT.data() + static_cast<Nd4jLong>(j) * F;
+
+                            PRAGMA_OMP_SIMD
+                            for (int f = 0; f < F; f++)
+                                g[f] += ds * k[f];
+                        }
+                    }
+                }
+
+                unpackBlock_<T>(dq, dq.head(bh), tq0, nQ, grad.data());
+            }
+        };
+
+        Threads::parallel_for(funcQ, 0, p.numBatches() * numQBlocks, 1, numThreads);
+
+        auto funcK = [&](Nd4jLong start, Nd4jLong stop) {
+            std::vector<T> qT(ATTENTION_BLOCK_Q * F), kT(ATTENTION_BLOCK_K * F), vT(ATTENTION_BLOCK_K * vF), eT(ATTENTION_BLOCK_Q * vF);
+            std::vector<T> s(ATTENTION_BLOCK_Q * ATTENTION_BLOCK_K), gradK(ATTENTION_BLOCK_K * F), gradV(ATTENTION_BLOCK_K * vF);
+
+            for (auto t = start; t < stop; t++) {
+                const Nd4jLong bh  = t / numKBlocks;
+                const Nd4jLong tk0 = (t % numKBlocks) * ATTENTION_BLOCK_K;
+                const int nK = static_cast<int>(nd4j::math::nd4j_min<Nd4jLong>(ATTENTION_BLOCK_K, Tk - tk0));
+
+                packBlock_<T>(p.k, p.k.head(bh), tk0, nK, static_cast<T>(1.), kT.data());
+                packBlock_<T>(p.v, p.v.head(bh), tk0, nK, static_cast<T>(1.), vT.data());
+
+                std::fill(gradK.begin(), gradK.end(), static_cast<T>(0.));
+                std::fill(gradV.begin(), gradV.end(), static_cast<T>(0.));
+
+                for (Nd4jLong tq0 = 0; tq0 < Tq; tq0 += ATTENTION_BLOCK_Q) {
+                    const int nQ = static_cast<int>(nd4j::math::nd4j_min<Nd4jLong>(ATTENTION_BLOCK_Q, Tq - tq0));
+                    const T* lseB   = lse.data() + bh * Tq + tq0;
+                    const T* deltaB = delta.data() + bh * Tq + tq0;
+
+                    // queries are packed scaled, so gradient of keys gets the scale from them
+                    packBlock_<T>(p.q, p.q.head(bh), tq0, nQ, p.scale, qT.data());
+                    packBlock_<T>(eps, eps.head(bh), tq0, nQ, static_cast<T>(1.), eT.data());
+                    scores_<T>(qT.data(), kT.data(), p.maskOf(bh, tk0), nQ, nK, F, s.data());
+
+                    for (int i = 0; i < nQ; i++) {
+                        const T* e = eT.data() + static_cast<Nd4jLong>(i) * vF;
+                        const T* q = qT.data() + static_cast<Nd4jLong>(i) * F;
+
+                        for (int j = 0; j < nK; j++) {
+                            const T w = nd4j::math::nd4j_exp<T, T>(s[i * nK + j] - lseB[i]);
+                            const T* y = vT.data() + static_cast<Nd4jLong>(j) * vF;
+                            T* gv = gradV.data() + static_cast<Nd4jLong>(j) * vF;
+
+                            T dw = static_cast<T>(0.);
+                            for (int f = 0; f < vF; f++) {
+                                dw += e[f] * y[f];
+                                gv[f] += w * e[f];
+                            }
+
+                            const T ds = w * (dw - deltaB[i]);
+                            T* gk = gradK.data() + static_cast<Nd4jLong>(j) * F;
+
+                            PRAGMA_OMP_SIMD
+                            for (int f = 0; f < F; f++)
+                                gk[f] += ds * q[f];
+                        }
+                    }
+                }
+
+                unpackBlock_<T>(dk, dk.head(bh), tk0, nK, gradK.data());
+                unpackBlock_<T>(dv, dv.head(bh), tk0, nK, gradV.data());
+            }
+        };
+
+        Threads::parallel_for(funcK, 0, p.numBatches() * numKBlocks, 1, numThreads);
+    }
+
+    template <typename T>
+    static AttentionProblem<T> problemOf(const AttentionView<T>& q, const AttentionView<T>& k, const AttentionView<T>& v, const Nd4jLong batchSize, const std::vector<T>& mask, const bool normalization) {
+        AttentionProblem<T> p;
+        p.q = q;
+        p.k = k;
+        p.v = v;
+        p.batchSize = batchSize;
+        p.mask  = mask.empty() ? nullptr : mask.data();
+        p.scale = static_cast<T>(normalization ? 1. / nd4j::math::nd4j_sqrt<double, double>(static_cast<double>(q.features)) : 1.);
+
+        return p;
+    }
+
+    template <typename T>
+    static void fusedDotProductAttention_(const NDArray* queries, const NDArray* keys, const NDArray* values, const NDArray* mask, NDArray* output, const bool normalization) {
+        auto maskBias = maskBias_<T>(mask);
+        auto p = problemOf<T>(viewOf<T>(queries), viewOf<T>(keys), viewOf<T>(values), queries->sizeAt(0), maskBias, normalization);
+
+        fusedAttention_<T>(p, viewOf<T>(output));
+    }
+
+    template <typename T>
+    static void fusedDotProductAttentionBp_(const NDArray* queries, const NDArray* keys, const NDArray* values, const NDArray* eps, const NDArray* mask, NDArray* dLdq, NDArray* dLdk, NDArray* dLdv, const bool normalization) {
+        auto maskBias = maskBias_<T>(mask);
+        auto p = problemOf<T>(viewOf<T>(queries), viewOf<T>(keys), viewOf<T>(values), queries->sizeAt(0), maskBias, normalization);
+
+        fusedAttentionBp_<T>(p, viewOf<T>(eps), viewOf<T>(dLdq), viewOf<T>(dLdk), viewOf<T>(dLdv));
+    }
+
+    template <typename T>
+    static void fusedMultiHeadDotProductAttention_(const NDArray* queries, const NDArray* keys, const NDArray* values, const NDArray* Wq, const NDArray* Wk, const NDArray* Wv, const NDArray* Wo, const NDArray* mask, NDArray* output, const bool normalization, nd4j::memory::Workspace* workspace) {
+        const Nd4jLong bS = queries->sizeAt(0);
+        const Nd4jLong numHeads = Wq->sizeAt(0);
+        const std::vector<const NDArray*> inputs  = {queries, keys, values};
+        const std::vector<const NDArray*> weights = {Wq, Wk, Wv};
+
+        // projections are grouped by input: every group takes single GEMM [sum of numHeads * projectedSize, features] x [features, bS * T]
+        std::vector<NDArray*> projected;
+        std::vector<AttentionView<T>> views(3);
+        std::vector<bool> done(3, false);
+
+        for (int e = 0; e < 3; e++) {
+            if (done[e])
+                continue;
+
+            std::vector<int> group;
+            Nd4jLong rows = 0;
+            for (int g = e; g < 3; g++)
+                if (inputs[g] == inputs[e]) {
+                    group.push_back(g);
+                    rows += weights[g]->sizeAt(0) * weights[g]->sizeAt(1);
+                }
+
+            NDArray stacked('c', {rows, inputs[e]->sizeAt(1)}, inputs[e]->dataType(), workspace);
+            Nd4jLong row0 = 0;
+            for (auto g: group) {
+                const Nd4jLong r = weights[g]->sizeAt(0) * weights[g]->sizeAt(1);
+                auto slice = stacked({row0, row0 + r, 0, 0}, true);
+                auto w2d = weights[g]->reshape(weights[g]->ordering(), {r, weights[g]->sizeAt(2)});
+                slice.assign(w2d);
+                delete w2d;
+                row0 += r;
+            }
+
+            const Nd4jLong length = inputs[e]->sizeAt(2);
+            auto result = new NDArray('c', {rows, bS, length}, inputs[e]->dataType(), workspace);
+            MmulHelper::tensorDot(&stacked, inputs[e], result, {1}, {1});          // [rows, features] x [bS, features, T] = [rows, bS, T]
+            projected.push_back(result);
+
+            row0 = 0;
+            for (auto g: group) {
+                views[g] = viewOfRows<T>(result->bufferAsT<T>(), row0, numHeads, weights[g]->sizeAt(1), bS, length);
+                row0 += weights[g]->sizeAt(0) * weights[g]->sizeAt(1);
+                done[g] = true;
+            }
+        }
+
+        // attention results are [numHeads * projectedValues, bS, Tq], i.e. rows are ready for output projection
+        const Nd4jLong Tq = queries->sizeAt(2);
+        NDArray attention('c', {numHeads * Wv->sizeAt(1), bS, Tq}, queries->dataType(), workspace);
+
+        auto maskBias = maskBias_<T>(mask);
+        auto p = problemOf<T>(views[0], views[1], views[2], bS, maskBias, normalization);
+        fusedAttention_<T>(p, viewOfRows<T>(attention.bufferAsT<T>(), 0, numHeads, Wv->sizeAt(1), bS, Tq));
+
+        MmulHelper::tensorDot(Wo, &attention, output, {0}, {0}, {1, 0, 2});        // [numHeads * projectedValues, outSize] x [numHeads * projectedValues, bS, Tq] = [outSize, bS, Tq]
+
+        for (auto v: projected)
+            delete v;
+    }
+
+    void fusedDotProductAttention(const NDArray* queries, const NDArray* keys, const NDArray* values, const NDArray* mask, NDArray* output, const bool normalization) {
+        BUILD_SINGLE_SELECTOR(queries->dataType(), fusedDotProductAttention_, (queries, keys, values, mask, output, normalization), FLOAT_TYPES);
+    }
+
+    void fusedDotProductAttentionBp(const NDArray* queries, const NDArray* keys, const NDArray* values, const NDArray* eps, const NDArray* mask, NDArray* dLdq, NDArray* dLdk, NDArray* dLdv, const bool normalization) {
+        BUILD_SINGLE_SELECTOR(queries->dataType(), fusedDotProductAttentionBp_, (queries, keys, values, eps, mask, dLdq, dLdk, dLdv, normalization), FLOAT_TYPES);
+    }
+
+    void fusedMultiHeadDotProductAttention(const NDArray* queries, const NDArray* keys, const NDArray* values, const NDArray* Wq, const NDArray* Wk, const NDArray* Wv, const NDArray* Wo, const NDArray* mask, NDArray* output, const bool normalization, nd4j::memory::Workspace* workspace) {
+        BUILD_SINGLE_SELECTOR(queries->dataType(), fusedMultiHeadDotProductAttention_, (queries, keys, values, Wq, Wk, Wv, Wo, mask, output, normalization, workspace), FLOAT_TYPES);
+    }
+
+    BUILD_SINGLE_TEMPLATE(template void fusedDotProductAttention_, (const NDArray* queries, const NDArray* keys, const NDArray* values, const NDArray* mask, NDArray* output, const bool normalization), FLOAT_TYPES);
+    BUILD_SINGLE_TEMPLATE(template void fusedDotProductAttentionBp_, (const NDArray* queries, const NDArray* keys, const NDArray* values, const NDArray* eps, const NDArray* mask, NDArray* dLdq, NDArray* dLdk, NDArray* dLdv, const bool normalization), FLOAT_TYPES);
+    BUILD_SINGLE_TEMPLATE(template void fusedMultiHeadDotProductAttention_, (const NDArray* queries, const NDArray* keys, const NDArray* values, const NDArray* Wq, const NDArray* Wk, const NDArray* Wv, const NDArray* Wo, const NDArray* mask, NDArray* output, const bool normalization, nd4j::memory::Workspace* workspace), FLOAT_TYPES);
+}
+}
+}
@@ -0,0 +1,389 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <ops/declarable/helpers/fused_ops.h>
+#include <ops/BroadcastOpsTuple.h>
+#include <helpers/ShapeBuilders.h>
+#include <helpers/ShapeUtils.h>
+#include <NDArrayFactory.h>
+#include <ops/ops.h>
+#include <stdexcept>
+
+namespace nd4j {
+namespace ops {
+namespace helpers {
+
+    // number of elements processed by all steps at once. 4096 floats of input, output and operand fit into L1/L2 together
+    static const Nd4jLong FUSED_BLOCK_SIZE = 4096;
+
+    bool isFusibleStep(int kind, int opNum) {
+        switch (kind) {
+            case FUSED_TRANSFORM_SAME:
+                switch (opNum) {
+                    case transform::Abs:
+                    case transform::Sign:
+                    case transform::Neg:
+                    case transform::Round:
+                    case transform::TimesOneMinus:
+                    case transform::Cube:
+                    case transform::OneMinus:
+                    case transform::Reciprocal:
+                    case transform::Square:
+                    case transform::Identity:
+                    case transform::Ceiling:
+                    case transform::Floor:
+                        return true;
+                    default:
+                        return false;
+                }
+            case FUSED_TRANSFORM_STRICT:
+                // these ops aren't elementwise, or rely on extra params
+                switch (opNum) {
+                    case transform::SoftMax:
+                    case transform::SoftMaxDerivative:
+                    case transform::LogSoftMax:
+                    case transform::SpecialDerivative:
+                    case transform::Stabilize:
+                    case transform::StabilizeFP16:
+                    case transform::SetRange:
+                        return false;
+                    default:
+                        return opNum >= 0 && opNum <= transform::PreciseGELUDerivative;
+                }
+            case FUSED_TRANSFORM_FLOAT:
+                return opNum == transform::Sqrt || opNum == transform::RSqrt;
+            case FUSED_SCALAR:
+                switch (opNum) {
+                    case scalar::CopyPws:
+                    case scalar::LogicalOr:
+                    case scalar::LogicalXor:
+                    case scalar::LogicalNot:
+                    case scalar::LogicalAnd:
+                    case scalar::PowDerivative:
+                    case scalar::CompareAndSet:
+                    case scalar::SXELogitsSmoother:
+                    case scalar::LeakyRELUDerivative:
+                    case scalar::ReplaceNans:
+                    case scalar::LstmClip:
+                        return false;
+                    default:
+                        return opNum >= 0 && opNum <= scalar::ReversePow;
+                }
+            case FUSED_PAIRWISE:
+                return opNum == pairwise::Add || opNum == pairwise::Subtract || opNum == pairwise::Multiply || opNum == pairwise::Divide;
+            default:
+                return false;
+        }
+    }
+
+    std::vector<FusedStep> parseFusedSteps(const std::vector<int>& iArgs, int iArgsOffset, const std::vector<double>& tArgs, const std::vector<NDArray*>& operands) {
+        std::vector<FusedStep> steps;
+
+        if ((iArgs.size() - iArgsOffset) % 2 != 0)
+            throw std::invalid_argument("parseFusedSteps: steps must be defined as (kind, opNum) pairs");
+
+        int numSteps = ((int) iArgs.size() - iArgsOffset) / 2;
+        if ((int) tArgs.size() != numSteps)
+            throw std::invalid_argument("parseFusedSteps: number of scalars doesn't match number of steps");
+
+        int operand = 0;
+        for (int e = 0; e < numSteps; e++) {
+            FusedStep step;
+            step.kind = iArgs[iArgsOffset + e * 2];
+            step.opNum = iArgs[iArgsOffset + e * 2 + 1];
+            step.scalar = tArgs[e];
+            step.operand = nullptr;
+
+            if (!isFusibleStep(step.kind, step.opNum)) {
+                nd4j_printf("Step [%i] of kind [%i] isn't supported: opNum %i\n", e, step.kind, step.opNum);
+                throw std::invalid_argument("parseFusedSteps: unsupported step");
+            }
+
+            if (step.kind == FUSED_PAIRWISE) {
+                if (operand >= (int) operands.size())
+                    throw std::invalid_argument("parseFusedSteps: number of operands doesn't match number of pairwise steps");
+
+                step.operand = operands[operand++];
+            }
+
+            steps.emplace_back(step);
+        }
+
+        if (operand != (int) operands.size())
+            throw std::invalid_argument("parseFusedSteps: number of operands doesn't match number of pairwise steps");
+
+        return steps;
+    }
+
+    Nd4jLong* fusedOutputShapeInfo(const Nd4jLong* inputShapeInfo, const std::vector<int>& iArgs, int iArgsOffset, const std::vector<Nd4jLong*>& operandShapes, nd4j::memory::Workspace* workspace) {
+        auto dtype = ArrayOptions::dataType(inputShapeInfo);
+        auto current = ShapeBuilders::copyShapeInfo(inputShapeInfo, false, workspace);
+
+        int operand = 0;
+        for (int e = iArgsOffset; e + 1 < (int) iArgs.size(); e += 2) {
+            auto kind = iArgs[e];
+            if (kind == FUSED_TRANSFORM_FLOAT && !DataTypeUtils::isR(dtype))
+                dtype = DataTypeUtils::pickFloatingType(dtype);
+            else if (kind == FUSED_PAIRWISE && operand < (int) operandShapes.size()) {
+                auto operandShape = operandShapes[operand++];
+                dtype = DataTypeUtils::pickPairwiseResultType(dtype, ArrayOptions::dataType(operandShape));
+
+                Nd4jLong* broadcasted = nullptr;
+                bool broadcastable = ShapeUtils::evalBroadcastShapeInfo(current, operandShape, true, broadcasted, workspace);
+                RELEASE(current, workspace);
+
+                if (!broadcastable)
+                    return nullptr;
+
+                current = broadcasted;
+            }
+        }
+
+        auto result = ShapeBuilders::createShapeInfo(dtype, shape::order(current), shape::rank(current), shape::shapeOf(current), workspace);
+        RELEASE(current, workspace);
+
+        return result;
+    }
+
+    static nd4j::BroadcastOpsTuple broadcastTuple(int opNum) {
+        switch (opNum) {
+            case pairwise::Add:
+                return BroadcastOpsTuple::Add();
+            case pairwise::Subtract:
+                return BroadcastOpsTuple::Subtract();
+            case pairwise::Multiply:
+                return BroadcastOpsTuple::Multiply();
+            case pairwise::Divide:
+                return BroadcastOpsTuple::Divide();
+            default:
+                throw std::invalid_argument("fusedElementwise: unsupported pairwise op");
+        }
+    }
+
+    // applies single unary step from source to target, both arrays are expected to have suitable types
+    static void applyUnaryStep(const FusedStep& step, NDArray* source, NDArray* target, NDArray* scalar) {
+        switch (step.kind) {
+            case FUSED_TRANSFORM_SAME:
+                source->applyTransform(static_cast<nd4j::transform::SameOps>(step.opNum), target, nullptr);
+                break;
+            case FUSED_TRANSFORM_STRICT:
+                source->applyTransform(static_cast<nd4j::transform::StrictOps>(step.opNum), target, nullptr);
+                break;
+            case FUSED_TRANSFORM_FLOAT:
+                source->applyTransform(static_cast<nd4j::transform::FloatOps>(step.opNum), target, nullptr);
+                break;
+            case FUSED_SCALAR:
+                if (scalar != nullptr)
+                    source->applyScalarArr(static_cast<nd4j::scalar::Ops>(step.opNum), scalar, target, nullptr);
+                else
+                    source->applyScalar<double>(static_cast<nd4j::scalar::Ops>(step.opNum), step.scalar, target, nullptr);
+                break;
+            default:
+                throw std::invalid_argument("fusedElementwise: unsupported step");
+        }
+    }
+
+//////////////////////////////////////////////////////////////////////////
+    template <typename T, typename OpType>
+    static void pairwiseLoop_(const T* x, const T* y, T* z, const Nd4jLong yLength, const Nd4jLong offset, const Nd4jLong length) {
+        if (yLength == 1) {
+            const T v = y[0];
+
+            PRAGMA_OMP_SIMD
+            for (Nd4jLong e = 0; e < length; e++)
+                z[e] = OpType::op(x[e], v, nullptr);
+        } else if (offset + length <= yLength) {
+            // operand has the same shape as output
+            y += offset;
+
+            PRAGMA_OMP_SIMD
+            for (Nd4jLong e = 0; e < length; e++)
+                z[e] = OpType::op(x[e], y[e], nullptr);
+        } else {
+            // operand is broadcast along last dimension
+            Nd4jLong c = offset % yLength;
+            for (Nd4jLong e = 0; e < length; e++) {
+                z[e] = OpType::op(x[e], y[c], nullptr);
+                if (++c == yLength)
+                    c = 0;
+            }
+        }
+    }
+
+    template <typename T>
+    static void pairwiseBlock_(const int opNum, const void* vx, const void* vy, void* vz, const Nd4jLong yLength, const Nd4jLong offset, const Nd4jLong length) {
+        auto x = reinterpret_cast<const T*>(vx);
+        auto y = reinterpret_cast<const T*>(vy);
+        auto z = reinterpret_cast<T*>(vz);
+
+        switch (opNum) {
+            case pairwise::Add:
+                pairwiseLoop_<T, simdOps::Add<T, T, T>>(x, y, z, yLength, offset, length);
+                break;
+            case pairwise::Subtract:
+                pairwiseLoop_<T, simdOps::Subtract<T, T, T>>(x, y, z, yLength, offset, length);
+                break;
+            case pairwise::Multiply:
+                pairwiseLoop_<T, simdOps::Multiply<T, T, T>>(x, y, z, yLength, offset, length);
+                break;
+            case pairwise::Divide:
+                pairwiseLoop_<T, simdOps::Divide<T, T, T>>(x, y, z, yLength, offset, length);
+                break;
+            default:
+                throw std::invalid_argument("fusedElementwise: unsupported pairwise op");
+        }
+    }
+
+    // blockwise execution is possible only if all arrays are dense, have the same floating type, and all operands are either of output shape or broadcast along last dimension
+    static bool canRunBlockwise(NDArray* input, std::vector<FusedStep>& steps, NDArray* output) {
+        auto dtype = input->dataType();
+        if (!DataTypeUtils::isR(dtype) || output->dataType() != dtype)
+            return false;
+
+        if (input->ews() != 1 || output->ews() != 1 || input->ordering() != output->ordering() || !input->isSameShape(output))
+            return false;
+
+        for (auto &step: steps) {
+            if (step.kind != FUSED_PAIRWISE)
+                continue;
+
+            auto y = step.operand;
+            if (y->dataType() != dtype || y->ews() != 1)
+                return false;
+
+            if (y->lengthOf() == 1)
+                continue;
+
+            if (y->isSameShape(output) && y->ordering() == output->ordering())
+                continue;
+
+            if (output->ordering() == 'c' && y->rankOf() <= output->rankOf() && y->sizeAt(-1) == output->sizeAt(-1) && y->lengthOf() == y->sizeAt(-1))
+                continue;
+
+            return false;
+        }
+
+        return true;
+    }
+
+    static void fusedBlockwise(NDArray* input, std::vector<FusedStep>& steps, NDArray* output) {
+        auto dtype = input->dataType();
+        auto length = output->lengthOf();
+        auto sizeOfT = output->sizeOfT();
+        auto numBlocks = (length + FUSED_BLOCK_SIZE - 1) / FUSED_BLOCK_SIZE;
+        auto tail = length - (numBlocks - 1) * FUSED_BLOCK_SIZE;
+
+        // every block is processed as plain vector, so only two shapes are possible
+        auto blockShape = ShapeBuilders::createVectorShapeInfo(dtype, FUSED_BLOCK_SIZE);
+        auto tailShape = ShapeBuilders::createVectorShapeInfo(dtype, tail);
+
+        std::vector<NDArray> scalars;
+        scalars.reserve(steps.size());
+        for (auto &step: steps)
+            scalars.emplace_back(NDArrayFactory::create<double>(dtype, step.scalar, input->getWorkspace()));
+
+        auto x = reinterpret_cast<int8_t*>(input->getBuffer());
+        auto z = reinterpret_cast<int8_t*>(output->getBuffer());
+
+        PRAGMA_OMP_PARALLEL_FOR_IF(numBlocks > 1)
+        for (Nd4jLong b = 0; b < numBlocks; b++) {
+            auto offset = b * FUSED_BLOCK_SIZE;
+            auto shape = b == numBlocks - 1 ? tailShape : blockShape;
+            auto blockLength = b == numBlocks - 1 ? tail : FUSED_BLOCK_SIZE;
+
+            NDArray xBlock(x + offset * sizeOfT, shape);
+            NDArray zBlock(z + offset * sizeOfT, shape);
+
+            auto source = &xBlock;
+            for (int e = 0; e < (int) steps.size(); e++) {
+                auto &step = steps[e];
+                if (step.kind == FUSED_PAIRWISE) {
+                    BUILD_SINGLE_SELECTOR(dtype, pairwiseBlock_, (step.opNum, source->getBuffer(), step.operand->getBuffer(), zBlock.getBuffer(), step.operand->lengthOf(), offset, blockLength), FLOAT_TYPES);
+                } else
+                    applyUnaryStep(step, source, &zBlock, &scalars[e]);
+
+                // all subsequent steps are applied in place
+                source = &zBlock;
+            }
+        }
+
+        delete[] blockShape;
+        delete[] tailShape;
+    }
+
+    // generic path: steps are applied one by one to whole arrays, with temporary arrays wherever type or shape changes
+    static void fusedSequential(NDArray* input, std::vector<FusedStep>& steps, NDArray* output) {
+        std::vector<NDArray*> temps;
+        auto source = input;
+
+        for (int e = 0; e < (int) steps.size(); e++) {
+            auto &step = steps[e];
+            bool last = e == (int) steps.size() - 1;
+
+            if (step.kind == FUSED_PAIRWISE) {
+                bool sameShape = source->isSameShape(step.operand);
+                auto dtype = DataTypeUtils::pickPairwiseResultType(source->dataType(), step.operand->dataType());
+
+                if (last || (sameShape && dtype == output->dataType() && source->isSameShape(output))) {
+                    if (sameShape && output->isSameShape(source))
+                        source->applyPairwiseTransform(static_cast<nd4j::pairwise::Ops>(step.opNum), step.operand, output, nullptr);
+                    else
+                        source->applyTrueBroadcast(broadcastTuple(step.opNum), step.operand, output, true, nullptr);
+
+                    source = output;
+                } else {
+                    auto result = source->applyTrueBroadcast(broadcastTuple(step.opNum), step.operand);
+                    temps.emplace_back(result);
+                    source = result;
+                }
+            } else {
+                auto dtype = source->dataType();
+                if (step.kind == FUSED_TRANSFORM_FLOAT && !source->isR())
+                    dtype = DataTypeUtils::pickFloatingType(dtype);
+
+                NDArray* target = output;
+                if (!last && (dtype != output->dataType() || !source->isSameShape(output))) {
+                    target = new NDArray(source->ordering(), source->getShapeAsVector(), dtype, source->getWorkspace());
+                    temps.emplace_back(target);
+                }
+
+                applyUnaryStep(step, source, target, nullptr);
+                source = target;
+            }
+        }
+
+        for (auto t: temps)
+            delete t;
+    }
+
+    void fusedElementwise(NDArray* input, std::vector<FusedStep>& steps, NDArray* output) {
+        if (steps.empty()) {
+            if (input != output)
+                output->assign(input);
+
+            return;
+        }
+
+        if (canRunBlockwise(input, steps, output))
+            fusedBlockwise(input, steps, output);
+        else
+            fusedSequential(input, steps, output);
+    }
+
+    BUILD_SINGLE_TEMPLATE(template void pairwiseBlock_, (const int opNum, const void* vx, const void* vy, void* vz, const Nd4jLong yLength, const Nd4jLong offset, const Nd4jLong length), FLOAT_TYPES);
+}
+}
+}
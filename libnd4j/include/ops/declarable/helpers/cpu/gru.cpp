@@ -116,6 +116,101 @@ void gruCell(const NDArray* x, const NDArray* hLast, const NDArray* Wru, const N
     delete result;
 }
 
+//////////////////////////////////////////////////////////////////////////
+// first fused pass of gru step: reset and update gates, and r◦ht_1 which is needed for the candidate projection
+template <typename T>
+static void gruGatesStep_(const T* xProj, const T* hProj, const T* bias, const T* hLast, T* u, T* rh, const int bS, const int nU) {
+
+    PRAGMA_OMP_PARALLEL_FOR_IF(bS * nU > Environment::getInstance()->elementwiseThreshold())
+    for (int e = 0; e < bS; ++e) {
+        auto zx = xProj + e * 3 * nU;
+        auto zh = hProj + e * 2 * nU;
+        auto hl = hLast + e * nU;
+        auto ue = u + e * nU;
+        auto re = rh + e * nU;
+
+        PRAGMA_OMP_SIMD
+        for (int j = 0; j < nU; ++j) {
+            T r = nd4j::math::nd4j_sigmoid<T,T>(zx[j] + zh[j] + bias[j]);
+            ue[j] = nd4j::math::nd4j_sigmoid<T,T>(zx[nU + j] + zh[nU + j] + bias[nU + j]);
+            re[j] = r * hl[j];
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// second fused pass of gru step: candidate activation and state update, h = u◦ht_1 + (1-u)◦n
+template <typename T>
+static void gruStateStep_(const T* xProj, const T* nProj, const T* bias, const T* u, T* hLast, T* ht, const int bS, const int nU) {
+
+    PRAGMA_OMP_PARALLEL_FOR_IF(bS * nU > Environment::getInstance()->elementwiseThreshold())
+    for (int e = 0; e < bS; ++e) {
+        auto zx = xProj + e * 3 * nU + 2 * nU;
+        auto zn = nProj + e * nU;
+        auto ue = u + e * nU;
+        auto hl = hLast + e * nU;
+        auto h  = ht + e * nU;
+
+        PRAGMA_OMP_SIMD
+        for (int j = 0; j < nU; ++j) {
+            T n = nd4j::math::nd4j_tanh<T,T>(zx[j] + zn[j] + bias[2 * nU + j]);
+            h[j] = ue[j] * hl[j] + (static_cast<T>(1.f) - ue[j]) * n;
+            hl[j] = h[j];
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void gruTimeLoop_(const NDArray* x, const NDArray* h0, const NDArray* Wx, const NDArray* Wh, const NDArray* b, NDArray* h) {
+
+    const int time = x->sizeAt(0);
+    const int bS   = x->sizeAt(1);
+    const int iS   = x->sizeAt(2);
+    const int nU   = h0->sizeAt(1);
+
+    auto workspace = x->getWorkspace();
+    const auto dtype = x->dataType();
+
+    // input projection doesn't depend on recurrence, so it's evaluated for all time steps with single gemm
+    NDArray xFlat('c', {time, bS, iS}, dtype, workspace);
+    xFlat.assign(x);
+    xFlat.reshapei('c', {time * bS, iS});
+    NDArray xProj('c', {time * bS, 3 * nU}, dtype, workspace);
+    MmulHelper::mmul(&xFlat, Wx, &xProj, 1.0, 0.0);
+
+    // recurrent weights are split once: candidate gate needs (r◦ht_1)*Whn, so it can't share gemm with r and u
+    NDArray WhRU('c', {nU, 2 * nU}, dtype, workspace);
+    NDArray WhN('c', {nU, nU}, dtype, workspace);
+    WhRU.assign((*Wh)({0,0, 0,2*nU}));
+    WhN.assign((*Wh)({0,0, 2*nU,3*nU}));
+
+    // buffers below are allocated once and reused by every time step
+    NDArray hProj('c', {bS, 2 * nU}, dtype, workspace);
+    NDArray nProj('c', {bS, nU}, dtype, workspace);
+    NDArray u('c', {bS, nU}, dtype, workspace);
+    NDArray rh('c', {bS, nU}, dtype, workspace);
+    NDArray hLast('c', {bS, nU}, dtype, workspace);
+    NDArray bias('c', {3 * nU}, dtype, workspace);
+    NDArray hSeq('c', {time, bS, nU}, dtype, workspace);
+
+    hLast.assign(h0);
+    bias.assign(b);
+
+    for (int t = 0; t < time; ++t) {
+        auto xt = xProj.bufferAsT<T>() + t * bS * 3 * nU;
+
+        MmulHelper::mmul(&hLast, &WhRU, &hProj, 1.0, 0.0);
+        gruGatesStep_<T>(xt, hProj.bufferAsT<T>(), bias.bufferAsT<T>(), hLast.bufferAsT<T>(), u.bufferAsT<T>(), rh.bufferAsT<T>(), bS, nU);
+
+        MmulHelper::mmul(&rh, &WhN, &nProj, 1.0, 0.0);
+        gruStateStep_<T>(xt, nProj.bufferAsT<T>(), bias.bufferAsT<T>(), u.bufferAsT<T>(), hLast.bufferAsT<T>(), hSeq.bufferAsT<T>() + t * bS * nU, bS, nU);
+    }
+
+    // h may be a view, so results are copied with respect to its strides
+    h->assign(hSeq);
+}
+
 //////////////////////////////////////////////////////////////////////////
 void gruTimeLoop(const NDArray* x, const NDArray* h0, const NDArray* Wx, const NDArray* Wh, const NDArray* b, NDArray* h) {
 
@@ -126,20 +221,9 @@ void gruTimeLoop(const NDArray* x, const NDArray* h0, const NDArray* Wx, const N
 // b   biases, [3*nU]
 
 // h is cell outputs at each time step [time, bS, nU]
+// gates are evaluated the same way as in gruCellBP: r and u gates use columns [0, 2*nU), candidate uses [2*nU, 3*nU)
 
-const int time = x->sizeAt(0);
-
-NDArray ht_1(*h0);
-
-// loop through time steps
-for (int t = 0; t < time; ++t) {
-
-    auto xt = (*x)({t,t+1, 0,0, 0,0});
-    auto ht = (*h)({t,t+1, 0,0, 0,0});
-
-    //helpers::gruCell(&xt, &ht_1, Wx, Wh, b, &ht);
-    //ht_1.assign(ht);
-}
+    BUILD_SINGLE_SELECTOR(x->dataType(), gruTimeLoop_, (x, h0, Wx, Wh, b, h), FLOAT_TYPES);
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -19,72 +19,275 @@
 //
 
 #include <ops/declarable/helpers/image_suppression.h>
-//#include <blas/NDArray.h>
+#include <algorithm>
+#include <queue>
+#include <vector>
 
 namespace nd4j {
 namespace ops {
 namespace helpers {
 
-    template <typename T>
-    static void nonMaxSuppressionV2_(NDArray* boxes, NDArray* scales, int maxSize, double threshold, NDArray* output) {
-        std::vector<Nd4jLong> indices(scales->lengthOf());
-        for (size_t i = 0; i < indices.size(); ++i)
-            indices[i] = i;
-        std::sort(indices.begin(), indices.end(), [scales](int i, int j) {return scales->e<T>(i) > scales->e<T>(j);});
-
-        std::vector<int> selected;
-        std::vector<int> selectedIndices(output->lengthOf(), 0);
-        auto needToSuppressWithThreshold = [threshold] (NDArray& boxes, int previousIndex, int nextIndex) -> bool {
-            T minYPrev = nd4j::math::nd4j_min(boxes.e<T>(previousIndex, 0), boxes.e<T>(previousIndex, 2));
-            T minXPrev = nd4j::math::nd4j_min(boxes.e<T>(previousIndex, 1), boxes.e<T>(previousIndex, 3));
-            T maxYPrev = nd4j::math::nd4j_max(boxes.e<T>(previousIndex, 0), boxes.e<T>(previousIndex, 2));
-            T maxXPrev = nd4j::math::nd4j_max(boxes.e<T>(previousIndex, 1), boxes.e<T>(previousIndex, 3));
-            T minYNext = nd4j::math::nd4j_min(boxes.e<T>(nextIndex, 0), boxes.e<T>(nextIndex, 2));
-            T minXNext = nd4j::math::nd4j_min(boxes.e<T>(nextIndex, 1), boxes.e<T>(nextIndex, 3));
-            T maxYNext = nd4j::math::nd4j_max(boxes.e<T>(nextIndex, 0), boxes.e<T>(nextIndex, 2));
-            T maxXNext = nd4j::math::nd4j_max(boxes.e<T>(nextIndex, 1), boxes.e<T>(nextIndex, 3));
-            T areaPrev = (maxYPrev - minYPrev) * (maxXPrev - minXPrev);
-            T areaNext = (maxYNext - minYNext) * (maxXNext - minXNext);
-
-            if (areaNext <= T(0.f) || areaPrev <= T(0.f)) return false;
-
-            T minIntersectionY = nd4j::math::nd4j_max(minYPrev, minYNext);
-            T minIntersectionX = nd4j::math::nd4j_max(minXPrev, minXNext);
-            T maxIntersectionY = nd4j::math::nd4j_min(maxYPrev, maxYNext);
-            T maxIntersectionX = nd4j::math::nd4j_min(maxXPrev, maxXNext);
-            T intersectionArea =
-                    nd4j::math::nd4j_max(T(maxIntersectionY - minIntersectionY), T(0.0f)) *
-                            nd4j::math::nd4j_max(T(maxIntersectionX - minIntersectionX), T(0.0f));
-            T intersectionValue = intersectionArea / (areaPrev + areaNext - intersectionArea);
-            return intersectionValue > threshold;
+    // selected boxes are checked tile by tile, starting from the most recent ones, so suppressed candidate usually leaves after first tile
+    #define NMS_TILE 64
 
-        };
+    // boxes stored as separate coordinate arrays, with corners normalized, so overlap checks vectorize
+    template <typename Z>
+    struct BoxesSoA {
+        std::vector<Z> y1, x1, y2, x2, area;
+
+        void resize(Nd4jLong size) {
+            y1.resize(size);
+            x1.resize(size);
+            y2.resize(size);
+            x2.resize(size);
+            area.resize(size);
+        }
+
+        void set(Nd4jLong i, Z ya, Z xa, Z yb, Z xb) {
+            y1[i] = nd4j::math::nd4j_min<Z>(ya, yb);
+            x1[i] = nd4j::math::nd4j_min<Z>(xa, xb);
+            y2[i] = nd4j::math::nd4j_max<Z>(ya, yb);
+            x2[i] = nd4j::math::nd4j_max<Z>(xa, xb);
+            area[i] = (y2[i] - y1[i]) * (x2[i] - x1[i]);
+        }
+
+        void copy(Nd4jLong i, const BoxesSoA<Z>& other, Nd4jLong j) {
+            y1[i] = other.y1[j];
+            x1[i] = other.x1[j];
+            y2[i] = other.y2[j];
+            x2[i] = other.x2[j];
+            area[i] = other.area[j];
+        }
+    };
+
+    // boxes are (numBoxes, 4) contiguous array
+    template <typename Z>
+    static void loadBoxes(const Z* boxes, Nd4jLong numBoxes, BoxesSoA<Z>& soa) {
+        soa.resize(numBoxes);
+        for (Nd4jLong i = 0; i < numBoxes; i++)
+            soa.set(i, boxes[i * 4], boxes[i * 4 + 1], boxes[i * 4 + 2], boxes[i * 4 + 3]);
+    }
+
+    template <typename Z>
+    static FORCEINLINE Z intersectionOverUnion(const BoxesSoA<Z>& a, Nd4jLong i, const BoxesSoA<Z>& b, Nd4jLong j) {
+        if (a.area[i] <= Z(0.f) || b.area[j] <= Z(0.f))
+            return Z(0.f);
+
+        Z h = nd4j::math::nd4j_max<Z>(nd4j::math::nd4j_min<Z>(a.y2[i], b.y2[j]) - nd4j::math::nd4j_max<Z>(a.y1[i], b.y1[j]), Z(0.f));
+        Z w = nd4j::math::nd4j_max<Z>(nd4j::math::nd4j_min<Z>(a.x2[i], b.x2[j]) - nd4j::math::nd4j_max<Z>(a.x1[i], b.x1[j]), Z(0.f));
+        Z intersection = h * w;
+        return intersection / (a.area[i] + b.area[j] - intersection);
+    }
+
+    // checks if box i overlaps any of first numSelected boxes of selected more than threshold
+    template <typename Z>
+    static bool isSuppressed(const BoxesSoA<Z>& boxes, Nd4jLong i, const BoxesSoA<Z>& selected, int numSelected, Z threshold) {
+        const Z cArea = boxes.area[i];
+        if (cArea <= Z(0.f))
+            return false;
+
+        const Z cy1 = boxes.y1[i], cx1 = boxes.x1[i], cy2 = boxes.y2[i], cx2 = boxes.x2[i];
+        auto sy1 = selected.y1.data();
+        auto sx1 = selected.x1.data();
+        auto sy2 = selected.y2.data();
+        auto sx2 = selected.x2.data();
+        auto sArea = selected.area.data();
+
+        for (int end = numSelected; end > 0; end -= NMS_TILE) {
+            const int start = nd4j::math::nd4j_max<int>(end - NMS_TILE, 0);
+
+            // intersection / union > threshold is checked as intersection > threshold * union, so there's no division here
+            int suppressed = 0;
+            PRAGMA_OMP_SIMD_ARGS(reduction(|:suppressed))
+            for (int j = start; j < end; j++) {
+                Z h = nd4j::math::nd4j_max<Z>(nd4j::math::nd4j_min<Z>(cy2, sy2[j]) - nd4j::math::nd4j_max<Z>(cy1, sy1[j]), Z(0.f));
+                Z w = nd4j::math::nd4j_max<Z>(nd4j::math::nd4j_min<Z>(cx2, sx2[j]) - nd4j::math::nd4j_max<Z>(cx1, sx1[j]), Z(0.f));
+                Z intersection = h * w;
+                suppressed |= (sArea[j] > Z(0.f) && intersection > threshold * (cArea + sArea[j] - intersection)) ? 1 : 0;
+            }
+
+            if (suppressed)
+                return true;
+        }
+
+        return false;
+    }
+
+    template <typename Z>
+    struct SuppressionCandidate {
+        Nd4jLong index;
+        Z score;
+        int suppressBegin;
+    };
+
+    /**
+     * Greedy selection of boxes for single set of scores. Returns number of selected boxes,
+     * their indices and (possibly decayed) scores are stored into selectedIndices/selectedScores
+     */
+    template <typename Z>
+    static int suppressBoxes(const BoxesSoA<Z>& boxes, const Z* scores, Nd4jLong scoreStride, int maxSize, Z overlapThreshold, Z scoreThreshold, Z softNmsSigma, Nd4jLong* selectedIndices, Z* selectedScores) {
+        const Nd4jLong numBoxes = boxes.area.size();
+
+        std::vector<Nd4jLong> order;
+        order.reserve(numBoxes);
+        for (Nd4jLong i = 0; i < numBoxes; i++)
+            if (scores[i * scoreStride] > scoreThreshold)
+                order.emplace_back(i);
+
+        std::stable_sort(order.begin(), order.end(), [scores, scoreStride] (Nd4jLong a, Nd4jLong b) { return scores[a * scoreStride] > scores[b * scoreStride]; });
+
+        BoxesSoA<Z> selected;
+        selected.resize(maxSize);
         int numSelected = 0;
-        for (int i = 0; i < boxes->sizeAt(0); ++i) {
-            if (selected.size() >= output->lengthOf()) break;
-            bool shouldSelect = true;
-            // Overlapping boxes are likely to have similar scores,
-            // therefore we iterate through the selected boxes backwards.
-            for (int j = numSelected - 1; j >= 0; --j) {
-                if (needToSuppressWithThreshold(*boxes, indices[i], indices[selectedIndices[j]])) {
-                    shouldSelect = false;
+
+        if (softNmsSigma <= Z(0.f)) {
+            for (auto i: order) {
+                if (numSelected >= maxSize)
+                    break;
+
+                if (isSuppressed<Z>(boxes, i, selected, numSelected, overlapThreshold))
+                    continue;
+
+                selected.copy(numSelected, boxes, i);
+                selectedIndices[numSelected] = i;
+                selectedScores[numSelected] = scores[i * scoreStride];
+                numSelected++;
+            }
+
+            return numSelected;
+        }
+
+        // soft-nms: overlapping boxes aren't dropped, but get their scores decayed as exp(-iou^2 / (2 * sigma)).
+        // scores are decayed lazily, only when candidate reaches top of the queue
+        auto lower = [] (const SuppressionCandidate<Z>& a, const SuppressionCandidate<Z>& b) {
+            return a.score < b.score || (a.score == b.score && a.index > b.index);
+        };
+
+        std::priority_queue<SuppressionCandidate<Z>, std::vector<SuppressionCandidate<Z>>, decltype(lower)> queue(lower);
+        for (auto i: order)
+            queue.push({i, scores[i * scoreStride], 0});
+
+        const Z scale = Z(-0.5f) / softNmsSigma;
+        while (numSelected < maxSize && !queue.empty()) {
+            auto candidate = queue.top();
+            queue.pop();
+
+            const Z original = candidate.score;
+            bool dropped = false;
+            for (int j = numSelected - 1; j >= candidate.suppressBegin; j--) {
+                Z iou = intersectionOverUnion<Z>(boxes, candidate.index, selected, j);
+                if (iou > overlapThreshold) {
+                    dropped = true;
                     break;
                 }
+
+                candidate.score *= nd4j::math::nd4j_exp<Z, Z>(scale * iou * iou);
+                if (candidate.score <= scoreThreshold)
+                    break;
             }
-            if (shouldSelect) {
-                selected.push_back(indices[i]);
-                selectedIndices[numSelected++] = i;
+
+            if (dropped || candidate.score <= scoreThreshold)
+                continue;
+
+            candidate.suppressBegin = numSelected;
+            if (candidate.score == original) {
+                selected.copy(numSelected, boxes, candidate.index);
+                selectedIndices[numSelected] = candidate.index;
+                selectedScores[numSelected] = candidate.score;
+                numSelected++;
+            } else {
+                // decayed candidate goes back, since it might not be the best one anymore
+                queue.push(candidate);
             }
         }
-        for (size_t e = 0; e < selected.size(); ++e)
-            output->p<int>(e, selected[e]);
+
+        return numSelected;
+    }
+
+    template <typename Z>
+    static void nonMaxSuppressionV2_(NDArray* boxes, NDArray* scales, int maxSize, double overlapThreshold, double scoreThreshold, double softNmsSigma, NDArray* output) {
+        const Nd4jLong numBoxes = boxes->sizeAt(0);
+
+        // single conversion pass into contiguous arrays of compute type
+        NDArray boxesZ('c', boxes->getShapeAsVector(), DataTypeUtils::fromT<Z>(), boxes->getWorkspace());
+        NDArray scoresZ('c', {numBoxes}, DataTypeUtils::fromT<Z>(), boxes->getWorkspace());
+        boxesZ.assign(boxes);
+        scoresZ.assign(scales);
+
+        BoxesSoA<Z> soa;
+        loadBoxes<Z>(boxesZ.bufferAsT<Z>(), numBoxes, soa);
+
+        maxSize = nd4j::math::nd4j_min<int>(maxSize, output->lengthOf());
+        std::vector<Nd4jLong> selectedIndices(maxSize);
+        std::vector<Z> selectedScores(maxSize);
+
+        auto numSelected = suppressBoxes<Z>(soa, scoresZ.bufferAsT<Z>(), 1, maxSize, static_cast<Z>(overlapThreshold), static_cast<Z>(scoreThreshold), static_cast<Z>(softNmsSigma), selectedIndices.data(), selectedScores.data());
+
+        for (int e = 0; e < numSelected; ++e)
+            output->p<Nd4jLong>(e, selectedIndices[e]);
+    }
+
+    template <typename Z>
+    static void nonMaxSuppressionBatched_(NDArray* boxes, NDArray* scores, int maxSize, double overlapThreshold, double scoreThreshold, double softNmsSigma, NDArray* indices, NDArray* selectedScores, NDArray* validCounts) {
+        const Nd4jLong batchSize = boxes->sizeAt(0);
+        const Nd4jLong numBoxes = boxes->sizeAt(1);
+        const Nd4jLong numClasses = scores->sizeAt(2);
+
+        NDArray boxesZ('c', boxes->getShapeAsVector(), DataTypeUtils::fromT<Z>(), boxes->getWorkspace());
+        NDArray scoresZ('c', scores->getShapeAsVector(), DataTypeUtils::fromT<Z>(), boxes->getWorkspace());
+        boxesZ.assign(boxes);
+        scoresZ.assign(scores);
+
+        auto b = boxesZ.bufferAsT<Z>();
+        auto s = scoresZ.bufferAsT<Z>();
+
+        // boxes are shared between classes, so each image is converted once
+        std::vector<BoxesSoA<Z>> soa(batchSize);
+        PRAGMA_OMP_PARALLEL_FOR_IF(batchSize > 1)
+        for (Nd4jLong i = 0; i < batchSize; i++)
+            loadBoxes<Z>(b + i * numBoxes * 4, numBoxes, soa[i]);
+
+        const Nd4jLong numTasks = batchSize * numClasses;
+        std::vector<Nd4jLong> zIndices(numTasks * maxSize, -1);
+        std::vector<Z> zScores(numTasks * maxSize, Z(0.f));
+        std::vector<Nd4jLong> zCounts(numTasks, 0);
+
+        // every (image, class) pair is independent
+        PRAGMA_OMP_PARALLEL_FOR_IF(numTasks > 1)
+        for (Nd4jLong t = 0; t < numTasks; t++) {
+            const Nd4jLong image = t / numClasses;
+            const Nd4jLong cls = t % numClasses;
+
+            zCounts[t] = suppressBoxes<Z>(soa[image], s + image * numBoxes * numClasses + cls, numClasses, maxSize, static_cast<Z>(overlapThreshold), static_cast<Z>(scoreThreshold), static_cast<Z>(softNmsSigma), zIndices.data() + t * maxSize, zScores.data() + t * maxSize);
+        }
+
+        NDArray tIndices('c', indices->getShapeAsVector(), nd4j::DataType::INT64, boxes->getWorkspace());
+        NDArray tScores('c', selectedScores->getShapeAsVector(), DataTypeUtils::fromT<Z>(), boxes->getWorkspace());
+        NDArray tCounts('c', validCounts->getShapeAsVector(), nd4j::DataType::INT64, boxes->getWorkspace());
+        memcpy(tIndices.buffer(), zIndices.data(), zIndices.size() * sizeof(Nd4jLong));
+        memcpy(tScores.buffer(), zScores.data(), zScores.size() * sizeof(Z));
+        memcpy(tCounts.buffer(), zCounts.data(), zCounts.size() * sizeof(Nd4jLong));
+
+        indices->assign(tIndices);
+        selectedScores->assign(tScores);
+        validCounts->assign(tCounts);
+    }
+
+    // overlap checks are done in double precision for double boxes, and in float for everything else
+    void nonMaxSuppressionV2(NDArray* boxes, NDArray* scales, int maxSize, double overlapThreshold, double scoreThreshold, double softNmsSigma, NDArray* output) {
+        if (boxes->dataType() == nd4j::DataType::DOUBLE)
+            nonMaxSuppressionV2_<double>(boxes, scales, maxSize, overlapThreshold, scoreThreshold, softNmsSigma, output);
+        else
+            nonMaxSuppressionV2_<float>(boxes, scales, maxSize, overlapThreshold, scoreThreshold, softNmsSigma, output);
     }
 
-    void nonMaxSuppressionV2(NDArray* boxes, NDArray* scales, int maxSize, double threshold, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(output->dataType(), nonMaxSuppressionV2_, (boxes, scales, maxSize, threshold, output), NUMERIC_TYPES);
+    void nonMaxSuppressionBatched(NDArray* boxes, NDArray* scores, int maxSize, double overlapThreshold, double scoreThreshold, double softNmsSigma, NDArray* indices, NDArray* selectedScores, NDArray* validCounts) {
+        if (boxes->dataType() == nd4j::DataType::DOUBLE)
+            nonMaxSuppressionBatched_<double>(boxes, scores, maxSize, overlapThreshold, scoreThreshold, softNmsSigma, indices, selectedScores, validCounts);
+        else
+            nonMaxSuppressionBatched_<float>(boxes, scores, maxSize, overlapThreshold, scoreThreshold, softNmsSigma, indices, selectedScores, validCounts);
     }
-    BUILD_SINGLE_TEMPLATE(template void nonMaxSuppressionV2_, (NDArray* boxes, NDArray* scales, int maxSize, double threshold, NDArray* output), NUMERIC_TYPES);
 
 }
 }
-}
\ No newline at end of file
+}
@@ -19,26 +19,52 @@
 //
 
 #include <ops/declarable/helpers/listdiff.h>
+#include <helpers/OpenAddressingTable.h>
 #include <vector>
 //#include <memory>
 
 namespace nd4j {
 namespace ops {
 namespace helpers {
+    //////////////////////////////////////////////////////////////////////////
+    // flags elements of values which are absent in keep. keep is hashed once, and values are probed in parallel
     template <typename T>
-    static Nd4jLong listDiffCount_(NDArray* values, NDArray* keep) {
-        Nd4jLong saved = 0L;
-        for (Nd4jLong e = 0; e < values->lengthOf(); e++) {
-            T v = values->e<T>(e);
-            T extras[] = {v, (T) 0.0f, (T) 10.0f};
-            NDArray idx = keep->indexReduceNumber(indexreduce::FirstIndex, extras);
-            Nd4jLong index = idx.e<Nd4jLong>(0);
-            if (index < 0)
-                saved++;
+    static Nd4jLong listDiffMask_(NDArray* values, NDArray* keep, std::vector<int8_t>& mask) {
+        NDArray* valuesCopy;
+        NDArray* keepCopy;
+        auto v = OpenAddressingTable<T>::linearBuffer(values, valuesCopy);
+        auto k = OpenAddressingTable<T>::linearBuffer(keep, keepCopy);
+
+        const Nd4jLong vLength = values->lengthOf();
+        const Nd4jLong kLength = keep->lengthOf();
+
+        OpenAddressingTable<T> table(kLength);
+        for (Nd4jLong e = 0; e < kLength; e++) {
+            bool inserted;
+            table.insert(k[e], e, inserted);
+        }
+
+        mask.resize(vLength);
+        Nd4jLong saved = 0;
+
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(OMP_IF(vLength > Environment::getInstance()->elementwiseThreshold()) reduction(+:saved))
+        for (Nd4jLong e = 0; e < vLength; e++) {
+            mask[e] = table.find(v[e]) < 0 ? 1 : 0;
+            saved += mask[e];
         }
+
+        delete valuesCopy;
+        delete keepCopy;
+
         return saved;
     }
 
+    template <typename T>
+    static Nd4jLong listDiffCount_(NDArray* values, NDArray* keep) {
+        std::vector<int8_t> mask;
+        return listDiffMask_<T>(values, keep, mask);
+    }
+
     Nd4jLong listDiffCount(NDArray* values, NDArray* keep) {
         auto xType = values->dataType();
 
@@ -50,21 +76,24 @@ namespace helpers {
     template <typename T>
     static int listDiffFunctor_(NDArray* values, NDArray* keep, NDArray* output1, NDArray* output2) {
 
+        std::vector<int8_t> mask;
+        listDiffMask_<T>(values, keep, mask);
+
+        NDArray* valuesCopy;
+        auto v = OpenAddressingTable<T>::linearBuffer(values, valuesCopy);
+
         std::vector<T> saved;
         std::vector<Nd4jLong> indices;
 
         for (Nd4jLong e = 0; e < values->lengthOf(); e++) {
-            T v = values->e<T>(e);
-            T extras[] = {v, (T) 0.0f, (T) 10.0f};
-            NDArray idxScalar = keep->indexReduceNumber(indexreduce::FirstIndex, extras);
-            Nd4jLong idx = idxScalar.e<Nd4jLong>(0);
-
-            if (idx < 0) {
-                saved.emplace_back(v);
+            if (mask[e]) {
+                saved.emplace_back(v[e]);
                 indices.emplace_back(e);
             }
         }
 
+        delete valuesCopy;
+
 
         if (saved.size() == 0) {
 //            if (nd4j::ops::conditionHelper(__FILE__, __LINE__, false, 0, "ListDiff: search returned no results") != 0)
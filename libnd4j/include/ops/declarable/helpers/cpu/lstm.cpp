@@ -294,6 +294,132 @@ void lstmBlockCell(const NDArray* xt, const NDArray* cLast, const NDArray* yLast
 
 
 
+//////////////////////////////////////////////////////////////////////////
+// single fused pass over gates of one time step: bias, peephole connections, activations and state update
+// xProj = xt*Wx and hProj = ht_1*Wh are [bS x 4*numUnits], gates are laid out as i, f, c, o
+template <typename T>
+static void lstmStep_(const T* xProj, const T* hProj, const T* bias, const T* Wc, const T* cPrev, T* ct, T* ht,
+                      const int bS, const int numUnits, const bool peephole, const double clippingCellValue, const double forgetBias) {
+
+    const T clip = static_cast<T>(clippingCellValue);
+    const T fBias = static_cast<T>(forgetBias);
+    const Nd4jLong gatesLen = 4 * numUnits;
+
+    PRAGMA_OMP_PARALLEL_FOR_IF(bS * gatesLen > Environment::getInstance()->elementwiseThreshold())
+    for (int e = 0; e < bS; ++e) {
+        auto zx = xProj + e * gatesLen;
+        auto zh = hProj + e * gatesLen;
+        auto cp = cPrev + e * numUnits;
+        auto c  = ct + e * numUnits;
+        auto h  = ht + e * numUnits;
+
+        PRAGMA_OMP_SIMD
+        for (int j = 0; j < numUnits; ++j) {
+            T zi = zx[j]              + zh[j]              + bias[j];
+            T zf = zx[numUnits + j]   + zh[numUnits + j]   + bias[numUnits + j];
+            T zc = zx[2*numUnits + j] + zh[2*numUnits + j] + bias[2*numUnits + j];
+            T zo = zx[3*numUnits + j] + zh[3*numUnits + j] + bias[3*numUnits + j];
+
+            if (peephole) {
+                zi += cp[j] * Wc[j];
+                zf += cp[j] * Wc[numUnits + j];
+            }
+
+            T cVal = nd4j::math::nd4j_sigmoid<T,T>(zf + fBias) * cp[j] + nd4j::math::nd4j_sigmoid<T,T>(zi) * nd4j::math::nd4j_tanh<T,T>(zc);
+
+            if (clippingCellValue > 0.0)
+                cVal = cVal > clip ? clip : (cVal < -clip ? -clip : cVal);
+
+            if (peephole)
+                zo += cVal * Wc[2*numUnits + j];
+
+            c[j] = cVal;
+            h[j] = nd4j::math::nd4j_sigmoid<T,T>(zo) * nd4j::math::nd4j_tanh<T,T>(cVal);
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void clipInplace_(T* buffer, const Nd4jLong length, const double clippingValue) {
+
+    const T clip = static_cast<T>(clippingValue);
+
+    PRAGMA_OMP_PARALLEL_FOR_SIMD_ARGS(if(length > Environment::getInstance()->elementwiseThreshold()))
+    for (Nd4jLong e = 0; e < length; ++e)
+        buffer[e] = buffer[e] > clip ? clip : (buffer[e] < -clip ? -clip : buffer[e]);
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void lstmTimeLoop_(const NDArray* x, const NDArray* h0, const NDArray* c0, const NDArray* Wx, const NDArray* Wh, const NDArray* Wc, const NDArray* Wp, const NDArray* b,
+                          NDArray* h, NDArray* c, const std::vector<double>& params) {
+
+    const bool peephole   = (bool)params[0];
+    const bool projection = (bool)params[1];
+    const double clippingCellValue = params[2];
+    const double clippingProjValue = params[3];
+    const double forgetBias        = params[4];
+
+    const int time     = x->sizeAt(0);
+    const int bS       = x->sizeAt(1);
+    const int inSize   = x->sizeAt(2);
+    const int numProj  = h0->sizeAt(1);
+    const int numUnits = c0->sizeAt(1);
+
+    auto workspace = x->getWorkspace();
+    const auto dtype = x->dataType();
+
+    // input projection doesn't depend on recurrence, so it's evaluated for all time steps with single gemm
+    NDArray xFlat('c', {time, bS, inSize}, dtype, workspace);
+    xFlat.assign(x);
+    xFlat.reshapei('c', {time * bS, inSize});
+    NDArray xProj('c', {time * bS, 4 * numUnits}, dtype, workspace);
+    MmulHelper::mmul(&xFlat, Wx, &xProj, 1.0, 0.0);
+
+    // buffers below are allocated once and reused by every time step
+    NDArray hProj('c', {bS, 4 * numUnits}, dtype, workspace);
+    NDArray hPrev('c', {bS, numProj}, dtype, workspace);
+    NDArray cPrev('c', {bS, numUnits}, dtype, workspace);
+    NDArray hCell('c', {bS, numUnits}, dtype, workspace);
+    NDArray bias('c', {4 * numUnits}, dtype, workspace);
+    NDArray peep('c', {3 * numUnits}, dtype, workspace);
+    NDArray hSeq('c', {time, bS, numProj}, dtype, workspace);
+    NDArray cSeq('c', {time, bS, numUnits}, dtype, workspace);
+
+    hPrev.assign(h0);
+    cPrev.assign(c0);
+    bias.assign(b);
+    if (peephole)
+        peep.assign(Wc);
+
+    const Nd4jLong hLen = bS * numProj;
+    const Nd4jLong cLen = bS * numUnits;
+
+    for (int t = 0; t < time; ++t) {
+        MmulHelper::mmul(&hPrev, Wh, &hProj, 1.0, 0.0);
+
+        auto ct = cSeq.bufferAsT<T>() + t * cLen;
+        auto ht = hSeq.bufferAsT<T>() + t * hLen;
+
+        lstmStep_<T>(xProj.bufferAsT<T>() + t * bS * 4 * numUnits, hProj.bufferAsT<T>(), bias.bufferAsT<T>(), peep.bufferAsT<T>(), cPrev.bufferAsT<T>(),
+                     ct, projection ? hCell.bufferAsT<T>() : hPrev.bufferAsT<T>(), bS, numUnits, peephole, clippingCellValue, forgetBias);
+
+        if (projection) {
+            MmulHelper::mmul(&hCell, Wp, &hPrev, 1.0, 0.0);
+            if (clippingProjValue != 0.)
+                clipInplace_<T>(hPrev.bufferAsT<T>(), hLen, clippingProjValue);
+        }
+
+        memcpy(ht, hPrev.bufferAsT<T>(), hLen * sizeof(T));
+        memcpy(cPrev.bufferAsT<T>(), ct, cLen * sizeof(T));
+    }
+
+    // h and c may be views, so results are copied with respect to their strides
+    h->assign(hSeq);
+    c->assign(cSeq);
+}
+
 //////////////////////////////////////////////////////////////////////////
 void lstmTimeLoop(const NDArray* x, const NDArray* h0, const NDArray* c0, const NDArray* Wx, const NDArray* Wh, const NDArray* Wc, const NDArray* Wp, const NDArray* b,
                   NDArray* h, NDArray* c, const std::vector<double>& params) {
@@ -311,21 +437,7 @@ void lstmTimeLoop(const NDArray* x, const NDArray* h0, const NDArray* c0, const
     // h cell outputs [time x bS x numProj], that is per each time step
     // c cell states  [time x bS x numUnits] that is per each time step
 
-    const int time  = x->sizeAt(0);
-
-    NDArray currentH(*h0);
-    NDArray currentC(*c0);
-
-    // loop through time steps
-    for (int t = 0; t < time; ++t) {
-        auto xt = (*x)({t,t+1, 0,0, 0,0});
-        auto ht = (*h)({t,t+1, 0,0, 0,0});
-        auto ct = (*c)({t,t+1, 0,0, 0,0});
-
-        helpers::lstmCell(&xt,&currentH,&currentC, Wx,Wh,Wc,Wp, b,   &ht, &ct,   params);
-        currentH.assign(ht);
-        currentC.assign(ct);
-    }
+    BUILD_SINGLE_SELECTOR(x->dataType(), lstmTimeLoop_, (x, h0, c0, Wx, Wh, Wc, Wp, b, h, c, params), FLOAT_TYPES);
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -22,6 +22,7 @@
 
 #include<ops/declarable/helpers/rnn.h>
 #include <helpers/BlasHelper.h>
+#include <MmulHelper.h>
 
 
 namespace nd4j    {
@@ -52,6 +53,85 @@ void rnnCell(const NDArray* xt, const NDArray* Wx, const NDArray* Wh, const NDAr
 }
 
 
+//////////////////////////////////////////////////////////////////////////
+// single fused pass of one time step: biases, activation and masking of samples which have already reached their max time step
+template <typename T>
+static void rnnStep_(const T* xProj, const T* hProj, const T* bias, const int* maxSteps, const int t, T* ht, T* hFinal, const int bS, const int numUnits) {
+
+    PRAGMA_OMP_PARALLEL_FOR_IF(bS * numUnits > Environment::getInstance()->elementwiseThreshold())
+    for (int e = 0; e < bS; ++e) {
+        auto h  = ht + e * numUnits;
+        auto hf = hFinal + e * numUnits;
+
+        // no calculations for time >= maxTimeStep, hFinal keeps output of last valid step
+        if (maxSteps != nullptr && t >= maxSteps[e]) {
+            PRAGMA_OMP_SIMD
+            for (int j = 0; j < numUnits; ++j)
+                h[j] = static_cast<T>(0.f);
+
+            continue;
+        }
+
+        auto zx = xProj + e * numUnits;
+        auto zh = hProj + e * numUnits;
+
+        PRAGMA_OMP_SIMD
+        for (int j = 0; j < numUnits; ++j) {
+            h[j] = nd4j::math::nd4j_tanh<T,T>(zx[j] + bias[j] + zh[j] + bias[numUnits + j]);
+            hf[j] = h[j];
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void rnnTimeLoop_(const NDArray* x, const NDArray* Wx, const NDArray* Wh, const NDArray* b, const NDArray* h0, const NDArray* maxTimeStep, NDArray* h, NDArray* hFinal) {
+
+    const int time     = x->sizeAt(0);
+    const int bS       = x->sizeAt(1);
+    const int inSize   = x->sizeAt(2);
+    const int numUnits = Wh->sizeAt(0);
+
+    auto workspace = x->getWorkspace();
+    const auto dtype = x->dataType();
+
+    // input projection doesn't depend on recurrence, so it's evaluated for all time steps with single gemm
+    NDArray xFlat('c', {time, bS, inSize}, dtype, workspace);
+    xFlat.assign(x);
+    xFlat.reshapei('c', {time * bS, inSize});
+    NDArray xProj('c', {time * bS, numUnits}, dtype, workspace);
+    MmulHelper::mmul(&xFlat, Wx, &xProj, 1.0, 0.0);
+
+    // buffers below are allocated once and reused by every time step
+    NDArray hProj('c', {bS, numUnits}, dtype, workspace);
+    NDArray hLast('c', {bS, numUnits}, dtype, workspace);
+    NDArray bias('c', {2 * numUnits}, dtype, workspace);
+    NDArray hSeq('c', {time, bS, numUnits}, dtype, workspace);
+
+    // at first time step
+    if(h0)
+        hLast.assign(h0);
+    else
+        hLast.nullify();
+
+    bias.assign(b);
+
+    std::vector<int> maxSteps;
+    if (maxTimeStep != nullptr)
+        maxSteps = const_cast<NDArray*>(maxTimeStep)->asVectorT<int>();
+
+    for (int t = 0; t < time; ++t) {
+        MmulHelper::mmul(&hLast, Wh, &hProj, 1.0, 0.0);
+
+        rnnStep_<T>(xProj.bufferAsT<T>() + t * bS * numUnits, hProj.bufferAsT<T>(), bias.bufferAsT<T>(), maxTimeStep != nullptr ? maxSteps.data() : nullptr, t,
+                    hSeq.bufferAsT<T>() + t * bS * numUnits, hLast.bufferAsT<T>(), bS, numUnits);
+    }
+
+    // h and hFinal may be views, so results are copied with respect to their strides
+    h->assign(hSeq);
+    hFinal->assign(hLast);
+}
+
 //////////////////////////////////////////////////////////////////////////
 void rnnTimeLoop(const NDArray* x, const NDArray* Wx, const NDArray* Wh, const NDArray* b, const NDArray* h0, const NDArray* maxTimeStep, NDArray* h, NDArray* hFinal) {
 
@@ -62,39 +142,8 @@ void rnnTimeLoop(const NDArray* x, const NDArray* Wx, const NDArray* Wh, const N
 
 	// h0          initial cell output (at time step = 0) [bS x numUnits]
 	// maxTimeStep vector [bS] containing integer values within [0,time), each element of this vector set max time step per each input in batch, this means there are no calculations for time >= maxTimeStep
-    
-    const int time     = x->sizeAt(0);
-    const int bS       = x->sizeAt(1);        
-    
-    // at first time step
-    if(h0)
-        hFinal->assign(h0);
-    else 
-        *hFinal = 0.;   
-
-    BlasHelper::getInstance();          // to avoid memory leak in pragma parallel loops
-    // loop through batch of inputs           
-    for (int e = 0; e < bS; ++e) {                  
-        // loop through time steps
-        for (int t = 0; t < time; ++t) {
-
-            int maxStep = maxTimeStep ? maxTimeStep->e<int>(e) : time;
-
-            auto xt   = (*x)({t,t+1, e,e+1, 0,0}, true);
-            auto ht   = (*h)({t,t+1, e,e+1, 0,0}, true);
-            auto ht_1 = (*hFinal)({e,e+1, 0,0}, true);                       // previous state
-            
-            if(t >= maxStep) {
-                ht = 0.;
-                if(maxStep != 0)                    
-                    ht_1.assign((*h)({maxStep-1,maxStep, e,e+1, 0,0}));
-            }
-            else {
-                helpers::rnnCell(&xt, Wx, Wh, b, &ht_1, &ht);
-                ht_1.assign(ht);
-            }
-        }
-    }    
+
+    BUILD_SINGLE_SELECTOR(x->dataType(), rnnTimeLoop_, (x, Wx, Wh, b, h0, maxTimeStep, h, hFinal), FLOAT_TYPES);
 }
 
 
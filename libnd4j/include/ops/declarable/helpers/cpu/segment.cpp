@@ -19,315 +19,288 @@
 //
 
 #include <ops/declarable/helpers/segment.h>
+#include <memory>
+#include <vector>
 
 namespace nd4j {
 namespace ops {
 namespace helpers {
 
-    // segment max
-    template <typename T>
-    static void segmentMaxFunctor_(NDArray* input, NDArray* indices, NDArray* output) {
-        //int numClasses = output->sizeAt(0);
-        // if input is a vector: (as if in doc sample)
-        Nd4jLong idx = indices->e<Nd4jLong>(0);
-        if (input->isVector()) {
-            T val = input->e<T>(0);
-
-            for (Nd4jLong e = 1; e < indices->lengthOf(); e++) {
-                if (idx == indices->e<Nd4jLong>(e)) {
-                   // max
-                   val = nd4j::math::nd4j_max<T>(val, input->t<T>(e));
-                }
-                else {
-                    idx = indices->e<Nd4jLong>(e);
-                    val = input->t<T>(e);
-                }
-                output->t<T>(idx) = val;
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            Nd4jLong loop_size = input->rankOf();
-            PRAGMA_OMP_PARALLEL_FOR
-            for (Nd4jLong e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            auto listOfTensors = input->allTensorsAlongDimension(restDims);
-            auto listOfOutTensors = output->allTensorsAlongDimension(restDims);
+    // reductions shared by sorted and unsorted segment ops
+    enum SegmentReduction {
+        SEGMENT_MAX = 0,
+        SEGMENT_MIN = 1,
+        SEGMENT_SUM = 2,
+        SEGMENT_PROD = 3,
+        SEGMENT_MEAN = 4,
+        SEGMENT_SQRTN = 5,
+    };
 
-            auto numOfClasses = output->sizeAt(0); // number of classes
-            std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-            auto maxT = listOfOutTensors->at(idx);
+    // output rows are processed in column blocks of this size, so wide rows are shared between threads even if there are few classes
+    #define SEGMENT_COLUMN_BLOCK 1024
 
-            //int pos = 0;
-            maxT->assign(listOfTensors->at(0));
+    // per-thread partial results are used only if each thread gets at least this number of input rows
+    #define SEGMENT_ROWS_PER_THREAD 256
 
-            for (Nd4jLong i = 1; i < indices->lengthOf(); i++) {
-                if (indices->e<int>(i) == idx) {
-
-                    for (Nd4jLong e = 0; e < maxT->lengthOf(); e++) {
-                       maxT->t<T>(e) = nd4j::math::nd4j_max(maxT->t<T>(e), listOfTensors->at(i)->t<T>(e));
-                    }
-                }
-                else {
-                    idx = indices->e<Nd4jLong>(i);
-                    maxT = listOfOutTensors->at(idx);
-                    maxT->assign(listOfTensors->at(i));
-                }
+    // returns array itself if it's dense c-ordered array of type T, or its converted copy otherwise
+    template <typename T>
+    static NDArray* denseArray(NDArray* array, std::unique_ptr<NDArray>& holder) {
+        if (array->ordering() == 'c' && array->ews() == 1 && array->dataType() == DataTypeUtils::fromT<T>())
+            return array;
 
-            }
-            delete listOfTensors;
-            delete listOfOutTensors;
-        }
+        holder.reset(new NDArray('c', array->getShapeAsVector(), DataTypeUtils::fromT<T>(), array->getWorkspace()));
+        holder->assign(array);
+        return holder.get();
     }
 
-    // segmen min 
     template <typename T>
-    static void segmentMinFunctor_(NDArray* input, NDArray* indices, NDArray* output) {
-        //int numClasses = output->sizeAt(0);
-        // if input is a vector: (as if in doc sample)
-        Nd4jLong idx = indices->e<Nd4jLong>(0);
-        if (input->isVector()) {
-            T val = input->e<T>(0);
-
-            for (int e = 1; e < indices->lengthOf(); e++) {
-                if (idx == indices->e<Nd4jLong>(e)) {
-                   // min 
-                   val = nd4j::math::nd4j_min<T>(val, input->t<T>(e));
+    static FORCEINLINE void accumulateRow(const int op, T* z, const T* x, const Nd4jLong length) {
+        switch (op) {
+            case SEGMENT_MAX: {
+                    PRAGMA_OMP_SIMD
+                    for (Nd4jLong e = 0; e < length; e++)
+                        z[e] = nd4j::math::nd4j_max<T>(z[e], x[e]);
                 }
-                else {
-                    idx = indices->e<int>(e);
-                    val = input->t<T>(e);
+                break;
+            case SEGMENT_MIN: {
+                    PRAGMA_OMP_SIMD
+                    for (Nd4jLong e = 0; e < length; e++)
+                        z[e] = nd4j::math::nd4j_min<T>(z[e], x[e]);
+                }
+                break;
+            case SEGMENT_PROD: {
+                    PRAGMA_OMP_SIMD
+                    for (Nd4jLong e = 0; e < length; e++)
+                        z[e] *= x[e];
+                }
+                break;
+            default: {
+                    PRAGMA_OMP_SIMD
+                    for (Nd4jLong e = 0; e < length; e++)
+                        z[e] += x[e];
                 }
-                output->t<T>(idx) = val;
-            }
         }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            auto loop_length = input->rankOf();
-            PRAGMA_OMP_PARALLEL_FOR
-            for (int e = 1; e < loop_length; e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfTensors( input->allTensorsAlongDimension(restDims) );
-            std::unique_ptr<ResultSet> listOfOutTensors( output->allTensorsAlongDimension(restDims) );
-
-            int numOfClasses = output->sizeAt(0); // number of classes
-            std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-            auto minT = listOfOutTensors->at(idx);
+    }
 
-            int pos = 0;
-            minT->assign(listOfTensors->at(0));
+    template <typename T>
+    static FORCEINLINE void finalizeRow(const int op, T* z, const Nd4jLong length, const Nd4jLong count) {
+        if (op != SEGMENT_MEAN && op != SEGMENT_SQRTN)
+            return;
 
-            for (Nd4jLong i = 1; i < indices->lengthOf(); i++) {
-                if (indices->e<T>(i) == idx) {
+        const double divisor = op == SEGMENT_MEAN ? static_cast<double>(count) : nd4j::math::nd4j_sqrt<Nd4jLong, double>(count);
 
-                    for (int e = 0; e < minT->lengthOf(); e++) {
-                       minT->p(e, nd4j::math::nd4j_min(minT->e<T>(e), listOfTensors->at(i)->e<T>(e)));
-                    }
-                }
-                else {
-                    idx = indices->e<T>(i);
-                    minT = listOfOutTensors->at(idx);
-                    minT->assign(listOfTensors->at(i));
-                }
-            }
-        }
+        PRAGMA_OMP_SIMD
+        for (Nd4jLong e = 0; e < length; e++)
+            z[e] = static_cast<T>(z[e] / divisor);
     }
 
-    // segmen mean
+    /**
+     * Reduces input rows (subarrays along dimension 0) into output rows: row i goes into output row classes[i].
+     * Computations are done in output type. Output rows of classes without input rows are left as is, so callers fill them in advance if needed
+     */
     template <typename T>
-    static void segmentMeanFunctor_(NDArray* input, NDArray* indices, NDArray* output) {
-        int numClasses = output->sizeAt(0);
-        // if input is a vector: (as if in doc sample)
-        int idx = indices->e<int>(0);
-        if (input->isVector()) {
-            T val = T(0.f);
-            int count = 0;
-
-            for (int e = 0; e < indices->lengthOf(); e++) {
-                if (idx == indices->e<int>(e)) {
-                   // mean 
-                   val += input->e<T>(e);
-                   count++;
-                }
-                else {
-                   output->p<T>(idx, val / count);
-                    idx = indices->e<int>(e);
-                    val = input->e<T>(e);
-                    count = 1;
-                }
-                output->p<T>(idx, val / count);
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            int loop_size = input->rankOf();
+    static void segmentReduce_(NDArray* input, const std::vector<Nd4jLong>& classes, const Nd4jLong numOfClasses, const int op, NDArray* output) {
+        if (input->lengthOf() == 0 || classes.empty())
+            return;
+
+        std::unique_ptr<NDArray> xHolder, zHolder;
+        auto x = denseArray<T>(input, xHolder)->template bufferAsT<T>();
+        auto zArray = denseArray<T>(output, zHolder);
+        auto z = zArray->template bufferAsT<T>();
+
+        const Nd4jLong numRows = input->sizeAt(0);
+        const Nd4jLong rowLength = input->lengthOf() / numRows;
+
+        // rows are grouped by class with stable counting sort: rows of class c are rows[starts[c]] ... rows[starts[c + 1] - 1]
+        std::vector<Nd4jLong> starts(numOfClasses + 1, 0);
+        for (auto c: classes)
+            starts[c + 1]++;
+
+        for (Nd4jLong c = 0; c < numOfClasses; c++)
+            starts[c + 1] += starts[c];
+
+        const int maxThreads = omp_get_max_threads();
+        const Nd4jLong blockSize = nd4j::math::nd4j_min<Nd4jLong>(rowLength, SEGMENT_COLUMN_BLOCK);
+        const Nd4jLong numBlocks = (rowLength + blockSize - 1) / blockSize;
+        const Nd4jLong numTasks = numOfClasses * numBlocks;
+        const bool parallel = input->lengthOf() > Environment::getInstance()->elementwiseThreshold();
+
+        if (parallel && numTasks < maxThreads && numRows >= (Nd4jLong) maxThreads * SEGMENT_ROWS_PER_THREAD) {
+            // few narrow classes: each thread reduces its own range of rows into private partial results, which are merged afterwards
+            const Nd4jLong span = (numRows + maxThreads - 1) / maxThreads;
+            std::unique_ptr<T[]> partials(new T[maxThreads * numOfClasses * rowLength]);
+            std::vector<int8_t> seen(maxThreads * numOfClasses, 0);
+
             PRAGMA_OMP_PARALLEL_FOR
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            auto listOfTensors = input->allTensorsAlongDimension(restDims);
-            auto listOfOutTensors = output->allTensorsAlongDimension(restDims);
-
-            int numOfClasses = output->sizeAt(0); // number of classes
-            std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-            auto meanT = listOfOutTensors->at(idx);
-            int count = 1;
-            auto meanV = meanT->dup();
-            meanV->assign(listOfTensors->at(0));
-
-            for (int i = 1; i < indices->lengthOf(); i++) {
-                if (indices->e<int>(i) == idx) {
-                    PRAGMA_OMP_PARALLEL_FOR
-                    for (int e = 0; e < meanT->lengthOf(); e++) {
-                       meanV->p<T>(e, meanV->e<T>(e) + listOfTensors->at(i)->e<T>(e));
+            for (int t = 0; t < maxThreads; t++) {
+                const Nd4jLong end = nd4j::math::nd4j_min<Nd4jLong>(t * span + span, numRows);
+                for (Nd4jLong r = t * span; r < end; r++) {
+                    const Nd4jLong p = t * numOfClasses + classes[r];
+                    auto partial = partials.get() + p * rowLength;
+
+                    if (seen[p]) {
+                        accumulateRow<T>(op, partial, x + r * rowLength, rowLength);
+                    } else {
+                        memcpy(partial, x + r * rowLength, rowLength * sizeof(T));
+                        seen[p] = 1;
                     }
-                    count++;
                 }
-                else {
-                    //meanT->assign(meanV);
-                    meanV->applyScalar(scalar::Divide, count, meanT, nullptr);
-                    idx = indices->e<int>(i);
-                    meanT = listOfOutTensors->at(idx);
-                    meanV->assign(listOfTensors->at(i));
-                    count = 1;
-                }
-                meanV->applyScalar(scalar::Divide, count, meanT, nullptr);
             }
-            delete meanV;
-            delete listOfTensors;
-            delete listOfOutTensors;
-        }
-    }
 
-    template <typename T>
-    static void segmentSumFunctor_(NDArray* input, NDArray* indices, NDArray* output) {
-        int numClasses = output->sizeAt(0);
-        // if input is a vector: (as if in doc sample)
-        int idx = indices->e<int>(0);
-        if (input->isVector()) {
-            T val = T(0.f);
-            int count = 0;
-            for (int e = 0; e < indices->lengthOf(); e++) {
-                if (idx == indices->e<int>(e)) {
-                   // sum 
-                   val += input->t<T>(e);
-                }
-                else {
-                    idx = indices->e<int>(e);
-                    val = input->t<T>(e);
+            PRAGMA_OMP_PARALLEL_FOR_IF(numOfClasses > 1)
+            for (Nd4jLong c = 0; c < numOfClasses; c++) {
+                auto zRow = z + c * rowLength;
+                bool first = true;
+                for (int t = 0; t < maxThreads; t++) {
+                    const Nd4jLong p = t * numOfClasses + c;
+                    if (!seen[p])
+                        continue;
+
+                    if (first) {
+                        memcpy(zRow, partials.get() + p * rowLength, rowLength * sizeof(T));
+                        first = false;
+                    } else {
+                        accumulateRow<T>(op, zRow, partials.get() + p * rowLength, rowLength);
+                    }
                 }
-                output->p(idx, val);
+
+                if (!first)
+                    finalizeRow<T>(op, zRow, rowLength, starts[c + 1] - starts[c]);
             }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-	    int loop_size = input->rankOf();
-            PRAGMA_OMP_PARALLEL_FOR
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
+        } else {
+            // each (class, column block) pair is owned by single thread, so no synchronization is needed.
+            // for sorted segments rows of each class are just a contiguous range
+            std::vector<Nd4jLong> rows(numRows);
+            std::vector<Nd4jLong> positions(starts.begin(), starts.end() - 1);
+            for (Nd4jLong r = 0; r < numRows; r++)
+                rows[positions[classes[r]]++] = r;
 
-            auto listOfTensors = input->allTensorsAlongDimension(restDims);
-            auto listOfOutTensors = output->allTensorsAlongDimension(restDims);
+            PRAGMA_OMP_PARALLEL_FOR_IF(parallel && numTasks > 1)
+            for (Nd4jLong task = 0; task < numTasks; task++) {
+                const Nd4jLong c = task / numBlocks;
+                if (starts[c] == starts[c + 1])
+                    continue;
 
-            int numOfClasses = output->sizeAt(0); // number of classes
-            std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-            auto sumT = listOfOutTensors->at(idx);
+                const Nd4jLong from = (task % numBlocks) * blockSize;
+                const Nd4jLong length = nd4j::math::nd4j_min<Nd4jLong>(blockSize, rowLength - from);
+                auto zRow = z + c * rowLength + from;
 
-            for (int i = 0; i < indices->lengthOf(); i++) {
-                if (indices->e<int>(i) == idx) {
-                    PRAGMA_OMP_PARALLEL_FOR
-                    for (int e = 0; e < sumT->lengthOf(); e++) {
-                       sumT->p(e, sumT->e<T>(e) + listOfTensors->at(i)->e<T>(e));
-                    }
-                }
-                else {
-                    idx = indices->e<int>(i);
-                    sumT = listOfOutTensors->at(idx);
-                    sumT->assign(listOfTensors->at(i));
-                }
+                memcpy(zRow, x + rows[starts[c]] * rowLength + from, length * sizeof(T));
+                for (Nd4jLong k = starts[c] + 1; k < starts[c + 1]; k++)
+                    accumulateRow<T>(op, zRow, x + rows[k] * rowLength + from, length);
+
+                finalizeRow<T>(op, zRow, length, starts[c + 1] - starts[c]);
             }
-            delete listOfTensors;
-            delete listOfOutTensors;
         }
+
+        if (zHolder != nullptr)
+            output->assign(zHolder.get());
     }
 
     template <typename T>
-    static void segmentProdFunctor_(NDArray* input, NDArray* indices, NDArray* output) {
-        //int numClasses = output->sizeAt(0);
-        // if input is a vector: (as if in doc sample)
-        int idx = indices->e<int>(0);
-        output->assign(1.f);
-        if (input->isVector()) {
-            T val = input->e<T>(0);
-            int count = 0;
-
-            for (int e = 1; e < indices->lengthOf(); e++) {
-                if (idx == indices->e<int>(e)) {
-                   // sum 
-                   val *= input->e<T>(e);
-                }
-                else {
-                    idx = indices->e<int>(e);
-                    val = input->e<T>(e);
-                }
-                output->p(idx, val);
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            int loop_size = input->rankOf();
-            PRAGMA_OMP_SIMD
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            auto listOfTensors = input->allTensorsAlongDimension(restDims);
-            auto listOfOutTensors = output->allTensorsAlongDimension(restDims);
-
-            int numOfClasses = output->sizeAt(0); // number of classes
-            auto sumT = listOfOutTensors->at(idx);
-            sumT->assign(listOfTensors->at(0));
-            for (int i = 1; i < indices->lengthOf(); i++) {
-                if (indices->e<int>(i)  == idx) {
-                    PRAGMA_OMP_PARALLEL_FOR
-                    for (int e = 0; e < sumT->lengthOf(); e++) {
-                       sumT->p(e, sumT->e<T>(e) * listOfTensors->at(i)->e<T>(e));
+    static void segmentReduce_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, int op, NDArray* output) {
+        segmentReduce_<T>(input, indices->asVectorT<Nd4jLong>(), numOfClasses, op, output);
+    }
+
+    /**
+     * Gradients of segment reductions. Each input row depends only on its own class, so rows are processed independently
+     */
+    template <typename T>
+    static int segmentReduceBP_(NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, int op, NDArray* output) {
+        auto classes = indices->asVectorT<Nd4jLong>();
+        if (input->lengthOf() == 0 || classes.empty())
+            return ND4J_STATUS_OK;
+
+        std::unique_ptr<NDArray> xHolder, gHolder, zHolder;
+        auto xArray = denseArray<T>(input, xHolder);
+        auto x = xArray->template bufferAsT<T>();
+        auto g = denseArray<T>(gradOut, gHolder)->template bufferAsT<T>();
+        auto zArray = denseArray<T>(output, zHolder);
+        auto z = zArray->template bufferAsT<T>();
+
+        // max, min and prod gradients need forward results
+        std::unique_ptr<NDArray> forward;
+        T* f = nullptr;
+        if (op == SEGMENT_MAX || op == SEGMENT_MIN || op == SEGMENT_PROD) {
+            forward.reset(new NDArray('c', gradOut->getShapeAsVector(), DataTypeUtils::fromT<T>(), gradOut->getWorkspace()));
+            segmentReduce_<T>(xArray, classes, numOfClasses, op, forward.get());
+            f = forward->bufferAsT<T>();
+        }
+
+        std::vector<Nd4jLong> counts(numOfClasses, 0);
+        for (auto c: classes)
+            counts[c]++;
+
+        const Nd4jLong numRows = input->sizeAt(0);
+        const Nd4jLong rowLength = input->lengthOf() / numRows;
+
+        PRAGMA_OMP_PARALLEL_FOR_IF(input->lengthOf() > Environment::getInstance()->elementwiseThreshold())
+        for (Nd4jLong r = 0; r < numRows; r++) {
+            const Nd4jLong c = classes[r];
+            auto xRow = x + r * rowLength;
+            auto zRow = z + r * rowLength;
+            auto gRow = g + c * rowLength;
+
+            switch (op) {
+                case SEGMENT_MAX:
+                case SEGMENT_MIN: {
+                        // gradient goes to every element equal to the selected one
+                        auto fRow = f + c * rowLength;
+                        PRAGMA_OMP_SIMD
+                        for (Nd4jLong e = 0; e < rowLength; e++)
+                            zRow[e] = xRow[e] == fRow[e] ? gRow[e] : static_cast<T>(0);
+                    }
+                    break;
+                case SEGMENT_PROD: {
+                        auto fRow = f + c * rowLength;
+                        PRAGMA_OMP_SIMD
+                        for (Nd4jLong e = 0; e < rowLength; e++)
+                            zRow[e] = fRow[e] * gRow[e] / xRow[e];
+                    }
+                    break;
+                case SEGMENT_MEAN:
+                case SEGMENT_SQRTN: {
+                        const double divisor = op == SEGMENT_MEAN ? static_cast<double>(counts[c]) : nd4j::math::nd4j_sqrt<Nd4jLong, double>(counts[c]);
+                        PRAGMA_OMP_SIMD
+                        for (Nd4jLong e = 0; e < rowLength; e++)
+                            zRow[e] = static_cast<T>(gRow[e] / divisor);
+                    }
+                    break;
+                default: {
+                        memcpy(zRow, gRow, rowLength * sizeof(T));
                     }
-                }
-                else {
-                    idx = indices->e<int>(i);
-                    sumT = listOfOutTensors->at(idx);
-                    sumT->assign(listOfTensors->at(i));
-                }
             }
-            delete listOfTensors;
-            delete listOfOutTensors;
         }
+
+        if (zHolder != nullptr)
+            output->assign(zHolder.get());
+
+        return ND4J_STATUS_OK;
     }
 
-//    template <typename T>
-//    static bool segmentIndicesValidate_(NDArray* indices, NDArray& aexpected, NDArray& anOutput) {
-//      }
+    // -------------------------------------------------------------------------------------------------------------- //
+    // Sorted segment ops
+    // -------------------------------------------------------------------------------------------------------------- //
 
     void segmentMaxFunctor(NDArray* input, NDArray* indices, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(input->dataType(), segmentMaxFunctor_, (input, indices, output), LIBND4J_TYPES);
+        BUILD_SINGLE_SELECTOR(output->dataType(), segmentReduce_, (input, indices, output->sizeAt(0), SEGMENT_MAX, output), LIBND4J_TYPES);
     }
 
     void segmentMinFunctor(NDArray* input, NDArray* indices, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(input->dataType(), segmentMinFunctor_, (input, indices, output), LIBND4J_TYPES);
+        BUILD_SINGLE_SELECTOR(output->dataType(), segmentReduce_, (input, indices, output->sizeAt(0), SEGMENT_MIN, output), LIBND4J_TYPES);
     }
 
     void segmentMeanFunctor(NDArray* input, NDArray* indices, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(input->dataType(), segmentMeanFunctor_, (input, indices, output), LIBND4J_TYPES);
+        BUILD_SINGLE_SELECTOR(output->dataType(), segmentReduce_, (input, indices, output->sizeAt(0), SEGMENT_MEAN, output), LIBND4J_TYPES);
     }
 
     void segmentSumFunctor(NDArray* input, NDArray* indices, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(input->dataType(), segmentSumFunctor_, (input, indices, output), LIBND4J_TYPES);
+        BUILD_SINGLE_SELECTOR(output->dataType(), segmentReduce_, (input, indices, output->sizeAt(0), SEGMENT_SUM, output), LIBND4J_TYPES);
     }
 
     void segmentProdFunctor(NDArray* input, NDArray* indices, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(input->dataType(), segmentProdFunctor_, (input, indices, output), LIBND4J_TYPES);
+        output->assign(1.f);
+        BUILD_SINGLE_SELECTOR(output->dataType(), segmentReduce_, (input, indices, output->sizeAt(0), SEGMENT_PROD, output), LIBND4J_TYPES);
     }
 
     bool segmentIndicesValidate(NDArray* indices, NDArray& expected, NDArray& output) {
@@ -342,12 +315,8 @@ namespace helpers {
         return true;
     }
 
-    //BUILD_SINGLE_TEMPLATE(template bool segmentIndicesValidate_, (NDArray*, NDArray&, NDArray&), LIBND4J_TYPES);
-    BUILD_SINGLE_TEMPLATE(template void segmentProdFunctor_, (NDArray* input, NDArray* indices, NDArray* output), LIBND4J_TYPES);
-    BUILD_SINGLE_TEMPLATE(template void segmentSumFunctor_, (NDArray* input, NDArray* indices, NDArray* output), LIBND4J_TYPES);
-    BUILD_SINGLE_TEMPLATE(template void segmentMeanFunctor_, (NDArray* input, NDArray* indices, NDArray* output), LIBND4J_TYPES);
-    BUILD_SINGLE_TEMPLATE(template void segmentMinFunctor_, (NDArray* input, NDArray* indices, NDArray* output), LIBND4J_TYPES);
-    BUILD_SINGLE_TEMPLATE(template void segmentMaxFunctor_, (NDArray* input, NDArray* indices, NDArray* output), LIBND4J_TYPES);
+    BUILD_SINGLE_TEMPLATE(template void segmentReduce_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, int op, NDArray* output), LIBND4J_TYPES);
+
     // -------------------------------------------------------------------------------------------------------------- //
     // Unsorted segment ops
     // -------------------------------------------------------------------------------------------------------------- //
@@ -364,764 +333,104 @@ namespace helpers {
         return true;
     }
 
+
     template <typename T>
     static void unsortedSegmentMaxFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
+        T maxVal = DataTypeUtils::max<T>();
+        output->assign(-maxVal);
 
-        // if input is a vector: (as if in doc sample)
-        //int idx = static_cast<int>((*indices)(0.));
-        std::map<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-            idxs[indices->e<Nd4jLong>(e)].push_back(e);
-
-        //std::sort(idxs.begin(), idxs.end());
-
-        if (input->isVector()) { // 1D case
-            T maxVal = DataTypeUtils::max<T>();
-            output->assign(-maxVal);
-
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                T val = input->e<T>(fi->second.at(0));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    val = nd4j::math::nd4j_max(val, input->e<T>(fi->second.at(idx)));
-                }
-                output->p(fi->first, val);
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            Nd4jLong idx = idxs[0][0];
-            int loop_size = input->rankOf();
-            PRAGMA_OMP_SIMD
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            T maxVal = DataTypeUtils::max<T>();
-            output->assign(-maxVal);
-
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors->at(fi->first);
-                outputT->assign(listOfTensors->at(fi->second.at(0)));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    auto maxT = listOfTensors->at(fi->second.at(idx));
-                    for (Nd4jLong e = 0; e < outputT->lengthOf(); ++e) {
-                        T val = nd4j::math::nd4j_max(maxT->e<T>(e), outputT->e<T>(e));
-
-                        outputT->p(e, val);
-                    }
-                }
-                //outputT->assign(maxT);
-            }
-        }
-    }
-    void unsortedSegmentMaxFunctor(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(input->dataType(), unsortedSegmentMaxFunctor_, (input, indices, numOfClasses, output), NUMERIC_TYPES);
+        segmentReduce_<T>(input, indices, numOfClasses, SEGMENT_MAX, output);
     }
-    BUILD_SINGLE_TEMPLATE(template void unsortedSegmentMaxFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
 
     template <typename T>
     static void unsortedSegmentMinFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        // if input is a vector: (as if in doc sample)
-        //int idx = static_cast<int>((*indices)(0.));
-        std::map<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
-
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-            idxs[indices->e<Nd4jLong>(e)].push_back(e);
-
-        //std::sort(idxs.begin(), idxs.end());
-
-        if (input->isVector()) { // 1D case
-            T maxVal = DataTypeUtils::max<T>();
-            output->assign(maxVal);
-
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                T val = input->t<T>(fi->second.at(0));
+        T maxVal = DataTypeUtils::max<T>();
+        output->assign(maxVal);
 
-                for (size_t idx = 1; idx < fi->second.size(); ++idx) {
-                    val = nd4j::math::nd4j_min(val, input->t<T>(fi->second.at(idx)));
-                }
-                output->t<T>(fi->first) = val;
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            Nd4jLong idx = idxs[0][0];
-            for (int e = 1; e < input->rankOf(); e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            T maxVal = DataTypeUtils::max<T>();
-            output->assign(maxVal);
-
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors->at(fi->first);
-                outputT->assign(listOfTensors->at(fi->second.at(0)));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    auto minT = listOfTensors->at(fi->second.at(idx));
-
-                    for (Nd4jLong e = 0; e < outputT->lengthOf(); ++e) {
-                        outputT->t<T>(e) = nd4j::math::nd4j_min(minT->t<T>(e), outputT->t<T>(e));
-                    }
-                }
-                //outputT->assign(maxT);
-            }
-        }
+        segmentReduce_<T>(input, indices, numOfClasses, SEGMENT_MIN, output);
+    }
 
+    void unsortedSegmentMaxFunctor(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
+        BUILD_SINGLE_SELECTOR(output->dataType(), unsortedSegmentMaxFunctor_, (input, indices, numOfClasses, output), NUMERIC_TYPES);
     }
+
     void unsortedSegmentMinFunctor(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(input->dataType(), unsortedSegmentMinFunctor_, (input, indices, numOfClasses, output),
-                              NUMERIC_TYPES);
+        BUILD_SINGLE_SELECTOR(output->dataType(), unsortedSegmentMinFunctor_, (input, indices, numOfClasses, output), NUMERIC_TYPES);
     }
 
-    BUILD_SINGLE_TEMPLATE(template void unsortedSegmentMinFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
-
     void unsortedSegmentMeanFunctor(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        std::map<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-            idxs[indices->e<Nd4jLong>(e)].push_back(e);
-
-        //std::sort(idxs.begin(), idxs.end());
-
-        if (input->isVector()) { // 1D case
-
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                double sumValue = input->e<double>(fi->second.at(0));
-                int loop_size = fi->second.size();
-                PRAGMA_OMP_PARALLEL_FOR_SIMD_REDUCTION(+:sumValue)
-                for (size_t idx = 1; idx < loop_size; ++idx) {
-                    sumValue += input->e<double>(fi->second.at(idx));
-                }
-
-                output->p(fi->first, sumValue / fi->second.size());
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            Nd4jLong loop_size= input->rankOf();
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors->at(fi->first);
-                outputT->assign(listOfTensors->at(fi->second.at(0)));
-                loop_size = fi->second.size();
-                PRAGMA_OMP_PARALLEL_FOR
-                for (Nd4jLong idx = 1; idx < loop_size; ++idx) {
-                    auto current = listOfTensors->at(fi->second.at(idx));
-                    *outputT += *current;
-                }
-                (*outputT) /= double(fi->second.size());
-            }
-        }
+        output->nullify();
+        BUILD_SINGLE_SELECTOR(output->dataType(), segmentReduce_, (input, indices, numOfClasses, SEGMENT_MEAN, output), LIBND4J_TYPES);
     }
 
     void unsortedSegmentSumFunctor(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        std::map<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-            idxs[indices->e<Nd4jLong>(e)].push_back(e);
-
-        if (input->isVector()) { // 1D case
-
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                double sumValue = input->e<double>(fi->second.at(0));
-                Nd4jLong loop_size = fi->second.size();
-                PRAGMA_OMP_PARALLEL_FOR_REDUCTION(+:sumValue)
-                for (Nd4jLong idx = 1; idx < loop_size; ++idx) {
-                    sumValue += input->e<double>(fi->second.at(idx));
-                }
-                output->p(fi->first, sumValue);
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            int loop_size = input->rankOf();
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors->at(fi->first);
-                outputT->assign(listOfTensors->at(fi->second.at(0)));
-                Nd4jLong loop_size = fi->second.size();
-                PRAGMA_OMP_PARALLEL_FOR
-                for (Nd4jLong idx = 1; idx < loop_size; ++idx) {
-                    auto current = listOfTensors->at(fi->second.at(idx));
-                    *(outputT) += *current;
-                }
-                //outputT->assign(maxT);
-            }
-        }
-    }
-
-    template <typename T>
-    void unsortedSegmentProdFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        std::map<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-            idxs[indices->e<Nd4jLong>(e)].push_back(e);
-
-        //std::sort(idxs.begin(), idxs.end());
-
-        output->assign(1.f);
-
-        if (input->isVector()) { // 1D case
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                T prodValue = input->e<T>(fi->second.at(0));
-                for (size_t idx = 1; idx < fi->second.size(); ++idx) {
-                    prodValue *= input->e<T>(fi->second.at(idx));
-                }
-                output->p(fi->first, prodValue);
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            Nd4jLong loop_size = input->rankOf();
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors->at(fi->first);
-                outputT->assign(listOfTensors->at(fi->second.at(0)));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    auto current = listOfTensors->at(fi->second.at(idx));
-
-                    *outputT *= *current;
-                }
-            }
-        }
+        output->nullify();
+        BUILD_SINGLE_SELECTOR(output->dataType(), segmentReduce_, (input, indices, numOfClasses, SEGMENT_SUM, output), LIBND4J_TYPES);
     }
 
     void unsortedSegmentProdFunctor(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(input->dataType(), unsortedSegmentProdFunctor_, (input, indices, numOfClasses, output), NUMERIC_TYPES);
+        output->assign(1.f);
+        BUILD_SINGLE_SELECTOR(output->dataType(), segmentReduce_, (input, indices, numOfClasses, SEGMENT_PROD, output), LIBND4J_TYPES);
     }
-    BUILD_SINGLE_TEMPLATE(template void unsortedSegmentProdFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
 
     void unsortedSegmentSqrtNFunctor(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        std::map<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-            idxs[indices->e<Nd4jLong>(e)].push_back(e);
-
-        //std::sort(idxs.begin(), idxs.end());
-
-        if (input->isVector()) { // 1D case
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                double sumValue = input->e<double>(fi->second.at(0));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    sumValue += input->e<double>(fi->second.at(idx));
-                }
-                output->p(fi->first, sumValue / nd4j::math::nd4j_sqrt<Nd4jLong, double>(fi->second.size()));
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-
-            int loop_size =  input->rankOf();
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors->at(fi->first);
-                outputT->assign(listOfTensors->at(fi->second.at(0)));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    auto current = listOfTensors->at(fi->second.at(idx));
-                    *outputT += *current;
-                }
-                //outputT->assign(maxT);
-                (*outputT) /= nd4j::math::nd4j_sqrt<size_t, double>(fi->second.size());
-            }
-        }
+        output->nullify();
+        BUILD_SINGLE_SELECTOR(output->dataType(), segmentReduce_, (input, indices, numOfClasses, SEGMENT_SQRTN, output), LIBND4J_TYPES);
     }
 
+    BUILD_SINGLE_TEMPLATE(template void unsortedSegmentMaxFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
+    BUILD_SINGLE_TEMPLATE(template void unsortedSegmentMinFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
+
     // -------------------------------------------------------------------------------------------------------------- //
     // Backpropagate ops helpers
     // -------------------------------------------------------------------------------------------------------------- //
-    // Sorted backpropagate ops
-    //
-
-    // segment max
-    template <typename T>
-    int segmentMaxFunctorBP_(NDArray* input, NDArray* indices, NDArray* gradOut, NDArray* output) {
-        //int numOfClasses = gradOut->sizeAt(0);
-        // if input is a vector: (as if in doc sample)
-        auto tempRes = gradOut->dup();
-        segmentMaxFunctor_<T>(input, indices, tempRes);
-        if (input->isVector()) {
-            Nd4jLong loop_size = input->lengthOf();
-            PRAGMA_OMP_PARALLEL_FOR
-            for (Nd4jLong e = 0; e < loop_size; ++e) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(e);
-                if (nd4j::math::nd4j_abs(tempRes->e<T>(classNum) -input->e<T>(e) <= T(1.e-6)))
-                    output->p(e, gradOut->e<T>(classNum));
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            Nd4jLong loop_size = input->rankOf();
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfBPTensors(tempRes->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfGradOuts(gradOut->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            //int numOfClasses = tempRes->sizeAt(0); // number of classes
-            //std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-
-            int pos = 0;
-
-            PRAGMA_OMP_PARALLEL_FOR
-            for (Nd4jLong i = 0; i < indices->lengthOf(); i++) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(i);
-                NDArray* current = listOfTensors->at(i);
-                NDArray* currentOut = listOfOutTensors->at(i);
-                NDArray* currentGradOut = listOfGradOuts->at(classNum);
-
-                for (Nd4jLong e = 0; e < current->lengthOf(); e++) {
-                    if (nd4j::math::nd4j_abs(listOfBPTensors->at(classNum)->e<T>(e) - current->e<T>(e)) <= T(1.e-6))
-                        currentOut->p(e, currentGradOut->e<T>(e));
-                }
-            }
-        }
-        delete tempRes;
-        return ND4J_STATUS_OK;
-    }
 
     int segmentMaxFunctorBP(NDArray* input, NDArray* indices, NDArray* gradOut, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(output->dataType(), return segmentMaxFunctorBP_, (input, indices, gradOut, output), NUMERIC_TYPES);
+        BUILD_SINGLE_SELECTOR(output->dataType(), return segmentReduceBP_, (input, indices, gradOut, gradOut->sizeAt(0), SEGMENT_MAX, output), NUMERIC_TYPES);
     }
-    BUILD_SINGLE_TEMPLATE(template int segmentMaxFunctorBP_, (NDArray* input, NDArray* indices, NDArray* gradOut, NDArray* output), NUMERIC_TYPES);
 
-    // segmen min
     int segmentMinFunctorBP(NDArray* input, NDArray* indices, NDArray* gradOut, NDArray* output) {
-        std::unique_ptr<NDArray> tempRes(gradOut->dup());
-        segmentMinFunctor(input, indices, tempRes.get());
-        if (input->isVector()) {
-            PRAGMA_OMP_PARALLEL_FOR
-            for (Nd4jLong e = 0; e < input->lengthOf(); ++e) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(e);
-                if (nd4j::math::nd4j_abs(tempRes->e<double>(classNum) - input->e<double>(e)) < 1.e-5)
-                    output->p(e, gradOut->e<double>(classNum));
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            Nd4jLong loop_size = input->rankOf();
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfBPTensors(tempRes->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfGradOuts(gradOut->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            //int numOfClasses = tempRes->sizeAt(0); // number of classes
-            //std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-            output->assign(0.);
-            int pos = 0;
-
-            PRAGMA_OMP_PARALLEL_FOR
-            for (int i = 0; i < indices->lengthOf(); i++) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(i);
-                NDArray* current = listOfTensors->at(i);
-                NDArray* currentOut = listOfOutTensors->at(i);
-                NDArray* currentGradOut = listOfGradOuts->at(classNum);
-                for (int e = 0; e < current->lengthOf(); e++) {
-                    if (nd4j::math::nd4j_abs(listOfBPTensors->at(classNum)->e<double>(e) - current->e<double>(e)) < 1.e-5)
-                        currentOut->p(e, currentGradOut->e<double>(e));
-                }
-            }
-        }
-        return ND4J_STATUS_OK;
+        BUILD_SINGLE_SELECTOR(output->dataType(), return segmentReduceBP_, (input, indices, gradOut, gradOut->sizeAt(0), SEGMENT_MIN, output), NUMERIC_TYPES);
     }
 
-    // segmen mean
     int segmentMeanFunctorBP(NDArray* input, NDArray* indices, NDArray* gradOut, NDArray* output) {
-        int numClasses = output->sizeAt(0);
-        std::map<Nd4jLong, Nd4jLong> classCount;//(numClasses);
-
-        for (Nd4jLong count = 0; count < numClasses; ++count) {
-            classCount[count] = 0;
-        }
-
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e) {
-            classCount[indices->e<Nd4jLong>(e)] ++;
-        }
-
-        // if input is a vector: (as if in doc sample)
-        if (input->isVector()) {
-            for (Nd4jLong e = 0; e < indices->lengthOf(); ++e) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(e);
-                output->p(e, gradOut->e<double>(classNum) / classCount[classNum]);
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            Nd4jLong loop_size = input->rankOf();
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfGradOuts(gradOut->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            //int numOfClasses = tempRes->sizeAt(0); // number of classes
-            //std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-
-            int pos = 0;
-            PRAGMA_OMP_PARALLEL_FOR
-            for (int i = 0; i < indices->lengthOf(); i++) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(i);
-                NDArray* current = listOfTensors->at(i);
-                NDArray* currentOut = listOfOutTensors->at(i);
-                NDArray* currentGradOut = listOfGradOuts->at(classNum);
-
-                for (int e = 0; e < current->lengthOf(); e++) {
-                    currentOut->p(e, currentGradOut->e<double>(e) / classCount[classNum]);
-                }
-            }
-        }
-        return ND4J_STATUS_OK;
+        BUILD_SINGLE_SELECTOR(output->dataType(), return segmentReduceBP_, (input, indices, gradOut, gradOut->sizeAt(0), SEGMENT_MEAN, output), NUMERIC_TYPES);
     }
 
     int segmentSumFunctorBP(NDArray* input, NDArray* indices, NDArray* gradOut, NDArray* output) {
-//        int numClasses = output->sizeAt(0);
-        // if input is a vector: (as if in doc sample)
-        Nd4jLong idx = indices->e<Nd4jLong>(0);
-        if (input->isVector()) {
-            for (Nd4jLong e = 0; e < indices->lengthOf(); ++e) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(e);
-                output->p(e, gradOut->e<double>(classNum));
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            int loop_size = input->rankOf();
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfGradOuts(gradOut->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            PRAGMA_OMP_PARALLEL_FOR
-            for (int i = 0; i < indices->lengthOf(); i++) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(i);
-                NDArray* current = listOfTensors->at(i);
-                NDArray* currentOut = listOfOutTensors->at(i);
-                NDArray* currentGradOut = listOfGradOuts->at(classNum);
-                currentOut->assign(currentGradOut);
-            }
-        }
-        return ND4J_STATUS_OK;
+        BUILD_SINGLE_SELECTOR(output->dataType(), return segmentReduceBP_, (input, indices, gradOut, gradOut->sizeAt(0), SEGMENT_SUM, output), NUMERIC_TYPES);
     }
 
     int segmentProdFunctorBP(NDArray* input, NDArray* indices, NDArray* gradOut, NDArray* output) {
-        auto tempRes = gradOut->dup();
-        segmentProdFunctor(input, indices, tempRes);
-        if (input->isVector()) {
-            for (Nd4jLong e = 0; e < indices->lengthOf(); ++e) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(e);
-                output->p(e, gradOut->e<double>(classNum) * tempRes->e<double>(classNum)/ input->e<double>(e));
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            int loop_size = input->rankOf();
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfBPTensors(tempRes->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfGradOuts(gradOut->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            //int numOfClasses = tempRes->sizeAt(0); // number of classes
-            //std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-
-            PRAGMA_OMP_PARALLEL_FOR
-            for (int i = 0; i < indices->lengthOf(); i++) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(i);
-                NDArray* current = listOfTensors->at(i);
-                NDArray* currentOut = listOfOutTensors->at(i);
-                NDArray* currentGradOut = listOfGradOuts->at(classNum);
-                NDArray* currentFFOut = listOfBPTensors->at(classNum);
-
-                currentOut->assign((*currentFFOut) * (*currentGradOut) / (*current));
-            }
-        }
-        delete tempRes;
-        return ND4J_STATUS_OK;
-    }
-
-    // -------------------------------------------------------------------------------------------------------------- //
-    // Unsorted backpropagate segment ops
-    // -------------------------------------------------------------------------------------------------------------- //
-
-    template <typename T>
-    static int unsortedSegmentMaxFunctorBP_(NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output) {
-//        int numOfClasses = gradOut->sizeAt(0);
-        // if input is a vector: (as if in doc sample)
-        auto tempRes = gradOut->dup();
-        unsortedSegmentMaxFunctor(input, indices, numOfClasses, tempRes);
-        if (input->isVector()) {
-
-            for (Nd4jLong e = 0; e < input->lengthOf(); ++e) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(e);
-                if (nd4j::math::nd4j_abs(tempRes->e<double>(classNum) - input->e<double>(e)) < 1.e-5)
-                    output->p(e, gradOut->e<T>(classNum));
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            for (int e = 1; e < input->rankOf(); e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfBPTensors(tempRes->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfGradOuts(gradOut->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            for (int i = 0; i < indices->lengthOf(); i++) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(i);
-                NDArray* current = listOfTensors->at(i);
-                NDArray* currentOut = listOfOutTensors->at(i);
-                NDArray* currentGradOut = listOfGradOuts->at(classNum);
-                for (int e = 0; e < current->lengthOf(); e++) {
-                    if (nd4j::math::nd4j_abs(listOfBPTensors->at(classNum)->e<double>(e) - current->e<double>(e)) < 1.e-5)
-                        currentOut->p(e, currentGradOut->e<T>(e));
-                }
-            }
-        }
-        delete tempRes;
-        return ND4J_STATUS_OK;
+        BUILD_SINGLE_SELECTOR(output->dataType(), return segmentReduceBP_, (input, indices, gradOut, gradOut->sizeAt(0), SEGMENT_PROD, output), NUMERIC_TYPES);
     }
 
     int unsortedSegmentMaxFunctorBP(NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(output->dataType(), return unsortedSegmentMaxFunctorBP_, (input, indices, gradOut, numOfClasses, output), NUMERIC_TYPES);
-    }
-    BUILD_SINGLE_TEMPLATE(template int unsortedSegmentMaxFunctorBP_, (NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
-
-    template <typename T>
-    static int unsortedSegmentMinFunctorBP_(NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output) {
-        auto tempRes = gradOut->dup();
-        unsortedSegmentMinFunctor(input, indices, numOfClasses, tempRes);
-        if (input->isVector()) {
-
-            PRAGMA_OMP_PARALLEL_FOR
-            for (Nd4jLong e = 0; e < input->lengthOf(); ++e) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(e);
-                if (nd4j::math::nd4j_abs(tempRes->t<T>(classNum) - input->t<T>(e)) < 1.e-6)
-                    output->t<T>(e) = gradOut->t<T>(classNum);
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            int loop_size = input->rankOf();
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfBPTensors(tempRes->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfGradOuts(gradOut->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            //int numOfClasses = tempRes->sizeAt(0); // number of classes
-            //std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-
-            PRAGMA_OMP_PARALLEL_FOR
-            for (int i = 0; i < indices->lengthOf(); i++) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(i);
-                NDArray* current = listOfTensors->at(i);
-                NDArray* currentOut = listOfOutTensors->at(i);
-                NDArray* currentGradOut = listOfGradOuts->at(classNum);
-
-                for (int e = 0; e < current->lengthOf(); e++) {
-                    if (nd4j::math::nd4j_abs(listOfBPTensors->at(classNum)->t<T>(e) - current->t<T>(e)) < 1.e-6)
-                        currentOut->t<T>(e) = currentGradOut->t<T>(e);
-                }
-            }
-        }
-        delete tempRes;
-        return ND4J_STATUS_OK;
+        BUILD_SINGLE_SELECTOR(output->dataType(), return segmentReduceBP_, (input, indices, gradOut, numOfClasses, SEGMENT_MAX, output), NUMERIC_TYPES);
     }
 
     int unsortedSegmentMinFunctorBP(NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(output->dataType(), return unsortedSegmentMinFunctorBP_, (input, indices, gradOut, numOfClasses, output), NUMERIC_TYPES);
+        BUILD_SINGLE_SELECTOR(output->dataType(), return segmentReduceBP_, (input, indices, gradOut, numOfClasses, SEGMENT_MIN, output), NUMERIC_TYPES);
     }
-    BUILD_SINGLE_TEMPLATE(template int unsortedSegmentMinFunctorBP_, (NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
 
     int unsortedSegmentMeanFunctorBP(NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output) {
-
-        std::map<Nd4jLong, Nd4jLong> classCount;//(numClasses);
-
-        for (Nd4jLong count = 0; count < numOfClasses; ++count) {
-            classCount[count] = 0;
-        }
-
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e) {
-            classCount[indices->e<Nd4jLong>(e)]++;
-        }
-
-        // if input is a vector: (as if in doc sample)
-        if (input->isVector()) {
-            for (Nd4jLong e = 0; e < indices->lengthOf(); ++e) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(e);
-                output->p(e, gradOut->e<double>(classNum) / classCount[classNum]);
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            for (int e = 1; e < input->rankOf(); e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfGradOuts(gradOut->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            for (int i = 0; i < indices->lengthOf(); i++) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(i);
-                NDArray* current = listOfTensors->at(i);
-                NDArray* currentOut = listOfOutTensors->at(i);
-                NDArray* currentGradOut = listOfGradOuts->at(classNum);
-                currentOut->assign(*currentGradOut / double(classCount[classNum]));
-            }
-        }
-        return ND4J_STATUS_OK;
+        BUILD_SINGLE_SELECTOR(output->dataType(), return segmentReduceBP_, (input, indices, gradOut, numOfClasses, SEGMENT_MEAN, output), NUMERIC_TYPES);
     }
 
     int unsortedSegmentSumFunctorBP(NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output) {
-
-        // if input is a vector: (as if in doc sample)
-        Nd4jLong idx = indices->e<Nd4jLong>(0);
-        if (input->isVector()) {
-            for (Nd4jLong e = 0; e < indices->lengthOf(); ++e) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(e);
-                output->p(e, gradOut->e<double>(classNum));
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            int loop_size = input->rankOf();
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfGradOuts(gradOut->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            PRAGMA_OMP_PARALLEL_FOR
-            for (int i = 0; i < indices->lengthOf(); i++) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(i);
-                //NDArray* current = listOfTensors->at(i);
-                NDArray* currentOut = listOfOutTensors->at(i);
-                NDArray* currentGradOut = listOfGradOuts->at(classNum);
-
-                currentOut->assign(currentGradOut);
-            }
-        }
-        return ND4J_STATUS_OK;
+        BUILD_SINGLE_SELECTOR(output->dataType(), return segmentReduceBP_, (input, indices, gradOut, numOfClasses, SEGMENT_SUM, output), NUMERIC_TYPES);
     }
 
     int unsortedSegmentProdFunctorBP(NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output) {
-        auto tempRes = gradOut->dup();
-
-        unsortedSegmentProdFunctor(input, indices, numOfClasses, tempRes);
-        if (input->isVector()) {
-            PRAGMA_OMP_PARALLEL_FOR
-            for (Nd4jLong e = 0; e < indices->lengthOf(); ++e) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(e);
-                output->p<double>(e, gradOut->e<double>(classNum) * tempRes->e<double>(classNum)/ input->e<double>(e));
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            int loop_size = input->rankOf();
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfBPTensors(tempRes->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfGradOuts(gradOut->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            PRAGMA_OMP_PARALLEL_FOR
-            for (int i = 0; i < indices->lengthOf(); i++) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(i);
-                NDArray* current = listOfTensors->at(i);
-                NDArray* currentOut = listOfOutTensors->at(i);
-                NDArray* currentGradOut = listOfGradOuts->at(classNum);
-                auto currentFFOut = listOfBPTensors->at(classNum);
-
-                currentOut->assign((*currentFFOut) * (*currentGradOut) / (*current));
-            }
-        }
-        delete tempRes;
-        return ND4J_STATUS_OK;
+        BUILD_SINGLE_SELECTOR(output->dataType(), return segmentReduceBP_, (input, indices, gradOut, numOfClasses, SEGMENT_PROD, output), NUMERIC_TYPES);
     }
 
-//    template <typename T>
     int unsortedSegmentSqrtNFunctorBP(NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output) {
-        std::map<Nd4jLong, Nd4jLong> classCount;//(numClasses);
-
-        for (Nd4jLong count = 0; count < numOfClasses; ++count) {
-            classCount[count] = 0;
-        }
-
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e) {
-            classCount[indices->e<Nd4jLong>(e)]++;
-        }
-
-        // if input is a vector: (as if in doc sample)
-        if (input->isVector()) {
-            PRAGMA_OMP_PARALLEL_FOR
-            for (Nd4jLong e = 0; e < indices->lengthOf(); ++e) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(e);
-                output->p(e, gradOut->e<double>(classNum) / nd4j::math::nd4j_sqrt<double,double>(classCount[classNum]));
-            }
-        }
-        else {
-            std::vector<int> restDims(input->rankOf() - 1);
-            int loop_size = input->rankOf();
-            for (int e = 1; e < loop_size; e++)
-                restDims[e - 1] = e;
-
-            std::unique_ptr<ResultSet> listOfGradOuts(gradOut->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfTensors(input->allTensorsAlongDimension(restDims));
-            std::unique_ptr<ResultSet> listOfOutTensors(output->allTensorsAlongDimension(restDims));
-
-            //int numOfClasses = tempRes->sizeAt(0); // number of classes
-            //std::vector<std::pair<NDArray*, int>> outputs(numOfClasses);
-
-            PRAGMA_OMP_PARALLEL_FOR
-            for (int i = 0; i < indices->lengthOf(); i++) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(i);
-                NDArray* current = listOfTensors->at(i);
-                NDArray* currentOut = listOfOutTensors->at(i);
-                NDArray* currentGradOut = listOfGradOuts->at(classNum);
-
-                for (int e = 0; e < current->lengthOf(); e++) {
-                    currentOut->p(e, currentGradOut->e<double>(e) / nd4j::math::nd4j_sqrt<double,double>(classCount[classNum]));
-                }
-            }
-        }
-        return ND4J_STATUS_OK;
+        BUILD_SINGLE_SELECTOR(output->dataType(), return segmentReduceBP_, (input, indices, gradOut, numOfClasses, SEGMENT_SQRTN, output), NUMERIC_TYPES);
     }
 
+    BUILD_SINGLE_TEMPLATE(template int segmentReduceBP_, (NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, int op, NDArray* output), NUMERIC_TYPES);
+
 }
 }
 }
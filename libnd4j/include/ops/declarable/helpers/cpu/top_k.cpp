@@ -21,120 +21,186 @@
 #include <ops/declarable/helpers/top_k.h>
 #include <ops/declarable/headers/parity_ops.h>
 #include <NDArrayFactory.h>
+#include <helpers/ConstantTadHelper.h>
+#include <algorithm>
+#include <vector>
 
 namespace nd4j {
 namespace ops {
 namespace helpers {
 
+    // rows are scanned in chunks of this size, and chunks without candidates are skipped after single vectorized pass
+    #define TOPK_CHUNK 256
+
+    // rows wider than this are split between threads if there are not enough rows to keep all threads busy
+    #define TOPK_SPLIT_THRESHOLD 65536
+
     template <typename T>
-    static int topKFunctor_(NDArray* input, NDArray* values, NDArray* indeces, int k, bool needSort) {
-        Nd4jLong width = input->sizeAt(-1);
-//        Nd4jLong lastDim = input->rankOf() - 1;
-//      FIX ME: lastDim should be Nd4Long not int only?
-        int lastDim = input->rankOf() - 1;
-//        std::unique_ptr<ResultSet> lastDimList(input->allTensorsAlongDimension({lastDim}));
-// ----------------------------------------------------------------------------------------------- //
-// this assumption is right:
-//        if (values->lengthOf() != k * lastDimList->size()) {
-//            nd4j_printf("top_k: something is wrong. %i expected, but %i given.\n",
-//                values->lengthOf(), k * lastDimList->size());
-//        }
-// ----------------------------------------------------------------------------------------------- //
-        std::vector<int> dimsToExclude(input->rankOf() - 1);
-        for (int d = 0; d < dimsToExclude.size(); ++d)
-            dimsToExclude[d] = d;
-
-        const Nd4jLong numOfSubArrs = ShapeUtils::getNumOfSubArrs(input->getShapeInfo(), dimsToExclude);
-
-            if (k == 1) {
-                for (Nd4jLong e = 0; e < numOfSubArrs; ++e) {
-                    auto trial = (*input)(e, dimsToExclude);
-                    //int maxPos = //lastDimList->at(e)->argMax();
-                    Nd4jLong maxPos = 0;
-                    //trial.printIndexedBuffer("TRIAL:");
-                    T maxVal = trial.e<T>(0);
-                    for (Nd4jLong pos = 1; pos < trial.lengthOf(); pos++)
-                        if (maxVal < trial.e<T>(pos)) {
-                            maxPos = pos;
-                            maxVal = trial.e<T>(pos);
+    using TopKItem = std::pair<T, Nd4jLong>;
+
+    // bigger values go first, equal values are ordered by position, just like stable sort would do
+    template <typename T>
+    static FORCEINLINE bool isBetter(const TopKItem<T>& a, const TopKItem<T>& b) {
+        return a.first > b.first || (a.first == b.first && a.second < b.second);
+    }
+
+    // heap is ordered by isBetter(), so its front is the worst of k items collected so far
+    template <typename T>
+    static FORCEINLINE void offerItem(std::vector<TopKItem<T>>& heap, const int k, const TopKItem<T>& item) {
+        if ((int) heap.size() < k) {
+            heap.emplace_back(item);
+            std::push_heap(heap.begin(), heap.end(), isBetter<T>);
+        } else if (isBetter<T>(item, heap.front())) {
+            std::pop_heap(heap.begin(), heap.end(), isBetter<T>);
+            heap.back() = item;
+            std::push_heap(heap.begin(), heap.end(), isBetter<T>);
+        }
+    }
+
+    // collects top k items of x[start..end) into heap, in O(n log k)
+    template <typename T>
+    static void topKRange(const T* x, const Nd4jLong stride, const Nd4jLong start, const Nd4jLong end, const int k, std::vector<TopKItem<T>>& heap) {
+        heap.clear();
+
+        Nd4jLong i = start;
+        for (; i < end && (int) heap.size() < k; i++)
+            offerItem<T>(heap, k, TopKItem<T>(x[i * stride], i));
+
+        if (i >= end)
+            return;
+
+        // positions grow, so value equal to the worst one can't make it into top k
+        T threshold = heap.front().first;
+
+        if (stride == 1) {
+            while (i < end) {
+                const Nd4jLong chunkEnd = nd4j::math::nd4j_min<Nd4jLong>(i + TOPK_CHUNK, end);
+
+                int found = 0;
+                PRAGMA_OMP_SIMD_ARGS(reduction(|:found))
+                for (Nd4jLong j = i; j < chunkEnd; j++)
+                    found |= x[j] > threshold ? 1 : 0;
+
+                if (found) {
+                    for (Nd4jLong j = i; j < chunkEnd; j++) {
+                        if (x[j] > threshold) {
+                            offerItem<T>(heap, k, TopKItem<T>(x[j], j));
+                            threshold = heap.front().first;
                         }
-                    if (indeces)
-                        indeces->p(e, maxPos); //topIndex;
-                    if (values)
-                        values->p(e, maxVal);
+                    }
                 }
+
+                i = chunkEnd;
             }
-            else { 
-                int nextPos = 0;
-
-                for (Nd4jLong e = 0; e < numOfSubArrs; ++e) {
-                    auto trial = (*input)(e, dimsToExclude);
-
-                    // fill up the first k elements
-                    NDArray topValues = NDArrayFactory::create<T>('c', {k});
-                    NDArray sortedVals = NDArrayFactory::create<T>('c', {k});
-                    NDArray topIndices = NDArrayFactory::create<Nd4jLong>('c', {k});
-                    for (Nd4jLong pos = 0; pos < k; ++pos) {
-                        topIndices.t<Nd4jLong>(pos) = pos;
-                        topValues.t<T>(pos) = trial.t<T>(pos);
-                    }
-                    //std::vector<T> sortedVals(topValues);
-                    sortedVals.assign(topValues);// = NDArrayFactory::create<T>('c', {k});
-                    //std::sort(sortedVals.begin(), sortedVals.end()); // sorted in ascending order
-                    SpecialMethods<T>::sortGeneric(sortedVals.buffer(), sortedVals.shapeInfo(), false);
-                    for (int i = k; i < width; ++i) {
-                        T val = trial.e<T>(i);
-                        T minTopVal = sortedVals.t<T>(0);
-                        if (minTopVal < val) { // value should be inserted to top k
-                            // only if it is not contained in
-                            T* begin = reinterpret_cast<T*>(sortedVals.buffer());
-                            T* end = begin + k;
-                            bool exists = std::binary_search(begin, end, val);
-                            if (!exists) {
-                                //exchangePos - a distance between begin and minimal existed to be suppressed by val
-                                T* topBegin = reinterpret_cast<T*>(topValues.buffer());
-                                T* topEnd = topBegin + k;
-                                auto exchangePos = std::distance(topBegin, std::find(topBegin, topEnd, sortedVals.t<T>(0)));
-                                topValues.t<T>(exchangePos) = val; //*exchangeIt = val;
-                                topIndices.t<Nd4jLong>(exchangePos) = i;
-                                sortedVals.t<T>(0) = val; // suppress in sorted
-                                //std::sort(sortedVals.begin(), sortedVals.end()); // sorted in ascending order
-                                SpecialMethods<T>::sortGeneric(sortedVals.buffer(), sortedVals.shapeInfo(), false);
-                            }
-                        }
-                    }
-                    if (needSort) {
-                        SpecialMethods<T>::sortGeneric(topValues.buffer(), topValues.shapeInfo(), true);
+        } else {
+            for (; i < end; i++) {
+                const T v = x[i * stride];
+                if (v > threshold) {
+                    offerItem<T>(heap, k, TopKItem<T>(v, i));
+                    threshold = heap.front().first;
+                }
+            }
+        }
+    }
 
-                        for (int j = 0; j < width; j++)
-                            for (int pos = 0; pos < k; ++pos)
-                                if (topValues.t<T>(pos) == trial.t<T>(j))
-                                    topIndices.t<Nd4jLong>(pos) = j;
-                    }
-                    else { // else sort by indices
-                        std::map<Nd4jLong, T> sortValsMap;
-                        //std::vector<std::pair<int, T>> data(topValues.lengthOf());
-                        for (size_t e = 0; e < topValues.lengthOf(); ++e) {
-                            sortValsMap[topIndices.t<Nd4jLong>(e)] = topValues.t<T>(e);
-                        }
+    template <typename I>
+    static void storeIndices_(void* buffer, const Nd4jLong offset, const Nd4jLong stride, const std::vector<Nd4jLong>& positions) {
+        auto z = reinterpret_cast<I*>(buffer) + offset;
+        for (int e = 0; e < (int) positions.size(); e++)
+            z[e * stride] = static_cast<I>(positions[e]);
+    }
 
-                        //std::sort(data.begin(), data.end(), [](std::pair<int, T> const& a, std::pair<int, T> const& b) {
-                        //    return a.first < b.first;
-                        //});
-                        Nd4jLong e = 0;
-                        for (auto it = sortValsMap.begin(); it != sortValsMap.end(); ++it, e++) {
-                            topIndices.t<Nd4jLong>(e) = it->first;
-                            topValues.t<T>(e) = it->second;
-                        }
+    static FORCEINLINE Nd4jLong lastStride(Nd4jLong* tadShapeInfo) {
+        const int rank = shape::rank(tadShapeInfo);
+        return rank > 0 ? shape::stride(tadShapeInfo)[rank - 1] : 1;
+    }
 
-                    }
-                    if (values)
-                    (*values)(e, dimsToExclude).assign(topValues);
-                    if (indeces)
-                    (*indeces)(e, dimsToExclude).assign(topIndices);
+    template <typename T>
+    static void storeRow(std::vector<TopKItem<T>>& heap, const bool needSort, NDArray* values, NDArray* indices, const Nd4jLong vOffset, const Nd4jLong vStride, const Nd4jLong iOffset, const Nd4jLong iStride) {
+        if (needSort)
+            std::sort_heap(heap.begin(), heap.end(), isBetter<T>);
+        else
+            std::sort(heap.begin(), heap.end(), [] (const TopKItem<T>& a, const TopKItem<T>& b) { return a.second < b.second; });
+
+        if (values != nullptr) {
+            auto z = values->bufferAsT<T>() + vOffset;
+            for (int e = 0; e < (int) heap.size(); e++)
+                z[e * vStride] = heap[e].first;
+        }
+
+        if (indices != nullptr) {
+            std::vector<Nd4jLong> positions(heap.size());
+            for (int e = 0; e < (int) heap.size(); e++)
+                positions[e] = heap[e].second;
+
+            BUILD_SINGLE_SELECTOR(indices->dataType(), storeIndices_, (indices->buffer(), iOffset, iStride, positions), INTEGER_TYPES);
+        }
+    }
+
+    template <typename T>
+    static int topKFunctor_(NDArray* input, NDArray* values, NDArray* indeces, int k, bool needSort) {
+        const int lastDim = input->rankOf() - 1;
+        const Nd4jLong width = input->sizeAt(-1);
+
+        auto xPack = ConstantTadHelper::getInstance()->tadForDimensions(input->getShapeInfo(), {lastDim});
+        const Nd4jLong numRows = xPack.numberOfTads();
+        const Nd4jLong xStride = lastStride(xPack.primaryShapeInfo());
+        auto x = input->bufferAsT<T>();
+
+        // outputs have the same number of rows, k elements each
+        Nd4jLong *vOffsets = nullptr, *iOffsets = nullptr;
+        Nd4jLong vStride = 1, iStride = 1;
+        if (values != nullptr) {
+            auto vPack = ConstantTadHelper::getInstance()->tadForDimensions(values->getShapeInfo(), {values->rankOf() - 1});
+            vOffsets = vPack.primaryOffsets();
+            vStride = lastStride(vPack.primaryShapeInfo());
+        }
+
+        if (indeces != nullptr) {
+            auto iPack = ConstantTadHelper::getInstance()->tadForDimensions(indeces->getShapeInfo(), {indeces->rankOf() - 1});
+            iOffsets = iPack.primaryOffsets();
+            iStride = lastStride(iPack.primaryShapeInfo());
+        }
+
+        const int numThreads = omp_get_max_threads();
+
+        if (numRows >= numThreads || width < TOPK_SPLIT_THRESHOLD) {
+            // plenty of rows: each row is processed by single thread
+            PRAGMA_OMP_PARALLEL_FOR_IF(numRows > 1 && numRows * width > Environment::getInstance()->elementwiseThreshold())
+            for (Nd4jLong r = 0; r < numRows; r++) {
+                std::vector<TopKItem<T>> heap;
+                heap.reserve(k);
+
+                topKRange<T>(x + xPack.primaryOffsets()[r], xStride, 0, width, k, heap);
+                storeRow<T>(heap, needSort, values, indeces, vOffsets != nullptr ? vOffsets[r] : 0, vStride, iOffsets != nullptr ? iOffsets[r] : 0, iStride);
+            }
+        } else {
+            // few huge rows: each row is split between threads, and partial results are merged
+            const Nd4jLong span = (width + numThreads - 1) / numThreads;
+            std::vector<std::vector<TopKItem<T>>> partial(numThreads);
+
+            for (Nd4jLong r = 0; r < numRows; r++) {
+                auto row = x + xPack.primaryOffsets()[r];
+
+                PRAGMA_OMP_PARALLEL_FOR
+                for (int t = 0; t < numThreads; t++) {
+                    const Nd4jLong start = t * span;
+                    const Nd4jLong end = nd4j::math::nd4j_min<Nd4jLong>(start + span, width);
+                    partial[t].clear();
+                    if (start < end)
+                        topKRange<T>(row, xStride, start, end, k, partial[t]);
                 }
-                //indeces->printIndexedBuffer("Indices as is");
+
+                std::vector<TopKItem<T>> heap;
+                heap.reserve(k);
+                for (auto &p: partial)
+                    for (auto &item: p)
+                        offerItem<T>(heap, k, item);
+
+                storeRow<T>(heap, needSort, values, indeces, vOffsets != nullptr ? vOffsets[r] : 0, vStride, iOffsets != nullptr ? iOffsets[r] : 0, iStride);
+            }
         }
+
         return Status::OK();
     }
 // ----------------------------------------------------------------------------------------------- //
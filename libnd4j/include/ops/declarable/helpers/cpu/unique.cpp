@@ -19,25 +19,200 @@
 //
 
 #include <ops/declarable/helpers/unique.h>
+#include <helpers/OpenAddressingTable.h>
 #include <Status.h>
 
 namespace nd4j {
 namespace ops {
 namespace helpers {
 
+    // inputs shorter than this are processed with single hash table, longer ones are partitioned across threads
+    static const Nd4jLong UNIQUE_PARTITION_THRESHOLD = 1 << 18;
+
+    // tables start at this size at most, and grow if there are more distinct values
+    static const Nd4jLong UNIQUE_INITIAL_TABLE = 1 << 16;
+
+    //////////////////////////////////////////////////////////////////////////
+    // single table pass. ids, firsts and counts are optional: without them only number of distinct values is returned
     template <typename T>
-    static Nd4jLong uniqueCount_(NDArray* input) {
-        Nd4jLong count = 0;
+    static Nd4jLong uniqueSequential_(const T* x, const Nd4jLong length, Nd4jLong* ids, std::vector<Nd4jLong>* firsts, std::vector<Nd4jLong>* counts) {
+        OpenAddressingTable<T> table(nd4j::math::nd4j_min<Nd4jLong>(length, UNIQUE_INITIAL_TABLE));
+
+        for (Nd4jLong e = 0; e < length; e++) {
+            bool inserted;
+            auto id = table.insert(x[e], table.size(), inserted);
+
+            if (ids == nullptr)
+                continue;
+
+            if (inserted) {
+                firsts->emplace_back(e);
+                counts->emplace_back(0);
+            }
+
+            (*counts)[id]++;
+            ids[e] = id;
+        }
+
+        return table.size();
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    // elements are partitioned by high bits of their hashes, so equal values always end up in the same partition,
+    // and every partition is deduplicated by its own thread. Stable partitioning keeps element order within
+    // partitions, and global ids are assigned afterwards in order of first occurrence
+    template <typename T>
+    static Nd4jLong uniquePartitioned_(const T* x, const Nd4jLong length, const int numParts, Nd4jLong* ids, std::vector<Nd4jLong>* firsts, std::vector<Nd4jLong>* counts) {
+        const Nd4jLong chunk = (length + numParts - 1) / numParts;
+
+        // histogram[c * numParts + p] is number of elements of chunk c that belong to partition p
+        std::vector<int> parts(length);
+        std::vector<Nd4jLong> histogram(numParts * numParts, 0);
+
+        PRAGMA_OMP_PARALLEL_FOR_THREADS(numParts)
+        for (int c = 0; c < numParts; c++) {
+            auto hist = histogram.data() + c * numParts;
+            auto stop = nd4j::math::nd4j_min<Nd4jLong>(length, (c + 1) * chunk);
+            for (Nd4jLong e = c * chunk; e < stop; e++) {
+                auto p = static_cast<int>((OpenAddressingTable<T>::hash(x[e]) >> 40) % numParts);
+                parts[e] = p;
+                hist[p]++;
+            }
+        }
+
+        // offsets are ordered by partition first and by chunk second, so scatter below is stable
+        std::vector<Nd4jLong> offsets(numParts * numParts);
+        std::vector<Nd4jLong> partStart(numParts + 1);
+        Nd4jLong position = 0;
+        for (int p = 0; p < numParts; p++) {
+            partStart[p] = position;
+            for (int c = 0; c < numParts; c++) {
+                offsets[c * numParts + p] = position;
+                position += histogram[c * numParts + p];
+            }
+        }
+        partStart[numParts] = position;
+
+        std::vector<Nd4jLong> order(length);
+
+        PRAGMA_OMP_PARALLEL_FOR_THREADS(numParts)
+        for (int c = 0; c < numParts; c++) {
+            auto offset = offsets.data() + c * numParts;
+            auto stop = nd4j::math::nd4j_min<Nd4jLong>(length, (c + 1) * chunk);
+            for (Nd4jLong e = c * chunk; e < stop; e++)
+                order[offset[parts[e]]++] = e;
+        }
+
+        std::vector<std::vector<Nd4jLong>> localFirsts(numParts);
+        std::vector<std::vector<Nd4jLong>> localCounts(numParts);
+        std::vector<Nd4jLong> localSizes(numParts, 0);
+
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(num_threads(numParts) schedule(dynamic, 1))
+        for (int p = 0; p < numParts; p++) {
+            OpenAddressingTable<T> table(nd4j::math::nd4j_min<Nd4jLong>(partStart[p + 1] - partStart[p], UNIQUE_INITIAL_TABLE));
+            auto &lFirsts = localFirsts[p];
+            auto &lCounts = localCounts[p];
+
+            for (Nd4jLong i = partStart[p]; i < partStart[p + 1]; i++) {
+                auto e = order[i];
+                bool inserted;
+                auto id = table.insert(x[e], table.size(), inserted);
+
+                if (ids == nullptr)
+                    continue;
+
+                if (inserted) {
+                    lFirsts.emplace_back(e);
+                    lCounts.emplace_back(0);
+                }
+
+                lCounts[id]++;
+
+                // local id for now, it's replaced with global one below
+                ids[e] = id;
+            }
+
+            localSizes[p] = table.size();
+        }
 
-        std::vector<T> values;
+        Nd4jLong numUnique = 0;
+        for (auto v:localSizes)
+            numUnique += v;
 
-        for (int e = 0; e < input->lengthOf(); e++) {
-            T v = input->e<T>(e);
-            if (std::find(values.begin(), values.end(), v) == values.end()) {
-                values.push_back(v);
-                count++;
+        if (ids == nullptr)
+            return numUnique;
+
+        // global id of each distinct value is number of first occurrences preceding its own first occurrence
+        std::vector<Nd4jLong> rank(length, 0);
+
+        PRAGMA_OMP_PARALLEL_FOR_THREADS(numParts)
+        for (int p = 0; p < numParts; p++)
+            for (auto f:localFirsts[p])
+                rank[f] = 1;
+
+        std::vector<Nd4jLong> chunkSums(numParts + 1, 0);
+
+        PRAGMA_OMP_PARALLEL_FOR_THREADS(numParts)
+        for (int c = 0; c < numParts; c++) {
+            auto stop = nd4j::math::nd4j_min<Nd4jLong>(length, (c + 1) * chunk);
+            Nd4jLong sum = 0;
+            for (Nd4jLong e = c * chunk; e < stop; e++) {
+                auto flag = rank[e];
+                rank[e] = sum;
+                sum += flag;
             }
+            chunkSums[c + 1] = sum;
         }
+
+        for (int c = 0; c < numParts; c++)
+            chunkSums[c + 1] += chunkSums[c];
+
+        firsts->resize(numUnique);
+        counts->resize(numUnique);
+
+        PRAGMA_OMP_PARALLEL_FOR_ARGS(num_threads(numParts) schedule(dynamic, 1))
+        for (int p = 0; p < numParts; p++) {
+            auto &lFirsts = localFirsts[p];
+            for (size_t k = 0; k < lFirsts.size(); k++) {
+                auto f = lFirsts[k];
+                auto g = rank[f] + chunkSums[f / chunk];
+                (*firsts)[g] = f;
+                (*counts)[g] = localCounts[p][k];
+
+                // local-to-global id mapping is stored in place
+                lFirsts[k] = g;
+            }
+        }
+
+        PRAGMA_OMP_PARALLEL_FOR_THREADS(numParts)
+        for (Nd4jLong e = 0; e < length; e++)
+            ids[e] = localFirsts[parts[e]][ids[e]];
+
+        return numUnique;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    static Nd4jLong uniqueIds_(const T* x, const Nd4jLong length, Nd4jLong* ids, std::vector<Nd4jLong>* firsts, std::vector<Nd4jLong>* counts) {
+        int numThreads = omp_get_max_threads();
+        if (length < UNIQUE_PARTITION_THRESHOLD || numThreads < 2)
+            return uniqueSequential_<T>(x, length, ids, firsts, counts);
+
+        return uniquePartitioned_<T>(x, length, numThreads, ids, firsts, counts);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    static Nd4jLong uniqueCount_(NDArray* input) {
+        if (input->lengthOf() == 0)
+            return 0;
+
+        NDArray* copy;
+        auto x = OpenAddressingTable<T>::linearBuffer(input, copy);
+
+        auto count = uniqueIds_<T>(x, input->lengthOf(), nullptr, nullptr, nullptr);
+
+        delete copy;
         return count;
     }
 
@@ -50,36 +225,43 @@ namespace helpers {
 
     template <typename T>
     static Nd4jStatus uniqueFunctor_(NDArray* input, NDArray* values, NDArray* indices, NDArray* counts) {
-    
-        std::vector<T> valuesVector;
-        std::map<T, int> indicesMap;
-        std::map<T, int> countsMap;
-
-        for (int e = 0; e < input->lengthOf(); e++) {
-            T v = input->e<T>(e);
-            if (std::find(valuesVector.begin(), valuesVector.end(), v) == valuesVector.end()) {
-                valuesVector.push_back(v);
-                indicesMap[v] = e;
-                countsMap[v] = 1;
-            }
-            else {
-                countsMap[v]++;
-            }
-        }
+        const Nd4jLong length = input->lengthOf();
+        if (length == 0)
+            return Status::OK();
+
+        NDArray* copy;
+        auto x = OpenAddressingTable<T>::linearBuffer(input, copy);
+
+        // ids are built in Nd4jLong, and converted to requested types on assign if needed
+        NDArray ids('c', {length}, nd4j::DataType::INT64, input->getWorkspace());
+        std::vector<Nd4jLong> firsts;
+        std::vector<Nd4jLong> countsVector;
+
+        auto numUnique = uniqueIds_<T>(x, length, ids.bufferAsT<Nd4jLong>(), &firsts, &countsVector);
 
-        PRAGMA_OMP_PARALLEL_FOR_IF(values->lengthOf() > Environment::getInstance()->elementwiseThreshold())
-        for (int e = 0; e < values->lengthOf(); e++) {
-            values->p(e, static_cast<T>(valuesVector[e]));
-            if (counts != nullptr) 
-                counts->p(e, countsMap[valuesVector[e]]);
+        if (values->lengthOf() != numUnique) {
+            delete copy;
+            nd4j_printf("Unique: output length %lld doesn't match number of unique values %lld\n", values->lengthOf(), numUnique);
+            throw std::runtime_error("Unique: output/actual size mismatch");
         }
 
-        for (int e = 0; e < indices->lengthOf(); e++) {
-            auto posI = std::find(valuesVector.begin(), valuesVector.end(), input->e<T>(e));
-            auto dist = std::distance(valuesVector.begin(), posI);
-            indices->p(e, Nd4jLong(dist));//indicesMap[(*input)(e)];
+        NDArray valuesBuffer('c', {numUnique}, input->dataType(), input->getWorkspace());
+        auto v = valuesBuffer.bufferAsT<T>();
+
+        PRAGMA_OMP_PARALLEL_FOR_IF(numUnique > Environment::getInstance()->elementwiseThreshold())
+        for (Nd4jLong e = 0; e < numUnique; e++)
+            v[e] = x[firsts[e]];
+
+        values->assign(valuesBuffer);
+        indices->assign(ids);
+
+        if (counts != nullptr) {
+            NDArray countsBuffer('c', {numUnique}, nd4j::DataType::INT64, input->getWorkspace());
+            memcpy(countsBuffer.bufferAsT<Nd4jLong>(), countsVector.data(), numUnique * sizeof(Nd4jLong));
+            counts->assign(countsBuffer);
         }
 
+        delete copy;
         return Status::OK();
     }
 
@@ -90,4 +272,4 @@ namespace helpers {
     BUILD_SINGLE_TEMPLATE(template Nd4jStatus uniqueFunctor_, (NDArray* input, NDArray* values, NDArray* indices, NDArray* counts), LIBND4J_TYPES);
 }
 }
-}
\ No newline at end of file
+}
@@ -0,0 +1,71 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_FUSED_OPS_H
+#define LIBND4J_FUSED_OPS_H
+
+#include <ops/declarable/helpers/helpers.h>
+#include <vector>
+
+namespace nd4j {
+namespace ops {
+namespace helpers {
+
+    // kinds of steps fused ops are built of. values are stored in graph as integer arguments, so don't reorder them
+    enum FusedStepKind {
+        FUSED_TRANSFORM_SAME = 0,
+        FUSED_TRANSFORM_STRICT = 1,
+        FUSED_TRANSFORM_FLOAT = 2,
+        FUSED_SCALAR = 3,
+        // x op y, where y is either of the same shape, or is broadcast along last dimension (i.e. bias)
+        FUSED_PAIRWISE = 4,
+    };
+
+    struct FusedStep {
+        int kind;
+        int opNum;
+        double scalar;
+        NDArray* operand;
+    };
+
+    /**
+     * This method checks if given legacy op can be used as a step of fused op
+     */
+    bool isFusibleStep(int kind, int opNum);
+
+    /**
+     * This method reads steps encoded as (kind, opNum) pairs of integer arguments, starting at iArgsOffset.
+     * Each step takes one scalar from tArgs, and each FUSED_PAIRWISE step takes next input array as operand
+     */
+    std::vector<FusedStep> parseFusedSteps(const std::vector<int>& iArgs, int iArgsOffset, const std::vector<double>& tArgs, const std::vector<NDArray*>& operands);
+
+    /**
+     * This method returns shapeInfo of the fused chain output, or nullptr if operand shapes aren't broadcastable
+     */
+    Nd4jLong* fusedOutputShapeInfo(const Nd4jLong* inputShapeInfo, const std::vector<int>& iArgs, int iArgsOffset, const std::vector<Nd4jLong*>& operandShapes, nd4j::memory::Workspace* workspace);
+
+    /**
+     * This method applies steps to the input, one by one. Contiguous arrays are processed block by block, with all steps
+     * applied to a block while it's still in cache, so whole chain takes single pass over memory.
+     *
+     * input and output can be the same array
+     */
+    void fusedElementwise(NDArray* input, std::vector<FusedStep>& steps, NDArray* output);
+}
+}
+}
+
+#endif //LIBND4J_FUSED_OPS_H
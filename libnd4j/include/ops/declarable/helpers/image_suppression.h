@@ -26,7 +26,18 @@ namespace nd4j {
 namespace ops {
 namespace helpers {
 
-    void nonMaxSuppressionV2(NDArray* boxes, NDArray* scales, int maxSize, double threshold, NDArray* output);
+    /**
+     * Greedy non-max suppression. Boxes with score not above scoreThreshold are ignored. With softNmsSigma > 0
+     * overlapping boxes get their scores decayed instead of being dropped (boxes overlapping more than overlapThreshold are still dropped)
+     */
+    void nonMaxSuppressionV2(NDArray* boxes, NDArray* scales, int maxSize, double overlapThreshold, double scoreThreshold, double softNmsSigma, NDArray* output);
+
+    /**
+     * Same as above, applied independently to each (image, class) pair.
+     * boxes are (batch, numBoxes, 4), shared by all classes; scores are (batch, numBoxes, numClasses).
+     * Unused positions of indices are filled with -1, unused scores with 0
+     */
+    void nonMaxSuppressionBatched(NDArray* boxes, NDArray* scores, int maxSize, double overlapThreshold, double scoreThreshold, double softNmsSigma, NDArray* indices, NDArray* selectedScores, NDArray* validCounts);
 
 }
 }
@@ -25,6 +25,10 @@
 #include <NDArrayFactory.h>
 #include <graph/exceptions/graph_exception.h>
 #include <graph/exceptions/unresolved_input_exception.h>
+#include <graph/profiling/OpTraceCollector.h>
+#include <helpers/ThreadPool.h>
+#include <ctime>
+#include <memory>
 
 namespace nd4j {
     namespace ops {
@@ -431,6 +435,82 @@ namespace nd4j {
             return ND4J_STATUS_OK;
         }
 
+        // returns output array with given index, or nullptr if there's no such output
+        static NDArray* outputArray(Context *block, int e) {
+            if (block->isFastPath()) {
+                // we have to check either in or out stack, depending on isInplace()
+                auto &stack = block->isInplace() ? block->fastpath_in() : block->fastpath_out();
+                return e < (int) stack.size() ? stack[e] : nullptr;
+            }
+
+            auto vs = block->getVariableSpace();
+            if (!vs->hasVariable(block->nodeId(), e))
+                return nullptr;
+
+            return vs->getVariable(block->nodeId(), e)->getNDArray();
+        }
+
+        static std::string traceShape(NDArray *array) {
+            auto type = DataTypeUtils::asString(array->dataType());
+            return type + ShapeUtils::shapeAsString(array);
+        }
+
+        // builds OpTraceEvent for op that just finished, and passes it to OpTraceCollector
+        static void traceExecution(const std::string &opName, Context *block, int numOutputs, Nd4jLong start, std::clock_t cpuStart, const nd4j::graph::OpTraceScope &scope, Nd4jLong spillsBefore) {
+            auto collector = nd4j::graph::OpTraceCollector::getInstance();
+            auto cpuEnd = std::clock();
+
+            nd4j::graph::OpTraceEvent event;
+            event.startTime = start;
+            event.duration = collector->now() - start;
+            event.name = opName;
+            event.nodeId = block->nodeId();
+            event.maxThreads = Threads::maxThreads();
+
+            // std::clock() is process-wide, so it's only meaningful if nothing else was running
+            event.concurrent = !scope.isExclusive();
+            if (!event.concurrent)
+                event.cpuTime = static_cast<Nd4jLong>((cpuEnd - cpuStart) * (1e9 / CLOCKS_PER_SEC));
+
+            if (block->workspace() != nullptr)
+                event.spills = nd4j::math::nd4j_max<Nd4jLong>(0L, block->workspace()->getSpilledSize() - spillsBefore);
+
+            std::vector<NDArray*> inputs;
+            if (block->isFastPath()) {
+                inputs = block->fastpath_in();
+            } else {
+                for (auto p: *block->inputs()) {
+                    auto v = block->variable(p);
+                    if (v != nullptr && v->getNDArray() != nullptr)
+                        inputs.emplace_back(v->getNDArray());
+                }
+            }
+
+            std::vector<NDArray*> outputs;
+            for (int e = 0; e < numOutputs; e++) {
+                auto array = outputArray(block, e);
+                if (array == nullptr)
+                    break;
+
+                outputs.emplace_back(array);
+            }
+
+            for (auto v: inputs) {
+                event.shapes += (event.shapes.empty() ? "" : " ") + traceShape(v);
+                event.bytesRead += v->lengthOf() * v->sizeOfT();
+            }
+
+            event.shapes += " ->";
+            for (auto v: outputs) {
+                event.shapes += " " + traceShape(v);
+                event.bytesWritten += v->lengthOf() * v->sizeOfT();
+            }
+
+            event.flops = nd4j::graph::OpTraceCollector::estimateFlops(opName, inputs, outputs, *block->getIArguments());
+
+            collector->record(event);
+        }
+
         Nd4jStatus nd4j::ops::DeclarableOp::execute(Context* block) {
             nd4j_debug("Executing op: [%s]\n", this->getOpName()->c_str());
 
@@ -459,8 +539,24 @@ namespace nd4j {
                 prepTime = std::chrono::duration_cast<std::chrono::nanoseconds>(timeStart - timeEnter).count();
             }
 
+            // tracing costs a single flag check when it's disabled
+            const bool tracing = Environment::getInstance()->isOpTracing();
+            Nd4jLong traceStart = 0L;
+            Nd4jLong spillsBefore = 0L;
+            std::clock_t cpuStart = 0;
+            std::unique_ptr<nd4j::graph::OpTraceScope> traceScope;
+            if (tracing) {
+                spillsBefore = block->workspace() == nullptr ? 0L : block->workspace()->getSpilledSize();
+                traceScope.reset(new nd4j::graph::OpTraceScope());
+                cpuStart = std::clock();
+                traceStart = nd4j::graph::OpTraceCollector::getInstance()->now();
+            }
+
             Nd4jStatus status = this->validateAndExecute(*block);
 
+            if (tracing)
+                traceExecution(*this->getOpName(), block, numOutputs, traceStart, cpuStart, *traceScope, spillsBefore);
+
             // optionally saving execution time
             if (Environment::getInstance()->isProfiling()) {
                 timeEnd = std::chrono::system_clock::now();
@@ -485,26 +581,11 @@ namespace nd4j {
 
             // now we print out all outputs for this node
             if (nd4j::Environment::getInstance()->isDebugAndVerbose()) {
-                auto vs = block->getVariableSpace();
-
                 for (int e = 0; e < numOutputs; e++) {
                     // if given output index doesn't exist - we're done
-
-                    if (!block->isFastPath()) {
-                        if (!vs->hasVariable(block->nodeId(), e))
-                            break;
-                    } else {
-                        // we have to check either in or out stack, depending on isInplace()
-                        if (block->isInplace()) {
-                            if (block->fastpath_in().size() <= e)
-                                break;
-                        } else {
-                            if (block->fastpath_out().size() <= e)
-                                break;
-                        }
-                    }
-
-                    auto array = block->isFastPath() ? block->isInplace() ? block->fastpath_in()[e] : block->fastpath_out()[e] : vs->getVariable(block->nodeId(), e)->getNDArray();
+                    auto array = outputArray(block, e);
+                    if (array == nullptr)
+                        break;
 
                     auto shape = ShapeUtils::shapeAsString(array);
                     auto first = array->isEmpty() ? std::string("Empty NDArray") : array->asString(32);
@@ -34,6 +34,10 @@ namespace nd4j {
          static inline int linearIndexC(int rows, int cols, int r, int c);
          static inline int linearIndexF(int rows, int cols, int r, int c);
 
+         /**
+          * Generic GEMM, used for types vendor BLAS doesn't support: C = alpha * op(A) x op(B) + beta * C, with regular BLAS semantics for Order, Trans* and leading dimensions.
+          * Inputs are packed into cache-sized panels and multiplied by register-blocked micro-kernel.
+          */
          template <typename X, typename Y, typename Z>
          class GEMM {
          protected:
@@ -22,6 +22,9 @@
 #include <gemm.h>
 #include <types/types.h>
 #include <Environment.h>
+#include <helpers/IsaDispatch.h>
+#include <vector>
+#include <type_traits>
 
 namespace nd4j {
     namespace blas {
@@ -45,6 +48,132 @@ namespace nd4j {
             return ret;
         }
 
+        // register tile computed by micro-kernel: MR rows of A panel x NR columns of B panel
+        static const int GEMM_MR = 4;
+        static const int GEMM_NR = 16;
+
+        // cache blocking: KC x NR panel of B stays in L1, MC x KC block of A stays in L2
+        static const int GEMM_KC = 256;
+        static const int GEMM_MC = 128;
+        static const int GEMM_NC = 1024;
+
+        // half-precision and integer inputs are accumulated in float, double inputs in double
+        template <typename Z>
+        struct GemmAccumulator {
+            typedef float type;
+        };
+
+        template <>
+        struct GemmAccumulator<double> {
+            typedef double type;
+        };
+
+        template <typename T>
+        static FORCEINLINE void gemmMicroKernel(int kc, const T *a, const T *b, T *c, int ldc, int mr, int nr) {
+            T acc[GEMM_MR][GEMM_NR];
+
+            for (int i = 0; i < GEMM_MR; i++)
+                for (int j = 0; j < GEMM_NR; j++)
+                    acc[i][j] = static_cast<T>(0);
+
+            for (int p = 0; p < kc; p++) {
+                auto bp = b + p * GEMM_NR;
+                auto ap = a + p * GEMM_MR;
+
+                for (int i = 0; i < GEMM_MR; i++) {
+                    auto av = ap[i];
+
+                    PRAGMA_OMP_SIMD
+                    for (int j = 0; j < GEMM_NR; j++)
+                        acc[i][j] += av * bp[j];
+                }
+            }
+
+            for (int i = 0; i < mr; i++)
+                for (int j = 0; j < nr; j++)
+                    c[i * ldc + j] += acc[i][j];
+        }
+
+        template <typename T>
+        using GemmKernel = void (*)(int, const T*, const T*, T*, int, int, int);
+
+        template <typename T>
+        static void gemmKernelGeneric(int kc, const T *a, const T *b, T *c, int ldc, int mr, int nr) {
+            gemmMicroKernel<T>(kc, a, b, c, ldc, mr, nr);
+        }
+
+#ifdef ND4J_ISA_DISPATCH
+        // same micro-kernel, vectorized for wider registers. proper variant is picked at runtime
+        template <typename T>
+        ND4J_TARGET_AVX2 static void gemmKernelAvx2(int kc, const T *a, const T *b, T *c, int ldc, int mr, int nr) {
+            gemmMicroKernel<T>(kc, a, b, c, ldc, mr, nr);
+        }
+
+        template <typename T>
+        ND4J_TARGET_AVX512 static void gemmKernelAvx512(int kc, const T *a, const T *b, T *c, int ldc, int mr, int nr) {
+            gemmMicroKernel<T>(kc, a, b, c, ldc, mr, nr);
+        }
+#endif
+
+        template <typename T>
+        static GemmKernel<T> gemmKernel() {
+#ifdef ND4J_ISA_DISPATCH
+            switch (Environment::getInstance()->isaLevel()) {
+                case ISA_AVX512:
+                    return gemmKernelAvx512<T>;
+                case ISA_AVX2:
+                    return gemmKernelAvx2<T>;
+                default:
+                    break;
+            }
+#endif
+            return gemmKernelGeneric<T>;
+        }
+
+        // pack buffers are kept by each calling thread and only grow, so repeated calls don't allocate nor zero anything
+        template <typename T>
+        static T* gemmBuffer(int slot, Nd4jLong length) {
+            static thread_local std::vector<T> buffers[3];
+
+            auto &buffer = buffers[slot];
+            if ((Nd4jLong) buffer.size() < length)
+                buffer.resize(length);
+
+            return buffer.data();
+        }
+
+        // packs mc x kc block of A, scaled by alpha, into MR-row panels, zero-padded at the edge
+        template <typename X, typename T>
+        static void gemmPackA(const X *A, Nd4jLong rs, Nd4jLong cs, int mc, int kc, T alpha, T *packed) {
+            int panels = (mc + GEMM_MR - 1) / GEMM_MR;
+
+            PRAGMA_OMP_PARALLEL_FOR_IF(panels > 1 && (Nd4jLong) mc * kc > Environment::getInstance()->elementwiseThreshold())
+            for (int ip = 0; ip < panels; ip++) {
+                auto dst = packed + (Nd4jLong) ip * GEMM_MR * kc;
+                for (int p = 0; p < kc; p++)
+                    for (int i = 0; i < GEMM_MR; i++) {
+                        int r = ip * GEMM_MR + i;
+                        dst[p * GEMM_MR + i] = r < mc ? alpha * static_cast<T>(A[r * rs + p * cs]) : static_cast<T>(0);
+                    }
+            }
+        }
+
+        // packs kc x nc block of B into NR-column panels, zero-padded at the edge
+        template <typename Y, typename T>
+        static void gemmPackB(const Y *B, Nd4jLong rs, Nd4jLong cs, int kc, int nc, T *packed) {
+            int panels = (nc + GEMM_NR - 1) / GEMM_NR;
+
+            PRAGMA_OMP_PARALLEL_FOR_IF(panels > 1 && (Nd4jLong) nc * kc > Environment::getInstance()->elementwiseThreshold())
+            for (int jp = 0; jp < panels; jp++) {
+                auto dst = packed + (Nd4jLong) jp * GEMM_NR * kc;
+                for (int p = 0; p < kc; p++)
+                    for (int j = 0; j < GEMM_NR; j++) {
+                        int c = jp * GEMM_NR + j;
+                        dst[p * GEMM_NR + j] = c < nc ? static_cast<T>(B[p * rs + c * cs]) : static_cast<T>(0);
+                    }
+            }
+        }
+
         template <typename X, typename Y, typename Z>
         void GEMM<X, Y, Z>::op(int Order, int TransA, int TransB,
                        int M, int N, int K,
@@ -54,49 +183,121 @@ namespace nd4j {
                        double beta,
                        void *vC, int ldc) {
 
+            typedef typename GemmAccumulator<Z>::type T;
+
             auto A = reinterpret_cast<X *>(vA);
             auto B = reinterpret_cast<Y *>(vB);
             auto C = reinterpret_cast<Z *>(vC);
 
+            if (M < 1 || N < 1)
+                return;
+
+            bool rowMajor = Order == CblasRowMajor;
             bool transAFlag = TransA == CblasTrans;
             bool transBFlag = TransB == CblasTrans;
 
-            if (beta == 0.0) {
-                int length = M*N;
-                if (length <= Environment::getInstance()->elementwiseThreshold()) {
-                    PRAGMA_OMP_SIMD
-                    for (int r = 0; r < length; r++)
-                        C[r] = static_cast<Z>(0.0f);
-                } else {
-                    PRAGMA_OMP_PARALLEL_FOR_SIMD
-                    for (int r = 0; r < length; r++)
-                        C[r] = static_cast<Z>(0.0f);
+            // element strides: A(i, k) = A[i * rsA + k * csA], same for B(k, j) and C(i, j)
+            Nd4jLong rsA = rowMajor != transAFlag ? lda : 1;
+            Nd4jLong csA = rowMajor != transAFlag ? 1 : lda;
+            Nd4jLong rsB = rowMajor != transBFlag ? ldb : 1;
+            Nd4jLong csB = rowMajor != transBFlag ? 1 : ldb;
+            Nd4jLong rsC = rowMajor ? ldc : 1;
+            Nd4jLong csC = rowMajor ? 1 : ldc;
+
+            auto alphaT = static_cast<T>(alpha);
+            auto betaT = static_cast<T>(beta);
+            bool compute = alpha != 0.0 && K > 0;
+
+            // row-major C of accumulator type is updated in place once beta is applied. Other C goes through row-major stripe of
+            // GEMM_MC x GEMM_NC elements, so low-precision C doesn't lose bits between K blocks
+            bool direct = std::is_same<Z, T>::value && csC == 1;
+
+            if (direct || !compute) {
+                if (beta != 1.0) {
+                    PRAGMA_OMP_PARALLEL_FOR_IF((Nd4jLong) M * N > Environment::getInstance()->elementwiseThreshold())
+                    for (int r = 0; r < M; r++) {
+                        for (int c = 0; c < N; c++) {
+                            auto z = C + r * rsC + c * csC;
+
+                            // C isn't read if beta is 0, so garbage in output buffer doesn't propagate
+                            *z = beta == 0.0 ? static_cast<Z>(0) : static_cast<Z>(betaT * static_cast<T>(*z));
+                        }
+                    }
                 }
+
+                if (!compute)
+                    return;
             }
 
+            // buffers are sized for actual product, so small ones don't pay for full cache blocks
+            int mcMax = nd4j::math::nd4j_min<int>(GEMM_MC, M);
+            int ncMax = nd4j::math::nd4j_min<int>(GEMM_NC, N);
+            int kcMax = nd4j::math::nd4j_min<int>(GEMM_KC, K);
 
-            PRAGMA_OMP_PARALLEL_FOR_SIMD_COLLAPSE(2)
-            for (int r = 0; r < M; r++) {
-                for (int c = 0; c < N; c++) {
-                    int zIdx = linearIndexF(M, N, r, c);
+            auto packedA = gemmBuffer<T>(0, (Nd4jLong) ((mcMax + GEMM_MR - 1) / GEMM_MR) * GEMM_MR * kcMax);
+            auto packedB = gemmBuffer<T>(1, (Nd4jLong) ((ncMax + GEMM_NR - 1) / GEMM_NR) * GEMM_NR * kcMax);
+            auto stripe = direct ? nullptr : gemmBuffer<T>(2, (Nd4jLong) mcMax * ncMax);
+            auto kernel = gemmKernel<T>();
 
-                    Z dot = static_cast<Z>(0.0f);
+            // in-place product covers all rows at once, stripe covers GEMM_MC rows, so B panel is packed once per stripe
+            int rowsBlock = direct ? M : GEMM_MC;
 
-                    if (alpha != 0.0) {
-                        int bIdx; // = linearIndexF(K, N, 0, c);
-                        int aIdx;
+            for (int jc = 0; jc < N; jc += GEMM_NC) {
+                int nc = nd4j::math::nd4j_min<int>(GEMM_NC, N - jc);
+                int nPanels = (nc + GEMM_NR - 1) / GEMM_NR;
+
+                for (int ir = 0; ir < M; ir += rowsBlock) {
+                    int rows = nd4j::math::nd4j_min<int>(rowsBlock, M - ir);
+
+                    // P(i, j) = P[i * ldp + j] holds rows [ir, ir + rows) and columns [jc, jc + nc) of product
+                    T *P;
+                    int ldp;
+                    if (direct) {
+                        P = reinterpret_cast<T *>(C) + ir * rsC + jc;
+                        ldp = static_cast<int>(rsC);
+                    } else {
+                        P = stripe;
+                        ldp = nc;
+                        std::fill(P, P + (Nd4jLong) rows * nc, static_cast<T>(0));
+                    }
 
-                        for (int k = 0; k < K; k++) {
-                            aIdx = (transAFlag ? linearIndexC(M, K, r, k) : linearIndexF(M, K, r, k));
-                            bIdx = (transBFlag ? linearIndexC(K, N, k, c) : linearIndexF(K,N, k, c));
-                            dot += static_cast<Z>(alpha) * static_cast<Z>(A[aIdx]) * static_cast<Z>(B[bIdx]);//A[aIdx]nd4j::math::nd4j_dot<T>(aX, bX, K) * alpha;
+                    for (int pc = 0; pc < K; pc += GEMM_KC) {
+                        int kc = nd4j::math::nd4j_min<int>(GEMM_KC, K - pc);
+                        gemmPackB<Y, T>(B + pc * rsB + jc * csB, rsB, csB, kc, nc, packedB);
+
+                        for (int ic = 0; ic < rows; ic += GEMM_MC) {
+                            int mc = nd4j::math::nd4j_min<int>(GEMM_MC, rows - ic);
+                            int mPanels = (mc + GEMM_MR - 1) / GEMM_MR;
+                            gemmPackA<X, T>(A + (ir + ic) * rsA + pc * csA, rsA, csA, mc, kc, alphaT, packedA);
+
+                            auto pA = packedA;
+                            auto pB = packedB;
+
+                            // tiles of P are disjoint, so they're split between threads without any synchronization
+                            PRAGMA_OMP_PARALLEL_FOR_ARGS(collapse(2) if((Nd4jLong) mc * nc * kc > Environment::getInstance()->elementwiseThreshold()))
+                            for (int jp = 0; jp < nPanels; jp++) {
+                                for (int ip = 0; ip < mPanels; ip++) {
+                                    int mr = nd4j::math::nd4j_min<int>(GEMM_MR, mc - ip * GEMM_MR);
+                                    int nr = nd4j::math::nd4j_min<int>(GEMM_NR, nc - jp * GEMM_NR);
+                                    auto c = P + (Nd4jLong) (ic + ip * GEMM_MR) * ldp + jp * GEMM_NR;
+
+                                    kernel(kc, pA + (Nd4jLong) ip * GEMM_MR * kc, pB + (Nd4jLong) jp * GEMM_NR * kc, c, ldp, mr, nr);
+                                }
+                            }
                         }
                     }
 
-                    if (beta != 0.0) {
-                        C[zIdx] = static_cast<Z>(dot + beta * C[zIdx]);
-                    } else {
-                        C[zIdx] = static_cast<Z>(dot);
+                    if (direct)
+                        continue;
+
+                    PRAGMA_OMP_PARALLEL_FOR_IF((Nd4jLong) rows * nc > Environment::getInstance()->elementwiseThreshold())
+                    for (int r = 0; r < rows; r++) {
+                        for (int c = 0; c < nc; c++) {
+                            auto z = C + (ir + r) * rsC + (jc + c) * csC;
+                            auto v = P[(Nd4jLong) r * nc + c];
+
+                            *z = beta == 0.0 ? static_cast<Z>(v) : static_cast<Z>(v + betaT * static_cast<T>(*z));
+                        }
                     }
                 }
             }
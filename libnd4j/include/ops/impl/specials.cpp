@@ -24,6 +24,7 @@
 #include <helpers/shape.h>
 #include <helpers/TAD.h>
 #include <specials.h>
+#include <ops/specials_sort.h>
 #include <dll.h>
 #include <NDArray.h>
 #include <ops/declarable/CustomOperations.h>
@@ -272,25 +273,50 @@ void SpecialMethods<T>::concatCpuGeneric(int dimension, int numArrays, Nd4jPoint
     template<typename T>
     void SpecialMethods<T>::sortGeneric(void *vx, Nd4jLong *xShapeInfo, bool descending) {
         auto x = reinterpret_cast<T *>(vx);
+        auto length = shape::length(xShapeInfo);
 
-        quickSort_parallel(x, xShapeInfo, shape::length(xShapeInfo), omp_get_max_threads(), descending);
+        if (shape::elementWiseStride(xShapeInfo) == 1) {
+            SortEngine::radixSort<T>(x, length, descending, omp_get_max_threads());
+            return;
+        }
+
+        auto buffer = new T[length];
+        SortEngine::gather(x, xShapeInfo, length, buffer);
+        SortEngine::radixSort<T>(buffer, length, descending, omp_get_max_threads());
+        SortEngine::scatter(buffer, x, xShapeInfo, length);
+        delete[] buffer;
     }
 
     template<typename T>
     void SpecialMethods<T>::sortTadGeneric(void *vx, Nd4jLong *xShapeInfo, int *dimension, int dimensionLength, Nd4jLong *tadShapeInfo, Nd4jLong *tadOffsets, bool descending) {
         auto x = reinterpret_cast<T *>(vx);
 
-        //quickSort_parallel(x, xShapeInfo, shape::length(xShapeInfo), omp_get_max_threads(), descending);
         Nd4jLong xLength = shape::length(xShapeInfo);
         Nd4jLong xTadLength = shape::tadLength(xShapeInfo, dimension, dimensionLength);
-        int numTads = xLength / xTadLength;
+        Nd4jLong numTads = xLength / xTadLength;
 
-        PRAGMA_OMP_PARALLEL_FOR
-        for (int r = 0; r < numTads; r++) {
-            T *dx = x + tadOffsets[r];
+        SortEngine::segmentedSort<T, T>(x, tadShapeInfo, tadOffsets, nullptr, nullptr, nullptr, numTads, xTadLength, descending, omp_get_max_threads());
+    }
 
-            quickSort_parallel(dx, tadShapeInfo, xTadLength, 1, descending);
-        }
+    template<typename T>
+    void SpecialMethods<T>::argSortGeneric(void *vx, Nd4jLong *xShapeInfo, Nd4jLong *z, Nd4jLong *zShapeInfo, bool descending) {
+        auto x = reinterpret_cast<T *>(vx);
+        auto length = shape::length(xShapeInfo);
+
+        // keys are sorted as a copy, so x stays intact
+        auto keys = new T[length];
+        auto indices = new Nd4jLong[length];
+        SortEngine::gather(x, xShapeInfo, length, keys);
+
+        PRAGMA_OMP_PARALLEL_FOR_IF(length > Environment::getInstance()->elementwiseThreshold())
+        for (Nd4jLong e = 0; e < length; e++)
+            indices[e] = e;
+
+        SortEngine::radixSort<T, Nd4jLong>(keys, indices, length, descending, omp_get_max_threads());
+        SortEngine::scatter(indices, z, zShapeInfo, length);
+
+        delete[] keys;
+        delete[] indices;
     }
 
 
@@ -0,0 +1,95 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <pointercast.h>
+#include <helpers/shape.h>
+#include <helpers/ConstantTadHelper.h>
+#include <specials.h>
+#include <ops/specials_sort.h>
+#include <dll.h>
+#include <types/types.h>
+
+namespace nd4j {
+
+    // sorts keys K and values V together by K. Strided arrays are copied into contiguous buffers first
+    template <typename K, typename V>
+    static void sortPairs_(K *keys, Nd4jLong *keysShapeInfo, V *values, Nd4jLong *valuesShapeInfo, bool descending) {
+        auto length = shape::length(keysShapeInfo);
+        if (length != shape::length(valuesShapeInfo))
+            throw std::runtime_error("sortByKey/sortByValue: keys and values must have the same length");
+
+        const bool keysLinear = shape::elementWiseStride(keysShapeInfo) == 1;
+        const bool valuesLinear = shape::elementWiseStride(valuesShapeInfo) == 1;
+
+        auto k = keysLinear ? keys : new K[length];
+        auto v = valuesLinear ? values : new V[length];
+
+        if (!keysLinear)
+            SortEngine::gather(keys, keysShapeInfo, length, k);
+
+        if (!valuesLinear)
+            SortEngine::gather(values, valuesShapeInfo, length, v);
+
+        SortEngine::radixSort<K, V>(k, v, length, descending, omp_get_max_threads());
+
+        if (!keysLinear) {
+            SortEngine::scatter(k, keys, keysShapeInfo, length);
+            delete[] k;
+        }
+
+        if (!valuesLinear) {
+            SortEngine::scatter(v, values, valuesShapeInfo, length);
+            delete[] v;
+        }
+    }
+
+    template <typename K, typename V>
+    static void sortTadPairs_(K *keys, Nd4jLong *keysShapeInfo, V *values, Nd4jLong *valuesShapeInfo, int *dimension, int dimensionLength, bool descending) {
+        if (shape::length(keysShapeInfo) != shape::length(valuesShapeInfo))
+            throw std::runtime_error("sortTadByKey/sortTadByValue: keys and values must have the same length");
+
+        auto keysPack = ConstantTadHelper::getInstance()->tadForDimensions(keysShapeInfo, dimension, dimensionLength);
+        auto valuesPack = ConstantTadHelper::getInstance()->tadForDimensions(valuesShapeInfo, dimension, dimensionLength);
+
+        auto tadLength = shape::length(keysPack.primaryShapeInfo());
+        auto numTads = keysPack.numberOfTads();
+
+        SortEngine::segmentedSort<K, V>(keys, keysPack.primaryShapeInfo(), keysPack.primaryOffsets(), values, valuesPack.primaryShapeInfo(), valuesPack.primaryOffsets(),
+                                        numTads, tadLength, descending, omp_get_max_threads());
+    }
+
+    template <typename X, typename Y>
+    void DoubleMethods<X, Y>::sortByKey(void *vx, Nd4jLong *xShapeInfo, void *vy, Nd4jLong *yShapeInfo, bool descending) {
+        sortPairs_<X, Y>(reinterpret_cast<X *>(vx), xShapeInfo, reinterpret_cast<Y *>(vy), yShapeInfo, descending);
+    }
+
+    template <typename X, typename Y>
+    void DoubleMethods<X, Y>::sortByValue(void *vx, Nd4jLong *xShapeInfo, void *vy, Nd4jLong *yShapeInfo, bool descending) {
+        sortPairs_<Y, X>(reinterpret_cast<Y *>(vy), yShapeInfo, reinterpret_cast<X *>(vx), xShapeInfo, descending);
+    }
+
+    template <typename X, typename Y>
+    void DoubleMethods<X, Y>::sortTadByKey(void *vx, Nd4jLong *xShapeInfo, void *vy, Nd4jLong *yShapeInfo, int *dimension, int dimensionLength, bool descending) {
+        sortTadPairs_<X, Y>(reinterpret_cast<X *>(vx), xShapeInfo, reinterpret_cast<Y *>(vy), yShapeInfo, dimension, dimensionLength, descending);
+    }
+
+    template <typename X, typename Y>
+    void DoubleMethods<X, Y>::sortTadByValue(void *vx, Nd4jLong *xShapeInfo, void *vy, Nd4jLong *yShapeInfo, int *dimension, int dimensionLength, bool descending) {
+        sortTadPairs_<Y, X>(reinterpret_cast<Y *>(vy), yShapeInfo, reinterpret_cast<X *>(vx), xShapeInfo, dimension, dimensionLength, descending);
+    }
+
+    BUILD_DOUBLE_TEMPLATE(template class ND4J_EXPORT DoubleMethods, , LIBND4J_TYPES, LIBND4J_TYPES);
+}
@@ -19,6 +19,8 @@
 //
 
 #include <ops/specials_sparse.h>
+#include <ops/specials_sort.h>
+#include <Environment.h>
 #include <dll.h>
 #include <pointercast.h>
 #include <stdio.h>
@@ -211,10 +213,34 @@ namespace nd4j {
         template <typename T>
         void SparseUtils<T>::sortCooIndicesGeneric(Nd4jLong *indices, T *values, Nd4jLong length, int rank) {
 #ifdef _OPENMP
-            coo_quickSort_parallel(indices, values, length, omp_get_max_threads(), rank);
+            int numThreads = omp_get_max_threads();
 #else
-            coo_quickSort_parallel(indices, values, length, 1, rank);
+            int numThreads = 1;
 #endif
+            // permutation is sorted instead of indices themselves, so every move is a single Nd4jLong instead of rank + 1 elements
+            std::vector<Nd4jLong> permutation(length);
+            for (Nd4jLong e = 0; e < length; e++)
+                permutation[e] = e;
+
+            SortEngine::mergeSort(permutation.data(), length, [&](Nd4jLong x, Nd4jLong y) -> bool {
+                return ltIndices(indices, rank, x, y);
+            }, numThreads);
+
+            std::vector<Nd4jLong> sortedIndices(length * rank);
+            std::vector<T> sortedValues(values, values + length);
+
+            PRAGMA_OMP_PARALLEL_FOR_IF(length > Environment::getInstance()->elementwiseThreshold())
+            for (Nd4jLong e = 0; e < length; e++) {
+                auto p = permutation[e];
+                for (int r = 0; r < rank; r++)
+                    sortedIndices[e * rank + r] = indices[p * rank + r];
+            }
+
+            PRAGMA_OMP_PARALLEL_FOR_IF(length > Environment::getInstance()->elementwiseThreshold())
+            for (Nd4jLong e = 0; e < length; e++)
+                values[e] = sortedValues[permutation[e]];
+
+            memcpy(indices, sortedIndices.data(), length * rank * sizeof(Nd4jLong));
         }
 
         BUILD_SINGLE_TEMPLATE(template class ND4J_EXPORT SparseUtils, , LIBND4J_TYPES);
@@ -56,9 +56,27 @@ namespace nd4j {
         static void sortGeneric(void *x, Nd4jLong *xShapeInfo, bool descending);
         static void sortTadGeneric(void *x, Nd4jLong *xShapeInfo, int *dimension, int dimensionLength, Nd4jLong *tadShapeInfo, Nd4jLong *tadOffsets, bool descending);
 
+        /**
+         * This method stores indices that would sort x into z, x itself isn't modified. z must be INT64 array of the same length as x
+         */
+        static void argSortGeneric(void *x, Nd4jLong *xShapeInfo, Nd4jLong *z, Nd4jLong *zShapeInfo, bool descending);
+
         static void decodeBitmapGeneric(void *dx, Nd4jLong N, void *dz, Nd4jLong *zShapeInfo);
         static Nd4jLong encodeBitmapGeneric(void *dx, Nd4jLong *zShapeInfo, Nd4jLong N, int *dz, float threshold);
     };
+
+    /**
+     * Key-value sorts: both arrays are permuted together, ordered either by x (keys) or by y (values). Sorts are stable
+     */
+    template <typename X, typename Y>
+    class ND4J_EXPORT DoubleMethods {
+    public:
+        static void sortByKey(void *x, Nd4jLong *xShapeInfo, void *y, Nd4jLong *yShapeInfo, bool descending);
+        static void sortByValue(void *x, Nd4jLong *xShapeInfo, void *y, Nd4jLong *yShapeInfo, bool descending);
+
+        static void sortTadByKey(void *x, Nd4jLong *xShapeInfo, void *y, Nd4jLong *yShapeInfo, int *dimension, int dimensionLength, bool descending);
+        static void sortTadByValue(void *x, Nd4jLong *xShapeInfo, void *y, Nd4jLong *yShapeInfo, int *dimension, int dimensionLength, bool descending);
+    };
 }
 
 
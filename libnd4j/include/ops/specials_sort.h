@@ -0,0 +1,352 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#ifndef LIBND4J_SPECIALS_SORT_H
+#define LIBND4J_SPECIALS_SORT_H
+
+#include <pointercast.h>
+#include <op_boilerplate.h>
+#include <helpers/shape.h>
+#include <templatemath.h>
+#include <types/float16.h>
+#include <types/bfloat16.h>
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+
+namespace nd4j {
+
+    /**
+     * These traits map keys to unsigned integers of the same width, so that unsigned order of integers matches order of keys:
+     * - unsigned types are used as is
+     * - signed types get their sign bit flipped
+     * - floating point types get sign bit flipped if positive, and all bits flipped if negative
+     */
+    template <typename T, typename U>
+    struct RadixUnsigned {
+        typedef U type;
+
+        static FORCEINLINE U toBits(T value) {
+            U bits = 0;
+            memcpy(&bits, &value, sizeof(T));
+            return bits;
+        }
+
+        static FORCEINLINE T fromBits(U bits) {
+            T value;
+            memcpy(&value, &bits, sizeof(T));
+            return value;
+        }
+    };
+
+    template <typename T, typename U>
+    struct RadixSigned {
+        typedef U type;
+        static const U signBit = static_cast<U>(static_cast<U>(1) << (sizeof(U) * 8 - 1));
+
+        static FORCEINLINE U toBits(T value) {
+            return static_cast<U>(RadixUnsigned<T, U>::toBits(value) ^ signBit);
+        }
+
+        static FORCEINLINE T fromBits(U bits) {
+            return RadixUnsigned<T, U>::fromBits(static_cast<U>(bits ^ signBit));
+        }
+    };
+
+    template <typename T, typename U>
+    struct RadixFloating {
+        typedef U type;
+        static const U signBit = static_cast<U>(static_cast<U>(1) << (sizeof(U) * 8 - 1));
+
+        static FORCEINLINE U toBits(T value) {
+            auto bits = RadixUnsigned<T, U>::toBits(value);
+            return static_cast<U>((bits & signBit) ? ~bits : (bits | signBit));
+        }
+
+        static FORCEINLINE T fromBits(U bits) {
+            return RadixUnsigned<T, U>::fromBits(static_cast<U>((bits & signBit) ? (bits ^ signBit) : ~bits));
+        }
+    };
+
+    template <typename T> struct RadixTraits;
+    template <> struct RadixTraits<bool> : RadixUnsigned<bool, uint8_t> {};
+    template <> struct RadixTraits<uint8_t> : RadixUnsigned<uint8_t, uint8_t> {};
+    template <> struct RadixTraits<uint16_t> : RadixUnsigned<uint16_t, uint16_t> {};
+    template <> struct RadixTraits<uint32_t> : RadixUnsigned<uint32_t, uint32_t> {};
+    template <> struct RadixTraits<Nd4jULong> : RadixUnsigned<Nd4jULong, uint64_t> {};
+    template <> struct RadixTraits<int8_t> : RadixSigned<int8_t, uint8_t> {};
+    template <> struct RadixTraits<int16_t> : RadixSigned<int16_t, uint16_t> {};
+    template <> struct RadixTraits<int32_t> : RadixSigned<int32_t, uint32_t> {};
+    template <> struct RadixTraits<Nd4jLong> : RadixSigned<Nd4jLong, uint64_t> {};
+    template <> struct RadixTraits<float16> : RadixFloating<float16, uint16_t> {};
+    template <> struct RadixTraits<bfloat16> : RadixFloating<bfloat16, uint16_t> {};
+    template <> struct RadixTraits<float> : RadixFloating<float, uint32_t> {};
+    template <> struct RadixTraits<double> : RadixFloating<double, uint64_t> {};
+
+
+    class SortEngine {
+    public:
+        enum {
+            // arrays shorter than this are sorted with insertion sort
+            INSERTION_THRESHOLD = 32,
+            // arrays shorter than this are sorted by single thread
+            PARALLEL_THRESHOLD = 65536,
+            // bits per radix digit
+            RADIX_BITS = 8,
+            RADIX_BUCKETS = 1 << RADIX_BITS,
+        };
+
+        /**
+         * This method returns offset of linear index within array, the same way legacy SpecialMethods::getPosition does
+         */
+        static FORCEINLINE Nd4jLong offset(Nd4jLong *shapeInfo, Nd4jLong ews, Nd4jLong length, Nd4jLong index) {
+            if (ews == 1)
+                return index;
+            else if (ews > 1)
+                return index * ews;
+            else
+                return shape::getIndexOffset(index, shapeInfo, length);
+        }
+
+        /**
+         * This method copies strided array into contiguous buffer
+         */
+        template <typename T>
+        static void gather(const T *x, Nd4jLong *shapeInfo, Nd4jLong length, T *buffer) {
+            auto ews = shape::elementWiseStride(shapeInfo);
+            for (Nd4jLong e = 0; e < length; e++)
+                buffer[e] = x[offset(shapeInfo, ews, length, e)];
+        }
+
+        /**
+         * This method copies contiguous buffer back into strided array
+         */
+        template <typename T>
+        static void scatter(const T *buffer, T *x, Nd4jLong *shapeInfo, Nd4jLong length) {
+            auto ews = shape::elementWiseStride(shapeInfo);
+            for (Nd4jLong e = 0; e < length; e++)
+                x[offset(shapeInfo, ews, length, e)] = buffer[e];
+        }
+
+        /**
+         * This method does stable LSD radix sort of contiguous keys, 8 bits per pass. If values aren't nullptr, they're permuted along with keys.
+         * Every pass is split across threads: each thread builds histogram of its chunk, and scatters its chunk to offsets
+         * given by prefix sum over (digit, thread), which keeps the pass stable. Passes where all keys share the digit are skipped.
+         */
+        template <typename K, typename V>
+        static void radixSort(K *keys, V *values, const Nd4jLong length, const bool descending, int numThreads) {
+            typedef typename RadixTraits<K>::type U;
+
+            if (length < 2)
+                return;
+
+            if (length < PARALLEL_THRESHOLD || numThreads < 1)
+                numThreads = 1;
+
+            const bool withValues = values != nullptr;
+
+            std::vector<U> bits(length);
+            std::vector<U> bitsSwap(length);
+            // plain arrays here, since std::vector<bool> has no data()
+            V *valuesSwap = withValues ? new V[length] : nullptr;
+
+            PRAGMA_OMP_PARALLEL_FOR_THREADS(numThreads)
+            for (Nd4jLong e = 0; e < length; e++) {
+                auto b = RadixTraits<K>::toBits(keys[e]);
+                bits[e] = descending ? static_cast<U>(~b) : b;
+            }
+
+            U *src = bits.data();
+            U *dst = bitsSwap.data();
+            V *vSrc = values;
+            V *vDst = valuesSwap;
+
+            if (length <= INSERTION_THRESHOLD) {
+                for (Nd4jLong i = 1; i < length; i++) {
+                    auto key = src[i];
+                    V value = withValues ? vSrc[i] : V();
+                    auto j = i - 1;
+                    for (; j >= 0 && src[j] > key; j--) {
+                        src[j + 1] = src[j];
+                        if (withValues)
+                            vSrc[j + 1] = vSrc[j];
+                    }
+                    src[j + 1] = key;
+                    if (withValues)
+                        vSrc[j + 1] = value;
+                }
+            } else {
+                const Nd4jLong chunk = (length + numThreads - 1) / numThreads;
+                std::vector<Nd4jLong> histogram(numThreads * RADIX_BUCKETS);
+
+                for (int shift = 0; shift < static_cast<int>(sizeof(U) * 8); shift += RADIX_BITS) {
+                    std::fill(histogram.begin(), histogram.end(), 0);
+
+                    PRAGMA_OMP_PARALLEL_FOR_THREADS(numThreads)
+                    for (int c = 0; c < numThreads; c++) {
+                        auto hist = histogram.data() + c * RADIX_BUCKETS;
+                        auto stop = nd4j::math::nd4j_min<Nd4jLong>(length, (c + 1) * chunk);
+                        for (Nd4jLong e = c * chunk; e < stop; e++)
+                            hist[(src[e] >> shift) & (RADIX_BUCKETS - 1)]++;
+                    }
+
+                    // exclusive offsets, digit-major and thread-minor
+                    bool trivial = false;
+                    Nd4jLong position = 0;
+                    for (int d = 0; d < RADIX_BUCKETS; d++) {
+                        auto start = position;
+                        for (int c = 0; c < numThreads; c++) {
+                            auto count = histogram[c * RADIX_BUCKETS + d];
+                            histogram[c * RADIX_BUCKETS + d] = position;
+                            position += count;
+                        }
+
+                        if (position - start == length)
+                            trivial = true;
+                    }
+
+                    if (trivial)
+                        continue;
+
+                    PRAGMA_OMP_PARALLEL_FOR_THREADS(numThreads)
+                    for (int c = 0; c < numThreads; c++) {
+                        auto offsets = histogram.data() + c * RADIX_BUCKETS;
+                        auto stop = nd4j::math::nd4j_min<Nd4jLong>(length, (c + 1) * chunk);
+                        for (Nd4jLong e = c * chunk; e < stop; e++) {
+                            auto pos = offsets[(src[e] >> shift) & (RADIX_BUCKETS - 1)]++;
+                            dst[pos] = src[e];
+                            if (withValues)
+                                vDst[pos] = vSrc[e];
+                        }
+                    }
+
+                    std::swap(src, dst);
+                    std::swap(vSrc, vDst);
+                }
+            }
+
+            PRAGMA_OMP_PARALLEL_FOR_THREADS(numThreads)
+            for (Nd4jLong e = 0; e < length; e++)
+                keys[e] = RadixTraits<K>::fromBits(descending ? static_cast<U>(~src[e]) : src[e]);
+
+            if (withValues && vSrc != values)
+                std::copy(vSrc, vSrc + length, values);
+
+            delete[] valuesSwap;
+        }
+
+        /**
+         * This method does stable radix sort of contiguous keys only
+         */
+        template <typename K>
+        static void radixSort(K *keys, const Nd4jLong length, const bool descending, int numThreads) {
+            radixSort<K, K>(keys, nullptr, length, descending, numThreads);
+        }
+
+        /**
+         * This method does stable merge sort with arbitrary comparator. Array is split into runs sorted by separate threads,
+         * and then adjacent runs are merged pairwise in parallel, so every round halves number of runs
+         */
+        template <typename T, typename Comparator>
+        static void mergeSort(T *data, const Nd4jLong length, Comparator comparator, int numThreads) {
+            if (length < PARALLEL_THRESHOLD || numThreads < 2) {
+                std::stable_sort(data, data + length, comparator);
+                return;
+            }
+
+            const int numRuns = numThreads;
+            const Nd4jLong chunk = (length + numRuns - 1) / numRuns;
+            std::vector<Nd4jLong> bounds(numRuns + 1);
+            for (int r = 0; r <= numRuns; r++)
+                bounds[r] = nd4j::math::nd4j_min<Nd4jLong>(length, r * chunk);
+
+            PRAGMA_OMP_PARALLEL_FOR_THREADS(numThreads)
+            for (int r = 0; r < numRuns; r++)
+                std::stable_sort(data + bounds[r], data + bounds[r + 1], comparator);
+
+            std::vector<T> buffer(length);
+            T *src = data;
+            T *dst = buffer.data();
+
+            for (int width = 1; width < numRuns; width *= 2) {
+                const int numPairs = (numRuns + 2 * width - 1) / (2 * width);
+
+                PRAGMA_OMP_PARALLEL_FOR_THREADS(numThreads)
+                for (int p = 0; p < numPairs; p++) {
+                    auto lo = bounds[p * 2 * width];
+                    auto mid = bounds[nd4j::math::nd4j_min<int>(numRuns, p * 2 * width + width)];
+                    auto hi = bounds[nd4j::math::nd4j_min<int>(numRuns, p * 2 * width + 2 * width)];
+
+                    // std::merge takes elements from first range on ties, so merge stays stable
+                    std::merge(src + lo, src + mid, src + mid, src + hi, dst + lo, comparator);
+                }
+
+                std::swap(src, dst);
+            }
+
+            if (src != data)
+                std::copy(src, src + length, data);
+        }
+
+        /**
+         * This method sorts many independent segments (i.e. TADs) of the same length. Keys of each segment are addressed through
+         * keyOffsets and keyShapeInfo, values - through valueOffsets and valueShapeInfo, and values can be nullptr.
+         *
+         * Many short segments are sorted by separate threads, few long segments are sorted one by one with all threads
+         */
+        template <typename K, typename V>
+        static void segmentedSort(K *keys, Nd4jLong *keyShapeInfo, Nd4jLong *keyOffsets, V *values, Nd4jLong *valueShapeInfo, Nd4jLong *valueOffsets,
+                                  const Nd4jLong numSegments, const Nd4jLong segmentLength, const bool descending, const int numThreads) {
+
+            const bool keysLinear = shape::elementWiseStride(keyShapeInfo) == 1;
+            const bool valuesLinear = values == nullptr || shape::elementWiseStride(valueShapeInfo) == 1;
+            const bool perSegmentThreads = numSegments >= numThreads || segmentLength < PARALLEL_THRESHOLD;
+
+            PRAGMA_OMP_PARALLEL_FOR_ARGS(OMP_IF(perSegmentThreads && numSegments > 1) schedule(guided))
+            for (Nd4jLong r = 0; r < numSegments; r++) {
+                K *keysBuffer = keysLinear ? nullptr : new K[segmentLength];
+                V *valuesBuffer = valuesLinear ? nullptr : new V[segmentLength];
+
+                K *k = keys + keyOffsets[r];
+                V *v = values == nullptr ? nullptr : values + valueOffsets[r];
+
+                if (!keysLinear) {
+                    gather(k, keyShapeInfo, segmentLength, keysBuffer);
+                    k = keysBuffer;
+                }
+
+                if (!valuesLinear) {
+                    gather(v, valueShapeInfo, segmentLength, valuesBuffer);
+                    v = valuesBuffer;
+                }
+
+                radixSort<K, V>(k, v, segmentLength, descending, perSegmentThreads ? 1 : numThreads);
+
+                if (!keysLinear)
+                    scatter(keysBuffer, keys + keyOffsets[r], keyShapeInfo, segmentLength);
+
+                if (!valuesLinear)
+                    scatter(valuesBuffer, values + valueOffsets[r], valueShapeInfo, segmentLength);
+
+                delete[] keysBuffer;
+                delete[] valuesBuffer;
+            }
+        }
+    };
+}
+
+#endif //LIBND4J_SPECIALS_SORT_H
@@ -20,6 +20,7 @@
 
 #include "GraphServer.h"
 #include <graph/GraphHolder.h>
+#include <graph/ExecutionResult.h>
 #include <GraphExecutioner.h>
 #include <graph/generated/result_generated.h>
 #include <helpers/StringUtils.h>
@@ -35,6 +36,25 @@
 
 namespace nd4j {
     namespace graph {
+            GraphInferenceServerImpl::GraphInferenceServerImpl(int maxBatchSize, Nd4jLong maxDelay) {
+                _maxBatchSize = maxBatchSize;
+                _maxDelay = maxDelay;
+            }
+
+            std::shared_ptr<RequestBatcher> GraphInferenceServerImpl::batcher(Nd4jLong graphId) {
+                std::lock_guard<std::mutex> lock(_mutex);
+
+                if (_batchers.count(graphId) == 0)
+                    _batchers[graphId] = std::make_shared<RequestBatcher>(graphId, _maxBatchSize, _maxDelay);
+
+                return _batchers[graphId];
+            }
+
+            void GraphInferenceServerImpl::forgetBatcher(Nd4jLong graphId) {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _batchers.erase(graphId);
+            }
+
             grpc::Status GraphInferenceServerImpl::RegisterGraph( grpc::ServerContext *context, const flatbuffers::grpc::Message<FlatGraph> *request_msg, flatbuffers::grpc::Message<FlatResponse> *response_msg) {
                 auto flat_graph = request_msg->GetRoot();
 
@@ -45,10 +65,11 @@ namespace nd4j {
                     // single data type for now
                     GraphHolder::getInstance()->registerGraph<float>(flat_graph->id(), graph);
 
-                    // sending out OK response
-                    auto response_offset = CreateFlatResponse(mb_, 0);
-                    mb_.Finish(response_offset);
-                    *response_msg = mb_.ReleaseMessage<FlatResponse>();
+                    // sending out OK response, calls are served concurrently, so each one gets its own builder
+                    flatbuffers::grpc::MessageBuilder mb;
+                    auto response_offset = CreateFlatResponse(mb, 0);
+                    mb.Finish(response_offset);
+                    *response_msg = mb.ReleaseMessage<FlatResponse>();
                     assert(response_msg->Verify());
 
                     return grpc::Status::OK;
@@ -68,10 +89,14 @@ namespace nd4j {
                     // single data type for now
                     GraphHolder::getInstance()->replaceGraph(flat_graph->id(), graph);
 
-                    // sending out OK response
-                    auto response_offset = CreateFlatResponse(mb_, 0);
-                    mb_.Finish(response_offset);
-                    *response_msg = mb_.ReleaseMessage<FlatResponse>();
+                    // batching verdict of the old graph says nothing about the new one
+                    forgetBatcher(flat_graph->id());
+
+                    // sending out OK response, calls are served concurrently, so each one gets its own builder
+                    flatbuffers::grpc::MessageBuilder mb;
+                    auto response_offset = CreateFlatResponse(mb, 0);
+                    mb.Finish(response_offset);
+                    *response_msg = mb.ReleaseMessage<FlatResponse>();
                     assert(response_msg->Verify());
 
                     return grpc::Status::OK;
@@ -92,11 +117,13 @@ namespace nd4j {
 
                     // dropping out graph (any datatype)
                     GraphHolder::getInstance()->dropGraphAny(request->id());
+                    forgetBatcher(request->id());
 
-                    // sending out OK response
-                    auto response_offset = CreateFlatResponse(mb_, 0);
-                    mb_.Finish(response_offset);
-                    *response_msg = mb_.ReleaseMessage<FlatResponse>();
+                    // sending out OK response, calls are served concurrently, so each one gets its own builder
+                    flatbuffers::grpc::MessageBuilder mb;
+                    auto response_offset = CreateFlatResponse(mb, 0);
+                    mb.Finish(response_offset);
+                    *response_msg = mb.ReleaseMessage<FlatResponse>();
                     assert(response_msg->Verify());
 
                     return grpc::Status::OK;
@@ -109,12 +136,49 @@ namespace nd4j {
             grpc::Status GraphInferenceServerImpl::InferenceRequest( grpc::ServerContext *context, const flatbuffers::grpc::Message<FlatInferenceRequest> *request_msg, flatbuffers::grpc::Message<FlatResult> *response_msg) {
                 auto request = request_msg->GetRoot();
 
-                try {
-                    // GraphHolder
-                    auto response_offset = GraphHolder::getInstance()->execute(request->id(), mb_, request);
+                // requests are served concurrently, so each one gets its own builder
+                flatbuffers::grpc::MessageBuilder mb;
 
-                    mb_.Finish(response_offset);
-                    *response_msg = mb_.ReleaseMessage<FlatResult>();
+                try {
+                    if (_maxBatchSize > 1) {
+                        if (!GraphHolder::getInstance()->hasGraph(request->id()))
+                            throw unknown_graph_exception(request->id());
+
+                        std::vector<Variable*> inputs;
+                        if (request->variables() != nullptr)
+                            for (int e = 0; e < (int) request->variables()->size(); e++)
+                                inputs.emplace_back(new Variable(request->variables()->Get(e)));
+
+                        std::vector<Variable*>* outputs = nullptr;
+                        try {
+                            outputs = batcher(request->id())->execute(inputs);
+                        } catch (...) {
+                            for (auto v: inputs)
+                                delete v;
+                            throw;
+                        }
+
+                        for (auto v: inputs)
+                            delete v;
+
+                        ExecutionResult result;
+                        for (auto v: *outputs)
+                            result.emplace_back(v);
+
+                        auto response_offset = result.asFlatResult(mb);
+
+                        for (auto v: *outputs)
+                            delete v;
+                        delete outputs;
+
+                        mb.Finish(response_offset);
+                    } else {
+                        // GraphHolder
+                        auto response_offset = GraphHolder::getInstance()->execute(request->id(), mb, request);
+                        mb.Finish(response_offset);
+                    }
+
+                    *response_msg = mb.ReleaseMessage<FlatResult>();
                     assert(response_msg->Verify());
 
                     return grpc::Status::OK;
@@ -135,13 +199,13 @@ namespace nd4j {
     }
 }
 
-void RunServer(int port) {
+void RunServer(int port, int maxBatchSize, Nd4jLong maxDelay) {
   assert(port > 0 && port < 65535);
 
   std::string server_address("0.0.0.0:");
   server_address += nd4j::StringUtils::valueToString<int>(port);
 
-  nd4j::graph::GraphInferenceServerImpl service;
+  nd4j::graph::GraphInferenceServerImpl service(maxBatchSize, maxDelay);
   auto registrator = nd4j::ops::OpRegistrator::getInstance();
 
   grpc::ServerBuilder builder;
@@ -171,6 +235,7 @@ int main(int argc, char *argv[]) {
      * 1) port number
      * 2) if we should use gprc, json, or both
      * 3) if there's any graph(s) provided at startup
+     * 4) if concurrent requests should be batched
      */
      int port = 40123;
      if(cmdOptionExists(argv, argv+argc, "-p")) {
@@ -184,7 +249,19 @@ int main(int argc, char *argv[]) {
         nd4j::graph::GraphHolder::getInstance()->registerGraph<float>(0L, graph);
     }
 
-    RunServer(port);
+    int maxBatchSize = 1;
+    if(cmdOptionExists(argv, argv+argc, "-b")) {
+        auto sBatch = getCmdOption(argv, argv + argc, "-b");
+        maxBatchSize = atoi(sBatch);
+    }
+
+    Nd4jLong maxDelay = 1000;
+    if(cmdOptionExists(argv, argv+argc, "-d")) {
+        auto sDelay = getCmdOption(argv, argv + argc, "-d");
+        maxDelay = atol(sDelay);
+    }
+
+    RunServer(port, maxBatchSize, maxDelay);
 
     return 0;
 }
\ No newline at end of file
@@ -22,6 +22,10 @@
 #include <grpc++/grpc++.h>
 #include <NDArray.h>
 #include <graph/Graph.h>
+#include <graph/RequestBatcher.h>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <ops/declarable/CustomOperations.h>
 
 #include <graph/generated/graph.grpc.fb.h>
@@ -30,8 +34,24 @@ namespace nd4j {
     namespace graph {
         class GraphInferenceServerImpl final : public GraphInferenceServer::Service {
         private:
-            flatbuffers::grpc::MessageBuilder mb_;
+            // requests batching: disabled if max batch size is 1
+            int _maxBatchSize;
+            Nd4jLong _maxDelay;
+
+            std::mutex _mutex;
+            // batchers are shared with requests in flight, so forgetting graph doesn't pull batcher from under them
+            std::map<Nd4jLong, std::shared_ptr<RequestBatcher>> _batchers;
+
+            std::shared_ptr<RequestBatcher> batcher(Nd4jLong graphId);
+            void forgetBatcher(Nd4jLong graphId);
         public:
+            /**
+             * @param maxBatchSize - maximal number of concurrent inference requests coalesced into single execution
+             * @param maxDelay - maximal time in microseconds request waits for others to join its batch
+             */
+            explicit GraphInferenceServerImpl(int maxBatchSize = 1, Nd4jLong maxDelay = 1000);
+            ~GraphInferenceServerImpl() = default;
+
             virtual grpc::Status RegisterGraph( grpc::ServerContext *context, const flatbuffers::grpc::Message<FlatGraph> *request_msg, flatbuffers::grpc::Message<FlatResponse> *response_msg);
 
             virtual grpc::Status ForgetGraph( grpc::ServerContext *context, const flatbuffers::grpc::Message<FlatDropRequest> *request_msg, flatbuffers::grpc::Message<FlatResponse> *response_msg);
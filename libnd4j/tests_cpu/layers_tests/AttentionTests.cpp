@@ -212,4 +212,104 @@ TEST_F(AttentionTests, basic_multi_head_dot_product_bp_attention_with_mask) {
     ASSERT_EQ(Status::OK(), result->status());
 
     delete result;
-}
\ No newline at end of file
+}
+
+TEST_F(AttentionTests, fused_dot_product_attention_1) {
+    // several blocks of queries and keys, with some timesteps masked
+    auto keys = NDArrayFactory::create<float>('c', {2, 4, 100});
+    auto values = NDArrayFactory::create<float>('c', {2, 3, 100});
+    auto queries = NDArrayFactory::create<float>('c', {2, 4, 40});
+    auto mask = NDArrayFactory::create<float>('c', {2, 100});
+    keys.linspace(-1.f, 0.0025f);
+    values.linspace(1.f, -0.003f);
+    queries.linspace(0.5f, -0.004f);
+    mask.assign(1.);
+    for (int e = 0; e < 70; e += 3)
+        mask.p(e, 0.f);
+
+    nd4j::ops::dot_product_attention op;
+    auto expected = op.execute({&queries, &keys, &values, &mask}, {}, {1, 0}, {});
+    ASSERT_EQ(Status::OK(), expected->status());
+
+    nd4j::ops::fused_dot_product_attention fused;
+    auto result = fused.execute({&queries, &keys, &values, &mask}, {}, {1}, {});
+    ASSERT_EQ(Status::OK(), result->status());
+
+    ASSERT_TRUE(expected->at(0)->isSameShape(result->at(0)));
+    ASSERT_TRUE(expected->at(0)->equalsTo(result->at(0), 1e-5));
+
+    delete expected;
+    delete result;
+}
+
+TEST_F(AttentionTests, fused_dot_product_attention_bp_1) {
+    auto keys = NDArrayFactory::create<float>('c', {2, 3, 4, 70});
+    auto values = NDArrayFactory::create<float>('c', {2, 3, 5, 70});
+    auto queries = NDArrayFactory::create<float>('c', {2, 3, 4, 35});
+    auto eps = NDArrayFactory::create<float>('c', {2, 3, 5, 35});
+    auto mask = NDArrayFactory::create<float>('c', {2, 70});
+    keys.linspace(-1.f, 0.001f);
+    values.linspace(1.f, -0.001f);
+    queries.linspace(0.5f, -0.0015f);
+    eps.linspace(-0.3f, 0.001f);
+    mask.assign(1.);
+    mask.p(5, 0.f);
+    mask.p(100, 0.f);
+
+    nd4j::ops::dot_product_attention_bp op;
+    auto expected = op.execute({&queries, &keys, &values, &eps, &mask}, {}, {1}, {});
+    ASSERT_EQ(Status::OK(), expected->status());
+
+    nd4j::ops::fused_dot_product_attention_bp fused;
+    auto result = fused.execute({&queries, &keys, &values, &eps, &mask}, {}, {1}, {});
+    ASSERT_EQ(Status::OK(), result->status());
+
+    for (int e = 0; e < 3; e++)
+        ASSERT_TRUE(expected->at(e)->equalsTo(result->at(e), 1e-5));
+
+    delete expected;
+    delete result;
+}
+
+TEST_F(AttentionTests, fused_multi_head_dot_product_attention_1) {
+    // self-attention, so queries, keys and values are projected at once
+    auto input = NDArrayFactory::create<float>('c', {3, 4, 50});
+    auto Wq = NDArrayFactory::create<float>('c', {2, 3, 4});
+    auto Wk = NDArrayFactory::create<float>('c', {2, 3, 4});
+    auto Wv = NDArrayFactory::create<float>('c', {2, 5, 4});
+    auto Wo = NDArrayFactory::create<float>('c', {2 * 5, 7});
+    auto mask = NDArrayFactory::create<float>('c', {3, 50});
+    input.linspace(-1.f, 0.003f);
+    Wq.linspace(0.5f, -0.04f);
+    Wk.linspace(-0.5f, 0.03f);
+    Wv.linspace(0.2f, -0.01f);
+    Wo.linspace(-0.3f, 0.01f);
+    mask.assign(1.);
+    mask.p(7, 0.f);
+
+    nd4j::ops::multi_head_dot_product_attention op;
+    auto expected = op.execute({&input, &input, &input, &Wq, &Wk, &Wv, &Wo, &mask}, {}, {1, 0}, {});
+    ASSERT_EQ(Status::OK(), expected->status());
+
+    nd4j::ops::fused_multi_head_dot_product_attention fused;
+    auto result = fused.execute({&input, &input, &input, &Wq, &Wk, &Wv, &Wo, &mask}, {}, {1}, {});
+    ASSERT_EQ(Status::OK(), result->status());
+
+    ASSERT_TRUE(expected->at(0)->isSameShape(result->at(0)));
+    ASSERT_TRUE(expected->at(0)->equalsTo(result->at(0), 1e-5));
+
+    // different queries take separate projection
+    auto queries = NDArrayFactory::create<float>('c', {3, 4, 20});
+    queries.linspace(0.7f, -0.01f);
+
+    auto expected2 = op.execute({&queries, &input, &input, &Wq, &Wk, &Wv, &Wo}, {}, {1, 0}, {});
+    auto result2 = fused.execute({&queries, &input, &input, &Wq, &Wk, &Wv, &Wo}, {}, {1}, {});
+    ASSERT_EQ(Status::OK(), expected2->status());
+    ASSERT_EQ(Status::OK(), result2->status());
+    ASSERT_TRUE(expected2->at(0)->equalsTo(result2->at(0), 1e-5));
+
+    delete expected;
+    delete result;
+    delete expected2;
+    delete result2;
+}
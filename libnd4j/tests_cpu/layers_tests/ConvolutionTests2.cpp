@@ -314,6 +314,311 @@ TEST_F(ConvolutionTests2, sconv2d_bp_2) {
     ASSERT_EQ(Status::OK(), status);    
 }
 
+//////////////////////////////////////////////////////////////////////
+// zero im2col limit sends arrays of the same type through implicit GEMM, double input makes conv2d fall back to im2col path
+TEST_F(ConvolutionTests2, conv2d_implicit_gemm_1) {
+
+    int bS=2, iH=11,iW=9,  iC=3,oC=5,  kH=3,kW=2,  sH=2,sW=1,  pH=0,pW=0,  dH=2,dW=2;
+    int       oH=6,oW=9;
+    int paddingMode = 1;             // 1-SAME, 0-VALID;
+
+    const auto limit = Environment::getInstance()->im2colLimit();
+    Environment::getInstance()->setIm2colLimit(0);
+
+    for (int dataFormat = 0; dataFormat < 2; dataFormat++) {     // 1-NHWC, 0-NCHW
+        std::vector<Nd4jLong> inShape  = dataFormat ? std::vector<Nd4jLong>({bS, iH, iW, iC}) : std::vector<Nd4jLong>({bS, iC, iH, iW});
+        std::vector<Nd4jLong> outShape = dataFormat ? std::vector<Nd4jLong>({bS, oH, oW, oC}) : std::vector<Nd4jLong>({bS, oC, oH, oW});
+
+        NDArray input('c', inShape, nd4j::DataType::FLOAT32);
+        NDArray inputD('c', inShape, nd4j::DataType::DOUBLE);
+        NDArray weights('c', {kH, kW, iC, oC}, nd4j::DataType::FLOAT32);
+        NDArray bias('c', {oC}, {1,2,3,4,5}, nd4j::DataType::FLOAT32);
+        NDArray gradO('c', outShape, nd4j::DataType::FLOAT32);
+
+        input.linspace(-1., 0.01);
+        inputD.linspace(-1., 0.01);
+        weights.linspace(-0.5, 0.03);
+        gradO.linspace(0.5, -0.01);
+
+        NDArray output('c', outShape, nd4j::DataType::FLOAT32);
+        NDArray expOutput('c', outShape, nd4j::DataType::FLOAT32);
+
+        nd4j::ops::conv2d op;
+        ASSERT_EQ(Status::OK(), op.execute({&input, &weights, &bias}, {&output}, {}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, dataFormat}, {}));
+        ASSERT_EQ(Status::OK(), op.execute({&inputD, &weights, &bias}, {&expOutput}, {}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, dataFormat}, {}));
+
+        ASSERT_TRUE(expOutput.equalsTo(output));
+
+        NDArray gradI('c', inShape, nd4j::DataType::FLOAT32);
+        NDArray gradW('c', {kH, kW, iC, oC}, nd4j::DataType::FLOAT32);
+        NDArray gradB('c', {oC}, nd4j::DataType::FLOAT32);
+        NDArray expGradI('c', inShape, nd4j::DataType::FLOAT32);
+        NDArray expGradW('c', {kH, kW, iC, oC}, nd4j::DataType::FLOAT32);
+        NDArray expGradB('c', {oC}, nd4j::DataType::FLOAT32);
+
+        nd4j::ops::conv2d_bp opBP;
+        ASSERT_EQ(Status::OK(), opBP.execute({&input, &weights, &bias, &gradO}, {&gradI, &gradW, &gradB}, {}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, dataFormat}, {}));
+        ASSERT_EQ(Status::OK(), opBP.execute({&inputD, &weights, &bias, &gradO}, {&expGradI, &expGradW, &expGradB}, {}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, dataFormat}, {}));
+
+        ASSERT_TRUE(expGradI.equalsTo(gradI));
+        ASSERT_TRUE(expGradW.equalsTo(gradW));
+        ASSERT_TRUE(expGradB.equalsTo(gradB));
+    }
+
+    Environment::getInstance()->setIm2colLimit(limit);
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(ConvolutionTests2, conv3d_implicit_gemm_1) {
+
+    int bS=2, iD=5,iH=6,iW=4,  iC=2,oC=3,  kD=2,kH=3,kW=2,  sD=2,sH=1,sW=1,  pD=0,pH=0,pW=0,  dD=1,dH=1,dW=2;
+    int       oD=2,oH=4,oW=2;
+    int paddingMode = 0;             // 1-SAME, 0-VALID;
+    int dataFormat  = 0;             // 1-NDHWC, 0-NCDHW
+
+    NDArray input('c', {bS, iC, iD, iH, iW}, nd4j::DataType::FLOAT32);
+    NDArray inputD('c', {bS, iC, iD, iH, iW}, nd4j::DataType::DOUBLE);
+    NDArray weights('c', {kD, kH, kW, iC, oC}, nd4j::DataType::FLOAT32);
+    NDArray bias('c', {oC}, {1,2,3}, nd4j::DataType::FLOAT32);
+
+    input.linspace(-1., 0.01);
+    inputD.linspace(-1., 0.01);
+    weights.linspace(-0.5, 0.02);
+
+    NDArray output('c', {bS, oC, oD, oH, oW}, nd4j::DataType::FLOAT32);
+    NDArray expOutput('c', {bS, oC, oD, oH, oW}, nd4j::DataType::FLOAT32);
+
+    const auto limit = Environment::getInstance()->im2colLimit();
+    Environment::getInstance()->setIm2colLimit(0);
+
+    nd4j::ops::conv3dnew op;
+    ASSERT_EQ(Status::OK(), op.execute({&input, &weights, &bias}, {&output}, {}, {kD,kH,kW,  sD,sH,sW,  pD,pH,pW,  dD,dH,dW, paddingMode, dataFormat}, {}));
+    ASSERT_EQ(Status::OK(), op.execute({&inputD, &weights, &bias}, {&expOutput}, {}, {kD,kH,kW,  sD,sH,sW,  pD,pH,pW,  dD,dH,dW, paddingMode, dataFormat}, {}));
+
+    Environment::getInstance()->setIm2colLimit(limit);
+
+    ASSERT_TRUE(expOutput.equalsTo(output));
+}
+
+//////////////////////////////////////////////////////////////////////
+// implicit GEMM forward and backprop in both data formats vs vol2col path on the same arrays
+TEST_F(ConvolutionTests2, conv3d_implicit_gemm_2) {
+
+    int bS=2, iD=5,iH=6,iW=4,  iC=3,oC=4,  kD=2,kH=3,kW=2,  sD=1,sH=2,sW=1,  pD=0,pH=0,pW=0,  dD=2,dH=1,dW=1;
+    int       oD=5,oH=3,oW=4;
+    int paddingMode = 1;             // 1-SAME, 0-VALID;
+
+    const auto limit = Environment::getInstance()->im2colLimit();
+
+    for (int dataFormat = 0; dataFormat < 2; dataFormat++) {     // 1-NDHWC, 0-NCDHW
+        std::vector<Nd4jLong> inShape  = dataFormat ? std::vector<Nd4jLong>({bS, iD, iH, iW, iC}) : std::vector<Nd4jLong>({bS, iC, iD, iH, iW});
+        std::vector<Nd4jLong> outShape = dataFormat ? std::vector<Nd4jLong>({bS, oD, oH, oW, oC}) : std::vector<Nd4jLong>({bS, oC, oD, oH, oW});
+
+        NDArray input('c', inShape, nd4j::DataType::FLOAT32);
+        NDArray weights('c', {kD, kH, kW, iC, oC}, nd4j::DataType::FLOAT32);
+        NDArray bias('c', {oC}, {1,2,3,4}, nd4j::DataType::FLOAT32);
+        NDArray gradO('c', outShape, nd4j::DataType::FLOAT32);
+
+        input.linspace(-1., 0.007);
+        weights.linspace(-0.5, 0.01);
+        gradO.linspace(0.5, -0.005);
+
+        NDArray output('c', outShape, nd4j::DataType::FLOAT32);
+        NDArray gradI('c', inShape, nd4j::DataType::FLOAT32);
+        NDArray gradW('c', {kD, kH, kW, iC, oC}, nd4j::DataType::FLOAT32);
+        NDArray gradB('c', {oC}, nd4j::DataType::FLOAT32);
+
+        NDArray expOutput('c', outShape, nd4j::DataType::FLOAT32);
+        NDArray expGradI('c', inShape, nd4j::DataType::FLOAT32);
+        NDArray expGradW('c', {kD, kH, kW, iC, oC}, nd4j::DataType::FLOAT32);
+        NDArray expGradB('c', {oC}, nd4j::DataType::FLOAT32);
+
+        nd4j::ops::conv3dnew op;
+        nd4j::ops::conv3dnew_bp opBP;
+
+        // columns of this test are tiny, any non-zero limit keeps them on vol2col path
+        Environment::getInstance()->setIm2colLimit(1024L * 1024L);
+        ASSERT_EQ(Status::OK(), op.execute({&input, &weights, &bias}, {&expOutput}, {}, {kD,kH,kW,  sD,sH,sW,  pD,pH,pW,  dD,dH,dW, paddingMode, dataFormat}, {}));
+        ASSERT_EQ(Status::OK(), opBP.execute({&input, &weights, &bias, &gradO}, {&expGradI, &expGradW, &expGradB}, {}, {kD,kH,kW,  sD,sH,sW,  pD,pH,pW,  dD,dH,dW, paddingMode, dataFormat}, {}));
+
+        Environment::getInstance()->setIm2colLimit(0);
+        ASSERT_EQ(Status::OK(), op.execute({&input, &weights, &bias}, {&output}, {}, {kD,kH,kW,  sD,sH,sW,  pD,pH,pW,  dD,dH,dW, paddingMode, dataFormat}, {}));
+        ASSERT_EQ(Status::OK(), opBP.execute({&input, &weights, &bias, &gradO}, {&gradI, &gradW, &gradB}, {}, {kD,kH,kW,  sD,sH,sW,  pD,pH,pW,  dD,dH,dW, paddingMode, dataFormat}, {}));
+
+        Environment::getInstance()->setIm2colLimit(limit);
+
+        ASSERT_TRUE(expOutput.equalsTo(output));
+        ASSERT_TRUE(expGradI.equalsTo(gradI));
+        ASSERT_TRUE(expGradW.equalsTo(gradW));
+        ASSERT_TRUE(expGradB.equalsTo(gradB));
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+// 3x3 stride-1 float convolutions go through Winograd, double input makes conv2d fall back to im2col path
+TEST_F(ConvolutionTests2, conv2d_winograd_1) {
+
+    int bS=2, iC=6,oC=4,  kH=3,kW=3,  sH=1,sW=1,  pH=0,pW=0,  dH=1,dW=1;
+
+    // 5x5 input is done with F(2x2, 3x3), 13x11 with F(4x4, 3x3)
+    for (int iH: {5, 13}) {
+        int iW = iH - 2 * (iH / 12);
+        for (int paddingMode = 0; paddingMode < 2; paddingMode++) {     // 1-SAME, 0-VALID;
+            for (int dataFormat = 0; dataFormat < 2; dataFormat++) {     // 1-NHWC, 0-NCHW
+                int oH = paddingMode ? iH : iH - 2;
+                int oW = paddingMode ? iW : iW - 2;
+
+                std::vector<Nd4jLong> inShape  = dataFormat ? std::vector<Nd4jLong>({bS, iH, iW, iC}) : std::vector<Nd4jLong>({bS, iC, iH, iW});
+                std::vector<Nd4jLong> outShape = dataFormat ? std::vector<Nd4jLong>({bS, oH, oW, oC}) : std::vector<Nd4jLong>({bS, oC, oH, oW});
+
+                NDArray input('c', inShape, nd4j::DataType::FLOAT32);
+                NDArray inputD('c', inShape, nd4j::DataType::DOUBLE);
+                NDArray weights('c', {kH, kW, iC, oC}, nd4j::DataType::FLOAT32);
+                NDArray bias('c', {oC}, {1,2,3,4}, nd4j::DataType::FLOAT32);
+
+                input.linspace(-1., 0.003);
+                inputD.linspace(-1., 0.003);
+                weights.linspace(-0.5, 0.005);
+
+                NDArray output('c', outShape, nd4j::DataType::FLOAT32);
+                NDArray expOutput('c', outShape, nd4j::DataType::FLOAT32);
+
+                nd4j::ops::conv2d op;
+                ASSERT_EQ(Status::OK(), op.execute({&input, &weights, &bias}, {&output}, {}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, dataFormat}, {}));
+                ASSERT_EQ(Status::OK(), op.execute({&inputD, &weights, &bias}, {&expOutput}, {}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, dataFormat}, {}));
+
+                ASSERT_TRUE(expOutput.equalsTo(output, 1e-4));
+            }
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(ConvolutionTests2, conv2d_winograd_filter_cache_1) {
+
+    int bS=1, iH=10,iW=10,  iC=3,oC=2;
+
+    NDArray input('c', {bS, iC, iH, iW}, nd4j::DataType::FLOAT32);
+    NDArray weights('c', {3, 3, iC, oC}, nd4j::DataType::FLOAT32);
+    NDArray output('c', {bS, oC, iH, iW}, nd4j::DataType::FLOAT32);
+    NDArray expOutput('c', {bS, oC, iH, iW}, nd4j::DataType::FLOAT32);
+    input.linspace(0.1, 0.01);
+    weights.linspace(-0.2, 0.01);
+
+    const Nd4jLong numBytes = 36 * iC * oC * sizeof(float);
+
+    // graph builds new Context from node prototype for every execution, transformed filter must survive that
+    ContextPrototype prototype(nullptr, 1);
+    Context block(&prototype, nullptr);
+    ConvolutionUtils::conv2d(block, &input, &weights, nullptr, &output, 3,3, 1,1, 0,0, 1,1, 1, 1);
+    ASSERT_FALSE(block.getWinogradFilter().checkAndReset(&weights, 4, numBytes));
+
+    Context next(&prototype, nullptr);
+    ASSERT_EQ(&block.getWinogradFilter(), &next.getWinogradFilter());
+    ASSERT_FALSE(next.getWinogradFilter().checkAndReset(&weights, 4, numBytes));
+
+    // content isn't checked, in-place weights update has to be followed by reset()
+    weights *= 2.f;
+    ASSERT_FALSE(next.getWinogradFilter().checkAndReset(&weights, 4, numBytes));
+    next.getWinogradFilter().reset();
+
+    ConvolutionUtils::conv2d(next, &input, &weights, nullptr, &output, 3,3, 1,1, 0,0, 1,1, 1, 1);
+    ASSERT_FALSE(next.getWinogradFilter().checkAndReset(&weights, 4, numBytes));
+
+    // new weights buffer is noticed
+    NDArray other('c', {3, 3, iC, oC}, nd4j::DataType::FLOAT32);
+    other.assign(weights);
+    ASSERT_TRUE(next.getWinogradFilter().checkAndReset(&other, 4, numBytes));
+    next.getWinogradFilter().reset();
+
+    Context fresh(2);
+    ConvolutionUtils::conv2d(fresh, &input, &weights, nullptr, &expOutput, 3,3, 1,1, 0,0, 1,1, 1, 1);
+
+    ASSERT_TRUE(expOutput.equalsTo(output));
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(ConvolutionTests2, depthwise_conv2d_direct_1) {
+
+    int bS=2, iH=10,iW=9,  iC=4,mC=2,  kH=3,kW=3,  sH=2,sW=1,  pH=0,pW=0,  dH=1,dW=1;
+    int       oC=iC*mC, oH=5,oW=9;
+    int paddingMode = 1;             // 1-SAME, 0-VALID;
+
+    for (int dataFormat = 0; dataFormat < 2; dataFormat++) {     // 1-NHWC, 0-NCHW
+        std::vector<Nd4jLong> inShape  = dataFormat ? std::vector<Nd4jLong>({bS, iH, iW, iC}) : std::vector<Nd4jLong>({bS, iC, iH, iW});
+        std::vector<Nd4jLong> outShape = dataFormat ? std::vector<Nd4jLong>({bS, oH, oW, oC}) : std::vector<Nd4jLong>({bS, oC, oH, oW});
+
+        NDArray input('c', inShape, nd4j::DataType::FLOAT32);
+        NDArray inputD('c', inShape, nd4j::DataType::DOUBLE);
+        NDArray weights('c', {kH, kW, iC, mC}, nd4j::DataType::FLOAT32);
+        NDArray bias('c', {oC}, {1,2,3,4,5,6,7,8}, nd4j::DataType::FLOAT32);
+        NDArray gradO('c', outShape, nd4j::DataType::FLOAT32);
+
+        input.linspace(-1., 0.01);
+        inputD.linspace(-1., 0.01);
+        weights.linspace(-0.5, 0.03);
+        gradO.linspace(0.5, -0.01);
+
+        NDArray output('c', outShape, nd4j::DataType::FLOAT32);
+        NDArray expOutput('c', outShape, nd4j::DataType::FLOAT32);
+
+        // mixed types go through im2col, so the second run gives reference results
+        nd4j::ops::depthwise_conv2d op;
+        ASSERT_EQ(Status::OK(), op.execute({&input, &weights, &bias}, {&output}, {}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, dataFormat}, {}));
+        ASSERT_EQ(Status::OK(), op.execute({&inputD, &weights, &bias}, {&expOutput}, {}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, dataFormat}, {}));
+
+        ASSERT_TRUE(expOutput.equalsTo(output));
+
+        NDArray gradI('c', inShape, nd4j::DataType::FLOAT32);
+        NDArray gradW('c', {kH, kW, iC, mC}, nd4j::DataType::FLOAT32);
+        NDArray gradB('c', {oC}, nd4j::DataType::FLOAT32);
+        NDArray expGradI('c', inShape, nd4j::DataType::FLOAT32);
+        NDArray expGradW('c', {kH, kW, iC, mC}, nd4j::DataType::FLOAT32);
+        NDArray expGradB('c', {oC}, nd4j::DataType::FLOAT32);
+
+        nd4j::ops::depthwise_conv2d_bp opBP;
+        ASSERT_EQ(Status::OK(), opBP.execute({&input, &weights, &bias, &gradO}, {&gradI, &gradW, &gradB}, {}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, dataFormat}, {}));
+        ASSERT_EQ(Status::OK(), opBP.execute({&inputD, &weights, &bias, &gradO}, {&expGradI, &expGradW, &expGradB}, {}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, dataFormat}, {}));
+
+        ASSERT_TRUE(expGradI.equalsTo(gradI));
+        ASSERT_TRUE(expGradW.equalsTo(gradW));
+        ASSERT_TRUE(expGradB.equalsTo(gradB));
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(ConvolutionTests2, sconv2d_fused_1) {
+
+    int bS=2, iH=7,iW=8,  iC=3,mC=2,oC=5,  kH=3,kW=3,  sH=1,sW=2,  pH=0,pW=0,  dH=1,dW=1;
+    int       oH=7,oW=4;
+    int paddingMode = 1;             // 1-SAME, 0-VALID;
+
+    for (int dataFormat = 0; dataFormat < 2; dataFormat++) {     // 1-NHWC, 0-NCHW
+        std::vector<Nd4jLong> inShape  = dataFormat ? std::vector<Nd4jLong>({bS, iH, iW, iC}) : std::vector<Nd4jLong>({bS, iC, iH, iW});
+        std::vector<Nd4jLong> outShape = dataFormat ? std::vector<Nd4jLong>({bS, oH, oW, oC}) : std::vector<Nd4jLong>({bS, oC, oH, oW});
+
+        NDArray input('c', inShape, nd4j::DataType::FLOAT32);
+        NDArray inputD('c', inShape, nd4j::DataType::DOUBLE);
+        NDArray weightsDepth('c', {kH, kW, iC, mC}, nd4j::DataType::FLOAT32);
+        NDArray weightsPoint('c', {1, 1, iC*mC, oC}, nd4j::DataType::FLOAT32);
+        NDArray bias('c', {oC}, {1,2,3,4,5}, nd4j::DataType::FLOAT32);
+
+        input.linspace(-1., 0.01);
+        inputD.linspace(-1., 0.01);
+        weightsDepth.linspace(-0.5, 0.03);
+        weightsPoint.linspace(0.3, -0.02);
+
+        NDArray output('c', outShape, nd4j::DataType::FLOAT32);
+        NDArray expOutput('c', outShape, nd4j::DataType::FLOAT32);
+
+        nd4j::ops::sconv2d op;
+        ASSERT_EQ(Status::OK(), op.execute({&input, &weightsDepth, &weightsPoint, &bias}, {&output}, {}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, dataFormat}, {}));
+        ASSERT_EQ(Status::OK(), op.execute({&inputD, &weightsDepth, &weightsPoint, &bias}, {&expOutput}, {}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, dataFormat}, {}));
+
+        ASSERT_TRUE(expOutput.equalsTo(output));
+    }
+}
+
  // @Test
  //    public void testSconv2dbp(){
 
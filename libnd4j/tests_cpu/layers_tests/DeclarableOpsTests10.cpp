@@ -2518,6 +2518,80 @@ TEST_F(DeclarableOpsTests10, Image_NonMaxSuppressing_2) {
     delete results;
 }
 
+////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests10, Image_NonMaxSuppressing_3) {
+
+    NDArray boxes    = NDArrayFactory::create<float>('c', {6,4}, {0, 0, 1, 1, 0, 0.1f, 1, 1.1f, 0, -0.1f, 1.f, 0.9f,
+                                         0, 10, 1, 11, 0, 10.1f, 1.f, 11.1f, 0, 100, 1, 101});
+    NDArray scales = NDArrayFactory::create<float>('c', {6}, {0.9f, .75f, .6f, .95f, .5f, .3f});
+    NDArray expected = NDArrayFactory::create<float>('c', {6}, {3.,0.,0.,0.,0.,0.});
+
+    // last box is below score threshold
+    nd4j::ops::non_max_suppression op;
+    auto results = op.execute({&boxes, &scales}, {0.5, 0.4}, {6});
+
+    ASSERT_EQ(ND4J_STATUS_OK, results->status());
+
+    NDArray* result = results->at(0);
+
+    ASSERT_TRUE(expected.isSameShapeStrict(result));
+    ASSERT_TRUE(expected.equalsTo(result));
+
+    delete results;
+}
+
+////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests10, Image_NonMaxSuppressing_4) {
+
+    NDArray boxes    = NDArrayFactory::create<float>('c', {6,4}, {0, 0, 1, 1, 0, 0.1f, 1, 1.1f, 0, -0.1f, 1.f, 0.9f,
+                                         0, 10, 1, 11, 0, 10.1f, 1.f, 11.1f, 0, 100, 1, 101});
+    NDArray scales = NDArrayFactory::create<float>('c', {6}, {0.9f, .75f, .6f, .95f, .5f, .3f});
+    NDArray expected = NDArrayFactory::create<float>('c', {6}, {3.,0.,1.,5.,4.,2.});
+
+    // soft-nms: overlapping boxes are kept, but they go after non-overlapping ones due to decayed scores
+    nd4j::ops::non_max_suppression op;
+    auto results = op.execute({&boxes, &scales}, {1.0, 0.0, 0.5}, {6});
+
+    ASSERT_EQ(ND4J_STATUS_OK, results->status());
+
+    NDArray* result = results->at(0);
+
+    ASSERT_TRUE(expected.isSameShapeStrict(result));
+    ASSERT_TRUE(expected.equalsTo(result));
+
+    delete results;
+}
+
+////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests10, Image_NonMaxSuppressing_Batched_1) {
+
+    NDArray boxes  = NDArrayFactory::create<float>('c', {2,3,4}, {0, 0, 1, 1,  0, 0.1f, 1, 1.1f,  0, 10, 1, 11,
+                                                                  0, 0, 1, 1,  0, 5, 1, 6,         0, 10, 1, 11});
+    NDArray scores = NDArrayFactory::create<float>('c', {2,3,2}, {.9f, .1f,  .8f, .7f,  .3f, .2f,
+                                                                  .4f, .6f,  .5f, .1f,  .2f, .9f});
+
+    NDArray expIndices = NDArrayFactory::create<int>('c', {2,2,3}, {0, 2, -1,  1, -1, -1,  1, 0, -1,  2, 0, -1});
+    NDArray expScores = NDArrayFactory::create<float>('c', {2,2,3}, {.9f, .3f, 0.f,  .7f, 0.f, 0.f,  .5f, .4f, 0.f,  .9f, .6f, 0.f});
+    NDArray expCounts = NDArrayFactory::create<int>('c', {2,2}, {2, 1, 2, 2});
+
+    nd4j::ops::non_max_suppression_batched op;
+    auto results = op.execute({&boxes, &scores}, {0.5, 0.25}, {3});
+
+    ASSERT_EQ(ND4J_STATUS_OK, results->status());
+    ASSERT_EQ(3, results->size());
+
+    ASSERT_TRUE(expIndices.isSameShape(results->at(0)));
+    ASSERT_TRUE(expIndices.equalsTo(results->at(0)));
+
+    ASSERT_TRUE(expScores.isSameShape(results->at(1)));
+    ASSERT_TRUE(expScores.equalsTo(results->at(1)));
+
+    ASSERT_TRUE(expCounts.isSameShape(results->at(2)));
+    ASSERT_TRUE(expCounts.equalsTo(results->at(2)));
+
+    delete results;
+}
+
 ////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests10, Image_CropAndResize_1) {
 
@@ -1362,3 +1362,136 @@ TEST_F(DeclarableOpsTests12, inTopK_1) {
     ASSERT_TRUE(expV.isSameShape(z));
     ASSERT_TRUE(expV.equalsTo(z));    
 }
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests12, softmax_10) {
+
+    // channels axis of NCHW input goes through lockstep path, f-ordered copy through generic one
+    NDArray input('c', {2, 5, 3, 4}, nd4j::DataType::FLOAT32);
+    input.linspace(-3., 0.1);
+    NDArray* inputF = input.dup('f');
+
+    NDArray outC('c', {2, 5, 3, 4}, nd4j::DataType::FLOAT32);
+    NDArray outF('f', {2, 5, 3, 4}, nd4j::DataType::FLOAT32);
+    NDArray outA('c', {2, 5, 3, 4}, nd4j::DataType::FLOAT32);
+
+    nd4j::ops::softmax op;
+    ASSERT_EQ(ND4J_STATUS_OK, op.execute({&input}, {&outC}, {}, {1}, {}));
+    ASSERT_EQ(ND4J_STATUS_OK, op.execute({inputF}, {&outF}, {}, {1}, {}));
+
+    Environment::getInstance()->setApproximateExp(true);
+    auto status = op.execute({&input}, {&outA}, {}, {1}, {});
+    Environment::getInstance()->setApproximateExp(false);
+    ASSERT_EQ(ND4J_STATUS_OK, status);
+
+    ASSERT_TRUE(outC.equalsTo(outF));
+    ASSERT_TRUE(outC.equalsTo(outA));
+
+    auto sum = outC.reduceAlongDims(reduce::Sum, {1});
+    ASSERT_NEAR(2 * 3 * 4, sum.reduceNumber(reduce::Sum).e<float>(0), 1e-4);
+
+    delete inputF;
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests12, log_softmax_2) {
+
+    NDArray input('c', {3, 4, 6}, nd4j::DataType::FLOAT32);
+    input.linspace(-10., 0.3);
+
+    for (int dim: {1, 2}) {
+        NDArray softmax('c', {3, 4, 6}, nd4j::DataType::FLOAT32);
+
+        nd4j::ops::softmax opS;
+        ASSERT_EQ(ND4J_STATUS_OK, opS.execute({&input}, {&softmax}, {}, {dim}, {}));
+
+        auto exp = softmax.transform(transform::Log);
+
+        nd4j::ops::log_softmax op;
+        auto results = op.execute({&input}, {}, {dim});
+        ASSERT_EQ(ND4J_STATUS_OK, results->status());
+
+        ASSERT_TRUE(exp.equalsTo(results->at(0)));
+
+        delete results;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests12, log_softmax_3) {
+
+    // f-ordered input goes through generic path, large logit gaps must stay finite
+    NDArray input('f', {2, 3}, {-100.f, 1.f, 0.f, 2.f, 100.f, 3.f}, nd4j::DataType::FLOAT32);
+    NDArray exp('c', {2, 3}, {-200.f, -100.f, 0.f, -2.4076059f, -1.4076059f, -0.4076059f}, nd4j::DataType::FLOAT32);
+
+    for (char order: {'c', 'f'}) {
+        auto x = input.dup(order);
+
+        nd4j::ops::log_softmax op;
+        auto results = op.execute({x}, {}, {1});
+        ASSERT_EQ(ND4J_STATUS_OK, results->status());
+
+        ASSERT_TRUE(exp.equalsTo(results->at(0)));
+
+        delete results;
+        delete x;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests12, softmax_bp_2) {
+
+    NDArray input('c', {2, 3, 4}, nd4j::DataType::DOUBLE);
+    NDArray gradO('c', {2, 3, 4}, nd4j::DataType::DOUBLE);
+    input.linspace(-1., 0.2);
+    gradO.linspace(0.5, -0.1);
+
+    for (int dim: {1, 2}) {
+        NDArray softmax('c', {2, 3, 4}, nd4j::DataType::DOUBLE);
+
+        nd4j::ops::softmax opS;
+        ASSERT_EQ(ND4J_STATUS_OK, opS.execute({&input}, {&softmax}, {}, {dim}, {}));
+
+        auto exp = softmax * (gradO - (softmax * gradO).reduceAlongDims(reduce::Sum, {dim}, true));
+
+        nd4j::ops::softmax_bp op;
+        auto results = op.execute({&input, &gradO}, {}, {dim});
+        ASSERT_EQ(ND4J_STATUS_OK, results->status());
+
+        ASSERT_TRUE(exp.equalsTo(results->at(0)));
+
+        delete results;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests12, softmax_bp_3) {
+
+    NDArray input('c', {2, 3, 4}, nd4j::DataType::DOUBLE);
+    NDArray gradO('c', {2, 3, 4}, nd4j::DataType::DOUBLE);
+    input.linspace(-40., 7.);
+    gradO.linspace(0.5, -0.1);
+
+    // reference softmax is built from broadcast ops, independently of softmax kernels
+    for (int dim: {1, 2}) {
+        auto max = input.reduceAlongDims(reduce::Max, {dim}, true);
+        auto e = (input - max).transform(transform::Exp);
+        auto softmax = e / e.reduceAlongDims(reduce::Sum, {dim}, true);
+        auto exp = softmax * (gradO - (softmax * gradO).reduceAlongDims(reduce::Sum, {dim}, true));
+
+        for (char order: {'c', 'f'}) {
+            auto x = input.dup(order);
+            auto g = gradO.dup(order);
+
+            nd4j::ops::softmax_bp op;
+            auto results = op.execute({x, g}, {}, {dim});
+            ASSERT_EQ(ND4J_STATUS_OK, results->status());
+
+            ASSERT_TRUE(exp.equalsTo(results->at(0)));
+
+            delete results;
+            delete x;
+            delete g;
+        }
+    }
+}
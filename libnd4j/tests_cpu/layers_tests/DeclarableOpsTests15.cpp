@@ -206,3 +206,69 @@ TEST_F(DeclarableOpsTests15, Test_layer_norm_bp_1) {
     ASSERT_EQ(Status::OK(), result->status());
     delete result;
 }
+
+TEST_F(DeclarableOpsTests15, Test_fused_elementwise_1) {
+    // long enough to be split into several blocks
+    auto x = NDArrayFactory::create<float>('c', {17, 1000});
+    auto b = NDArrayFactory::create<float>('c', {1000});
+    auto z = NDArrayFactory::create<float>('c', {17, 1000});
+    x.linspace(-5.f, 0.001f);
+    b.linspace(-1.f, 0.002f);
+
+    auto exp = x.dup();
+    exp->addiRowVector(&b);
+    exp->applyTransform(transform::Sigmoid);
+    exp->applyScalar(scalar::Multiply, 3.0f);
+    exp->applyTransform(transform::Square);
+
+    // bias, sigmoid, scalar multiply, square
+    nd4j::ops::fused_elementwise op;
+    auto status = op.execute({&x, &b}, {&z}, {0., 0., 3., 0.}, {4, pairwise::Add, 1, transform::Sigmoid, 3, scalar::Multiply, 0, transform::Square}, {});
+    ASSERT_EQ(Status::OK(), status);
+    ASSERT_TRUE(exp->equalsTo(&z));
+
+    delete exp;
+}
+
+TEST_F(DeclarableOpsTests15, Test_fused_elementwise_2) {
+    // mixed types and broadcast along first dimension fall back to sequential execution
+    auto x = NDArrayFactory::create<int>('c', {3, 4}, {1, 4, 9, 16, 25, 36, 49, 64, 81, 100, 121, 144});
+    auto y = NDArrayFactory::create<float>('c', {3, 1}, {1.f, 2.f, 3.f});
+    auto exp = NDArrayFactory::create<float>('c', {3, 4}, {0.f, 1.f, 2.f, 3.f, 3.f, 4.f, 5.f, 6.f, 6.f, 7.f, 8.f, 9.f});
+
+    nd4j::ops::fused_elementwise op;
+    auto result = op.execute({&x, &y}, {0., 0.}, {2, transform::Sqrt, 4, pairwise::Subtract}, {});
+    ASSERT_EQ(Status::OK(), result->status());
+
+    auto z = result->at(0);
+    ASSERT_TRUE(exp.isSameShape(z));
+    ASSERT_TRUE(exp.equalsTo(z));
+
+    delete result;
+}
+
+TEST_F(DeclarableOpsTests15, Test_fused_matmul_1) {
+    auto x = NDArrayFactory::create<double>('c', {5, 7});
+    auto y = NDArrayFactory::create<double>('c', {7, 3});
+    auto b = NDArrayFactory::create<double>('c', {3}, {-1., 0., 1.});
+    x.linspace(-1., 0.1);
+    y.linspace(1., -0.05);
+
+    nd4j::ops::matmul mmul;
+    nd4j::ops::biasadd bias;
+    nd4j::ops::relu relu;
+
+    auto r0 = mmul.execute({&x, &y}, {}, {});
+    auto r1 = bias.execute({r0->at(0), &b}, {}, {});
+    auto r2 = relu.execute({r1->at(0)}, {0.0}, {});
+
+    nd4j::ops::fused_matmul op;
+    auto result = op.execute({&x, &y, &b}, {0., 0.}, {0, 0, 0, 4, pairwise::Add, 3, scalar::RELU}, {});
+    ASSERT_EQ(Status::OK(), result->status());
+    ASSERT_TRUE(r2->at(0)->equalsTo(result->at(0)));
+
+    delete r0;
+    delete r1;
+    delete r2;
+    delete result;
+}
@@ -163,6 +163,47 @@ TEST_F(DeclarableOpsTests3, Test_Unique_2) {
     delete result;
 }
 
+TEST_F(DeclarableOpsTests3, Test_Unique_Large_1) {
+    // long enough to be partitioned across threads
+    const Nd4jLong length = 1 << 19;
+    const int numUnique = 1000;
+
+    auto x = NDArrayFactory::create<int>('c', {length});
+    auto expV = NDArrayFactory::create<int>('c', {numUnique});
+    auto expI = NDArrayFactory::create<Nd4jLong>('c', {length});
+    auto expC = NDArrayFactory::create<Nd4jLong>('c', {numUnique});
+
+    for (Nd4jLong e = 0; e < length; e++) {
+        x.p(e, (int) ((e * 7919) % numUnique));
+        expI.p(e, e % numUnique);
+    }
+
+    for (int e = 0; e < numUnique; e++) {
+        expV.p(e, (int) ((e * 7919) % numUnique));
+        expC.p(e, length / numUnique + (e < length % numUnique ? 1 : 0));
+    }
+
+    nd4j::ops::unique_with_counts op;
+    auto result = op.execute({&x}, {}, {});
+
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+
+    auto v = result->at(0);
+    auto i = result->at(1);
+    auto c = result->at(2);
+
+    ASSERT_TRUE(expV.isSameShape(v));
+    ASSERT_TRUE(expV.equalsTo(v));
+
+    ASSERT_TRUE(expI.isSameShape(i));
+    ASSERT_TRUE(expI.equalsTo(i));
+
+    ASSERT_TRUE(expC.isSameShape(c));
+    ASSERT_TRUE(expC.equalsTo(c));
+
+    delete result;
+}
+
 TEST_F(DeclarableOpsTests3, Test_Rint_1) {
     auto x= NDArrayFactory::create<float>('c', {1, 7}, {-1.7, -1.5, -0.2, 0.2, 1.5, 1.7, 2.0});
     auto exp= NDArrayFactory::create<float>('c', {1, 7}, {-2., -2., -0., 0., 2., 2., 2.});
@@ -1150,6 +1191,41 @@ TEST_F(DeclarableOpsTests3, gruCell_test3) {
     delete results;
 }
 
+////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests3, gru_test1) {
+
+    const int time     = 3;
+    const int bS       = 2;
+    const int inSize   = 3;
+    const int numUnits = 2;
+
+    auto x  = NDArrayFactory::create<double>('c', {time, bS, inSize});
+    auto h0 = NDArrayFactory::create<double>('c', {bS, numUnits});
+    auto Wx = NDArrayFactory::create<double>('c', {inSize, 3*numUnits});
+    auto Wh = NDArrayFactory::create<double>('c', {numUnits, 3*numUnits});
+    auto b  = NDArrayFactory::create<double>('c', {3*numUnits});
+
+    x.linspace(0.1, 0.1);
+    h0.assign(0.5);
+    Wx.linspace(-0.5, 0.05);
+    Wh.linspace(0.4, -0.05);
+    b.linspace(-0.2, 0.1);
+
+    auto expH = NDArrayFactory::create<double>('c', {time, bS, numUnits}, {0.3966100,0.4424718,0.3903410,0.4580374,0.3290554,0.4421282,0.3216706,0.4667042,0.2889265,0.4751543,0.2830179,0.5041392});
+
+    nd4j::ops::gru op;
+    auto results = op.execute({&x, &h0, &Wx, &Wh, &b}, {}, {});
+
+    ASSERT_EQ(ND4J_STATUS_OK, results->status());
+
+    auto *h = results->at(0);
+
+    ASSERT_TRUE(expH.isSameShape(h));
+    ASSERT_TRUE(expH.equalsTo(h, 1e-5));
+
+    delete results;
+}
+
 ////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests3, invertPermutation_test1) {
 
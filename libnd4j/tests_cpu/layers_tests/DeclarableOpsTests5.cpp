@@ -1136,6 +1136,65 @@ TEST_F(DeclarableOpsTests5, Test_TopK_5) {
     delete result;
 }
 
+//////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests5, Test_TopK_6) {
+    auto x = NDArrayFactory::create<float>('c', {2, 6}, {1.f, 3.f, 3.f, 2.f, 3.f, 0.f, 5.f, 5.f, 1.f, 5.f, 0.f, 0.f});
+    auto expV = NDArrayFactory::create<float>('c', {2, 2}, {3.f, 3.f, 5.f, 5.f});
+    auto expI = NDArrayFactory::create<Nd4jLong>('c', {2, 2}, {1, 2, 0, 1});
+
+    nd4j::ops::top_k op;
+    auto result = op.execute({&x}, {}, {2, 1});
+
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+
+    auto v = result->at(0);
+    auto i = result->at(1);
+
+    // equal values are ordered by position
+    ASSERT_TRUE(expV.isSameShape(v));
+    ASSERT_TRUE(expV.equalsTo(v));
+
+    ASSERT_TRUE(expI.isSameShape(i));
+    ASSERT_TRUE(expI.equalsTo(i));
+
+    delete result;
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests5, Test_TopK_7) {
+    // single row wide enough to be split between threads
+    const Nd4jLong width = 200000;
+    auto x = NDArrayFactory::create<float>('c', {1, width});
+    for (Nd4jLong e = 0; e < width; e++)
+        x.p<float>(e, (float) (e % 1000));
+
+    x.p<float>(150000, 5000.f);
+    x.p<float>(7, 5000.f);
+    x.p<float>(width - 1, 4000.f);
+
+    auto expV = NDArrayFactory::create<float>('c', {1, 3}, {5000.f, 5000.f, 4000.f});
+    auto expI = NDArrayFactory::create<Nd4jLong>('c', {1, 3}, {7, 150000, width - 1});
+
+    nd4j::ops::top_k op;
+    auto result = op.execute({&x}, {}, {3, 1});
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+
+    ASSERT_TRUE(expV.equalsTo(result->at(0)));
+    ASSERT_TRUE(expI.equalsTo(result->at(1)));
+    delete result;
+
+    // unsorted output is ordered by position
+    auto expU = NDArrayFactory::create<float>('c', {1, 4}, {5000.f, 999.f, 5000.f, 4000.f});
+    auto expJ = NDArrayFactory::create<Nd4jLong>('c', {1, 4}, {7, 999, 150000, width - 1});
+
+    result = op.execute({&x}, {}, {4, 0});
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+
+    ASSERT_TRUE(expU.equalsTo(result->at(0)));
+    ASSERT_TRUE(expJ.equalsTo(result->at(1)));
+    delete result;
+}
+
 //////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests5, Test_InTopK_1) {
     auto x = NDArrayFactory::create<double>('c', {2, 3}, {1.0, 11.0, 3.0, 14.0, 5.0, 6.0});
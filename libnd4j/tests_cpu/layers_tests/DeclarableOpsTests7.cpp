@@ -2064,6 +2064,74 @@ TEST_F(DeclarableOpsTests7, TestUnsortedSegmentProdBP_4) {
     delete result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests7, TestUnsortedSegmentSum_Large_1) {
+    // few classes and narrow rows: input rows are split between threads
+    const Nd4jLong numRows = 50000;
+    auto x = NDArrayFactory::create<float>('c', {numRows, 3});
+    auto idx = NDArrayFactory::create<int>('c', {numRows});
+    auto exp = NDArrayFactory::create<float>('c', {4, 3});
+
+    for (Nd4jLong r = 0; r < numRows; r++) {
+        // class 2 is never used
+        int c = r % 3 == 2 ? 3 : r % 3;
+        idx.p<int>(r, c);
+        for (int e = 0; e < 3; e++) {
+            float v = (float) ((r * 3 + e) % 7);
+            x.p<float>(r * 3 + e, v);
+            exp.p<float>(c * 3 + e, exp.e<float>(c * 3 + e) + v);
+        }
+    }
+
+    nd4j::ops::unsorted_segment_sum op;
+    auto result = op.execute({&x, &idx}, {}, {4});
+    ASSERT_EQ(result->status(), Status::OK());
+    ASSERT_TRUE(exp.isSameShape(result->at(0)));
+    ASSERT_TRUE(exp.equalsTo(result->at(0)));
+
+    delete result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests7, TestSegmentMax_Large_1) {
+    // many classes: each class is reduced by single thread
+    const Nd4jLong numRows = 20000;
+    const Nd4jLong numClasses = numRows / 100;
+    auto x = NDArrayFactory::create<float>('c', {numRows, 4});
+    auto idx = NDArrayFactory::create<Nd4jLong>('c', {numRows});
+    auto exp = NDArrayFactory::create<float>('c', {numClasses, 4});
+    auto gradO = NDArrayFactory::create<float>('c', {numClasses, 4});
+    auto expBP = NDArrayFactory::create<float>('c', {numRows, 4});
+    exp.assign(-1.f);
+    gradO.assign(2.f);
+
+    for (Nd4jLong r = 0; r < numRows; r++) {
+        idx.p<Nd4jLong>(r, r / 100);
+        for (int e = 0; e < 4; e++) {
+            float v = (float) ((r * 7 + e * 3) % 101);
+            x.p<float>(r * 4 + e, v);
+            exp.p<float>((r / 100) * 4 + e, nd4j::math::nd4j_max<float>(exp.e<float>((r / 100) * 4 + e), v));
+        }
+    }
+
+    for (Nd4jLong r = 0; r < numRows; r++)
+        for (int e = 0; e < 4; e++)
+            expBP.p<float>(r * 4 + e, x.e<float>(r * 4 + e) == exp.e<float>((r / 100) * 4 + e) ? 2.f : 0.f);
+
+    nd4j::ops::segment_max op;
+    auto result = op.execute({&x, &idx}, {}, {});
+    ASSERT_EQ(result->status(), Status::OK());
+    ASSERT_TRUE(exp.isSameShape(result->at(0)));
+    ASSERT_TRUE(exp.equalsTo(result->at(0)));
+    delete result;
+
+    nd4j::ops::segment_max_bp opBP;
+    result = opBP.execute({&x, &idx, &gradO}, {}, {});
+    ASSERT_EQ(result->status(), Status::OK());
+    ASSERT_TRUE(expBP.equalsTo(result->at(0)));
+    delete result;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests7, TestExtractImagePatches_1) {
     auto x = NDArrayFactory::create<double>('c', {2,4, 4, 4}, {
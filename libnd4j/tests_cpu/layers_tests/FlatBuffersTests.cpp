@@ -26,6 +26,7 @@
 #include <graph/Node.h>
 #include <graph/Graph.h>
 #include <GraphExecutioner.h>
+#include <graph/FlatUtils.h>
 #include <ops/declarable/CustomOperations.h>
 
 using namespace nd4j;
@@ -226,6 +227,32 @@ TEST_F(FlatBuffersTest, ExecutionTest1) {
     delete exp;
 }
 
+TEST_F(FlatBuffersTest, ZeroCopyArray_1) {
+    auto x = NDArrayFactory::create<float>('c', {3, 5});
+    x.linspace(1.0f);
+
+    flatbuffers::FlatBufferBuilder builder(1024);
+
+    // misaligning builder on purpose, to make sure padding is applied
+    builder.CreateString("abc");
+
+    auto fArray = FlatUtils::toFlatArray(builder, x);
+    builder.Finish(fArray);
+
+    auto base = builder.GetBufferPointer();
+    auto flatArray = flatbuffers::GetRoot<FlatArray>(base);
+    auto buffer = reinterpret_cast<const int8_t *>(flatArray->buffer()->data());
+
+    ASSERT_EQ(0, (buffer - reinterpret_cast<int8_t *>(base)) % FlatUtils::BUFFER_ALIGNMENT);
+
+    auto view = FlatUtils::viewFlatArray(flatArray);
+    ASSERT_TRUE(view != nullptr);
+    ASSERT_EQ(buffer, view->buffer());
+    ASSERT_EQ(x, *view);
+
+    delete view;
+}
+
 /*
 TEST_F(FlatBuffersTest, ExplicitOutputTest1) {
     flatbuffers::FlatBufferBuilder builder(4096);
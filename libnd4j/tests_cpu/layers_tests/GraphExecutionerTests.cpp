@@ -27,6 +27,8 @@
 #include <graph/Graph.h>
 #include <NDArray.h>
 #include <ops/declarable/DeclarableOp.h>
+#include <GraphExecutioner.h>
+#include <graph/execution/DataflowExecutor.h>
 
 using namespace nd4j;
 using namespace nd4j::graph;
@@ -101,3 +103,101 @@ TEST_F(GraphExecutionerTests, Test_Implicit_Output_3) {
     delete graph;
 }
 #endif
+
+TEST_F(GraphExecutionerTests, Test_Dataflow_1) {
+    auto graph = new Graph();
+
+    auto x = NDArrayFactory::create_<float>('c', {5, 5});
+    x->assign(-2.0f);
+
+    graph->getVariableSpace()->putVariable(-1, x);
+
+    // 3 independent branches, merged in 2 steps
+    auto nodeA = new Node(OpType_TRANSFORM_SAME, transform::Abs, 1, {-1}, {3});
+    auto nodeB = new Node(OpType_TRANSFORM_SAME, transform::Abs, 2, {-1}, {3});
+    auto nodeC = new Node(OpType_PAIRWISE, pairwise::Add, 3, {1, 2}, {5});
+    auto nodeD = new Node(OpType_TRANSFORM_SAME, transform::Abs, 4, {-1}, {5});
+    auto nodeE = new Node(OpType_PAIRWISE, pairwise::Add, 5, {3, 4}, {});
+
+    graph->addNode(nodeA);
+    graph->addNode(nodeB);
+    graph->addNode(nodeC);
+    graph->addNode(nodeD);
+    graph->addNode(nodeE);
+
+    graph->getExecutorConfiguration()->_executionMode = ExecutionMode_AUTO;
+    graph->getExecutorConfiguration()->_interOpThreads = 3;
+
+    ASSERT_TRUE(DataflowExecutor::isApplicable(graph));
+
+    auto status = GraphExecutioner::execute(graph);
+    ASSERT_EQ(Status::OK(), status);
+
+    ASSERT_TRUE(graph->getVariableSpace()->hasVariable(5));
+
+    auto z = graph->getVariableSpace()->getVariable(5)->getNDArray();
+    ASSERT_NEAR(6.0f, z->reduceNumber(reduce::Mean).e<float>(0), 1e-5);
+
+    delete graph;
+}
+
+TEST_F(GraphExecutionerTests, Test_Dataflow_2) {
+    auto graph = new Graph();
+
+    auto x = NDArrayFactory::create_<float>('c', {3, 3});
+    x->assign(-1.0f);
+
+    graph->getVariableSpace()->putVariable(-1, x);
+
+    // long chain: no parallelism available, but results must match sequential execution
+    for (int e = 1; e <= 8; e++) {
+        auto node = new Node(OpType_SCALAR, scalar::Add, e, {e == 1 ? -1 : e - 1}, {}, {}, 1.0f);
+        graph->addNode(node);
+    }
+
+    graph->getExecutorConfiguration()->_executionMode = ExecutionMode_AUTO;
+
+    auto status = GraphExecutioner::execute(graph);
+    ASSERT_EQ(Status::OK(), status);
+
+    auto z = graph->getVariableSpace()->getVariable(8)->getNDArray();
+    ASSERT_NEAR(7.0f, z->reduceNumber(reduce::Mean).e<float>(0), 1e-5);
+
+    delete graph;
+}
+
+TEST_F(GraphExecutionerTests, Test_Dataflow_3) {
+    auto graph = new Graph();
+
+    auto x = NDArrayFactory::create_<float>('c', {4, 4});
+    x->assign(-3.0f);
+
+    graph->getVariableSpace()->putVariable(-1, x);
+
+    // independent terminal nodes: their outputs are written concurrently, nobody consumes them
+    for (int e = 1; e <= 6; e++) {
+        auto node = new Node(OpType_SCALAR, scalar::Add, e, {-1}, {}, {}, (float) e);
+        graph->addNode(node);
+    }
+
+    graph->getExecutorConfiguration()->_executionMode = ExecutionMode_AUTO;
+    graph->getExecutorConfiguration()->_interOpThreads = 3;
+
+    auto status = GraphExecutioner::execute(graph);
+    ASSERT_EQ(Status::OK(), status);
+
+    for (int e = 1; e <= 6; e++) {
+        ASSERT_TRUE(graph->getVariableSpace()->hasVariable(e));
+
+        auto z = graph->getVariableSpace()->getVariable(e)->getNDArray();
+        ASSERT_TRUE(z != nullptr);
+        ASSERT_NEAR(e - 3.0f, z->reduceNumber(reduce::Mean).e<float>(0), 1e-5);
+    }
+
+    auto space = graph->getVariableSpace();
+    ASSERT_TRUE(space->workerWorkspace(0) == space->workspace());
+    ASSERT_TRUE(space->workerWorkspace(1) != space->workspace());
+    ASSERT_TRUE(space->workerWorkspace(1) != space->workerWorkspace(2));
+
+    delete graph;
+}
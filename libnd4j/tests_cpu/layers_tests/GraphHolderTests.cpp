@@ -83,4 +83,69 @@ TEST_F(GraphHolderTests, SimpleTests_3) {
 
 
     delete graph2;
-}
\ No newline at end of file
+}
+
+TEST_F(GraphHolderTests, SessionsTests_1) {
+    auto graph = new Graph;
+    graph->getVariableSpace()->putVariable(-1, NDArrayFactory::create_<float>('c', {2, 2}));
+
+    Nd4jLong graphId = 119;
+    GraphHolder::getInstance()->registerGraph(graphId, graph);
+
+    auto session1 = GraphHolder::getInstance()->acquireSession(graphId);
+    auto session2 = GraphHolder::getInstance()->acquireSession(graphId);
+
+    ASSERT_TRUE(session1 != session2);
+    ASSERT_TRUE(session1 != graph);
+
+    // weights are shared, activations are not
+    ASSERT_TRUE(session1->getVariableSpace()->hasVariable(-1));
+    session1->getVariableSpace()->putVariable(1, NDArrayFactory::create_<float>('c', {2, 2}));
+    ASSERT_TRUE(session1->getVariableSpace()->hasVariable(1));
+    ASSERT_FALSE(session2->getVariableSpace()->hasVariable(1));
+    ASSERT_FALSE(graph->getVariableSpace()->hasVariable(1));
+
+    GraphHolder::getInstance()->releaseSession(graphId, session1);
+
+    // released session is reused, without variables of previous request
+    auto session3 = GraphHolder::getInstance()->acquireSession(graphId);
+    ASSERT_TRUE(session1 == session3);
+    ASSERT_TRUE(session3->getVariableSpace()->hasVariable(-1));
+    ASSERT_FALSE(session3->getVariableSpace()->hasVariable(1));
+
+    GraphHolder::getInstance()->releaseSession(graphId, session2);
+    GraphHolder::getInstance()->releaseSession(graphId, session3);
+
+    GraphHolder::getInstance()->dropGraph(graphId);
+    ASSERT_FALSE(GraphHolder::getInstance()->hasGraph(graphId));
+}
+
+TEST_F(GraphHolderTests, SessionsTests_2) {
+    auto graph = new Graph;
+    graph->getVariableSpace()->putVariable(-1, NDArrayFactory::create_<float>('c', {2, 2}));
+
+    Nd4jLong graphId = 121;
+    GraphHolder::getInstance()->registerGraph(graphId, graph);
+
+    auto session1 = GraphHolder::getInstance()->acquireSession(graphId);
+
+    // replacement gets its own pool, while session of previous one stays valid
+    auto replacement = new Graph;
+    replacement->getVariableSpace()->putVariable(-1, NDArrayFactory::create_<float>('c', {3, 3}));
+    GraphHolder::getInstance()->replaceGraph(graphId, replacement);
+
+    auto session2 = GraphHolder::getInstance()->acquireSession(graphId);
+    ASSERT_TRUE(session1 != session2);
+    ASSERT_EQ(4, session1->getVariableSpace()->getVariable(-1)->getNDArray()->lengthOf());
+    ASSERT_EQ(9, session2->getVariableSpace()->getVariable(-1)->getNDArray()->lengthOf());
+
+    // dropped graph is deleted once its last session is released
+    GraphHolder::getInstance()->dropGraph(graphId);
+    ASSERT_FALSE(GraphHolder::getInstance()->hasGraph(graphId));
+    ASSERT_EQ(9, session2->getVariableSpace()->getVariable(-1)->getNDArray()->lengthOf());
+
+    GraphHolder::getInstance()->releaseSession(graphId, session1);
+    GraphHolder::getInstance()->releaseSession(graphId, session2);
+
+    delete graph;
+}
@@ -25,6 +25,8 @@
 #include <graph/Node.h>
 #include <graph/Graph.h>
 #include <graph/GraphUtils.h>
+#include <graph/MemoryPlan.h>
+#include <graph/GraphFusion.h>
 #include <NDArray.h>
 #include <ops/declarable/DeclarableOp.h>
 #include <ops/declarable/generic/parity_ops.cpp>
@@ -1602,6 +1604,223 @@ TEST_F(GraphTests, Test_Inplace_Outputs_2) {
 #endif
 }
 
+TEST_F(GraphTests, Test_MemoryPlan_1) {
+    auto graph = new Graph();
+
+    auto x = NDArrayFactory::create_<float>('c', {10, 10});
+    x->assign(-2.0f);
+
+    graph->getVariableSpace()->putVariable(-1, x);
+
+    auto nodeA = new Node(OpType_TRANSFORM_SAME, transform::Abs, 1, {-1}, {2});
+    auto nodeB = new Node(OpType_TRANSFORM_STRICT, transform::Cosine, 2, {1}, {3});
+    auto nodeC = new Node(OpType_TRANSFORM_SAME, transform::Abs, 3, {2}, {4});
+    auto nodeD = new Node(OpType_TRANSFORM_STRICT, transform::Cosine, 4, {3}, {});
+
+    graph->addNode(nodeA);
+    graph->addNode(nodeB);
+    graph->addNode(nodeC);
+    graph->addNode(nodeD);
+
+    // plan needs shapes from at least one execution
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(graph));
+    ASSERT_EQ(Status::OK(), graph->planMemory());
+
+    auto plan = graph->memoryPlan();
+    ASSERT_TRUE(plan != nullptr);
+    ASSERT_EQ(4, plan->numberOfTensors());
+
+    // chain needs only 2 buffers at any time
+    ASSERT_EQ(plan->offset(1), plan->offset(3));
+    ASSERT_EQ(plan->offset(2), plan->offset(4));
+    ASSERT_NE(plan->offset(1), plan->offset(2));
+    ASSERT_EQ(plan->naiveSize(), plan->arenaSize() * 2);
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(graph));
+
+    auto z = graph->getVariableSpace()->getVariable(4)->getNDArray();
+    ASSERT_NEAR(0.9146533f, z->reduceNumber(reduce::Mean).e<float>(0), 1e-5);
+
+    // different input shape invalidates plan
+    auto y = graph->getVariableSpace()->getVariable(-1);
+    auto x2 = NDArrayFactory::create_<float>('c', {5, 5});
+    x2->assign(-2.0f);
+    delete y->getNDArray();
+    y->setNDArray(x2);
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(graph));
+    ASSERT_TRUE(graph->memoryPlan() == nullptr);
+
+    z = graph->getVariableSpace()->getVariable(4)->getNDArray();
+    ASSERT_EQ(25, z->lengthOf());
+    ASSERT_NEAR(0.9146533f, z->reduceNumber(reduce::Mean).e<float>(0), 1e-5);
+
+    delete graph;
+}
+
+TEST_F(GraphTests, Test_MemoryPlan_2) {
+    auto graph = new Graph();
+
+    auto x = NDArrayFactory::create_<float>('c', {6}, {-1.f, 1.f, -2.f, 2.f, 3.f, 3.f});
+    graph->getVariableSpace()->putVariable(-1, x);
+
+    nd4j::ops::unique uniqueOp;
+
+    auto nodeA = new Node(OpType_TRANSFORM_SAME, transform::Abs, 1, {-1}, {2});
+    auto nodeB = new Node(&uniqueOp, 2, {1}, {});
+
+    graph->addNode(nodeA);
+    graph->addNode(nodeB);
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(graph));
+    ASSERT_EQ(Status::OK(), graph->planMemory());
+
+    // unique output depends on values, so it's allocated by op on every run
+    auto plan = graph->memoryPlan();
+    ASSERT_TRUE(plan->offset(1) >= 0);
+    ASSERT_EQ(-1, plan->offset(2));
+    ASSERT_EQ(3, graph->getVariableSpace()->getVariable(2)->getNDArray()->lengthOf());
+
+    // planned output is zeroed before its producer runs
+    auto a = graph->getVariableSpace()->getVariable(1)->getNDArray();
+    a->assign(17.f);
+    plan->prepare(nodeA, graph->getVariableSpace());
+    ASSERT_NEAR(0.f, a->reduceNumber(reduce::Sum).e<float>(0), 1e-5);
+
+    // same input shape, different number of unique values
+    x->assign(5.f);
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(graph));
+    ASSERT_TRUE(graph->memoryPlan() != nullptr);
+    ASSERT_EQ(1, graph->getVariableSpace()->getVariable(2)->getNDArray()->lengthOf());
+
+    delete graph;
+}
+
+TEST_F(GraphTests, Test_MemoryPlan_3) {
+    auto graph = new Graph();
+
+    auto x = NDArrayFactory::create_<float>('c', {2, 3}, {-1.f, 2.f, -3.f, 4.f, -5.f, 6.f});
+    auto s = NDArrayFactory::create_<int>('c', {2}, {3, 2});
+    graph->getVariableSpace()->putVariable(-1, x);
+    graph->getVariableSpace()->putVariable(-2, s);
+
+    nd4j::ops::reshape reshapeOp;
+
+    auto nodeA = new Node(OpType_TRANSFORM_SAME, transform::Abs, 1, {-1}, {2});
+    auto nodeB = new Node(&reshapeOp, 2, {1, -2}, {3});
+    auto nodeC = new Node(OpType_TRANSFORM_SAME, transform::Neg, 3, {2}, {});
+
+    graph->addNode(nodeA);
+    graph->addNode(nodeB);
+    graph->addNode(nodeC);
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(graph));
+    ASSERT_EQ(Status::OK(), graph->planMemory());
+    ASSERT_TRUE(graph->memoryPlan()->offset(2) >= 0);
+
+    // shape argument keeps its shape, but not its values, so planned reshape output doesn't fit anymore
+    s->p(0, 6);
+    s->p(1, 1);
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(graph));
+
+    auto exp = NDArrayFactory::create<float>('c', {6, 1}, {-1.f, -2.f, -3.f, -4.f, -5.f, -6.f});
+    auto z = graph->getVariableSpace()->getVariable(3)->getNDArray();
+    ASSERT_TRUE(exp.isSameShape(z));
+    ASSERT_TRUE(exp.equalsTo(z));
+
+    // plan is dropped on next run
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(graph));
+    ASSERT_TRUE(graph->memoryPlan() == nullptr);
+
+    z = graph->getVariableSpace()->getVariable(3)->getNDArray();
+    ASSERT_TRUE(exp.equalsTo(z));
+
+    delete graph;
+}
+
+TEST_F(GraphTests, Test_Fusion_1) {
+    auto graph = new Graph();
+
+    auto x = NDArrayFactory::create_<float>('c', {4, 3}, {-1.f, 2.f, -3.f, 4.f, -5.f, 6.f, -7.f, 8.f, -9.f, 10.f, -11.f, 12.f});
+    auto y = NDArrayFactory::create_<float>('c', {3, 5});
+    auto b = NDArrayFactory::create_<float>('c', {5}, {-10.f, -5.f, 0.f, 5.f, 10.f});
+    y->linspace(-1.f, 0.25f);
+
+    graph->getVariableSpace()->putVariable(-1, x);
+    graph->getVariableSpace()->putVariable(-2, y);
+    graph->getVariableSpace()->putVariable(-3, b);
+
+    nd4j::ops::matmul mmulOp;
+    nd4j::ops::biasadd biasOp;
+    nd4j::ops::relu reluOp;
+
+    // matmul -> biasadd -> relu -> neg, with neg result requested
+    std::map<int, Node*> nodes;
+    nodes[1] = new Node(&mmulOp, 1, {-1, -2}, {2});
+    nodes[2] = new Node(&biasOp, 2, {1, -3}, {3});
+    nodes[3] = new Node(&reluOp, 3, {2}, {4}, {}, 0.0f, {0.0});
+    nodes[4] = new Node(OpType_TRANSFORM_SAME, transform::Neg, 4, {3}, {});
+
+    // node 3 is output, so it can't be fused into node 4
+    ASSERT_EQ(2, GraphFusion::fuse(nodes, {3}));
+    ASSERT_EQ(2, nodes.size());
+    ASSERT_EQ(std::string("fused_matmul"), *nodes[3]->getCustomOp()->getOpName());
+
+    for (auto &v: nodes)
+        graph->addNode(v.second);
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(graph));
+
+    auto exp = mmul(*x, *y);
+    exp.addiRowVector(b);
+    exp.applyScalar(scalar::RELU, 0.0f);
+
+    auto z = graph->getVariableSpace()->getVariable(3)->getNDArray();
+    ASSERT_EQ(exp, *z);
+
+    exp.applyTransform(transform::Neg);
+    z = graph->getVariableSpace()->getVariable(4)->getNDArray();
+    ASSERT_EQ(exp, *z);
+
+    delete graph;
+}
+
+TEST_F(GraphTests, Test_Fusion_2) {
+    auto graph = new Graph();
+
+    auto x = NDArrayFactory::create_<float>('c', {2, 3});
+    x->assign(-2.0f);
+    graph->getVariableSpace()->putVariable(-1, x);
+
+    // abs -> neg -> cos, with neg result requested
+    std::map<int, Node*> nodes;
+    nodes[1] = new Node(OpType_TRANSFORM_SAME, transform::Abs, 1, {-1}, {2});
+    nodes[2] = new Node(OpType_TRANSFORM_SAME, transform::Neg, 2, {1}, {3});
+    nodes[3] = new Node(OpType_TRANSFORM_STRICT, transform::Cosine, 3, {2}, {});
+
+    ASSERT_EQ(1, GraphFusion::fuse(nodes, {2}));
+    ASSERT_EQ(2, nodes.size());
+
+    // fused node keeps outputs of the last node in chain
+    auto outputs = nodes[2]->output();
+    ASSERT_EQ(1, outputs->size());
+    ASSERT_EQ(3, outputs->at(0).first);
+    ASSERT_TRUE(nodes[2]->hasInternalOutputs());
+
+    for (auto &v: nodes)
+        graph->addNode(v.second);
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(graph));
+
+    auto z = graph->getVariableSpace()->getVariable(2)->getNDArray();
+    ASSERT_NEAR(-2.0f, z->e<float>(0), 1e-5);
+
+    z = graph->getVariableSpace()->getVariable(3)->getNDArray();
+    ASSERT_NEAR(-0.4161468f, z->e<float>(0), 1e-5);
+
+    delete graph;
+}
+
 /*
 TEST_F(GraphTests, Test_Minifier_1) {
     // run preprocessor to produce single header
@@ -1585,6 +1585,103 @@ TEST_F(HelpersTests1, mmulHelper_test_7) {
 
 }
 
+////////////////////////////////////////////////////////////////////
+TEST_F(HelpersTests1, mmulHelper_test_8) {
+
+    // half precision has no vendor BLAS, dimensions span several cache blocks and micro-tile edges
+    auto x = NDArrayFactory::create<float16>('f', {150, 300});  x.linspace(0., 1e-5);
+    auto y = NDArrayFactory::create<float16>('c', {300, 37});   y.linspace(0., 1e-5);
+    auto result = NDArrayFactory::create<float16>('c', {150, 37});
+
+    auto xF = x.cast(nd4j::DataType::FLOAT32);
+    auto yF = y.cast(nd4j::DataType::FLOAT32);
+    auto expF = NDArrayFactory::create<float>('c', {150, 37});
+
+    MmulHelper::mmul(xF, yF, &expF, 1., 0.);
+    MmulHelper::mmul(&x, &y, &result, 1., 0.);
+
+    auto resultF = result.cast(nd4j::DataType::FLOAT32);
+    ASSERT_TRUE(expF.equalsTo(resultF, 1e-2));
+
+    delete xF;
+    delete yF;
+    delete resultF;
+}
+
+////////////////////////////////////////////////////////////////////
+// calls generic GEMM directly, so vendor BLAS doesn't take over, and checks it against naive loop over logical indices.
+// A and B are stored in the order of C, transposed ones have swapped dimensions
+template <typename X>
+static void checkGenericGemm(const char order, const bool transA, const bool transB, const int M, const int N, const int K, const double alpha, const double beta) {
+
+    NDArray a = NDArrayFactory::create<X>(order, transA ? std::vector<Nd4jLong>({K, M}) : std::vector<Nd4jLong>({M, K}));
+    auto b = NDArrayFactory::create<float>(order, transB ? std::vector<Nd4jLong>({N, K}) : std::vector<Nd4jLong>({K, N}));
+    auto c = NDArrayFactory::create<float>(order, {M, N});
+
+    for (Nd4jLong e = 0; e < a.lengthOf(); e++)
+        a.p(e, (e * 7) % 11 - 5);
+
+    b.linspace(-1., 2. / b.lengthOf());
+    c.linspace(1., -1. / c.lengthOf());
+
+    auto exp = c.dup();
+    for (int i = 0; i < M; i++) {
+        for (int j = 0; j < N; j++) {
+            double sum = 0.;
+            for (int k = 0; k < K; k++)
+                sum += (transA ? a.e<double>(k, i) : a.e<double>(i, k)) * (transB ? b.e<double>(j, k) : b.e<double>(k, j));
+
+            exp->p(i, j, alpha * sum + beta * c.e<double>(i, j));
+        }
+    }
+
+    const int lda = order == 'c' ? a.sizeAt(1) : a.sizeAt(0);
+    const int ldb = order == 'c' ? b.sizeAt(1) : b.sizeAt(0);
+    const int ldc = order == 'c' ? N : M;
+
+    nd4j::blas::GEMM<X, float, float>::op(order == 'c' ? CblasRowMajor : CblasColMajor, transA ? CblasTrans : CblasNoTrans, transB ? CblasTrans : CblasNoTrans,
+                                          M, N, K, alpha, a.getBuffer(), lda, b.getBuffer(), ldb, beta, c.getBuffer(), ldc);
+
+    ASSERT_TRUE(exp->equalsTo(&c, 1e-4));
+
+    delete exp;
+}
+
+////////////////////////////////////////////////////////////////////
+TEST_F(HelpersTests1, gemm_test_1) {
+
+    // K spans two cache blocks, both operands transposed
+    checkGenericGemm<float>('c', true, true, 133, 50, 270, 1., 0.);
+    checkGenericGemm<float>('c', true, false, 133, 50, 270, 1., 0.);
+    checkGenericGemm<float>('c', false, true, 133, 50, 270, 1., 0.);
+}
+
+////////////////////////////////////////////////////////////////////
+TEST_F(HelpersTests1, gemm_test_2) {
+
+    // N spans two column blocks, C is scaled by beta in place
+    checkGenericGemm<float>('c', false, false, 70, 1100, 20, 2., 0.5);
+    checkGenericGemm<float>('c', true, false, 3, 5, 2, 1., -1.);
+}
+
+////////////////////////////////////////////////////////////////////
+TEST_F(HelpersTests1, gemm_test_3) {
+
+    // f-ordered C goes through the stripe, M spans several stripes
+    checkGenericGemm<float>('f', false, false, 300, 40, 30, 1., 0.);
+    checkGenericGemm<float>('f', true, true, 300, 40, 30, 1., 1.5);
+    checkGenericGemm<float>('f', false, true, 1, 1, 1, 1., 0.);
+}
+
+////////////////////////////////////////////////////////////////////
+TEST_F(HelpersTests1, gemm_test_4) {
+
+    // integer A is accumulated in float
+    checkGenericGemm<int>('c', false, false, 17, 19, 23, 1., 0.);
+    checkGenericGemm<int>('c', true, true, 17, 19, 23, 0.5, 2.);
+    checkGenericGemm<int>('f', true, false, 17, 19, 23, 1., 1.);
+}
+
 ////////////////////////////////////////////////////////////////////
 TEST_F(HelpersTests1, tensordot_test_1) {
 
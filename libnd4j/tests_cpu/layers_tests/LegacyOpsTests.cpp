@@ -31,6 +31,7 @@
 #include <ops/declarable/LegacyBroadcastOp.h>
 #include <helpers/TAD.h>
 #include <helpers/ConstantTadHelper.h>
+#include <helpers/CpuFeatures.h>
 
 using namespace nd4j;
 using namespace nd4j::ops;
@@ -608,4 +609,36 @@ TEST_F(LegacyOpsTests, Softmax_119_2) {
     x.linspace(1.0);
 
     x.applyTransform(transform::StrictOps::SoftMax, &z);
-}
\ No newline at end of file
+}
+
+TEST_F(LegacyOpsTests, test_isa_dispatch_1) {
+    auto env = Environment::getInstance();
+    auto level = env->isaLevel();
+    ASSERT_TRUE(level <= env->maxIsaLevel());
+
+    auto x = NDArrayFactory::create<float>('c', {1027});
+    auto y = NDArrayFactory::create<float>('c', {1027});
+    x.linspace(1.0);
+    y.linspace(0.5);
+
+    std::vector<NDArray> results;
+    for (int l = ISA_GENERIC; l <= env->maxIsaLevel(); l++) {
+        env->setIsaLevel(l);
+        ASSERT_EQ(l, env->isaLevel());
+
+        auto z = NDArrayFactory::create<float>('c', {1027});
+        x.applyPairwiseTransform(pairwise::Multiply, &y, &z, nullptr);
+        z.applyScalar(scalar::Add, 1.0f, &z);
+        z.applyTransform(transform::Sqrt, &z);
+
+        results.emplace_back(z);
+        results.emplace_back(z.reduceNumber(reduce::Sum));
+    }
+
+    env->setIsaLevel(level);
+
+    for (int e = 2; e < (int) results.size(); e++)
+        ASSERT_TRUE(results[e % 2].equalsTo(results[e], 1e-4));
+
+    ASSERT_ANY_THROW(env->setIsaLevel(env->maxIsaLevel() + 1));
+}
@@ -2664,3 +2664,50 @@ TEST_F(NDArrayTest, assign_test1) {
     x.reshapei('c',{3, 2});    
     ASSERT_TRUE(x.equalsTo(y));
 }
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(NDArrayTest, constant_shape_1) {
+    auto helper = nd4j::ConstantShapeHelper::getInstance();
+
+    NDArray x('c', {3, 17, 5}, nd4j::DataType::FLOAT32);
+    auto hits = helper->cacheHits();
+
+    NDArray y('c', {3, 17, 5}, nd4j::DataType::FLOAT32);
+    ASSERT_EQ(hits + 1, helper->cacheHits());
+
+    NDArray z('f', {3, 17, 5}, nd4j::DataType::FLOAT32);
+
+    // equal shapes share single buffer
+    ASSERT_TRUE(x.shapeInfo() == y.shapeInfo());
+    ASSERT_TRUE(x.shapeInfo() != z.shapeInfo());
+    ASSERT_TRUE(helper->isInterned(x.shapeInfo()));
+
+    // and modification of one array doesn't affect the other one
+    y.permutei({2, 1, 0});
+    ASSERT_EQ(std::vector<Nd4jLong>({3, 17, 5}), x.getShapeAsVector());
+    ASSERT_EQ(std::vector<Nd4jLong>({5, 17, 3}), y.getShapeAsVector());
+
+    auto tad = x.tensorAlongDimension(1, {1, 2});
+    ASSERT_TRUE(helper->isInterned(tad->shapeInfo()));
+    ASSERT_EQ(std::vector<Nd4jLong>({17, 5}), tad->getShapeAsVector());
+
+    delete tad;
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(NDArrayTest, constant_shape_2) {
+    auto helper = nd4j::ConstantShapeHelper::getInstance();
+    auto limit = helper->cacheLimit();
+
+    // once cache is full, arrays fall back to own shapes
+    helper->setCacheLimit(helper->cacheSize());
+
+    NDArray x('c', {7, 19, 3, 2}, nd4j::DataType::DOUBLE);
+    x.assign(1.0);
+
+    helper->setCacheLimit(limit);
+
+    ASSERT_FALSE(helper->isInterned(x.shapeInfo()));
+    ASSERT_EQ(7 * 19 * 3 * 2, x.lengthOf());
+    ASSERT_NEAR(1.0, x.meanNumber().e<double>(0), 1e-5);
+}
@@ -112,6 +112,42 @@ TEST_F(OneOffTests, test_pad_1D_1) {
     ASSERT_EQ(e, *z);
     delete graph;
 }
+
+TEST_F(OneOffTests, test_pad_1D_mapped_1) {
+    auto e = NDArrayFactory::create<float>('c', {7}, {10.f,0.778786f, 0.801198f, 0.724375f, 0.230894f, 0.727141f,10.f});
+    auto graph = GraphExecutioner::importFromMappedFlatBuffers("./resources/pad_1D.fb");
+
+    ASSERT_TRUE(graph != nullptr);
+    ASSERT_TRUE(graph->mappedFile() != nullptr);
+
+    // constants must be views of mapped file rather than copies
+    auto begin = reinterpret_cast<int8_t *>(graph->mappedFile()->pointer());
+    auto end = begin + graph->mappedFile()->length();
+    int mapped = 0;
+    for (auto v: graph->getVariableSpace()->getVariables()) {
+        if (v->id() >= 0 || !v->hasNDArray())
+            continue;
+
+        auto buffer = reinterpret_cast<int8_t *>(v->getNDArray()->buffer());
+        if (buffer >= begin && buffer < end) {
+            ASSERT_TRUE(v->isReadOnly());
+            mapped++;
+        }
+    }
+    ASSERT_TRUE(mapped > 0);
+
+    Nd4jStatus status = GraphExecutioner::execute(graph);
+    ASSERT_EQ(Status::OK(), status);
+
+    ASSERT_TRUE(graph->getVariableSpace()->hasVariable(4));
+
+    auto z = graph->getVariableSpace()->getVariable(4)->getNDArray();
+    ASSERT_TRUE(z != nullptr);
+
+    ASSERT_EQ(e, *z);
+    delete graph;
+}
+
 /*
 TEST_F(OneOffTests, test_scatter_nd_update_1) {
 
@@ -0,0 +1,155 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include "testlayers.h"
+#include <NDArray.h>
+#include <ops/declarable/CustomOperations.h>
+#include <graph/profiling/OpTraceCollector.h>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+
+using namespace nd4j;
+using namespace nd4j::graph;
+
+class OpTraceTests : public testing::Test {
+public:
+    OpTraceTests() {
+        OpTraceCollector::getInstance()->reset();
+    }
+
+    ~OpTraceTests() {
+        Environment::getInstance()->setOpTracing(false);
+        OpTraceCollector::getInstance()->reset();
+    }
+};
+
+TEST_F(OpTraceTests, test_disabled_1) {
+    Environment::getInstance()->setOpTracing(false);
+
+    auto x = NDArrayFactory::create<float>('c', {3}, {1.f, 2.f, 3.f});
+    auto y = NDArrayFactory::create<float>('c', {3}, {1.f, 2.f, 3.f});
+
+    nd4j::ops::add op;
+    auto result = op.execute({&x, &y}, {}, {});
+    ASSERT_EQ(Status::OK(), result->status());
+    delete result;
+
+    ASSERT_EQ(0, OpTraceCollector::getInstance()->numberOfEvents());
+}
+
+TEST_F(OpTraceTests, test_matmul_1) {
+    Environment::getInstance()->setOpTracing(true);
+
+    auto x = NDArrayFactory::create<float>('c', {4, 5});
+    auto y = NDArrayFactory::create<float>('c', {5, 6});
+    x.linspace(1.f);
+    y.linspace(1.f);
+
+    nd4j::ops::matmul op;
+    for (int e = 0; e < 3; e++) {
+        auto result = op.execute({&x, &y}, {}, {});
+        ASSERT_EQ(Status::OK(), result->status());
+        delete result;
+    }
+
+    ASSERT_EQ(3, OpTraceCollector::getInstance()->numberOfEvents());
+
+    auto summary = OpTraceCollector::getInstance()->summary();
+    ASSERT_EQ(1, summary.size());
+
+    auto &s = summary[0];
+    ASSERT_EQ(std::string("matmul"), s.name);
+    ASSERT_EQ(3, s.count);
+    ASSERT_EQ(3 * (20 + 30) * 4, s.bytesRead);
+    ASSERT_EQ(3 * 24 * 4, s.bytesWritten);
+
+    // 2 * M * N * K per call
+    ASSERT_EQ(3 * 2 * 4 * 6 * 5, s.flops);
+    ASSERT_TRUE(s.minTime <= s.maxTime);
+
+    // nothing else was running, so CPU time counts for every call
+    ASSERT_EQ(s.totalTime, s.exclusiveTime);
+}
+
+TEST_F(OpTraceTests, test_matmul_2) {
+    Environment::getInstance()->setOpTracing(true);
+
+    auto x = NDArrayFactory::create<float>('c', {4, 5});
+    auto y = NDArrayFactory::create<float>('c', {5, 6});
+    x.linspace(1.f);
+    y.linspace(1.f);
+
+    // transZ gives [6, 4] output, K is still 5
+    nd4j::ops::matmul op;
+    auto result = op.execute({&x, &y}, {}, {0, 0, 1});
+    ASSERT_EQ(Status::OK(), result->status());
+    ASSERT_EQ(6, result->at(0)->sizeAt(0));
+    delete result;
+
+    auto summary = OpTraceCollector::getInstance()->summary();
+    ASSERT_EQ(1, summary.size());
+    ASSERT_EQ(2 * 4 * 6 * 5, summary[0].flops);
+}
+
+TEST_F(OpTraceTests, test_scope_1) {
+    OpTraceScope outer;
+
+    // nested call from the same thread isn't an overlap
+    {
+        OpTraceScope inner;
+        ASSERT_TRUE(inner.isExclusive());
+    }
+
+    ASSERT_TRUE(outer.isExclusive());
+
+    std::thread other([] {
+        OpTraceScope scope;
+    });
+    other.join();
+
+    ASSERT_FALSE(outer.isExclusive());
+
+    OpTraceScope next;
+    ASSERT_TRUE(next.isExclusive());
+}
+
+TEST_F(OpTraceTests, test_chrome_trace_1) {
+    Environment::getInstance()->setOpTracing(true);
+
+    auto x = NDArrayFactory::create<float>('c', {2, 2}, {1.f, 2.f, 3.f, 4.f});
+    auto y = NDArrayFactory::create<float>('c', {2, 2}, {1.f, 2.f, 3.f, 4.f});
+
+    nd4j::ops::add op;
+    auto result = op.execute({&x, &y}, {}, {});
+    ASSERT_EQ(Status::OK(), result->status());
+    delete result;
+
+    auto json = OpTraceCollector::getInstance()->asChromeTrace();
+    ASSERT_NE(std::string::npos, json.find("\"traceEvents\""));
+    ASSERT_NE(std::string::npos, json.find("\"name\":\"add\""));
+    ASSERT_NE(std::string::npos, json.find("\"ph\":\"X\""));
+
+    const char *path = "OpTraceTests_test_chrome_trace_1.json";
+    OpTraceCollector::getInstance()->exportChromeTrace(path);
+
+    std::ifstream file(path);
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    ASSERT_EQ(json, content);
+
+    file.close();
+    std::remove(path);
+}
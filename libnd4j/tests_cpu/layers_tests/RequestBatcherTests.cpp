@@ -0,0 +1,251 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include "testlayers.h"
+#include <graph/GraphHolder.h>
+#include <graph/RequestBatcher.h>
+#include <ops/declarable/CustomOperations.h>
+#include <thread>
+
+using namespace nd4j;
+using namespace nd4j::ops;
+using namespace nd4j::graph;
+
+class RequestBatcherTests : public testing::Test {
+public:
+    static Graph* buildGraph() {
+        auto graph = new Graph();
+        graph->getVariableSpace()->putVariable(-1, NDArrayFactory::create_<float>('c', {1, 3}));
+
+        auto nodeA = new Node(OpType_TRANSFORM_SAME, transform::Abs, 1, {-1}, {2});
+        auto nodeB = new Node(OpType_TRANSFORM_SAME, transform::Neg, 2, {1}, {});
+
+        graph->addNode(nodeA);
+        graph->addNode(nodeB);
+        graph->buildGraph();
+
+        return graph;
+    }
+
+    // softmax along dimension 0 mixes rows of different requests, so merged execution can't be split back
+    static Graph* buildMixingGraph() {
+        static nd4j::ops::softmax softmaxOp;
+
+        auto graph = new Graph();
+        graph->getVariableSpace()->putVariable(-1, NDArrayFactory::create_<float>('c', {1, 3}));
+
+        auto nodeA = new Node(&softmaxOp, 1, {-1}, {}, {}, 0.0f, {}, {0});
+
+        graph->addNode(nodeA);
+        graph->buildGraph();
+
+        return graph;
+    }
+};
+
+// gives tests control over batch composition, regardless of threads timing
+class ManualBatcher : public RequestBatcher {
+public:
+    explicit ManualBatcher(Nd4jLong graphId) : RequestBatcher(graphId, 8, 0) { }
+
+    std::vector<std::vector<Variable*>*> executeAll(std::vector<std::vector<Variable*>>& requests) {
+        std::vector<Ticket> tickets(requests.size());
+        std::vector<Ticket*> batch;
+        for (int e = 0; e < (int) requests.size(); e++) {
+            tickets[e].inputs = &requests[e];
+            batch.emplace_back(&tickets[e]);
+        }
+
+        executeBatch(batch);
+
+        std::vector<std::vector<Variable*>*> results;
+        for (auto &t: tickets) {
+            if (t.error)
+                std::rethrow_exception(t.error);
+
+            results.emplace_back(t.outputs);
+        }
+
+        return results;
+    }
+
+    static void release(std::vector<std::vector<Variable*>*>& results) {
+        RequestBatcher::release(results);
+    }
+};
+
+TEST_F(RequestBatcherTests, Basic_Test_1) {
+    Nd4jLong graphId = 121;
+    GraphHolder::getInstance()->registerGraph(graphId, buildGraph());
+
+    RequestBatcher batcher(graphId, 4, 0);
+
+    auto x = NDArrayFactory::create<float>('c', {2, 3}, {1.f, -2.f, 3.f, -4.f, 5.f, -6.f});
+    auto exp = NDArrayFactory::create<float>('c', {2, 3}, {-1.f, -2.f, -3.f, -4.f, -5.f, -6.f});
+
+    Variable input(&x, nullptr, -1, 0);
+    input.markRemovable(false);
+    std::vector<Variable*> inputs({&input});
+
+    auto outputs = batcher.execute(inputs);
+
+    ASSERT_EQ(1, outputs->size());
+    ASSERT_EQ(exp, *outputs->at(0)->getNDArray());
+    ASSERT_EQ(1, batcher.executions());
+    ASSERT_EQ(1, batcher.requests());
+
+    for (auto v: *outputs)
+        delete v;
+    delete outputs;
+
+    GraphHolder::getInstance()->dropGraph(graphId);
+}
+
+TEST_F(RequestBatcherTests, Concurrent_Test_1) {
+    Nd4jLong graphId = 122;
+    GraphHolder::getInstance()->registerGraph(graphId, buildGraph());
+
+    const int numThreads = 4;
+
+    // long delay, but idle batcher flushes right away, so requests might be split into several batches
+    RequestBatcher batcher(graphId, numThreads, 5000000L);
+
+    std::vector<std::vector<Variable*>*> results(numThreads);
+    std::vector<NDArray> arrays;
+    for (int e = 0; e < numThreads; e++) {
+        // requests have different batch sizes
+        arrays.emplace_back(NDArrayFactory::create<float>('c', {e + 1, 3}));
+        arrays.back().assign(e + 1.f);
+    }
+
+    std::vector<std::thread> threads;
+    for (int e = 0; e < numThreads; e++) {
+        threads.emplace_back(std::thread([&, e] () {
+            Variable input(&arrays[e], nullptr, -1, 0);
+            input.markRemovable(false);
+            std::vector<Variable*> inputs({&input});
+
+            results[e] = batcher.execute(inputs);
+        }));
+    }
+
+    for (auto &t: threads)
+        t.join();
+
+    ASSERT_LE(1, batcher.executions());
+    ASSERT_EQ(numThreads, batcher.requests());
+
+    for (int e = 0; e < numThreads; e++) {
+        ASSERT_EQ(1, results[e]->size());
+
+        auto z = results[e]->at(0)->getNDArray();
+        ASSERT_EQ(std::vector<Nd4jLong>({e + 1, 3}), z->getShapeAsVector());
+        ASSERT_NEAR(-(e + 1.f), z->meanNumber().e<float>(0), 1e-5);
+
+        for (auto v: *results[e])
+            delete v;
+        delete results[e];
+    }
+
+    GraphHolder::getInstance()->dropGraph(graphId);
+}
+
+TEST_F(RequestBatcherTests, Verification_Test_1) {
+    Nd4jLong graphId = 123;
+    GraphHolder::getInstance()->registerGraph(graphId, buildGraph());
+
+    ManualBatcher batcher(graphId);
+
+    auto x = NDArrayFactory::create<float>('c', {1, 3}, {1.f, -2.f, 3.f});
+    auto y = NDArrayFactory::create<float>('c', {2, 3}, {-4.f, 5.f, -6.f, 7.f, -8.f, 9.f});
+
+    Variable inputX(&x, nullptr, -1, 0);
+    Variable inputY(&y, nullptr, -1, 0);
+    inputX.markRemovable(false);
+    inputY.markRemovable(false);
+
+    std::vector<std::vector<Variable*>> requests({{&inputX}, {&inputY}});
+
+    // first merged execution is checked against separate execution of first request
+    auto results = batcher.executeAll(requests);
+    ASSERT_EQ(2, batcher.executions());
+    ASSERT_EQ(2, batcher.requests());
+    ASSERT_FALSE(batcher.isUnbatchable());
+
+    auto expX = NDArrayFactory::create<float>('c', {1, 3}, {-1.f, -2.f, -3.f});
+    auto expY = NDArrayFactory::create<float>('c', {2, 3}, {-4.f, -5.f, -6.f, -7.f, -8.f, -9.f});
+
+    ASSERT_EQ(expX, *results[0]->at(0)->getNDArray());
+    ASSERT_EQ(expY, *results[1]->at(0)->getNDArray());
+    ManualBatcher::release(results);
+
+    // graph is verified already, so next batch takes single execution
+    results = batcher.executeAll(requests);
+    ASSERT_EQ(3, batcher.executions());
+    ASSERT_EQ(4, batcher.requests());
+
+    ASSERT_EQ(expX, *results[0]->at(0)->getNDArray());
+    ASSERT_EQ(expY, *results[1]->at(0)->getNDArray());
+    ManualBatcher::release(results);
+
+    GraphHolder::getInstance()->dropGraph(graphId);
+}
+
+TEST_F(RequestBatcherTests, Verification_Test_2) {
+    Nd4jLong graphId = 124;
+    GraphHolder::getInstance()->registerGraph(graphId, buildMixingGraph());
+
+    ManualBatcher batcher(graphId);
+
+    auto x = NDArrayFactory::create<float>('c', {1, 3}, {1.f, -2.f, 3.f});
+    auto y = NDArrayFactory::create<float>('c', {2, 3}, {-4.f, 5.f, -6.f, 7.f, -8.f, 9.f});
+
+    Variable inputX(&x, nullptr, -1, 0);
+    Variable inputY(&y, nullptr, -1, 0);
+    inputX.markRemovable(false);
+    inputY.markRemovable(false);
+
+    std::vector<std::vector<Variable*>> requests({{&inputX}, {&inputY}});
+
+    // merged output has proper batch size, yet values differ from separate execution
+    auto results = batcher.executeAll(requests);
+    ASSERT_TRUE(batcher.isUnbatchable());
+    ASSERT_EQ(2, batcher.requests());
+
+    nd4j::ops::softmax op;
+    auto expX = op.execute({&x}, {}, {0});
+    auto expY = op.execute({&y}, {}, {0});
+    ASSERT_EQ(Status::OK(), expX->status());
+    ASSERT_EQ(Status::OK(), expY->status());
+
+    ASSERT_TRUE(expX->at(0)->equalsTo(results[0]->at(0)->getNDArray()));
+    ASSERT_TRUE(expY->at(0)->equalsTo(results[1]->at(0)->getNDArray()));
+    ManualBatcher::release(results);
+
+    // unbatchable graph isn't merged anymore
+    auto executions = batcher.executions();
+    results = batcher.executeAll(requests);
+    ASSERT_EQ(executions + 2, batcher.executions());
+
+    ASSERT_TRUE(expX->at(0)->equalsTo(results[0]->at(0)->getNDArray()));
+    ASSERT_TRUE(expY->at(0)->equalsTo(results[1]->at(0)->getNDArray()));
+    ManualBatcher::release(results);
+
+    delete expX;
+    delete expY;
+
+    GraphHolder::getInstance()->dropGraph(graphId);
+}
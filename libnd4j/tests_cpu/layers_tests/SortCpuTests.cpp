@@ -0,0 +1,147 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include "testlayers.h"
+#include <NDArray.h>
+#include <NativeOps.h>
+#include <ops/specials_sort.h>
+#include <algorithm>
+
+using namespace nd4j;
+
+class SortCpuTests : public testing::Test {
+public:
+
+};
+
+
+TEST_F(SortCpuTests, test_sort_1) {
+    auto x = NDArrayFactory::create<float>('c', {8}, {3.f, -1.f, 0.f, -7.5f, 2.f, -0.5f, 10.f, -1.f});
+    auto e = NDArrayFactory::create<float>('c', {8}, {-7.5f, -1.f, -1.f, -0.5f, 0.f, 2.f, 3.f, 10.f});
+
+    NativeOps nativeOps;
+    nativeOps.sort(nullptr, x.buffer(), x.shapeInfo(), nullptr, nullptr, false);
+
+    ASSERT_EQ(e, x);
+}
+
+TEST_F(SortCpuTests, test_sort_2) {
+    // long enough to be sorted by multiple threads
+    const Nd4jLong length = 1 << 18;
+    auto x = NDArrayFactory::create<int>('c', {length});
+    std::vector<int> exp(length);
+
+    for (Nd4jLong e = 0; e < length; e++) {
+        auto v = static_cast<int>((e * 7919) % 100003) - 50000;
+        x.p(e, v);
+        exp[e] = v;
+    }
+
+    std::sort(exp.begin(), exp.end(), [](int a, int b) -> bool { return a > b; });
+
+    NativeOps nativeOps;
+    nativeOps.sort(nullptr, x.buffer(), x.shapeInfo(), nullptr, nullptr, true);
+
+    for (Nd4jLong e = 0; e < length; e++)
+        ASSERT_EQ(exp[e], x.e<int>(e));
+}
+
+TEST_F(SortCpuTests, test_sort_by_key_1) {
+    auto k = NDArrayFactory::create<Nd4jLong>('c', {10}, {1, 3, 5, 9, 0, 2, 4, 6, 7, 8});
+    auto v = NDArrayFactory::create<double>('c', {10}, {1.5, 3.5, 5.5, 9.5, 0.5, 2.5, 4.5, 6.5, 7.5, 8.5});
+
+    auto ek = NDArrayFactory::create<Nd4jLong>('c', {10}, {0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+    auto ev = NDArrayFactory::create<double>('c', {10}, {0.5, 1.5, 2.5, 3.5, 4.5, 5.5, 6.5, 7.5, 8.5, 9.5});
+
+    NativeOps nativeOps;
+    nativeOps.sortByKey(nullptr, k.buffer(), k.shapeInfo(), nullptr, nullptr, v.buffer(), v.shapeInfo(), nullptr, nullptr, false);
+
+    ASSERT_EQ(ek, k);
+    ASSERT_EQ(ev, v);
+}
+
+TEST_F(SortCpuTests, test_sort_by_value_1) {
+    auto k = NDArrayFactory::create<Nd4jLong>('c', {10}, {1, 3, 5, 9, 0, 2, 4, 6, 7, 8});
+    auto v = NDArrayFactory::create<double>('c', {10}, {1.5, 3.5, 5.5, 9.5, 0.5, 2.5, 4.5, 6.5, 7.5, 8.5});
+
+    auto ek = NDArrayFactory::create<Nd4jLong>('c', {10}, {9, 8, 7, 6, 5, 4, 3, 2, 1, 0});
+    auto ev = NDArrayFactory::create<double>('c', {10}, {9.5, 8.5, 7.5, 6.5, 5.5, 4.5, 3.5, 2.5, 1.5, 0.5});
+
+    NativeOps nativeOps;
+    nativeOps.sortByValue(nullptr, k.buffer(), k.shapeInfo(), nullptr, nullptr, v.buffer(), v.shapeInfo(), nullptr, nullptr, true);
+
+    ASSERT_EQ(ek, k);
+    ASSERT_EQ(ev, v);
+}
+
+TEST_F(SortCpuTests, test_sort_by_key_stable_1) {
+    // equal keys keep their original order
+    auto k = NDArrayFactory::create<int>('c', {6}, {2, 1, 2, 1, 2, 1});
+    auto v = NDArrayFactory::create<int>('c', {6}, {0, 1, 2, 3, 4, 5});
+
+    auto ek = NDArrayFactory::create<int>('c', {6}, {2, 2, 2, 1, 1, 1});
+    auto ev = NDArrayFactory::create<int>('c', {6}, {0, 2, 4, 1, 3, 5});
+
+    NativeOps nativeOps;
+    nativeOps.sortByKey(nullptr, k.buffer(), k.shapeInfo(), nullptr, nullptr, v.buffer(), v.shapeInfo(), nullptr, nullptr, true);
+
+    ASSERT_EQ(ek, k);
+    ASSERT_EQ(ev, v);
+}
+
+TEST_F(SortCpuTests, test_sort_tad_by_key_1) {
+    auto k = NDArrayFactory::create<Nd4jLong>('c', {2, 5}, {1, 3, 5, 9, 0,   2, 4, 6, 7, 8});
+    auto v = NDArrayFactory::create<double>('c', {2, 5}, {1.5, 3.5, 5.5, 9.5, 0.5,   2.5, 4.5, 6.5, 7.5, 8.5});
+
+    auto ek = NDArrayFactory::create<Nd4jLong>('c', {2, 5}, {0, 1, 3, 5, 9,   2, 4, 6, 7, 8});
+    auto ev = NDArrayFactory::create<double>('c', {2, 5}, {0.5, 1.5, 3.5, 5.5, 9.5,   2.5, 4.5, 6.5, 7.5, 8.5});
+
+    int axis = 1;
+    NativeOps nativeOps;
+    nativeOps.sortTadByKey(nullptr, k.buffer(), k.shapeInfo(), nullptr, nullptr, v.buffer(), v.shapeInfo(), nullptr, nullptr, &axis, 1, false);
+
+    ASSERT_EQ(ek, k);
+    ASSERT_EQ(ev, v);
+}
+
+TEST_F(SortCpuTests, test_arg_sort_1) {
+    auto x = NDArrayFactory::create<float>('c', {5}, {0.5f, -2.f, 3.f, -2.f, 1.f});
+    auto xCopy = x.dup();
+    auto z = NDArrayFactory::create<Nd4jLong>('c', {5});
+    auto e = NDArrayFactory::create<Nd4jLong>('c', {5}, {1, 3, 0, 4, 2});
+
+    NativeOps nativeOps;
+    nativeOps.argSort(nullptr, x.buffer(), x.shapeInfo(), nullptr, nullptr, z.buffer(), z.shapeInfo(), nullptr, nullptr, false);
+
+    ASSERT_EQ(e, z);
+    ASSERT_EQ(*xCopy, x);
+
+    delete xCopy;
+}
+
+TEST_F(SortCpuTests, test_merge_sort_1) {
+    const Nd4jLong length = 1 << 17;
+    std::vector<Nd4jLong> data(length);
+    for (Nd4jLong e = 0; e < length; e++)
+        data[e] = (e * 104729) % 65537;
+
+    auto exp = data;
+    std::sort(exp.begin(), exp.end());
+
+    SortEngine::mergeSort(data.data(), length, [](Nd4jLong a, Nd4jLong b) -> bool { return a < b; }, 4);
+
+    ASSERT_EQ(exp, data);
+}
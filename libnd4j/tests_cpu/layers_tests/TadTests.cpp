@@ -26,6 +26,7 @@
 #include <helpers/TAD.h>
 #include <array>
 #include <helpers/ConstantTadHelper.h>
+#include <thread>
 
 using namespace nd4j;
 
@@ -275,6 +276,48 @@ TEST_F(TadTests, test_column_1) {
     ASSERT_TRUE(shape::equalsStrict(tadPack.primaryShapeInfo(), scalarViewPack.primaryShapeInfo()));
 }
 
+TEST_F(TadTests, test_tad_cache_1) {
+    auto x = NDArrayFactory::create<float>('c', {7, 3, 11});
+    auto helper = nd4j::ConstantTadHelper::getInstance();
+
+    auto hits = helper->cacheHits();
+    auto misses = helper->cacheMisses();
+    auto size = helper->cacheSize();
+
+    auto &packA = helper->tadForDimensions(x.shapeInfo(), {2, 0});
+    ASSERT_EQ(misses + 1, helper->cacheMisses());
+    ASSERT_EQ(size + 1, helper->cacheSize());
+
+    // dimensions are sorted within descriptor, so this is the same pack
+    auto &packB = helper->tadForDimensions(x.shapeInfo(), {0, 2});
+    ASSERT_EQ(hits + 1, helper->cacheHits());
+    ASSERT_EQ(misses + 1, helper->cacheMisses());
+    ASSERT_TRUE(&packA == &packB);
+    ASSERT_EQ(3, packA.numberOfTads());
+}
+
+TEST_F(TadTests, test_tad_cache_2) {
+    auto x = NDArrayFactory::create<float>('c', {13, 5, 9});
+    auto helper = nd4j::ConstantTadHelper::getInstance();
+    auto size = helper->cacheSize();
+
+    std::vector<TadPack*> packs(8);
+    std::vector<std::thread> threads;
+    for (int e = 0; e < (int) packs.size(); e++)
+        threads.emplace_back([&, e] {
+            for (int i = 0; i < 100; i++)
+                packs[e] = &helper->tadForDimensions(x.shapeInfo(), {1});
+        });
+
+    for (auto &t: threads)
+        t.join();
+
+    // concurrent lookups must end up with single cached pack
+    ASSERT_EQ(size + 1, helper->cacheSize());
+    for (auto p: packs)
+        ASSERT_TRUE(p == packs[0]);
+}
+
 ///////////////////////////////////////////////////////////////////
 TEST_F(TadTests, calcOffsets_1) {
     
@@ -0,0 +1,115 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include "testlayers.h"
+#include <helpers/ThreadPool.h>
+#include <NDArray.h>
+#include <vector>
+#include <atomic>
+#include <stdexcept>
+
+using namespace nd4j;
+
+class ThreadPoolTests : public testing::Test {
+public:
+
+};
+
+TEST_F(ThreadPoolTests, test_parallel_for_1) {
+    const Nd4jLong length = 10007;
+    std::vector<int> hits(length, 0);
+
+    Threads::parallel_for([&](Nd4jLong start, Nd4jLong stop) {
+        for (auto e = start; e < stop; e++)
+            hits[e]++;
+    }, 0, length, 7, 4);
+
+    for (Nd4jLong e = 0; e < length; e++)
+        ASSERT_EQ(1, hits[e]);
+}
+
+TEST_F(ThreadPoolTests, test_parallel_for_2) {
+    const Nd4jLong length = 10007;
+    std::vector<int> hits(length, 0);
+    std::atomic<int> calls{0};
+
+    Threads::parallel_for([&](Nd4jLong start, Nd4jLong stop) {
+        calls++;
+        for (auto e = start; e < stop; e++)
+            hits[e]++;
+    }, 0, length, 0, 4);
+
+    for (Nd4jLong e = 0; e < length; e++)
+        ASSERT_EQ(1, hits[e]);
+
+    // default chunking: single span per OpenMP thread, few chunks per pool worker
+#ifdef __ND4J_THREADPOOL__
+    ASSERT_TRUE(calls.load() <= 17);
+#else
+    ASSERT_TRUE(calls.load() <= 4);
+#endif
+}
+
+TEST_F(ThreadPoolTests, test_parallel_for_nested_1) {
+    std::vector<int> hits(64 * 64, 0);
+
+    Threads::parallel_for([&](Nd4jLong rStart, Nd4jLong rStop) {
+        for (auto r = rStart; r < rStop; r++) {
+            Threads::parallel_for([&](Nd4jLong cStart, Nd4jLong cStop) {
+                for (auto c = cStart; c < cStop; c++)
+                    hits[r * 64 + c]++;
+            }, 0, 64, 4, 4);
+        }
+    }, 0, 64, 1, 4);
+
+    for (auto h: hits)
+        ASSERT_EQ(1, h);
+}
+
+TEST_F(ThreadPoolTests, test_parallel_for_exception_1) {
+    ASSERT_ANY_THROW(Threads::parallel_for([&](Nd4jLong start, Nd4jLong stop) {
+        if (start <= 50 && 50 < stop)
+            throw std::runtime_error("chunk failed");
+    }, 0, 100, 10, 4));
+}
+
+TEST_F(ThreadPoolTests, test_parallel_reduce_1) {
+    const Nd4jLong length = 100003;
+
+    auto sum = Threads::parallel_reduce<Nd4jLong>([](Nd4jLong start, Nd4jLong stop) -> Nd4jLong {
+        Nd4jLong r = 0;
+        for (auto e = start; e < stop; e++)
+            r += e;
+
+        return r;
+    }, [](Nd4jLong a, Nd4jLong b) -> Nd4jLong { return a + b; }, 0, length, 113, 4);
+
+    ASSERT_EQ(length * (length - 1) / 2, sum);
+}
+
+TEST_F(ThreadPoolTests, test_pairwise_1) {
+    // long enough to be split between threads
+    auto x = NDArrayFactory::create<float>('c', {100000});
+    auto y = NDArrayFactory::create<float>('c', {100000});
+    auto e = NDArrayFactory::create<float>('c', {100000});
+    x.linspace(1.f);
+    y.assign(2.f);
+    e.linspace(3.f);
+
+    x += y;
+
+    ASSERT_EQ(e, x);
+}
@@ -26,6 +26,12 @@
 #include <Workspace.h>
 #include <MemoryRegistrator.h>
 #include <MmulHelper.h>
+#include <Environment.h>
+#include <helpers/NumaHelper.h>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
 
 using namespace nd4j;
 using namespace nd4j::memory;
@@ -252,6 +258,149 @@ TEST_F(WorkspaceTests, Test_Externalized_1) {
     ASSERT_NEAR(2.0f, m, 1e-5);
 }
 
+TEST_F(WorkspaceTests, Test_Spills_Pool_1) {
+    Workspace ws(128);
+
+    auto p0 = ws.allocateBytes(1000);
+    ASSERT_EQ(1000, ws.getSpilledSize());
+    ASSERT_EQ(0, ws.getPooledSize());
+
+    // spills go back to pool once scope is closed
+    ws.scopeOut();
+    ASSERT_EQ(0, ws.getSpilledSize());
+    ASSERT_EQ(1024, ws.getPooledSize());
+
+    // pooled buffer fits, so it's reused
+    auto p1 = ws.allocateBytes(900);
+    ASSERT_TRUE(p0 == p1);
+    ASSERT_EQ(900, ws.getSpilledSize());
+    ASSERT_EQ(0, ws.getPooledSize());
+
+    // workspace grows here, so pool isn't needed anymore
+    ws.scopeOut();
+    ws.scopeIn();
+    ASSERT_EQ(1900, ws.getCurrentSize());
+    ASSERT_EQ(0, ws.getPooledSize());
+    ASSERT_EQ(0, ws.getSpilledSize());
+}
+
+TEST_F(WorkspaceTests, Test_Spills_Pool_2) {
+    Workspace ws(128);
+
+    // big spills are rounded to page size, not to power of 2
+    ws.allocateBytes(4096 * 5 + 1);
+    ws.scopeOut();
+    ASSERT_EQ(4096 * 6, ws.getPooledSize());
+
+    // pooled block is too big for this request, so it stays in pool
+    ws.allocateBytes(4096);
+    ASSERT_EQ(4096 * 6, ws.getPooledSize());
+    ASSERT_EQ(4096, ws.getSpilledSize());
+
+    ws.scopeOut();
+    ASSERT_EQ(4096 * 7, ws.getPooledSize());
+}
+
+TEST_F(WorkspaceTests, Test_Thread_Chunks_1) {
+    Environment::getInstance()->setWorkspaceThreadChunk(1024);
+    Workspace ws(65536);
+    Environment::getInstance()->setWorkspaceThreadChunk(0);
+
+    auto p0 = (char *) ws.allocateBytes(12);
+    auto p1 = (char *) ws.allocateBytes(12);
+
+    // whole chunk is taken from workspace at once, small allocations are served from it
+    ASSERT_EQ(1024, ws.getCurrentOffset());
+    ASSERT_EQ(16, p1 - p0);
+
+    // big allocations bypass thread chunk
+    ws.allocateBytes(4096);
+    ASSERT_EQ(1024 + 4096, ws.getCurrentOffset());
+
+    // chunk is invalidated once scope is closed
+    ws.scopeOut();
+    auto p2 = (char *) ws.allocateBytes(12);
+    ASSERT_EQ(1024, ws.getCurrentOffset());
+    ASSERT_EQ(p0, p2);
+}
+
+TEST_F(WorkspaceTests, Test_Numa_Policies_1) {
+    ASSERT_EQ(NUMA_INTERLEAVE, NumaHelper::policyByName("interleave"));
+    ASSERT_EQ(NUMA_LOCAL, NumaHelper::policyByName("local"));
+    ASSERT_EQ(-1, NumaHelper::policyByName("something"));
+    ASSERT_TRUE(NumaHelper::numNodes() >= 1);
+    ASSERT_FALSE(NumaHelper::cpusOfNode(0).empty());
+
+    ASSERT_ANY_THROW(Environment::getInstance()->setNumaPolicy(17));
+    ASSERT_ANY_THROW(Environment::getInstance()->setNumaNode(NumaHelper::numNodes()));
+}
+
+TEST_F(WorkspaceTests, Test_Numa_Local_1) {
+    auto policy = Environment::getInstance()->numaPolicy();
+    Environment::getInstance()->setNumaPolicy(NUMA_LOCAL);
+
+    // local policy touches whole workspace, so it's zeroed even without workspace zeroing
+    Workspace ws(1024 * 1024);
+    auto p = (char *) ws.allocateBytes(1024 * 1024);
+    for (int e = 0; e < 1024 * 1024; e++)
+        ASSERT_EQ(0, p[e]);
+
+    auto x = NDArrayFactory::create<float>('c', {512, 512});
+    ASSERT_NEAR(0.0f, x.sumNumber().e<float>(0), 1e-5f);
+
+    Environment::getInstance()->setNumaPolicy(policy);
+}
+
+TEST_F(WorkspaceTests, Test_Numa_Interleave_1) {
+    auto policy = Environment::getInstance()->numaPolicy();
+    Environment::getInstance()->setNumaPolicy(NUMA_INTERLEAVE);
+
+    // big heap array is placed, small one isn't, both must be zeroed
+    auto x = NDArrayFactory::create<float>('c', {1024, 1024});
+    auto y = NDArrayFactory::create<float>('c', {16, 16});
+    ASSERT_TRUE(x.lengthOf() * sizeof(float) >= NumaHelper::minPlacedBytes());
+
+    ASSERT_NEAR(0.0f, x.sumNumber().e<float>(0), 1e-5f);
+    ASSERT_NEAR(0.0f, y.sumNumber().e<float>(0), 1e-5f);
+
+    Environment::getInstance()->setNumaPolicy(policy);
+}
+
+#ifdef __linux__
+TEST_F(WorkspaceTests, Test_Numa_Pin_Team_1) {
+    cpu_set_t before;
+    CPU_ZERO(&before);
+    ASSERT_EQ(0, sched_getaffinity(0, sizeof(cpu_set_t), &before));
+
+    auto pin = Environment::getInstance()->isNumaPinThreads();
+    Environment::getInstance()->setNumaPinThreads(true);
+    NumaHelper::pinTeam();
+    Environment::getInstance()->setNumaPinThreads(pin);
+
+    // pinning team doesn't change affinity of calling thread
+    cpu_set_t after;
+    CPU_ZERO(&after);
+    ASSERT_EQ(0, sched_getaffinity(0, sizeof(cpu_set_t), &after));
+    ASSERT_TRUE(CPU_EQUAL(&before, &after));
+}
+#endif
+
+TEST_F(WorkspaceTests, Test_Numa_First_Touch_1) {
+    std::vector<std::vector<float>> buffers(4, std::vector<float>(100000, 1.0f));
+
+    // called from parallel region it gets team of one thread, whole buffer must be zeroed anyway
+    PRAGMA_OMP_PARALLEL_FOR_THREADS(4)
+    for (int e = 0; e < 4; e++)
+        NumaHelper::firstTouch(buffers[e].data(), buffers[e].size(), sizeof(float));
+
+    std::fill(buffers[0].begin(), buffers[0].end(), 1.0f);
+    NumaHelper::firstTouch(buffers[0].data(), buffers[0].size(), sizeof(float));
+
+    for (auto &buffer: buffers)
+        for (auto v: buffer)
+            ASSERT_EQ(0.0f, v);
+}
+
 // TODO: uncomment this test once long shapes are introduced
 /*
 TEST_F(WorkspaceTests, Test_Big_Allocation_1) {